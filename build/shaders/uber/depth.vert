@@ -0,0 +1,31 @@
+#version 450
+#extension GL_EXT_multiview : require
+
+// Depth prepass: positions only, read from their own tightly packed stream
+layout(location = 0) in vec3 vertex;
+
+struct Camera {
+    mat4 view;
+    mat4 projection;
+    mat4 viewProjection;
+    vec4 position;
+};
+
+layout(set = 0, binding = 0) uniform ViewData {
+    Camera cameras[2];
+} viewData;
+
+layout(std430, set = 0, binding = 1) readonly buffer ObjectData {
+    mat4 worldMatrices[];
+} objects;
+
+// Same expression and operand order of the main pass (world position first), so that its depth test can be an
+// equality: invariant only guarantees identical results for identical computations
+invariant gl_Position;
+
+void main() {
+    mat4 worldMatrix = objects.worldMatrices[gl_InstanceIndex];
+
+    vec4 position = worldMatrix * vec4(vertex, 1.0);
+    gl_Position = viewData.cameras[gl_ViewIndex].viewProjection * position;
+}
@@ -1,13 +1,77 @@
 #version 450
+#extension GL_EXT_nonuniform_qualifier : require
+#extension GL_EXT_multiview : require
 
-layout (std140) uniform FragmentData {
-    sampler2D diffuseTexture;
-    sampler2D shadowMapTexture;
+const uint kNoTexture = 0xFFFFFFFFu;
 
+layout(location = 0) in vec3 worldNormal;
+layout(location = 1) in vec2 fragmentUV;
+layout(location = 2) flat in uint materialId;
+layout(location = 3) in vec3 worldPosition;
+
+layout(location = 0) out vec4 fragColor;
+
+struct Material {
+    vec4 diffuseColor;
+    vec4 specularColor;
+    uint diffuseTexture;
+    uint normalTexture;
+    uint specularTexture;
+    uint padding;
+};
+
+// Bindless resources: materials select their textures by index in a single array
+layout(std430, set = 1, binding = 0) readonly buffer MaterialData {
+    Material materials[];
+} materialData;
+
+layout(set = 1, binding = 2) uniform sampler2D textures[];
+
+struct Camera {
+    mat4 view;
+    mat4 projection;
+    mat4 viewProjection;
+    vec4 position;
+};
+
+// Cascades of the sun light shadows (cascadeCount is 0 without shadows)
+struct Shadows {
+    mat4 viewProjections[4];
+    vec4 splitDepths;
+    vec4 lightDirection;
+    uint cascadeCount;
 };
 
-out vec4 fragColor;
+layout(set = 0, binding = 0) uniform ViewData {
+    Camera cameras[2];
+    Shadows shadows;
+} viewData;
+
+layout(set = 0, binding = 2) uniform sampler2DArrayShadow shadowMap;
+
+// Fraction of light reaching the fragment, filtered by the comparison sampler
+float computeShadow() {
+    float viewDepth = -(viewData.cameras[gl_ViewIndex].view * vec4(worldPosition, 1.0)).z;
+
+    for (uint i = 0; i < viewData.shadows.cascadeCount; ++i) {
+        if (viewDepth <= viewData.shadows.splitDepths[i]) {
+            vec4 shadowCoords = viewData.shadows.viewProjections[i] * vec4(worldPosition, 1.0);
+            return texture(shadowMap, vec4(shadowCoords.xy * 0.5 + 0.5, float(i), shadowCoords.z));
+        }
+    }
+
+    return 1.0;
+}
 
 void main() {
+    Material material = materialData.materials[materialId];
+
+    vec4 diffuseColor = material.diffuseColor;
+    if (material.diffuseTexture != kNoTexture) {
+        diffuseColor *= texture(textures[nonuniformEXT(material.diffuseTexture)], fragmentUV);
+    }
+
+    float diffuse = max(dot(normalize(worldNormal), viewData.shadows.lightDirection.xyz), 0.0) * computeShadow();
 
-}
\ No newline at end of file
+    fragColor = vec4(diffuseColor.rgb * (0.1 + 0.9 * diffuse), diffuseColor.a);
+}
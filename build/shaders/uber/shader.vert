@@ -1,21 +1,61 @@
 #version 450
+#extension GL_ARB_shader_draw_parameters : require
+#extension GL_EXT_multiview : require
 
-// TODO watch out for draw indirect and its structure
-// https://learnopengl.com/Advanced-OpenGL/Advanced-GLSL
-/*
 layout(location = 0) in vec3 vertex;
 layout(location = 1) in vec3 normal;
-layout(location = 2) in vec3 tangent;
-layout(location = 3) in vec3 bitangent;
-layout(location = 4) in vec2 uv;
-*/
+layout(location = 2) in vec2 uv;
+layout(location = 3) in vec3 tangent;
+layout(location = 4) in vec3 bitangent;
 
-/*
-layout (std140) uniform VertexData {
+struct Camera {
+    mat4 view;
+    mat4 projection;
+    mat4 viewProjection;
+    vec4 position;
+};
+
+// Per-frame data, bound with dynamic offsets in the frame ring buffer
+// One camera for each view of a multiview pass (single view passes only use the first one)
+layout(set = 0, binding = 0) uniform ViewData {
+    Camera cameras[2];
+} viewData;
 
+// World matrix of every instance (gl_InstanceIndex already includes firstInstance)
+layout(std430, set = 0, binding = 1) readonly buffer ObjectData {
+    mat4 worldMatrices[];
+} objects;
+
+// Indirect draw commands (VkDrawIndexedIndirectCommand followed by per-draw data)
+struct DrawCommand {
+    uint indexCount;
+    uint instanceCount;
+    uint firstIndex;
+    int vertexOffset;
+    uint firstInstance;
+    uint materialId;
 };
-*/
+
+layout(std430, set = 1, binding = 1) readonly buffer DrawData {
+    DrawCommand draws[];
+} drawData;
+
+// Same expression and operand order of the depth prepass, so that the depth test can be an equality
+invariant gl_Position;
+
+layout(location = 0) out vec3 worldNormal;
+layout(location = 1) out vec2 fragmentUV;
+layout(location = 2) flat out uint materialId;
+layout(location = 3) out vec3 worldPosition;
 
 void main() {
+    mat4 worldMatrix = objects.worldMatrices[gl_InstanceIndex];
+
+    vec4 position = worldMatrix * vec4(vertex, 1.0);
+    gl_Position = viewData.cameras[gl_ViewIndex].viewProjection * position;
 
-}
\ No newline at end of file
+    worldPosition = position.xyz;
+    worldNormal = mat3(worldMatrix) * normal;
+    fragmentUV = uv;
+    materialId = drawData.draws[gl_DrawIDARB].materialId;
+}
@@ -0,0 +1,18 @@
+#version 450
+
+// Shadow cascades: positions only, read from their own tightly packed stream
+layout(location = 0) in vec3 vertex;
+
+// Shadow caster matrices (static casters of each model first), bound with dynamic offsets in the frame ring buffer
+layout(std430, set = 0, binding = 1) readonly buffer ObjectData {
+    mat4 worldMatrices[];
+} objects;
+
+// World to shadow map clip space of the cascade being rendered
+layout(push_constant) uniform CascadeData {
+    mat4 viewProjection;
+} cascade;
+
+void main() {
+    gl_Position = cascade.viewProjection * objects.worldMatrices[gl_InstanceIndex] * vec4(vertex, 1.0);
+}
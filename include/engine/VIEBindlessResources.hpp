@@ -0,0 +1,67 @@
+/* Created by LordRibblesdale on 18/10/2026.
+ * MIT License
+ */
+
+#pragma once
+
+#include <vulkan/vulkan.h>
+#include <cstdint>
+
+/**
+ * @brief VIEBindlessResources class exposing materials, draw data and textures of the scene with one descriptor set
+ * Textures are stored in a single descriptor-indexed array of combined image samplers, while materials and draw data
+ * are storage buffers: shaders select resources by index, so switching material between draws needs no rebinding.
+ * The texture array is partially bound and can be updated after being bound, so textures can be registered at any
+ * time (as long as the slot is not used by a pending command buffer).
+ */
+class VIEBindlessResources {
+public:
+    static constexpr uint32_t kMaterialBinding{0};  ///< Storage buffer of VIEMaterial
+    static constexpr uint32_t kDrawBinding{1};      ///< Storage buffer of VIEDrawCommand (indirect draw data)
+    static constexpr uint32_t kTextureBinding{2};   ///< Variable sized array of sampled textures (last binding)
+
+private:
+    VkDescriptorSetLayout setLayout{};
+    VkDescriptorPool descriptorPool{};
+    VkDescriptorSet descriptorSet{};
+    VkSampler defaultSampler{};         ///< Trilinear repeating sampler, used for every registered texture
+
+    uint32_t maxTextures{0};
+    uint32_t textureCount{0};
+
+public:
+    VIEBindlessResources() = default;
+    VIEBindlessResources(const VIEBindlessResources &) = delete;
+    VIEBindlessResources(VIEBindlessResources &&) = default;
+    ~VIEBindlessResources() = default;
+
+    /**
+     * @brief Creates layout, pool and set, with a texture array limited by the device update-after-bind limits
+     */
+    bool create(const VkDevice &device, const VkPhysicalDevice &physicalDevice, uint32_t requestedMaxTextures);
+
+    void destroy(const VkDevice &device);
+
+    /**
+     * @brief Points one of the storage buffer bindings to a buffer
+     */
+    void setStorageBuffer(const VkDevice &device, uint32_t binding, const VkBuffer &buffer, VkDeviceSize range);
+
+    /**
+     * @brief Adds a texture to the bindless array
+     * @return index of the texture in the array (VIEMaterial::kNoTexture if the array is full)
+     */
+    uint32_t registerTexture(const VkDevice &device, const VkImageView &imageView);
+
+    VkDescriptorSetLayout getSetLayout() const {
+        return setLayout;
+    }
+
+    VkDescriptorSet getDescriptorSet() const {
+        return descriptorSet;
+    }
+
+    uint32_t getTextureCount() const {
+        return textureCount;
+    }
+};
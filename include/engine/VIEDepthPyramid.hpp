@@ -0,0 +1,77 @@
+/* Created by LordRibblesdale on 18/10/2026.
+ * MIT License
+ */
+
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include <vulkan/vulkan.h>
+
+/**
+ * @brief VIEDepthPyramid class, hierarchical depth (farthest depth of each texel footprint) for occlusion culling
+ * Level 0 has the largest power of two extent within the depth buffer, and each level halves the previous one. Levels
+ * are reduced by a compute shader from the depth buffer after the scene is drawn, and stay in general layout.
+ * With reversed depth the farthest value is the minimum, so each texel keeps the minimum of its footprint.
+ */
+class VIEDepthPyramid {
+    VkImage image{};
+    VkDeviceMemory imageMemory{};
+    VkImageView imageView{};                    ///< Every level, for sampling
+    std::vector<VkImageView> levelViews;        ///< One view for each level, for storage writes
+    VkImageView depthView{};                    ///< First layer of the depth buffer, source of the first level
+    VkSampler sampler{};
+
+    VkDescriptorSetLayout setLayout{};
+    VkDescriptorPool descriptorPool{};
+    std::vector<VkDescriptorSet> levelSets;     ///< Source and destination of each level reduction
+    VkPipelineLayout pipelineLayout{};
+    VkPipeline pipeline{};
+
+    VkExtent2D depthExtent{};
+    VkExtent2D extent{};
+
+public:
+    static constexpr uint32_t kGroupSize{8};    ///< Workgroup size (in both dimensions) of the reduction shader
+
+    VIEDepthPyramid() = default;
+    VIEDepthPyramid(const VIEDepthPyramid &) = delete;
+    VIEDepthPyramid(VIEDepthPyramid &&) = default;
+    ~VIEDepthPyramid() = default;
+
+    /**
+     * @brief Creates the pyramid image with every level, and the reduction pipeline
+     * @param depthImage depth buffer (sampled usage), read in depth stencil read only layout
+     * @param reductionModule compute shader reducing a level into the next one
+     */
+    bool create(const VkDevice &device, const VkPhysicalDevice &physicalDevice, const VkCommandPool &commandPool,
+                const VkQueue &queue, VkImage depthImage, VkFormat depthFormat, VkExtent2D depthImageExtent,
+                VkShaderModule reductionModule);
+
+    void destroy(const VkDevice &device);
+
+    /**
+     * @brief Records the reduction of every level, after the depth buffer has been written
+     */
+    void record(const VkCommandBuffer &commandBuffer) const;
+
+    VkImage getImage() const {
+        return image;
+    }
+
+    VkImageView getImageView() const {
+        return imageView;
+    }
+
+    VkSampler getSampler() const {
+        return sampler;
+    }
+
+    VkExtent2D getExtent() const {
+        return extent;
+    }
+
+    uint32_t getLevelCount() const {
+        return static_cast<uint32_t>(levelViews.size());
+    }
+};
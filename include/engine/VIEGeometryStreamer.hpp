@@ -0,0 +1,227 @@
+/* Created by LordRibblesdale on 18/10/2026.
+ * MIT License
+ */
+
+#pragma once
+
+#include <span>
+#include <memory>
+#include <string>
+#include <vector>
+#include <atomic>
+#include <cstdint>
+#include <utility>
+#include <optional>
+#include <vulkan/vulkan.h>
+
+#include "VIERingBuffer.hpp"
+#include "structs/VIEScene.hpp"
+
+/**
+ * @brief VIEGeometryStreamer class, keeping the levels of detail of the scene resident within device and host budgets
+ * Each level of each model is a block, with the geometry of every mesh of the model at that level packed together.
+ * The coarsest level of every model is pinned (uploaded once and never evicted), so that each model can always be
+ * drawn. Every frame, the finest level selected for each model is requested with the projected size of the model as
+ * priority: missing blocks are uploaded from the highest priority down, within the upload budget of the frame, evicting
+ * the blocks least recently drawn (or less important) when the device heaps are full. Draws of a level not resident
+ * use the nearest coarser one instead.
+ * Blocks beyond the host budget are kept in a spill file, and read back on workers when requested.
+ */
+class VIEGeometryStreamer {
+public:
+    struct Budget {
+        VkDeviceSize device{256 << 20};     ///< Device memory of vertices, positions and indices (bytes)
+        size_t host{512 << 20};             ///< Host memory of the blocks (bytes), exceeded without a spill file
+        VkDeviceSize upload{4 << 20};       ///< Geometry uploaded at most each frame (bytes)
+        std::string spillLocation{};        ///< File of the blocks beyond the host budget (empty to keep them all)
+        bool hasPositions{false};           ///< Whether positions are also uploaded, for depth only passes
+    };
+
+    /**
+     * @brief Device buffers the blocks are uploaded to, sized from getVertexCapacity and getIndexCapacity
+     */
+    struct Buffers {
+        VkBuffer vertices{};
+        VkBuffer positions{};               ///< Null without positions
+        VkBuffer indices{};
+    };
+
+private:
+    /**
+     * @brief Geometry of a mesh inside its block
+     */
+    struct Part {
+        uint32_t firstIndex{0};
+        uint32_t indexCount{0};
+        uint32_t vertexOffset{0};
+    };
+
+    enum class BlockState : uint8_t {
+        IN_HOST,                            ///< Geometry in memory, ready to be uploaded
+        SPILLED,                            ///< Geometry only in the spill file
+        LOADING,                            ///< Geometry being read by a worker
+        FAILED                              ///< Geometry lost (spill file not readable), never requested again
+    };
+
+    struct Block {
+        std::vector<VIEVertex> vertices;
+        std::vector<uint32_t> indices;
+        std::vector<Part> parts;            ///< One for each mesh of the model
+        uint32_t vertexCount{0};            ///< Also when the geometry is not in memory
+        uint32_t indexCount{0};
+        std::optional<uint64_t> spillOffset;    ///< Offset of the geometry in the spill file, if written there
+
+        BlockState state{BlockState::IN_HOST};
+        bool isPinned{false};
+        bool isResident{false};
+        uint32_t firstVertex{0};            ///< First vertex in the device heap, when resident
+        uint32_t firstIndex{0};
+        uint64_t lastUsedFrame{0};          ///< Last frame drawing the block
+        uint64_t lastRequestedFrame{0};
+        float importance{0.0f};             ///< Projected size of the model, when last requested
+    };
+
+    struct ModelBlocks {
+        uint32_t firstBlock{0};             ///< Block of the finest level, followed by the coarser ones
+        uint32_t levelCount{1};
+        uint32_t meshCount{0};
+    };
+
+    /**
+     * @brief First fit allocator of ranges of a device heap, keeping free ranges sorted and coalesced
+     */
+    class RangeHeap {
+        std::vector<std::pair<uint32_t, uint32_t>> freeRanges;     ///< Free ranges as (first, count), sorted
+
+    public:
+        void reset(uint32_t capacity);
+        std::optional<uint32_t> allocate(uint32_t count);
+        void release(uint32_t first, uint32_t count);
+    };
+
+    struct PendingRelease {
+        uint32_t block{0};
+        uint32_t firstVertex{0};
+        uint32_t firstIndex{0};
+        uint64_t frame{0};                  ///< Frame evicting the block
+    };
+
+    std::vector<Block> blocks;
+    std::vector<ModelBlocks> models;
+    std::vector<uint32_t> drawLevels;       ///< Level drawn for each level of each model (kUint32Max for none)
+    std::unique_ptr<std::atomic<bool>[]> loadDoneFlags;     ///< Set by workers once a spilled block is read
+    std::vector<uint32_t> loadingBlocks;
+    std::string spillLocation;
+    size_t drawCommandCount{0};             ///< Draws of VIEScene::buildDrawCommands
+    size_t meshCount{0};
+
+    RangeHeap vertexHeap;
+    RangeHeap indexHeap;
+    uint32_t vertexCapacity{0};
+    uint32_t indexCapacity{0};
+    std::vector<PendingRelease> pendingReleases;
+    uint32_t pendingVertexCount{0};         ///< Vertices of the ranges waiting for the frames in flight
+    uint32_t pendingIndexCount{0};
+
+    VIERingBuffer stagingBuffer;            ///< Geometry of the uploads of each frame in flight
+    std::vector<VkBufferCopy> vertexCopies; ///< Copies recorded by the current frame
+    std::vector<VkBufferCopy> positionCopies;
+    std::vector<VkBufferCopy> indexCopies;
+
+    bool hasPositions{false};
+    VkDeviceSize uploadBudget{0};
+    size_t hostBudget{0};
+    size_t hostBytes{0};
+    VkDeviceSize residentBytes{0};
+    uint64_t frameNumber{0};
+    uint32_t framesInFlight{1};
+
+    VkDeviceSize getVertexStride() const;
+    VkDeviceSize getDeviceSize(const Block &block) const;
+    static size_t getHostSize(const Block &block);
+    void dropHostCopy(Block &block);
+    void startLoad(uint32_t block);
+    void finishLoads();
+    bool allocateBlock(Block &block, float importance);
+    void evictBlock(uint32_t block);
+
+    /**
+     * @brief Writes the geometry of a block (with its positions) at data, and adds its copies from the source offset
+     */
+    void writeBlock(const Block &block, uint8_t *data, VkDeviceSize sourceOffset);
+    void recordCopies(const VkCommandBuffer &commandBuffer, VkBuffer source, const Buffers &buffers) const;
+    void updateDrawLevels(const VIEScene &scene);
+
+public:
+    VIEGeometryStreamer() = default;
+    VIEGeometryStreamer(const VIEGeometryStreamer &) = delete;
+    VIEGeometryStreamer(VIEGeometryStreamer &&) = default;
+    ~VIEGeometryStreamer() = default;
+
+    /**
+     * @brief Packs the levels of every model into blocks, and sizes the device heaps within the device budget
+     * Heaps are raised (with a warning) when the pinned levels alone exceed the budget. To be called while the mesh
+     * pool still holds the geometry, which is not needed afterwards.
+     * @return false if the spill file cannot be written
+     */
+    bool build(const VIEScene &scene, const Budget &budget);
+
+    /**
+     * @brief Creates the staging buffer and uploads the pinned levels, waiting for the queue
+     */
+    bool create(const VkDevice &device, const VkPhysicalDevice &physicalDevice, const VkCommandPool &commandPool,
+                const VkQueue &queue, const Buffers &buffers, uint32_t frameCount);
+
+    /**
+     * @brief Waits for the blocks being read, and destroys the staging buffer
+     */
+    void destroy(const VkDevice &device);
+
+    /**
+     * @brief Requests the levels selected by the last VIEScene::updateLods, and stages the uploads of the frame
+     * To be called once a frame, after the fence of the frame has been waited.
+     */
+    void update(const VIEScene &scene, uint32_t frame);
+
+    /**
+     * @brief Records the copies staged by update, to be read by the draws of the same frame
+     */
+    void recordUploads(const VkCommandBuffer &commandBuffer, const Buffers &buffers) const;
+
+    /**
+     * @brief Points the draws of VIEScene::getFrameDrawCommands to the resident levels (disabling those with none)
+     * Fields are only written, so that draws can be patched in mapped memory.
+     */
+    void patchDrawCommands(std::span<VIEDrawCommand> drawCommands) const;
+
+    /**
+     * @brief Points the draws of VIEScene::getShadowDrawCommands to the pinned levels, which never move
+     */
+    void patchShadowDrawCommands(std::span<VIEDrawCommand> drawCommands) const;
+
+    uint32_t getVertexCapacity() const {
+        return vertexCapacity;
+    }
+
+    uint32_t getIndexCapacity() const {
+        return indexCapacity;
+    }
+
+    /**
+     * @brief Device memory of the resident blocks (bytes)
+     */
+    VkDeviceSize getResidentBytes() const {
+        return residentBytes;
+    }
+
+    /**
+     * @brief Host memory of the blocks in memory (bytes)
+     */
+    size_t getHostBytes() const {
+        return hostBytes;
+    }
+
+    uint32_t getBlockCount() const {
+        return static_cast<uint32_t>(blocks.size());
+    }
+};
@@ -0,0 +1,92 @@
+/* Created by LordRibblesdale on 18/10/2026.
+ * MIT License
+ */
+
+#pragma once
+
+#include <array>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <vulkan/vulkan.h>
+
+/**
+ * @brief GPU time of a profiled pass (milliseconds)
+ */
+struct VIEGpuTiming {
+    std::string name;
+    double lastMs{0.0};             ///< Time of the last frame whose results are available
+    double averageMs{0.0};          ///< Rolling average over the last VIEGpuProfiler::kHistorySize frames
+};
+
+/**
+ * @brief VIEGpuProfiler class, timestamps bracketing passes of the frame command buffers
+ * Each frame in flight writes into its own query pool, whose results are read when the same frame begins again: its
+ * fence has already been waited, so results are read without waiting and the device is never stalled. Results still
+ * unavailable are skipped. Scopes are recorded outside render pass instances, as multiview passes would write one
+ * query for each view.
+ */
+class VIEGpuProfiler {
+public:
+    static constexpr uint32_t kHistorySize{64};     ///< Frames of the rolling averages
+
+private:
+    /**
+     * @brief Last samples of a pass, as a ring with their running sum
+     */
+    struct PassHistory {
+        std::array<double, kHistorySize> samples{};
+        uint32_t sampleCount{0};
+        uint32_t nextSample{0};
+        double sum{0.0};
+    };
+
+    std::vector<VkQueryPool> queryPools;                ///< One for each frame in flight, two queries for each scope
+    std::vector<std::vector<uint32_t>> frameScopes;     ///< Pass of each scope recorded by each frame in flight
+    std::vector<uint64_t> results;
+
+    std::vector<VIEGpuTiming> timings;                  ///< Every pass profiled so far, in first recording order
+    std::vector<PassHistory> histories;                 ///< Same order of timings
+
+    uint32_t maxScopes{0};
+    uint32_t currentFrame{0};
+    uint64_t timestampMask{0};                          ///< Valid bits of the timestamps of the queue
+    double timestampPeriod{1.0};                        ///< Nanoseconds for each timestamp increment
+
+public:
+    VIEGpuProfiler() = default;
+    VIEGpuProfiler(const VIEGpuProfiler &) = delete;
+    VIEGpuProfiler(VIEGpuProfiler &&) = default;
+    ~VIEGpuProfiler() = default;
+
+    /**
+     * @brief Creates the query pools, if the queue family supports timestamps (otherwise scopes are not recorded)
+     * @param scopeCount scopes that each frame can record at most
+     */
+    bool create(const VkDevice &device, const VkPhysicalDevice &physicalDevice, uint32_t queueFamilyIndex,
+                uint32_t framesInFlight, uint32_t scopeCount);
+
+    void destroy(const VkDevice &device);
+
+    /**
+     * @brief Reads the results of the previous use of the frame, then resets its queries
+     * To be recorded first in the command buffer, after the fence of the frame has been waited.
+     */
+    void beginFrame(const VkDevice &device, const VkCommandBuffer &commandBuffer, uint32_t frame);
+
+    /**
+     * @brief Writes the starting timestamp of a pass, outside of render pass instances
+     * @return scope to be ended, kUint32Max if not recorded
+     */
+    uint32_t beginScope(const VkCommandBuffer &commandBuffer, const std::string &name);
+
+    void endScope(const VkCommandBuffer &commandBuffer, uint32_t scope) const;
+
+    const std::vector<VIEGpuTiming> &getTimings() const {
+        return timings;
+    }
+
+    bool isEnabled() const {
+        return !queryPools.empty();
+    }
+};
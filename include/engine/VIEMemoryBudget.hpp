@@ -0,0 +1,76 @@
+/* Created by LordRibblesdale on 18/10/2026.
+ * MIT License
+ */
+
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include <vulkan/vulkan.h>
+
+/**
+ * @brief Budget and usage of a memory heap (bytes)
+ */
+struct VIEHeapBudget {
+    VkDeviceSize size{0};
+    VkDeviceSize budget{0};         ///< Memory the process can use before others are affected (size if unknown)
+    VkDeviceSize usage{0};          ///< Memory used by the process, this engine and any other (0 if unknown)
+    bool isDeviceLocal{false};
+};
+
+/**
+ * @brief VIEMemoryBudget class, budget and usage of the device heaps through VK_EXT_memory_budget
+ * Heaps are queried once a frame, and allocations of streamed resources are planned within a share of the budget of
+ * the device local heaps, so that they wait for memory instead of failing when other processes (or other engine
+ * instances) use the same device. Without the extension budgets are the heap sizes and usage is unknown, so nothing
+ * waits.
+ */
+class VIEMemoryBudget {
+    std::vector<VIEHeapBudget> heaps;
+    bool isExtensionEnabled{false};
+    float usageShare{1.0f};         ///< Share of the budgets allocations are planned within
+
+public:
+    VIEMemoryBudget() = default;
+    VIEMemoryBudget(const VIEMemoryBudget &) = delete;
+    VIEMemoryBudget(VIEMemoryBudget &&) = default;
+    ~VIEMemoryBudget() = default;
+
+    static bool isExtensionSupported(const VkPhysicalDevice &physicalDevice);
+
+    /**
+     * @param isExtensionEnabled whether the device has been created with VK_EXT_memory_budget
+     * @param usageShare share of the budgets allocations are planned within, in (0, 1]
+     */
+    void create(const VkPhysicalDevice &physicalDevice, bool isExtensionEnabled, float usageShare);
+
+    /**
+     * @brief Queries budget and usage of every heap, to be called once a frame
+     */
+    void update(const VkPhysicalDevice &physicalDevice);
+
+    /**
+     * @brief Memory that can still be allocated within the share of the budget of the largest device local heap
+     */
+    VkDeviceSize getDeviceHeadroom() const;
+
+    /**
+     * @brief Memory used by the process in the device local heaps
+     */
+    VkDeviceSize getDeviceUsage() const;
+
+    bool canAllocate(VkDeviceSize size) const {
+        return size <= getDeviceHeadroom();
+    }
+
+    /**
+     * @brief Whether budgets and usage are reported by the device (otherwise they are the heap sizes and 0)
+     */
+    bool isTracked() const {
+        return isExtensionEnabled;
+    }
+
+    const std::vector<VIEHeapBudget> &getHeaps() const {
+        return heaps;
+    }
+};
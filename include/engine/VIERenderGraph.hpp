@@ -0,0 +1,209 @@
+/* Created by LordRibblesdale on 18/10/2026.
+ * MIT License
+ */
+
+#pragma once
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <functional>
+#include <vulkan/vulkan.h>
+
+/**
+ * @brief VIERenderGraph class, passes of a frame declared with the resources they read and write
+ * Compiling the declarations culls the passes whose writes reach no output, plans the barriers between passes (one
+ * batched vkCmdPipelineBarrier before each pass, only where a hazard or a layout change exists) and creates the
+ * transient images, aliasing the memory of those whose lifetimes do not overlap. Declarations can be repeated every
+ * frame: compiling them again reuses the plan and transients as long as they match the compiled ones, so that only
+ * imported handles and pass callbacks change.
+ */
+class VIERenderGraph {
+public:
+    using ResourceHandle = uint32_t;
+    using ExecuteCallback = std::function<void(const VkCommandBuffer &)>;
+
+    /**
+     * @brief Pipeline stages, accesses and layout (ignored for buffers) of a resource use
+     */
+    struct Usage {
+        VkPipelineStageFlags stages{VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT};
+        VkAccessFlags access{0};
+        VkImageLayout layout{VK_IMAGE_LAYOUT_UNDEFINED};
+    };
+
+    static constexpr Usage kColorAttachment{VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT,
+                                            VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT,
+                                            VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL};
+    static constexpr Usage kDepthAttachment{VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT |
+                                            VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT,
+                                            VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_READ_BIT |
+                                            VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT,
+                                            VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL};
+    static constexpr Usage kTransferSource{VK_PIPELINE_STAGE_TRANSFER_BIT, VK_ACCESS_TRANSFER_READ_BIT,
+                                           VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL};
+    static constexpr Usage kTransferDestination{VK_PIPELINE_STAGE_TRANSFER_BIT, VK_ACCESS_TRANSFER_WRITE_BIT,
+                                                VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL};
+    static constexpr Usage kPresent{VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, 0, VK_IMAGE_LAYOUT_PRESENT_SRC_KHR};
+
+    /**
+     * @brief Image created by the graph, living only within the frame
+     */
+    struct ImageDescription {
+        VkFormat format{VK_FORMAT_UNDEFINED};
+        VkExtent2D extent{};
+        uint32_t layerCount{1};
+        VkImageUsageFlags usage{0};
+        VkImageAspectFlags aspect{VK_IMAGE_ASPECT_COLOR_BIT};
+    };
+
+private:
+    struct Resource {
+        std::string name;
+        bool isImage{true};
+        bool isTransient{false};
+        bool isOutput{false};                   ///< Read after the frame, passes writing it are never culled
+        VkImage image{};                        ///< Imported image (transients are owned by the compiled plan)
+        VkBuffer buffer{};
+        ImageDescription description{};
+        Usage initialUsage{};                   ///< Last use before the frame (imported resources)
+        Usage finalUsage{};                     ///< Use after the frame, undefined layout to leave it as it is
+    };
+
+    struct Access {
+        ResourceHandle resource{0};
+        Usage usage{};
+        bool isWrite{false};
+    };
+
+    struct Pass {
+        std::string name;
+        ExecuteCallback execute;
+        bool hasSideEffects{false};             ///< Never culled (for example writes outside of the graph)
+        std::vector<Access> accesses;
+    };
+
+    struct Barrier {
+        ResourceHandle resource{0};
+        VkAccessFlags srcAccess{0};
+        VkAccessFlags dstAccess{0};
+        VkImageLayout oldLayout{VK_IMAGE_LAYOUT_UNDEFINED};
+        VkImageLayout newLayout{VK_IMAGE_LAYOUT_UNDEFINED};
+    };
+
+    /**
+     * @brief Barriers recorded together before a pass (or after the last one)
+     */
+    struct BarrierBatch {
+        VkPipelineStageFlags srcStages{0};
+        VkPipelineStageFlags dstStages{0};
+        std::vector<Barrier> imageBarriers;
+        std::vector<Barrier> bufferBarriers;
+    };
+
+    struct Step {
+        uint32_t pass{0};
+        BarrierBatch barriers;
+    };
+
+    struct TransientImage {
+        VkImage image{};
+        VkImageView imageView{};
+        uint32_t memoryBlock{0};
+    };
+
+    std::vector<Resource> resources;
+    std::vector<Pass> passes;
+
+    // Compiled plan
+    std::vector<uint64_t> compiledKey;                  ///< Declarations the plan was compiled from
+    std::vector<Step> steps;                            ///< Passes not culled, in declaration order
+    BarrierBatch finalBarriers;                         ///< Resources left in their final layout
+    std::vector<TransientImage> transientImages;        ///< Same index of resources (null for imported ones)
+    std::vector<VkDeviceMemory> memoryBlocks;           ///< Shared by transients with disjoint lifetimes
+    VkDeviceSize transientMemorySize{0};
+    VkDeviceSize transientRequestedSize{0};             ///< Memory the transients would take without aliasing
+
+    std::vector<uint64_t> buildKey() const;
+    void cullPasses(std::vector<bool> &isPassAlive) const;
+    bool createTransients(const VkDevice &device, const VkPhysicalDevice &physicalDevice,
+                          const std::vector<bool> &isPassAlive);
+    void planBarriers(const std::vector<bool> &isPassAlive);
+    void recordBarriers(const VkCommandBuffer &commandBuffer, const BarrierBatch &batch) const;
+    void destroyTransients(const VkDevice &device);
+
+public:
+    VIERenderGraph() = default;
+    VIERenderGraph(const VIERenderGraph &) = delete;
+    VIERenderGraph(VIERenderGraph &&) = default;
+    ~VIERenderGraph() = default;
+
+    /**
+     * @brief Clears the declarations, to be declared again (the compiled plan is kept)
+     */
+    void reset();
+
+    /**
+     * @brief Declares an image living outside of the graph
+     * @param initialUsage last use of the image before the frame (undefined layout to discard its contents)
+     * @param finalUsage use expected after the frame (undefined layout to leave it as the last pass does)
+     * @param isOutput whether the image is read after the frame
+     */
+    ResourceHandle importImage(const std::string &name, VkImage image, VkImageAspectFlags aspect,
+                               const Usage &initialUsage, const Usage &finalUsage, bool isOutput);
+
+    ResourceHandle importBuffer(const std::string &name, VkBuffer buffer, const Usage &initialUsage, bool isOutput);
+
+    /**
+     * @brief Declares an image created by the graph, whose contents do not outlive the frame
+     */
+    ResourceHandle createImage(const std::string &name, const ImageDescription &description);
+
+    /**
+     * @brief Declares a pass, recorded by execute in declaration order
+     * @param hasSideEffects whether the pass is kept even if none of its writes is read
+     */
+    uint32_t addPass(const std::string &name, ExecuteCallback execute, bool hasSideEffects = false);
+
+    void read(uint32_t pass, ResourceHandle resource, const Usage &usage);
+    void write(uint32_t pass, ResourceHandle resource, const Usage &usage);
+
+    /**
+     * @brief Culls passes, plans barriers and creates transients, unless the declarations match the compiled ones
+     * Transients of a different plan are destroyed after the device is idle.
+     */
+    bool compile(const VkDevice &device, const VkPhysicalDevice &physicalDevice);
+
+    /**
+     * @brief Records the passes not culled, each after its barriers
+     */
+    void execute(const VkCommandBuffer &commandBuffer) const;
+
+    /**
+     * @brief Destroys the transients and forgets the compiled plan
+     */
+    void destroy(const VkDevice &device);
+
+    VkImage getImage(ResourceHandle resource) const;
+
+    /**
+     * @brief View of every layer of a transient image (null for imported images)
+     */
+    VkImageView getImageView(ResourceHandle resource) const;
+
+    uint32_t getPassCount() const {
+        return static_cast<uint32_t>(passes.size());
+    }
+
+    uint32_t getCompiledPassCount() const {
+        return static_cast<uint32_t>(steps.size());
+    }
+
+    VkDeviceSize getTransientMemorySize() const {
+        return transientMemorySize;
+    }
+
+    VkDeviceSize getTransientRequestedSize() const {
+        return transientRequestedSize;
+    }
+};
@@ -0,0 +1,66 @@
+/* Created by LordRibblesdale on 18/10/2026.
+ * MIT License
+ */
+
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include <vulkan/vulkan.h>
+
+/**
+ * @brief VIERenderTarget class storing an offscreen attachment (optionally layered) in device local memory
+ * Layered targets are viewed as 2D arrays, so that a multiview render pass writes one layer for each view.
+ */
+class VIERenderTarget {
+    VkImage image{};
+    VkDeviceMemory imageMemory{};
+    VkImageView imageView{};
+
+    VkFormat format{VK_FORMAT_UNDEFINED};
+    VkExtent2D extent{};
+    uint32_t layerCount{1};
+
+public:
+    VIERenderTarget() = default;
+    VIERenderTarget(const VIERenderTarget &) = delete;
+    VIERenderTarget(VIERenderTarget &&) = default;
+    ~VIERenderTarget() = default;
+
+    /**
+     * @brief Creates the image (single mip level) and its view over every layer
+     * @param aspect aspect of the view (color or depth)
+     */
+    bool create(const VkDevice &device, const VkPhysicalDevice &physicalDevice, VkExtent2D imageExtent,
+                uint32_t imageLayerCount, VkFormat imageFormat, VkImageUsageFlags usage, VkImageAspectFlags aspect);
+
+    void destroy(const VkDevice &device);
+
+    /**
+     * @brief Copies every layer of a color target with 4 bytes texels to host memory, one layer after the other
+     * The target must have been created with transfer source usage and be in transfer source layout. The copy is
+     * submitted to the given queue and waited for before returning.
+     */
+    bool readPixels(const VkDevice &device, const VkPhysicalDevice &physicalDevice, const VkCommandPool &commandPool,
+                    const VkQueue &queue, std::vector<uint8_t> &pixels) const;
+
+    VkImage getImage() const {
+        return image;
+    }
+
+    VkImageView getImageView() const {
+        return imageView;
+    }
+
+    VkFormat getFormat() const {
+        return format;
+    }
+
+    VkExtent2D getExtent() const {
+        return extent;
+    }
+
+    uint32_t getLayerCount() const {
+        return layerCount;
+    }
+};
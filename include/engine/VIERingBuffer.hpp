@@ -0,0 +1,73 @@
+/* Created by LordRibblesdale on 18/10/2026.
+ * MIT License
+ */
+
+#pragma once
+
+#include <vulkan/vulkan.h>
+#include <cstdint>
+#include <optional>
+
+/**
+ * @brief Sub-range of VIERingBuffer, valid until the same frame in flight begins again
+ */
+struct VIERingAllocation {
+    void *data{nullptr};        ///< Mapped pointer to the sub-range
+    VkDeviceSize offset{0};     ///< Offset of the sub-range in the buffer (to be used as dynamic offset)
+    VkDeviceSize size{0};
+};
+
+/**
+ * @brief VIERingBuffer class handing out per-frame uniform, storage and indirect data from a persistently mapped buffer
+ * The buffer is split in one region for each frame in flight: a frame allocates linearly from its own region, which
+ * is reset when the frame begins again (after its fence has been waited), so nothing is created, mapped or updated
+ * while rendering. Sub-ranges are aligned so that they can be bound as dynamic uniform and storage buffers, and can
+ * also be copied from (for staging uploads).
+ */
+class VIERingBuffer {
+    VkBuffer buffer{};
+    VkDeviceMemory bufferMemory{};
+    uint8_t *mappedMemory{nullptr};
+
+    VkDeviceSize frameSize{0};      ///< Size of the region of each frame in flight
+    VkDeviceSize alignment{1};      ///< Alignment of each sub-range
+    VkDeviceSize frameBegin{0};     ///< Offset of the region of the current frame
+    VkDeviceSize head{0};           ///< First free byte in the region of the current frame
+
+public:
+    VIERingBuffer() = default;
+    VIERingBuffer(const VIERingBuffer &) = delete;
+    VIERingBuffer(VIERingBuffer &&) = default;
+    ~VIERingBuffer() = default;
+
+    /**
+     * @brief Creates and maps the buffer (host visible and coherent memory)
+     * @param requestedFrameSize size available to each frame in flight, rounded up to the alignment
+     */
+    bool create(const VkDevice &device, const VkPhysicalDevice &physicalDevice, VkDeviceSize requestedFrameSize,
+                uint32_t framesInFlight);
+
+    void destroy(const VkDevice &device);
+
+    /**
+     * @brief Starts allocating from the region of the given frame, discarding its previous allocations
+     */
+    void beginFrame(uint32_t frame) {
+        frameBegin = frame * frameSize;
+        head = 0;
+    }
+
+    /**
+     * @brief Allocates an aligned sub-range from the region of the current frame
+     * @return std::nullopt if the region is full
+     */
+    std::optional<VIERingAllocation> allocate(VkDeviceSize size);
+
+    VkBuffer getBuffer() const {
+        return buffer;
+    }
+
+    VkDeviceSize getFrameSize() const {
+        return frameSize;
+    }
+};
@@ -15,6 +15,7 @@
 
 #include "VIEStatus.hpp"
 #include "LanguageResource.hpp"
+#include "structs/VIETextureData.hpp"
 
 /**
  * @brief VIESettings structure for data access around the engine
@@ -38,6 +39,8 @@ public:
     const uint32_t kEngineVersion{VK_MAKE_API_VERSION(0, 1, 0, 0)};
 
     const uint8_t kMaxFramesInFlight{2};
+    const VkDeviceSize kMinFrameDataSize{1 << 20};  ///< Minimum size of per-frame uniform and storage data
+    const uint32_t kMaxBindlessTextures{4096};      ///< Size of the bindless texture array (if allowed by the device)
 
     // -----------------------------------------------------------------------------------------------------------------
 
@@ -51,6 +54,49 @@ public:
 
     std::string vertexShaderLocation{};
     std::string fragmentShaderLocation{};
+    std::string depthVertexShaderLocation{};        ///< Position only vertex shader of the depth prepass
+    std::string depthPyramidShaderLocation{};       ///< Compute shader reducing each level of the depth pyramid
+    std::string shadowVertexShaderLocation{};       ///< Position only vertex shader of the shadow cascades
+
+    std::string scenarioLocation{};
+
+    std::string textureCacheLocation{};         ///< Directory of baked textures (empty for no cache)
+    VIEMipFilter mipFilter{VIEMipFilter::BOX};
+    VIETextureCompression textureCompression{VIETextureCompression::NONE};
+
+    uint32_t lodLevels{0};                      ///< Levels of detail generated for each mesh (0 for none)
+    float lodReduction{0.5f};                   ///< Index count ratio between consecutive levels of detail
+    float lodErrorThreshold{1.0f};              ///< Maximum screen-space error (pixels) of the selected levels
+    bool generateMeshlets{false};               ///< Partitions meshes into meshlets for cluster culling
+
+    bool isGeometryStreamingEnabled{false};     ///< Keeps levels of detail resident on demand, within the budgets below
+    VkDeviceSize geometryDeviceBudget{256 << 20};   ///< Device memory of the streamed geometry (bytes)
+    size_t geometryHostBudget{512 << 20};       ///< Host memory of the streamed geometry (bytes)
+    VkDeviceSize geometryUploadBudget{4 << 20}; ///< Geometry uploaded at most each frame (bytes)
+    std::string geometrySpillLocation{};        ///< File of the geometry beyond the host budget (empty for none)
+
+    float memoryBudgetShare{0.9f};              ///< Share of the device heap budgets streamed resources stay within
+
+    bool isStereoEnabled{false};                ///< Renders both eye cameras in a single multiview pass
+    uint32_t stereoXRes{1440};                  ///< Resolution of each eye (layer of the stereo target)
+    uint32_t stereoYRes{1600};
+    float interpupillaryDistance{0.064f};       ///< Distance between the eye cameras (scene units)
+
+    bool isDepthPrepassEnabled{false};          ///< Draws depth only first, then shades with an equal depth test
+    bool isDepthPyramidEnabled{false};          ///< Reduces the depth buffer into a hierarchy for occlusion culling
+
+    bool isShadowEnabled{false};                ///< Cascaded shadow maps of the sun light, cached for static casters
+    uint32_t shadowCascadeCount{4};             ///< Cascades splitting the view depth (at most 4)
+    uint32_t shadowResolution{2048};            ///< Resolution of each cascade
+    float shadowDistance{200.0f};               ///< View depth covered by the cascades (scene units)
+    float shadowSplitLambda{0.75f};             ///< Blend between logarithmic (1) and uniform (0) cascade splits
+    float shadowCasterDistance{100.0f};         ///< Distance towards the light at which casters are still included
+    float shadowDepthBiasConstant{1.25f};
+    float shadowDepthBiasSlope{1.75f};
+
+    bool isGpuProfilingEnabled{false};          ///< Brackets the passes of each frame with timestamp queries
+    std::string traceLocation{};                ///< Chrome trace of the CPU zones, written at shutdown (empty for none)
+    std::string startupReportLocation{};        ///< JSON of the engine status transitions (empty for none)
 
     VkPhysicalDeviceType selectedDeviceType{VK_PHYSICAL_DEVICE_TYPE_DISCRETE_GPU};
     VkPresentModeKHR preferredPresentMode{VK_PRESENT_MODE_FIFO_KHR};
@@ -0,0 +1,132 @@
+/* Created by LordRibblesdale on 18/10/2026.
+ * MIT License
+ */
+
+#pragma once
+
+#include <bit>
+#include <array>
+#include <vector>
+#include <cstdint>
+#include <functional>
+#include <vulkan/vulkan.h>
+
+#include "VIERenderTarget.hpp"
+#include "structs/VIEScene.hpp"
+
+/**
+ * @brief VIEShadowMaps class, cascaded shadow maps of a directional light with cached static casters
+ * Each cascade bounds a slice of the view depth with a sphere, snapped to a grid in light space larger than a texel:
+ * moving the camera within a grid cell leaves the cascade bounds unchanged. Static casters of each cascade are
+ * rendered into a cache layer only when its bounds, the light or the static casters change; the shadow layer is then
+ * a copy of the cache with the dynamic casters drawn over it. Without dynamic casters, layers are only rendered when
+ * stale, so a static scene costs no shadow pass at all.
+ */
+class VIEShadowMaps {
+public:
+    /**
+     * @brief Records the indirect draws of the casters (static or dynamic) with the shadow pipeline layout
+     */
+    using DrawCallback = std::function<void(const VkCommandBuffer &, const VkPipelineLayout &, bool isStatic)>;
+
+private:
+    /**
+     * @brief Cascade bounds, as grid cell of the snapped center in light space and size
+     */
+    struct CascadeKey {
+        int32_t x{0};
+        int32_t y{0};
+        int32_t z{0};
+        float halfSize{0.0f};
+
+        bool operator==(const CascadeKey &) const = default;
+    };
+
+    VIERenderTarget cacheTarget;                    ///< Static casters of each cascade (one layer each)
+    VIERenderTarget shadowTarget;                   ///< Static and dynamic casters of each cascade, sampled by shading
+    VkImageView arrayView{};                        ///< Every layer of shadowTarget, as an array also for one cascade
+    std::vector<VkImageView> cacheLayerViews;
+    std::vector<VkImageView> shadowLayerViews;
+    std::vector<VkFramebuffer> cacheFramebuffers;
+    std::vector<VkFramebuffer> shadowFramebuffers;
+    VkSampler sampler{};                            ///< Depth comparison sampler, filtered over 2x2 texels
+
+    VkRenderPass cachePass{};                       ///< Clears and draws static casters, leaves the layer for copies
+    VkRenderPass shadowPass{};                      ///< Draws dynamic casters over the copy, leaves the layer sampled
+    VkPipelineLayout pipelineLayout{};
+    VkPipeline pipeline{};
+
+    uint32_t cascadeCount{0};
+    uint32_t resolution{1};
+
+    std::array<glm::mat4x4, VIEShadowData::kMaxCascades> viewProjections{};
+    std::array<CascadeKey, VIEShadowData::kMaxCascades> cachedKeys{};
+    std::array<uint64_t, VIEShadowData::kMaxCascades> cachedVersions{};     ///< Static caster version of each cache
+    glm::vec3 cachedLightDirection{0.0f};
+    uint32_t staticRedrawMask{0};                   ///< Cascades whose cache is rendered again this frame
+    uint32_t layerRedrawMask{0};                    ///< Cascades whose shadow layer is rendered again this frame
+    uint32_t dynamicLayerMask{0};                   ///< Cascades whose shadow layer holds dynamic casters
+
+public:
+    static constexpr float kGuardBand{0.25f};       ///< Grid cell size, relative to the cascade sphere radius
+
+    VIEShadowMaps() = default;
+    VIEShadowMaps(const VIEShadowMaps &) = delete;
+    VIEShadowMaps(VIEShadowMaps &&) = default;
+    ~VIEShadowMaps() = default;
+
+    /**
+     * @brief Creates the cache and shadow layers of every cascade, and the depth only caster pipeline
+     * Without cascades, only a single texel shadow layer is created (and never rendered), so that shaders can always
+     * bind it.
+     * @param frameSetLayout set 0 of the caster pipeline (view data and caster matrices with dynamic offsets)
+     * @param vertexModule position only vertex shader, with the cascade matrix as push constant
+     */
+    bool create(const VkDevice &device, const VkPhysicalDevice &physicalDevice, const VkCommandPool &commandPool,
+                const VkQueue &queue, VkFormat depthFormat, uint32_t shadowCascadeCount, uint32_t shadowResolution,
+                VkDescriptorSetLayout frameSetLayout, VkShaderModule vertexModule, float depthBiasConstant,
+                float depthBiasSlope);
+
+    void destroy(const VkDevice &device);
+
+    /**
+     * @brief Fits the cascades to the camera and selects the layers to render this frame
+     * @param distance view depth covered by the cascades
+     * @param splitLambda blend between logarithmic (1) and uniform (0) splits
+     * @param casterDistance distance towards the light at which casters are still included
+     * @param staticCasterVersion version of the static casters, a change makes every cache stale
+     * @param hasDynamicCasters whether dynamic casters are drawn over the cached layers
+     * @param shadowData receives the cascades as read by shaders
+     */
+    void update(const VIECamera &camera, float aspectRatio, const glm::vec3 &lightDirection, float distance,
+                float splitLambda, float casterDistance, uint64_t staticCasterVersion, bool hasDynamicCasters,
+                VIEShadowData &shadowData);
+
+    /**
+     * @brief Records the passes of the layers selected by the last update, before they are sampled
+     */
+    void record(const VkCommandBuffer &commandBuffer, const DrawCallback &drawCasters) const;
+
+    VkImage getImage() const {
+        return shadowTarget.getImage();
+    }
+
+    VkImageView getImageView() const {
+        return arrayView;
+    }
+
+    VkSampler getSampler() const {
+        return sampler;
+    }
+
+    uint32_t getCascadeCount() const {
+        return cascadeCount;
+    }
+
+    /**
+     * @brief Number of cascades rendered by the current frame (static and dynamic casters together)
+     */
+    uint32_t getRedrawnCascadeCount() const {
+        return static_cast<uint32_t>(std::popcount(layerRedrawMask));
+    }
+};
@@ -4,7 +4,9 @@
 
 #pragma once
 
+#include <cstdint>
 #include <iostream>
+#include <string_view>
 
 /**
  * VIEStatus enumerator for engine status
@@ -33,32 +35,70 @@ enum class VIEStatus : uint8_t {
     VULKAN_ENGINE_RUNNING               = 28,   ///<
 };
 
-// inline std::string fromVIEStatusToString(VIEStatus status) {
-inline std::ostream& operator<<(std::ostream& ostream, VIEStatus status) {
+/**
+ * @brief Stage of the engine reaching a status, with its time and memory
+ * Stages overlapping workers are measured between records on the main thread. Stages without a status of their own
+ * are recorded with the status of the engine.
+ */
+struct VIEStatusTiming {
+    VIEStatus status{VIEStatus::UNINITIALISED};
+    std::string_view stage{};       ///< Name of the stage (string literal)
+    double timeMs{0.0};             ///< Since the engine was created
+    double durationMs{0.0};         ///< Since the previous record (or the creation of the engine)
+    int64_t hostMemoryDelta{0};     ///< Change of the resident memory of the process (bytes)
+    int64_t deviceMemoryDelta{0};   ///< Change of the usage of the device local heaps (bytes, 0 if not tracked)
+};
+
+/**
+ * @brief Name of the status, as declared
+ */
+inline std::string_view fromVIEStatusToString(VIEStatus status) {
     switch (status) {
         case VIEStatus::UNINITIALISED:
-            return ostream << "UNINITIALISED";
+            return "UNINITIALISED";
         case VIEStatus::SETTINGS_LOADED:
-            return ostream << "SETTINGS_LOADED";
+            return "SETTINGS_LOADED";
+        case VIEStatus::SCENARIO_LOADED:
+            return "SCENARIO_LOADED";
         case VIEStatus::GLFW_LOADED:
-            return ostream << "GLFW_LOADED";
-        case VIEStatus::VULKAN_SURFACE_CREATED:
-            return ostream << "VULKAN_SURFACE_CREATED";
+            return "GLFW_LOADED";
         case VIEStatus::VULKAN_INSTANCE_CREATED:
-            return ostream << "VULKAN_INSTANCE_CREATED";
+            return "VULKAN_INSTANCE_CREATED";
+        case VIEStatus::VULKAN_SURFACE_CREATED:
+            return "VULKAN_SURFACE_CREATED";
         case VIEStatus::VULKAN_PHYSICAL_DEVICES_PREPARED:
-            return ostream << "VULKAN_PHYSICAL_DEVICES_PREPARED";
+            return "VULKAN_PHYSICAL_DEVICES_PREPARED";
         case VIEStatus::VULKAN_LOGICAL_DEVICE_CREATED:
-            return ostream << "VULKAN_LOGICAL_DEVICE_CREATED";
+            return "VULKAN_LOGICAL_DEVICE_CREATED";
         case VIEStatus::VULKAN_SWAP_CHAIN_CREATED:
-            return ostream << "VULKAN_SWAP_CHAIN_CREATED";
-        case VIEStatus::VULKAN_IMAGE_VIEWS_CREATED:
-            return ostream << "VULKAN_IMAGE_VIEWS_CREATED";
+            return "VULKAN_SWAP_CHAIN_CREATED";
         case VIEStatus::VULKAN_SHADERS_COMPILED:
-            return ostream << "VULKAN_SHADERS_COMPILED";
+            return "VULKAN_SHADERS_COMPILED";
+        case VIEStatus::VULKAN_COMMAND_POOL_CREATED:
+            return "VULKAN_COMMAND_POOL_CREATED";
+        case VIEStatus::VULKAN_IMAGE_VIEWS_CREATED:
+            return "VULKAN_IMAGE_VIEWS_CREATED";
+        case VIEStatus::VULKAN_RENDER_PASSES_GENERATED:
+            return "VULKAN_RENDER_PASSES_GENERATED";
+        case VIEStatus::VULKAN_PIPELINE_STATES_PREPARED:
+            return "VULKAN_PIPELINE_STATES_PREPARED";
+        case VIEStatus::VULKAN_GRAPHICS_PIPELINE_GENERATED:
+            return "VULKAN_GRAPHICS_PIPELINE_GENERATED";
+        case VIEStatus::VULKAN_FRAMEBUFFERS_CREATED:
+            return "VULKAN_FRAMEBUFFERS_CREATED";
+        case VIEStatus::VULKAN_COMMAND_BUFFERS_PREPARED:
+            return "VULKAN_COMMAND_BUFFERS_PREPARED";
         case VIEStatus::VULKAN_RENDERER_CORE_INIT:
-            return ostream << "VULKAN_RENDERER_CORE_INIT";
+            return "VULKAN_RENDERER_CORE_INIT";
+        case VIEStatus::VULKAN_SEMAPHORES_CREATED:
+            return "VULKAN_SEMAPHORES_CREATED";
+        case VIEStatus::VULKAN_ENGINE_RUNNING:
+            return "VULKAN_ENGINE_RUNNING";
         default:
-            return ostream << "[ERROR: VIEStatus not recognised]";
+            return "[ERROR: VIEStatus not recognised]";
     }
-}
\ No newline at end of file
+}
+
+inline std::ostream& operator<<(std::ostream& ostream, VIEStatus status) {
+    return ostream << fromVIEStatusToString(status);
+}
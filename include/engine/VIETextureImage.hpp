@@ -0,0 +1,56 @@
+/* Created by LordRibblesdale on 18/10/2026.
+ * MIT License
+ */
+
+#pragma once
+
+#include <vulkan/vulkan.h>
+
+#include "structs/VIETextureData.hpp"
+
+/**
+ * @brief VIETextureImage class storing a sampled texture (with its whole mip chain) in device local memory
+ * Block compressed textures are copied as they are, so the device samples the compressed blocks directly.
+ */
+class VIETextureImage {
+    VkImage image{};
+    VkDeviceMemory imageMemory{};
+    VkImageView imageView{};
+
+    // Upload recorded and not completed yet
+    VkBuffer stagingBuffer{};
+    VkDeviceMemory stagingMemory{};
+    VkFormat format{VK_FORMAT_UNDEFINED};
+    uint32_t mipCount{0};
+
+public:
+    VIETextureImage() = default;
+    VIETextureImage(const VIETextureImage &) = delete;
+    VIETextureImage(VIETextureImage &&) = default;
+    ~VIETextureImage() = default;
+
+    /**
+     * @brief Creates the image and uploads every mip level through a staging buffer
+     * The copy is submitted to the given queue and waited for before returning, leaving the image ready for sampling.
+     */
+    bool create(const VkDevice &device, const VkPhysicalDevice &physicalDevice, const VkCommandPool &commandPool,
+                const VkQueue &queue, const VIETextureData &texture);
+
+    /**
+     * @brief Creates the image and records the upload of every mip level, leaving it ready for sampling
+     * The staging buffer is kept (and texture no longer needed) until finishUpload.
+     */
+    bool recordUpload(const VkDevice &device, const VkPhysicalDevice &physicalDevice,
+                      const VkCommandBuffer &commandBuffer, const VIETextureData &texture);
+
+    /**
+     * @brief Releases the staging buffer and creates the view, once the recorded upload has completed
+     */
+    bool finishUpload(const VkDevice &device);
+
+    void destroy(const VkDevice &device);
+
+    VkImageView getImageView() const {
+        return imageView;
+    }
+};
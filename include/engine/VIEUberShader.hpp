@@ -8,12 +8,16 @@
 #include <fstream>
 
 #include "VIEStatus.hpp"
+#include "tools/VIETrace.hpp"
+#include "tools/VIELogger.hpp"
 
 class VIEUberShader {
     std::vector<uint32_t> currentVertexShader;
     std::vector<uint32_t> currentFragmentShader;
 
     bool compileSPIRVVertexShader(const std::string &shaderModule) {
+        VIE_TRACE_ZONE("compile vertex shader");
+
         if (shaderc::Compiler compiler{}; compiler.IsValid()) {
             shaderc::CompileOptions options{};
             shaderc::SpvCompilationResult result = compiler.CompileGlslToSpv(shaderModule,
@@ -21,13 +25,13 @@ class VIEUberShader {
                                                                              "vs", options);
 
             if (result.GetCompilationStatus() != shaderc_compilation_status_success) {
-                std::cout << "Error compiling vertex shader." << std::endl;
+                log_error("Error compiling vertex shader.");
                 return false;
             }
 
             currentVertexShader.assign(result.cbegin(), result.cend());
         } else {
-            std::cout << "Error creating Google shaderc (not valid)." << std::endl;
+            log_error("Error creating Google shaderc (not valid).");
             return false;
         }
 
@@ -35,6 +39,8 @@ class VIEUberShader {
     }
 
     bool compileSPIRVFragmentShader(const std::string &shaderModule) {
+        VIE_TRACE_ZONE("compile fragment shader");
+
         if (shaderc::Compiler compiler{}; compiler.IsValid()) {
             shaderc::CompileOptions options{};
             shaderc::SpvCompilationResult result = compiler.CompileGlslToSpv(shaderModule,
@@ -42,20 +48,20 @@ class VIEUberShader {
                                                                              "fs", options);
 
             if (result.GetCompilationStatus() != shaderc_compilation_status_success) {
-                std::cout << "Error compiling fragment shader." << std::endl;
+                log_error("Error compiling fragment shader.");
                 return false;
             }
 
             currentFragmentShader.assign(result.cbegin(), result.cend());
         } else {
-            std::cout << "Error creating Google shaderc (not valid)." << std::endl;
+            log_error("Error creating Google shaderc (not valid).");
             return false;
         }
 
         return true;
     }
 
-    VkShaderModule createShaderModuleFromSPIRV(VkDevice &logicDevice, const std::vector<uint32_t> &spirvCode) const {
+    static VkShaderModule createShaderModuleFromSPIRV(VkDevice &logicDevice, const std::vector<uint32_t> &spirvCode) {
         VkShaderModuleCreateInfo vkShaderModuleCreateInfo{};
         vkShaderModuleCreateInfo.sType = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO;
         vkShaderModuleCreateInfo.codeSize = spirvCode.size() * sizeof(uint32_t);
@@ -64,7 +70,7 @@ class VIEUberShader {
         VkShaderModule shaderModule;
         // TODO align code here with define
         if (vkCreateShaderModule(logicDevice, &vkShaderModuleCreateInfo, nullptr, &shaderModule) != VK_SUCCESS) {
-            std::cout << "Error creating VkShaderModule from SPIR-V code" << std::endl;
+            log_error("Error creating VkShaderModule from SPIR-V code");
             return nullptr;
         }
 
@@ -87,7 +93,7 @@ public:
 
             compileSPIRVVertexShader(vertexShader);
         } else {
-            std::cout << "Error: cannot open vertex shader file {}" << std::endl;
+            log_error("Error: cannot open vertex shader file {}", vertexShaderLocation);
         }
 
         if (fragmentShaderFile.is_open()) {
@@ -99,7 +105,7 @@ public:
 
             compileSPIRVFragmentShader(fragmentShader);
         } else {
-            std::cout << "Error: cannot open fragment shader file {}" << std::endl;
+            log_error("Error: cannot open fragment shader file {}", fragmentShaderLocation);
         }
     }
 
@@ -116,4 +122,57 @@ public:
     VkShaderModule createFragmentModuleFromSPIRV(VkDevice &logicDevice) const {
         return createShaderModuleFromSPIRV(logicDevice, currentFragmentShader);
     }
+
+    /**
+     * @brief Compiles a GLSL file of any stage outside of the uber shader (depth only, compute) into SPIR-V
+     * Only the file is read, so that shaders can be compiled on workers before the device is created.
+     * @return empty code if the file cannot be read or compiled
+     */
+    static std::vector<uint32_t> compileFile(const std::string &shaderLocation, shaderc_shader_kind kind) {
+        VIE_TRACE_ZONE("compile shader");
+
+        std::ifstream shaderFile(shaderLocation);
+
+        if (!shaderFile.is_open()) {
+            log_error("Error: cannot open shader file {}", shaderLocation);
+            return {};
+        }
+
+        std::string shader;
+        for (std::string line; std::getline(shaderFile, line);) {
+            shader.append(line).append("\n");
+        }
+
+        if (shaderc::Compiler compiler{}; compiler.IsValid()) {
+            shaderc::CompileOptions options{};
+            shaderc::SpvCompilationResult result = compiler.CompileGlslToSpv(shader, kind, shaderLocation.c_str(),
+                                                                             options);
+
+            if (result.GetCompilationStatus() != shaderc_compilation_status_success) {
+                log_error("Error compiling shader {}: {}", shaderLocation, result.GetErrorMessage());
+                return {};
+            }
+
+            return {result.cbegin(), result.cend()};
+        }
+
+        log_error("Error creating Google shaderc (not valid).");
+        return {};
+    }
+
+    /**
+     * @return nullptr if the code is empty (not compiled) or the module cannot be created
+     */
+    static VkShaderModule createModule(VkDevice &logicDevice, const std::vector<uint32_t> &spirvCode) {
+        return spirvCode.empty() ? nullptr : createShaderModuleFromSPIRV(logicDevice, spirvCode);
+    }
+
+    /**
+     * @brief Compiles a GLSL file of any stage outside of the uber shader (depth only, compute) into a module
+     * @return nullptr if the file cannot be read or compiled
+     */
+    static VkShaderModule createModuleFromFile(VkDevice &logicDevice, const std::string &shaderLocation,
+                                               shaderc_shader_kind kind) {
+        return createModule(logicDevice, compileFile(shaderLocation, kind));
+    }
 };
\ No newline at end of file
@@ -24,15 +24,30 @@
 #include <GLFW/glfw3.h>
 #include <GLFW/glfw3native.h>
 
+#include <array>
+#include <chrono>
 #include <vector>
 #include <optional>
 #include <iostream>
+#include <stop_token>
 #include <algorithm>
 
 #include "VIEStatus.hpp"
 #include "VIESettings.hpp"
 #include "VIEUberShader.hpp"
+#include "VIERingBuffer.hpp"
+#include "VIEBindlessResources.hpp"
+#include "VIETextureImage.hpp"
+#include "VIERenderTarget.hpp"
+#include "VIEDepthPyramid.hpp"
+#include "VIEShadowMaps.hpp"
+#include "VIEGpuProfiler.hpp"
+#include "VIERenderGraph.hpp"
+#include "VIEGeometryStreamer.hpp"
+#include "VIEMemoryBudget.hpp"
+#include "structs/VIEScene.hpp"
 #include "tools/VIETools.hpp"
+#include "tools/VIETask.hpp"
 
 /* Rendering phases:
  * - Phase 0: Vertex input      (mandatory step for defining input data structure at the beginning of the shader
@@ -55,11 +70,16 @@
 class VIEngine {
     VIESettings settings;
     VIEStatus engineStatus{VIEStatus::UNINITIALISED};
+    std::vector<VIEStatusTiming> statusTimings;                 ///< Every stage recorded, in order
+    std::chrono::steady_clock::time_point creationTime{std::chrono::steady_clock::now()};
+    size_t lastHostMemory{0};                                   ///< Resident memory at the last transition
+    VkDeviceSize lastDeviceMemory{0};                           ///< Device local usage at the last transition
 
     // TODO check which of these elements could be freed from memory after prepareEngine
     // GLFW
     GLFWwindow *glfwWindow{};           ///< GLFW window pointer
     bool isFramebufferResized{false};   ///<
+    uint32_t pickedInstance{kUint32Max};    ///< Instance under the cursor at the last left click
 
     // Vulkan instance
     VkInstance vkInstance{};            ///< Vulkan runtime instance
@@ -72,6 +92,9 @@ class VIEngine {
 
     VkShaderModule vertexModule{};
     VkShaderModule fragmentModule{};
+    VkShaderModule depthVertexModule{};                     ///< Depth prepass vertex shader (positions only)
+    VkShaderModule depthPyramidModule{};                    ///< Depth pyramid level reduction compute shader
+    VkShaderModule shadowVertexModule{};                    ///< Shadow caster vertex shader (positions only)
 
     // Vulkan window surface
     VkSurfaceKHR surface{};             ///< Window surface for GLFW
@@ -101,9 +124,26 @@ class VIEngine {
     VkRenderPass renderPass{};
     VkPipelineLayout pipelineLayout{};
     VkPipeline graphicsPipeline{};
+    VkPipeline depthPipeline{};                             ///< Depth prepass pipeline, first subpass
 
     std::vector<VkFramebuffer> swapChainFramebuffers;
 
+    // Stereo rendering (both eyes in a single multiview pass, then copied side by side to the swap chain image)
+    VIERenderTarget stereoTarget;                           ///< Layered color target, one layer for each eye
+    VkFramebuffer stereoFramebuffer{};
+
+    // Depth (reversed, cleared to 0 and nearer fragments are greater)
+    VkFormat depthFormat{VK_FORMAT_UNDEFINED};
+    VIERenderGraph::ResourceHandle depthResource{0};        ///< Depth buffer (render graph transient), a layer per view
+    VIEDepthPyramid depthPyramid;                           ///< Hierarchical depth, reduced after the scene is drawn
+
+    VIEShadowMaps shadowMaps;                               ///< Cascaded shadows of the scene light, rendered first
+
+    VIEGpuProfiler gpuProfiler;                             ///< Timestamps of the passes of each frame in flight
+    VIEMemoryBudget memoryBudget;                           ///< Budget and usage of the device heaps, each frame
+
+    VIERenderGraph renderGraph;                             ///< Passes of the frame, declared again for every frame
+
     VkCommandPool commandPool;
     std::vector<VkCommandBuffer> commandBuffers;
 
@@ -113,19 +153,98 @@ class VIEngine {
     std::vector<VkFence> imagesInFlight;
     uint8_t currentFrame{0};
 
+    // Scene data
+    VIEScene scene;                                         ///< Models, instances and cameras of the scenario
+    VkBuffer vertexBuffer{};                                ///< Vertices of every mesh in the scene mesh pool
+    VkDeviceMemory vertexBufferMemory{};
+    VkBuffer positionBuffer{};                              ///< Vertex positions only, for depth prepass and shadows
+    VkDeviceMemory positionBufferMemory{};
+    VkBuffer indexBuffer{};                                 ///< Indices of every mesh in the scene mesh pool
+    VkDeviceMemory indexBufferMemory{};
+    VkBuffer materialBuffer{};                              ///< VIEMaterial of every material in the scene
+    VkDeviceMemory materialBufferMemory{};
+    VkBuffer drawBuffer{};                                  ///< VIEDrawCommand of every mesh level (shader data)
+    VkDeviceMemory drawBufferMemory{};
+    uint32_t drawCount{0};
+    VIEGeometryStreamer geometryStreamer;                   ///< Levels of detail in the geometry buffers, if streamed
+    std::vector<VIETextureImage> textureImages;             ///< Textures of the scene, same order of scene textures
+    VIEBindlessResources bindlessResources;                 ///< Materials, draw data and textures descriptor set
+
+    // Asset streaming
+    VIETask<bool> textureStream;                            ///< Loads and uploads textures while frames are drawn
+    std::stop_source loadStopSource;                        ///< Stops the loads in progress
+    std::vector<VIEMaterial> deviceMaterials;               ///< Materials with the bindless slots streamed so far
+    bool areMaterialsDirty{false};                          ///< deviceMaterials to be copied by the next frame
+
+    // Per-frame data
+    VIERingBuffer frameRingBuffer;                          ///< Camera, object and draw data of every frame in flight
+    VkDeviceSize objectDataRange{};                         ///< Size of the object data written each frame
+    VkDescriptorSetLayout frameSetLayout{};                 /**< Views (dynamic uniform), objects (dynamic storage)
+                                                             *    and shadow maps */
+    VkDescriptorPool descriptorPool{};
+    VkDescriptorSet frameDescriptorSet{};                   ///< Bound with the dynamic offsets of the current frame
+
     // Vulkan graphics queue
     VkQueue graphicsQueue{};                                ///< Main rendering queue
     VkQueue presentQueue{};                                 ///< Main frame representation queue
 
+    /**
+     * @brief Offsets of the data of the current frame in the frame ring buffer
+     */
+    struct FrameOffsets {
+        std::array<uint32_t, 2> dynamicOffsets{};           ///< View and object data of the scene pass
+        VkDeviceSize drawOffset{0};
+        std::array<uint32_t, 2> shadowDynamicOffsets{};     ///< View and shadow caster data of the shadow passes
+        VkDeviceSize shadowDrawOffset{0};
+    };
+
     static void framebufferResizeCallback(GLFWwindow *window, int width, int height);
 
+    /**
+     * @brief Picks the instance under the cursor on left clicks, casting a ray from the screen camera
+     */
+    static void mouseButtonCallback(GLFWwindow *window, int button, int action, int mods);
+
     bool drawFrame();
+    bool writeFrameData(FrameOffsets &frameOffsets);
+    bool recordCommandBuffer(const VkCommandBuffer &buffer, uint32_t imageIndex, const FrameOffsets &frameOffsets);
+
+    /**
+     * @brief Declares the passes of the frame and the images they use, to be compiled in renderGraph
+     * Declarations only depend on settings and extents, so that every frame reuses the plan compiled (with the
+     * transients) when the renderer core is generated.
+     */
+    void declareRenderGraph(uint32_t imageIndex, const FrameOffsets &frameOffsets);
+
+    /**
+     * @brief Loads the scene textures in batches on workers, uploading each batch from the main thread
+     * Materials sample a texture from the frame after its upload has completed, and no texture until then.
+     */
+    VIETask<bool> streamTextures(std::stop_token stopToken);
+
+    /**
+     * @brief Creates the render pass, the pipeline layout and the graphics pipelines, from any thread
+     */
+    bool createPipelines(const VkExtent2D &renderExtent);
 
     bool generateRendererCore();
     bool regenerateRendererCore();
 
+    VkExtent2D getRenderExtent() const;
+
     void cleanSwapchain();
 
+    /**
+     * @brief Records the time and memory of the stage reaching status, without changing the engine status
+     * To be called by the main thread only.
+     */
+    void recordTiming(VIEStatus status, std::string_view stage = {});
+
+    /**
+     * @brief Records the stage reaching status, and moves the engine into it unless the engine is already further
+     */
+    void setStatus(VIEStatus status, std::string_view stage = {});
+
 public:
     VIEngine() = delete;
     explicit VIEngine(VIESettings settings);
@@ -133,25 +252,77 @@ public:
     VIEngine(VIEngine &&) = default;
     ~VIEngine();
 
-    /** TODO complete documentation
-     * @brief
+    /**
+     * @brief VIEngine::loadScenario for loading models, instances and cameras from the scenario in VIESettings
+     * Optional before prepareEngine, which otherwise loads the scenario while the device is created.
      */
     bool loadScenario();
 
+    /**
+     * @brief Loads the scenario on workers, returning on the main thread (textures are streamed after prepareEngine)
+     * @return false if the scenario cannot be loaded, or the load was stopped
+     */
+    VIETask<bool> loadScenarioAsync(std::stop_token stopToken = {});
+
+    /**
+     * @brief Stops the loads in progress, waiting for the texture stream to return
+     */
+    void cancelLoading();
+
     /**
      * @brief VIEngine::prepareEngine for running up all processes (initialisation, preparation, running, cleaning)
      * This function collects all functions needed for running the engine for initialization
+     * Shaders are compiled (and the scenario loaded, if not yet) on workers while GLFW, the instance and the device are
+     * created, and pipelines along with the swap chain. The wall time of each stage is logged.
      */
     bool prepareEngine();
 
-    /** TODO complete documentation
-     * @brief
+    /**
+     * @brief Draws frames until the window is closed
+     * @param frameLimit frames drawn at most (0 for no limit)
      */
-    void runEngine();
+    void runEngine(uint64_t frameLimit = 0);
 
     /** TODO complete documentation
      * @brief
      *
      */
     void cleanEngine();
+
+    /**
+     * @brief Reads back both eyes of the last rendered stereo frame, left eye first (4 bytes per texel)
+     * To be called after at least one frame has been drawn.
+     * @return false if stereo rendering is not enabled or the engine is not prepared
+     */
+    bool captureStereoFrame(std::vector<uint8_t> &pixels);
+
+    /**
+     * @brief GPU time of each profiled pass, empty if profiling is disabled or not supported
+     */
+    const std::vector<VIEGpuTiming> &getGpuTimings() const {
+        return gpuProfiler.getTimings();
+    }
+
+    /**
+     * @brief Budget and usage of each memory heap as of the last frame (see VIEMemoryBudget::isTracked)
+     */
+    const std::vector<VIEHeapBudget> &getMemoryBudgets() const {
+        return memoryBudget.getHeaps();
+    }
+
+    VIEStatus getStatus() const {
+        return engineStatus;
+    }
+
+    /**
+     * @brief Every stage recorded since the engine was created, with the status reached, its duration and memory delta
+     */
+    const std::vector<VIEStatusTiming> &getStatusTimings() const {
+        return statusTimings;
+    }
+
+    /**
+     * @brief Writes the status timings as JSON, also written once running if the settings name a startup report
+     */
+    bool writeStatusReport(const std::string &reportLocation) const;
 };
\ No newline at end of file
@@ -0,0 +1,74 @@
+/* Created by LordRibblesdale on 18/10/2026.
+ * MIT License
+ */
+
+#pragma once
+
+#include <limits>
+#include <glm/glm.hpp>
+#include <glm/mat4x4.hpp>
+
+/**
+ * @brief Axis aligned bounding box (empty when minimum > maximum)
+ */
+struct VIEAABB {
+    glm::vec3 minimum{std::numeric_limits<float>::max()};
+    glm::vec3 maximum{std::numeric_limits<float>::lowest()};
+
+    void extend(const glm::vec3 &point) {
+        minimum = glm::min(minimum, point);
+        maximum = glm::max(maximum, point);
+    }
+
+    void extend(const VIEAABB &box) {
+        minimum = glm::min(minimum, box.minimum);
+        maximum = glm::max(maximum, box.maximum);
+    }
+
+    bool isEmpty() const {
+        return minimum.x > maximum.x || minimum.y > maximum.y || minimum.z > maximum.z;
+    }
+
+    glm::vec3 getCenter() const {
+        return (minimum + maximum) * 0.5f;
+    }
+
+    float getSurfaceArea() const {
+        if (isEmpty()) {
+            return 0.0f;
+        }
+
+        const glm::vec3 size(maximum - minimum);
+        return 2.0f * (size.x * size.y + size.y * size.z + size.z * size.x);
+    }
+
+    bool overlaps(const VIEAABB &box) const {
+        return minimum.x <= box.maximum.x && maximum.x >= box.minimum.x &&
+               minimum.y <= box.maximum.y && maximum.y >= box.minimum.y &&
+               minimum.z <= box.maximum.z && maximum.z >= box.minimum.z;
+    }
+
+    bool overlapsSphere(const glm::vec3 &center, float radius) const {
+        const glm::vec3 delta(center - glm::clamp(center, minimum, maximum));
+        return glm::dot(delta, delta) <= radius * radius;
+    }
+
+    /**
+     * @brief Box around the transformed box (the eight corners are not computed, see Arvo's method)
+     */
+    VIEAABB transform(const glm::mat4x4 &matrix) const {
+        VIEAABB result;
+        result.minimum = result.maximum = glm::vec3(matrix[3]);
+
+        for (int column = 0; column < 3; ++column) {
+            const glm::vec3 axis(matrix[column]);
+            const glm::vec3 a(axis * minimum[column]);
+            const glm::vec3 b(axis * maximum[column]);
+
+            result.minimum += glm::min(a, b);
+            result.maximum += glm::max(a, b);
+        }
+
+        return result;
+    }
+};
@@ -0,0 +1,98 @@
+/* Created by LordRibblesdale on 18/10/2026.
+ * MIT License
+ */
+
+#pragma once
+
+#include <span>
+#include <vector>
+#include <cstdint>
+
+#include "structs/VIEAABB.hpp"
+#include "structs/VIEFrustum.hpp"
+
+/**
+ * @brief VIEBVH class, bounding volume hierarchy over a set of boxes (scene instances) for culling and spatial queries
+ * The tree is built top-down with binned SAH splits: top levels are split with parallel binning, then the remaining
+ * subtrees are built by different workers. Nodes are stored in a single array, children of a node are adjacent and
+ * always follow their parent, so a refit (after primitives moved) is a single reverse pass.
+ */
+class VIEBVH {
+public:
+    struct Node {
+        VIEAABB bounds;
+        uint32_t firstChild{0};         ///< Left child (right one is firstChild + 1), or first primitive of a leaf
+        uint32_t primitiveCount{0};     ///< Primitives of a leaf (0 for inner nodes)
+
+        bool isLeaf() const {
+            return primitiveCount > 0;
+        }
+    };
+
+    static constexpr uint32_t kMaxLeafSize{4};          ///< Leaves are always created below this size
+    static constexpr uint32_t kBinCount{16};            ///< SAH candidate splits for each axis
+    static constexpr float kRebuildAreaRatio{2.0f};     ///< Root area growth (since the build) suggesting a rebuild
+
+private:
+    std::vector<Node> nodes;
+    std::vector<uint32_t> primitiveIndices;     ///< Primitives referenced by leaves, grouped by leaf
+    std::vector<VIEAABB> primitiveBounds;
+    float builtRootArea{0.0f};                  ///< Root surface area right after the last build
+
+    bool splitNode(std::vector<Node> &treeNodes, uint32_t node, uint32_t first, uint32_t count,
+                   const std::vector<glm::vec3> &centroids, bool isParallel, uint32_t &split);
+    void buildSubtree(std::vector<Node> &treeNodes, uint32_t first, uint32_t count,
+                      const std::vector<glm::vec3> &centroids);
+
+public:
+    /**
+     * @brief Builds the tree from scratch
+     * @param bounds box of each primitive, primitives are then identified by their index
+     */
+    void build(std::span<const VIEAABB> bounds);
+
+    /**
+     * @brief Updates the boxes of the tree after primitives moved, keeping the same topology
+     * @param bounds box of each primitive (same count of the last build)
+     * @return false if the primitive count changed (build is needed)
+     */
+    bool refit(std::span<const VIEAABB> bounds);
+
+    /**
+     * @brief True if refits made the tree loose enough to be worth a new build
+     */
+    bool needsRebuild() const {
+        return !nodes.empty() && nodes.front().bounds.getSurfaceArea() > builtRootArea * kRebuildAreaRatio;
+    }
+
+    /**
+     * @brief Primitives intersecting the frustum (whole subtrees inside every plane are taken without more tests)
+     */
+    void queryFrustum(const VIEFrustum &frustum, std::vector<uint32_t> &results) const;
+
+    /**
+     * @brief Primitives whose box overlaps the sphere
+     */
+    void querySphere(const glm::vec3 &center, float radius, std::vector<uint32_t> &results) const;
+
+    /**
+     * @brief Primitives whose box overlaps the box
+     */
+    void queryBox(const VIEAABB &box, std::vector<uint32_t> &results) const;
+
+    /**
+     * @brief Closest primitive box hit by a ray
+     * @param direction ray direction (not necessarily normalised, distances are expressed in its length)
+     * @param distance maximum distance as input, distance of the hit as output
+     * @return false if nothing is hit within the maximum distance
+     */
+    bool raycast(const glm::vec3 &origin, const glm::vec3 &direction, float &distance, uint32_t &primitive) const;
+
+    size_t getPrimitiveCount() const {
+        return primitiveBounds.size();
+    }
+
+    const std::vector<Node> &getNodes() const {
+        return nodes;
+    }
+};
@@ -0,0 +1,25 @@
+/* Created by LordRibblesdale on 18/10/2026.
+ * MIT License
+ */
+
+#pragma once
+
+#include <cstdint>
+
+/**
+ * @brief VIEDrawCommand structure for indexed indirect draws
+ * The first five members have the layout of VkDrawIndexedIndirectCommand, so that the buffer can be consumed both by
+ * vkCmdDrawIndexedIndirect (with this structure as stride) and by shaders, which read the per-draw data through
+ * gl_DrawID.
+ */
+struct VIEDrawCommand {
+    uint32_t indexCount{0};
+    uint32_t instanceCount{0};
+    uint32_t firstIndex{0};
+    int32_t vertexOffset{0};
+    uint32_t firstInstance{0};
+
+    uint32_t materialId{0};     ///< Material of the draw in the material storage buffer
+};
+
+static_assert(sizeof(VIEDrawCommand) == 24, "VIEDrawCommand must match its std430 shader declaration");
@@ -0,0 +1,57 @@
+/* Created by LordRibblesdale on 18/10/2026.
+ * MIT License
+ */
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <glm/glm.hpp>
+#include <glm/mat4x4.hpp>
+
+/**
+ * @brief View frustum as six planes (xyz normal pointing inside, w distance), extracted from a view-projection matrix
+ * Planes follow the Vulkan clip volume with reversed depth (from 1 at the near plane to 0 at the far plane).
+ */
+struct VIEFrustum {
+    enum Plane : uint32_t {
+        LEFT_PLANE = 0, RIGHT_PLANE, BOTTOM_PLANE, TOP_PLANE, NEAR_PLANE, FAR_PLANE
+    };
+
+    std::array<glm::vec4, 6> planes{};
+
+    VIEFrustum() = default;
+
+    explicit VIEFrustum(const glm::mat4x4 &viewProjection) {
+        // Rows of the matrix (glm is column major)
+        std::array<glm::vec4, 4> rows;
+        for (int i = 0; i < 4; ++i) {
+            rows[i] = glm::vec4(viewProjection[0][i], viewProjection[1][i], viewProjection[2][i],
+                                viewProjection[3][i]);
+        }
+
+        planes[LEFT_PLANE] = rows[3] + rows[0];
+        planes[RIGHT_PLANE] = rows[3] - rows[0];
+        planes[BOTTOM_PLANE] = rows[3] + rows[1];
+        planes[TOP_PLANE] = rows[3] - rows[1];
+        planes[NEAR_PLANE] = rows[3] - rows[2];
+        planes[FAR_PLANE] = rows[2];
+
+        for (glm::vec4 &plane: planes) {
+            plane /= glm::length(glm::vec3(plane));
+        }
+    }
+
+    /**
+     * @return false if the sphere is completely outside of at least one plane
+     */
+    bool intersectsSphere(const glm::vec3 &center, float radius) const {
+        for (const glm::vec4 &plane: planes) {
+            if (glm::dot(glm::vec3(plane), center) + plane.w < -radius) {
+                return false;
+            }
+        }
+
+        return true;
+    }
+};
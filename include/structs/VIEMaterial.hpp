@@ -0,0 +1,27 @@
+/* Created by LordRibblesdale on 18/10/2026.
+ * MIT License
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <limits>
+#include <glm/vec4.hpp>
+
+/**
+ * @brief VIEMaterial structure, as read by shaders from the material storage buffer (std430 layout)
+ * Textures are indices in the bindless texture array.
+ */
+struct VIEMaterial {
+    static constexpr uint32_t kNoTexture{std::numeric_limits<uint32_t>::max()};
+
+    glm::vec4 diffuseColor{1.0f};                       ///< Diffuse color (alpha in w)
+    glm::vec4 specularColor{0.0f, 0.0f, 0.0f, 1.0f};    ///< Specular color (shininess in w)
+
+    uint32_t diffuseTexture{kNoTexture};
+    uint32_t normalTexture{kNoTexture};
+    uint32_t specularTexture{kNoTexture};
+    uint32_t padding{0};
+};
+
+static_assert(sizeof(VIEMaterial) == 48, "VIEMaterial must match its std430 shader declaration");
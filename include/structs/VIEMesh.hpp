@@ -4,17 +4,68 @@
 
 #pragma once
 
-#include <vector>
+#include <array>
+#include <cstdint>
+#include <limits>
 
 #include "structs/VIEVertex.hpp"
-#include "structs/transform/VIETransform.hpp"
 
-class VIEMesh : public VIELocalTransform {
-    std::vector<VIEVertex> vertices;
-    std::vector<uint32_t> indices;
-
-    // Textures?
+/**
+ * @brief Level of detail of a VIEMesh, stored right after the full mesh indices and using the same vertices
+ */
+struct VIEMeshLod {
+    uint32_t firstIndex{0};     ///< First index of the level, relative to VIEMesh::firstIndex
+    uint32_t indexCount{0};     ///< Number of indices of the level
+    float error{0.0f};          ///< Geometric error of the level (model space distance from the full mesh)
+};
 
+/**
+ * @brief VIEMesh record, referencing its geometry inside the VIEMeshPool arena
+ * Indices are relative to firstVertex, which is used as vertex offset when drawing.
+ */
+class VIEMesh {
 public:
-    VIEMesh(size_t vertexSize, size_t indicesSize) : vertices(vertexSize), indices(indicesSize) {}
-};
\ No newline at end of file
+    static constexpr uint32_t kMaxLods{8};
+
+    uint32_t firstVertex{0};    ///< First vertex of the mesh in the pool vertex arena
+    uint32_t vertexCount{0};    ///< Number of vertices of the mesh
+    uint32_t firstIndex{0};     ///< First index of the mesh in the pool index arena
+    uint32_t indexCount{0};     ///< Number of indices of the mesh
+    uint32_t materialId{0};     ///< Material of the mesh in VIEScene materials
+    uint32_t firstMeshlet{0};   ///< First meshlet of the mesh (full mesh only) in the pool meshlets
+    uint32_t meshletCount{0};
+
+    std::array<VIEMeshLod, kMaxLods> lods{};    ///< Levels of detail, from the full mesh (level 0) to the coarsest
+    uint32_t lodCount{1};
+
+    /**
+     * @brief Number of indices of the mesh, levels of detail included
+     */
+    uint32_t getIndexSpan() const {
+        return lods[lodCount - 1].firstIndex + lods[lodCount - 1].indexCount;
+    }
+};
+
+/**
+ * @brief Generational handle to a VIEMesh record, invalidated when the record is released
+ */
+struct VIEMeshHandle {
+    static constexpr uint32_t kInvalidIndex{std::numeric_limits<uint32_t>::max()};
+
+    uint32_t index{kInvalidIndex};
+    uint32_t generation{0};
+
+    bool isValid() const {
+        return index != kInvalidIndex;
+    }
+
+    bool operator==(const VIEMeshHandle &) const = default;
+};
+
+/**
+ * @brief Contiguous range of VIEMesh records, identified by the handle of its first record
+ */
+struct VIEMeshRange {
+    VIEMeshHandle first{};
+    uint32_t count{0};
+};
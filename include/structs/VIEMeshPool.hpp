@@ -0,0 +1,145 @@
+/* Created by LordRibblesdale on 18/10/2026.
+ * MIT License
+ */
+
+#pragma once
+
+#include <span>
+#include <vector>
+#include <utility>
+
+#include "structs/VIEMesh.hpp"
+#include "structs/VIEMeshlet.hpp"
+
+/**
+ * @brief VIEMeshPool class storing every VIEMesh record contiguously, with all geometry in a single arena
+ * Records are addressed by generational handles, so stale handles to released meshes are detected. Models own
+ * contiguous ranges of records, so iterating the meshes of a model (or of the whole scene) is a linear scan.
+ */
+class VIEMeshPool {
+    std::vector<VIEMesh> meshes;                ///< Mesh records (released ones have no geometry)
+    std::vector<uint32_t> generations;          ///< Generation of each record slot
+    std::vector<uint8_t> aliveRecords;          ///< 1 if the record slot is in use
+    std::vector<std::pair<uint32_t, uint32_t>> freeRanges;  ///< Released record slots as (first, count), sorted
+
+    std::vector<VIEVertex> vertices;            ///< Vertex arena
+    std::vector<uint32_t> indices;              ///< Index arena
+    size_t releasedVertices{0};                 ///< Arena vertices not referenced by any record anymore
+    size_t releasedIndices{0};                  ///< Arena indices not referenced by any record anymore
+
+    std::vector<VIEMeshlet> meshlets;           ///< Meshlets of every mesh, offsets refer to the arrays below
+    std::vector<uint32_t> meshletVertices;      ///< Mesh vertex indices of every meshlet
+    std::vector<uint8_t> meshletTriangles;      ///< Meshlet vertex indices of every meshlet triangle
+    size_t releasedMeshlets{0};                 ///< Meshlets not referenced by any record anymore
+
+    bool isRecordInArena(const VIEMesh &mesh) const;
+    bool isRangeValid(const VIEMeshRange &range) const;
+
+public:
+    VIEMeshPool() = default;
+    VIEMeshPool(const VIEMeshPool &) = delete;
+    VIEMeshPool(VIEMeshPool &&) = default;
+    ~VIEMeshPool() = default;
+
+    /**
+     * @brief Reserves a contiguous range of empty mesh records (released slots are reused when possible)
+     */
+    VIEMeshRange createMeshes(uint32_t count);
+
+    /**
+     * @brief Releases a range of records: their handles become stale and their geometry is marked as unused
+     */
+    void releaseMeshes(const VIEMeshRange &range);
+
+    /**
+     * @brief Copies mesh geometry at the end of the arena and links it to the record
+     * @return false if the handle is stale
+     */
+    bool setGeometry(const VIEMeshHandle &handle, std::span<const VIEVertex> meshVertices,
+                     std::span<const uint32_t> meshIndices);
+
+    /**
+     * @brief Stores the levels of detail of a mesh after its indices (indexing the same vertices)
+     * @param lodIndices indices of each level, from the finest to the coarsest (full mesh excluded)
+     * @param lodErrors geometric error of each level
+     * @return false if the handle is stale or there are too many levels
+     */
+    bool setLods(const VIEMeshHandle &handle, std::span<const std::vector<uint32_t>> lodIndices,
+                 std::span<const float> lodErrors);
+
+    /**
+     * @brief Copies the meshlets of a mesh (built on its full mesh indices) at the end of the meshlet arrays
+     * @param meshletData meshlets with offsets relative to the given vertex and triangle arrays
+     * @return false if the handle is stale
+     */
+    bool setMeshlets(const VIEMeshHandle &handle, std::span<const VIEMeshlet> meshletData,
+                     std::span<const uint32_t> vertexData, std::span<const uint8_t> triangleData);
+
+    /**
+     * @brief Removes unused geometry from the arena, updating the offsets of the live records
+     */
+    void compactGeometry();
+
+    /**
+     * @brief Frees the vertex and index arenas, once their geometry is owned elsewhere (for example by a streamer)
+     * Records keep their handles, materials, meshlets and level count, while their vertex and index ranges are
+     * zeroed, so that later compactions or range checks never reference the freed arenas.
+     */
+    void releaseGeometry();
+
+    /**
+     * @brief Reserves arena memory for the given number of vertices and indices
+     */
+    void reserveGeometry(size_t vertexCount, size_t indexCount);
+
+    /**
+     * @brief Handle of the i-th record of a range
+     */
+    VIEMeshHandle getHandle(const VIEMeshRange &range, uint32_t i) const;
+
+    /**
+     * @return pointer to the record, or nullptr if the handle is stale
+     */
+    VIEMesh *getMesh(const VIEMeshHandle &handle);
+    const VIEMesh *getMesh(const VIEMeshHandle &handle) const;
+
+    /**
+     * @return records of a range, or an empty span if the range is stale
+     */
+    std::span<VIEMesh> getMeshes(const VIEMeshRange &range);
+    std::span<const VIEMesh> getMeshes(const VIEMeshRange &range) const;
+
+    /**
+     * @brief Every record slot, for linear scans (released records have indexCount == 0)
+     */
+    std::span<const VIEMesh> getAllMeshes() const {
+        return meshes;
+    }
+
+    const std::vector<VIEVertex> &getVertices() const {
+        return vertices;
+    }
+
+    const std::vector<uint32_t> &getIndices() const {
+        return indices;
+    }
+
+    /**
+     * @return meshlets of a mesh
+     */
+    std::span<const VIEMeshlet> getMeshlets(const VIEMesh &mesh) const {
+        return {meshlets.data() + mesh.firstMeshlet, mesh.meshletCount};
+    }
+
+    const std::vector<VIEMeshlet> &getAllMeshlets() const {
+        return meshlets;
+    }
+
+    const std::vector<uint32_t> &getMeshletVertices() const {
+        return meshletVertices;
+    }
+
+    const std::vector<uint8_t> &getMeshletTriangles() const {
+        return meshletTriangles;
+    }
+};
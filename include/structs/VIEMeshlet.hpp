@@ -0,0 +1,35 @@
+/* Created by LordRibblesdale on 18/10/2026.
+ * MIT License
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <glm/vec4.hpp>
+
+/**
+ * @brief Cluster of a VIEMesh (std430 layout), culled as a whole against the frustum, its normal cone and occluders
+ * Vertices are indices of the mesh vertices (relative to VIEMesh::firstVertex) stored in the pool meshlet vertices,
+ * while triangles are triplets of 8 bit indices of the meshlet vertices stored in the pool meshlet triangles (padded
+ * to 4 bytes for each meshlet).
+ */
+struct VIEMeshlet {
+    static constexpr uint32_t kMaxVertices{64};
+    static constexpr uint32_t kMaxTriangles{124};
+
+    glm::vec4 boundingSphere{0.0f};     ///< Center (xyz) and radius (w), in model space
+    glm::vec4 coneApex{0.0f};           ///< Apex of the normal cone (xyz), in model space
+    glm::vec4 coneAxis{0.0f, 0.0f, 0.0f, 1.0f};   ///< Average normal (xyz) and sine of the cone angle (w, 1 if no cone)
+
+    uint32_t vertexOffset{0};           ///< First vertex of the meshlet in the pool meshlet vertices
+    uint32_t triangleOffset{0};         ///< First byte of the meshlet in the pool meshlet triangles
+    uint32_t vertexCount{0};
+    uint32_t triangleCount{0};
+
+    /**
+     * @brief Bytes used by the triangles of the meshlet (padded to 4 bytes)
+     */
+    uint32_t getTriangleSpan() const {
+        return (triangleCount * 3 + 3) & ~3u;
+    }
+};
@@ -4,11 +4,41 @@
 
 #pragma once
 
-#include <list>
+#include <array>
+#include <string>
+#include <vector>
+#include <filesystem>
+#include <glm/vec4.hpp>
 
+#include "structs/VIEAABB.hpp"
 #include "structs/VIEMesh.hpp"
+#include "structs/VIEMaterial.hpp"
+#include "structs/VIETextureData.hpp"
+#include "structs/VIEMeshPool.hpp"
+#include "structs/VIESceneGraph.hpp"
 #include "structs/transform/VIETransform.hpp"
 
-class VIEModel : public std::list<VIEMesh>, public VIELocalTransform, public VIEGlobalTransform {
+class VIEModel : public VIELocalTransform, public VIEGlobalTransform {
+public:
+    std::string keyName{};                          ///< Name of the model in the scenario
+    VIEMeshRange meshes{};                          ///< Meshes of the model, stored in VIEScene mesh pool
+    uint32_t sceneNode{VIESceneGraph::kNoParent};   ///< Node of the model in VIEScene scene graph
 
+    uint32_t firstInstance{0};                      ///< First element of the model instances in the instance buffer
+    uint32_t instanceCount{0};                      ///< Number of instances drawn with a single instanced draw
+
+    VIEAABB boundingBox{};                          ///< Bounds of the model, in model space
+    glm::vec4 boundingSphere{0.0f};                 ///< Center (xyz) and radius (w) of the model, in model space
+    std::array<float, VIEMesh::kMaxLods> lodErrors{};   ///< Geometric error of each level (maximum over meshes)
+    uint32_t lodCount{1};                           ///< Levels of detail of the model (maximum over meshes)
+
+    /**
+     * @brief Loads an OBJ file (with its MTL materials) into the mesh pool, one mesh for each material of each shape
+     * Vertices are deduplicated per mesh, so that each mesh can be drawn indexed. Materials are appended to the
+     * scene materials, while textures are appended (not loaded) to the scene textures, if not already referenced.
+     * Material texture fields store indices of the scene textures.
+     * @return false if the file cannot be parsed or contains no geometry
+     */
+    bool loadOBJ(const std::filesystem::path &objLocation, VIEMeshPool &meshPool, std::vector<VIEMaterial> &materials,
+                 std::vector<VIETextureData> &textures);
 };
@@ -5,13 +5,91 @@
 #pragma once
 
 #include <glm/mat4x4.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+#include <array>
 #include <memory>
+#include <span>
+#include <string>
+#include <vector>
+
+#include "structs/VIEBVH.hpp"
+#include "structs/VIEModel.hpp"
+#include "structs/VIEMaterial.hpp"
+#include "structs/VIETextureData.hpp"
+#include "structs/VIEDrawCommand.hpp"
+#include "structs/VIEMeshPool.hpp"
+#include "structs/VIESceneGraph.hpp"
+#include "tools/VIECulling.hpp"
+
+/**
+ * @brief Camera data as read by shaders (std140 layout)
+ */
+struct VIECameraData {
+    glm::mat4x4 view{1.0f};
+    glm::mat4x4 projection{1.0f};
+    glm::mat4x4 viewProjection{1.0f};
+    glm::vec4 position{0.0f};
+};
 
 struct VIECamera {
-    glm::mat4x4 viewMatrix;
-    glm::vec4 center;
-    glm::vec4 lookAt;
-    glm::vec4 up;
+    glm::mat4x4 viewMatrix{1.0f};
+    glm::mat4x4 projectionMatrix{1.0f};
+    glm::vec4 center{0.0f};
+    glm::vec4 lookAt{0.0f};
+    glm::vec4 up{0.0f, 1.0f, 0.0f, 0.0f};
+
+    float fieldOfView{45.0f};   ///< Vertical field of view (degrees)
+    float nearPlane{0.1f};
+    float farPlane{1000.0f};
+
+    void updateView() {
+        viewMatrix = glm::lookAt(glm::vec3(center), glm::vec3(lookAt), glm::vec3(up));
+    }
+
+    void updateProjection(float aspectRatio) {
+        // Reversed depth (1 at the near plane, 0 at the far plane): float precision is spent far from the camera,
+        // where depth values are closer to each other
+        projectionMatrix = glm::perspectiveRH_ZO(glm::radians(fieldOfView), aspectRatio, farPlane, nearPlane);
+        // Vulkan clip space has Y pointing down
+        projectionMatrix[1][1] *= -1;
+    }
+
+    glm::mat4x4 getViewProjection() const {
+        return projectionMatrix * viewMatrix;
+    }
+
+    VIECameraData getData() const {
+        return {viewMatrix, projectionMatrix, getViewProjection(), center};
+    }
+
+    VIEFrustum getFrustum() const {
+        return VIEFrustum(getViewProjection());
+    }
+};
+
+/**
+ * @brief Shadow cascades of the sun light as read by shaders (std140 layout)
+ * Fragments select the first cascade whose split depth is beyond their view depth.
+ */
+struct VIEShadowData {
+    static constexpr uint32_t kMaxCascades{4};
+
+    std::array<glm::mat4x4, kMaxCascades> viewProjections{};    ///< World to shadow map clip space of each cascade
+    glm::vec4 splitDepths{0.0f};                                ///< View depth where each cascade ends
+    glm::vec4 lightDirection{0.0f};                             ///< Direction towards the light (world space)
+    uint32_t cascadeCount{0};                                   ///< 0 when shadows are disabled
+    std::array<uint32_t, 3> padding{};
+};
+
+/**
+ * @brief Cameras of the views rendered by a pass, selected in shaders by gl_ViewIndex (std140 layout)
+ * A pass rendering a single view only reads the first camera.
+ */
+struct VIEViewData {
+    static constexpr uint32_t kMaxViews{2};     ///< Left and right eye
+
+    std::array<VIECameraData, kMaxViews> cameras{};
+    VIEShadowData shadows{};
 };
 
 class VIEScene {
@@ -19,5 +97,249 @@ class VIEScene {
     std::unique_ptr<VIECamera> leftEyeCamera;
     std::unique_ptr<VIECamera> rightEyeCamera;
 
+    VIESceneGraph sceneGraph;   ///< Hierarchy of every transformable element in the scene
+    VIEMeshPool meshPool;       ///< Mesh records and geometry of every model in the scene
+
+    std::vector<VIEModel> models;
+    std::vector<VIEMaterial> materials{VIEMaterial{}};  ///< Materials of every mesh (0 is the default material)
+    std::vector<VIETextureData> textures;               ///< Textures referenced by materials
+
+    std::vector<uint32_t> instanceNodes;        ///< Scene graph node of every instance, grouped by model
+    std::vector<glm::mat4x4> instanceMatrices;  ///< World matrix of every instance, same order of instanceNodes
+    std::vector<VIEAABB> instanceBounds;        ///< World bounds of every instance, same order of instanceNodes
+    VIEBVH instanceBVH;                         ///< Hierarchy over instanceBounds (primitives are instance indices)
+    VIESphereSet instanceSpheres;               ///< Spheres around instanceBounds, for the culling kernels
+
+    std::vector<uint8_t> instanceLods;                  ///< Level of detail selected for every instance (or culled)
+    std::vector<uint8_t> instanceVisible;               ///< Whether each instance is within a view frustum
+    std::vector<uint32_t> visibleInstances;             ///< Instances within the view frustum being tested
+    std::vector<float> instanceCoverage;                ///< Projected radius of every instance (pixels)
+    std::vector<uint8_t> modelLods;                     ///< Finest level selected for each model
+    std::vector<float> modelCoverage;                   ///< Largest projected radius of the instances of each model
+    std::vector<glm::mat4x4> frameInstanceMatrices;     ///< Instance matrices grouped by level of detail per model
+    std::vector<VIEDrawCommand> frameDrawCommands;      ///< Draws of the selected levels (buildDrawCommands order)
+
+    // Shadow casters: instances moved after loading are dynamic, and are drawn apart from the cached static ones
+    glm::vec3 lightDirection{glm::normalize(glm::vec3(0.5f, 1.0f, 0.3f))};   ///< Direction towards the sun light
+    std::vector<uint8_t> instanceDynamic;               ///< Whether each instance moved since it was loaded
+    uint32_t dynamicInstanceCount{0};
+    uint64_t staticCasterVersion{0};                    ///< Changes whenever the static casters change
+    std::vector<glm::mat4x4> shadowInstanceMatrices;    ///< Instance matrices of each model, static ones first
+    std::vector<VIEDrawCommand> shadowDrawCommands;     ///< Full mesh draws of static casters, then of dynamic ones
+
+    void updateShadowCasters();
+
+public:
+    /**
+     * @brief Loads models (with their instances) and cameras from a scenario file
+     * Every model and instance becomes a node of the scene graph: instances are children of their model node, while
+     * a model without instances is drawn once with its own transform.
+     * @return false if the scenario cannot be parsed
+     */
+    bool loadFromXML(const std::string &scenarioLocation);
+
+    /**
+     * @brief Loads (in parallel) every texture referenced by materials, with their mip chains
+     * Textures that cannot be loaded are removed, and materials referencing them fall back to no texture.
+     * @param cacheDirectory directory of baked textures (empty for no cache)
+     */
+    void loadTextures(VIEMipFilter filter, VIETextureCompression compression, const std::string &cacheDirectory);
+
+    /**
+     * @brief Generates (in parallel) the levels of detail of every mesh by quadric simplification
+     * Levels are stored after the indices of each mesh, then the mesh pool is compacted.
+     * @param maxLevels maximum number of levels for each mesh, full mesh excluded
+     * @param reductionRatio ratio between the index counts of consecutive levels
+     */
+    void generateLods(uint32_t maxLevels, float reductionRatio);
+
+    /**
+     * @brief Partitions (in parallel) the full mesh of every mesh into meshlets, with their culling bounds
+     */
+    void generateMeshlets();
+
+    /**
+     * @brief Propagates transforms through the scene graph and gathers the instance matrices and bounds
+     * The instance hierarchy is refitted, or built again when instances changed or refits made it too loose.
+     * Instances whose world matrix changed become dynamic shadow casters.
+     */
+    void updateInstances(const glm::mat4x4 &viewProjection = glm::mat4x4(1.0f));
+
+    /**
+     * @brief Generates one indexed indirect draw for each level of detail of each mesh
+     * Every mesh gets as many draws as the levels of its model (meshes with fewer levels repeat the coarsest one),
+     * and the full meshes cover every instance.
+     */
+    std::vector<VIEDrawCommand> buildDrawCommands() const;
+
+    /**
+     * @brief Selects the level of detail of every instance from its projected screen-space error
+     * The coarsest level with an error within errorThreshold pixels is chosen. Instances of each model are then
+     * grouped by level in getFrameInstanceMatrices, and getFrameDrawCommands draws each group with its level.
+     * Instances outside every view frustum (see cullInstances) are placed after the levels, and are not drawn.
+     * @param viewportHeight height of the viewport (pixels)
+     * @param errorThreshold maximum projected error (pixels)
+     * @param frusta frusta of the rendered views, every instance is drawn if empty
+     */
+    void updateLods(const VIECamera &camera, float viewportHeight, float errorThreshold,
+                    std::span<const VIEFrustum> frusta = {});
+
+    /**
+     * @brief Tests the bounding sphere of every instance against the frustum with the fastest culling kernel
+     * Large scenes descend the instance hierarchy instead, testing the bounding boxes of the subtrees crossing the
+     * frustum only.
+     * @param visible receives the indices of the visible instances, in order
+     * @return number of visible instances
+     */
+    size_t cullInstances(const VIEFrustum &frustum, std::vector<uint32_t> &visible) const;
+
+    /**
+     * @brief Closest instance whose bounding box is hit by a ray, through the instance hierarchy
+     * @param direction ray direction (not necessarily normalised, distances are expressed in its length)
+     * @param distance maximum distance as input, distance of the hit as output
+     * @return false if no instance is hit within the maximum distance
+     */
+    bool pickInstance(const glm::vec3 &origin, const glm::vec3 &direction, float &distance, uint32_t &instance) const;
+
+    /**
+     * @brief Places the eye cameras at the sides of the screen camera, looking parallel to it
+     * @param interpupillaryDistance distance between the eyes
+     * @param aspectRatio aspect ratio of each eye
+     */
+    void updateEyeCameras(float interpupillaryDistance, float aspectRatio);
+
+    /**
+     * @brief Whether transforms changed since the last updateInstances() call
+     */
+    bool hasDirtyTransforms() const {
+        return sceneGraph.hasDirtyTransforms();
+    }
+
+    uint32_t getInstanceCount() const {
+        return static_cast<uint32_t>(instanceMatrices.size());
+    }
+
+    /**
+     * @brief World matrix of every instance, in the order expected by VIEModel::firstInstance
+     */
+    const std::vector<glm::mat4x4> &getInstanceMatrices() const {
+        return instanceMatrices;
+    }
+
+    /**
+     * @brief Instance matrices ordered by level of detail, as referenced by getFrameDrawCommands
+     */
+    const std::vector<glm::mat4x4> &getFrameInstanceMatrices() const {
+        return frameInstanceMatrices;
+    }
+
+    const std::vector<VIEDrawCommand> &getFrameDrawCommands() const {
+        return frameDrawCommands;
+    }
+
+    /**
+     * @brief Finest level of detail selected by updateLods among the visible instances of each model
+     */
+    const std::vector<uint8_t> &getModelLods() const {
+        return modelLods;
+    }
+
+    /**
+     * @brief Largest projected radius (pixels) among the visible instances of each model, as of the last updateLods
+     */
+    const std::vector<float> &getModelCoverage() const {
+        return modelCoverage;
+    }
+
+    /**
+     * @brief Instance matrices ordered by caster kind (static first) per model, as referenced by getShadowDrawCommands
+     */
+    const std::vector<glm::mat4x4> &getShadowInstanceMatrices() const {
+        return shadowInstanceMatrices;
+    }
+
+    /**
+     * @brief One draw for each mesh with its static casters, followed by one draw for each mesh with its dynamic ones
+     */
+    const std::vector<VIEDrawCommand> &getShadowDrawCommands() const {
+        return shadowDrawCommands;
+    }
+
+    uint32_t getShadowDrawCount() const {
+        return static_cast<uint32_t>(shadowDrawCommands.size());
+    }
+
+    uint32_t getDynamicInstanceCount() const {
+        return dynamicInstanceCount;
+    }
+
+    /**
+     * @brief Version of the static casters: cached shadows rendered with a different version are stale
+     */
+    uint64_t getStaticCasterVersion() const {
+        return staticCasterVersion;
+    }
+
+    const glm::vec3 &getLightDirection() const {
+        return lightDirection;
+    }
+
+    void setLightDirection(const glm::vec3 &direction) {
+        lightDirection = glm::normalize(direction);
+    }
+
+    /**
+     * @brief Hierarchy over the instance bounds, for culling and spatial queries (results are instance indices)
+     */
+    const VIEBVH &getInstanceBVH() const {
+        return instanceBVH;
+    }
+
+    const std::vector<VIEAABB> &getInstanceBounds() const {
+        return instanceBounds;
+    }
+
+    const std::vector<VIEModel> &getModels() const {
+        return models;
+    }
+
+    const std::vector<VIEMaterial> &getMaterials() const {
+        return materials;
+    }
+
+    std::vector<VIETextureData> &getTextures() {
+        return textures;
+    }
+
+    const std::vector<VIETextureData> &getTextures() const {
+        return textures;
+    }
+
+    VIECamera *getScreenCamera() const {
+        return screenCamera.get();
+    }
+
+    VIECamera *getLeftEyeCamera() const {
+        return leftEyeCamera.get();
+    }
+
+    VIECamera *getRightEyeCamera() const {
+        return rightEyeCamera.get();
+    }
+
+    VIESceneGraph &getSceneGraph() {
+        return sceneGraph;
+    }
+
+    const VIESceneGraph &getSceneGraph() const {
+        return sceneGraph;
+    }
+
+    VIEMeshPool &getMeshPool() {
+        return meshPool;
+    }
 
+    const VIEMeshPool &getMeshPool() const {
+        return meshPool;
+    }
 };
@@ -0,0 +1,182 @@
+/* Created by LordRibblesdale on 18/10/2026.
+ * MIT License
+ */
+
+#pragma once
+
+#include <vector>
+#include <limits>
+#include <utility>
+#include <cstdint>
+#include <glm/mat4x4.hpp>
+#include <glm/gtc/quaternion.hpp>
+
+/**
+ * @brief VIESceneGraph class storing the scene hierarchy as flat arrays (structure of arrays)
+ * Nodes are addressed by a stable node index, while data is stored in slots kept in depth-first order: every parent
+ * precedes its children and every subtree is a contiguous range of slots. World and MVP matrices are then propagated
+ * in a single linear pass, split across workers by subtree.
+ * Local transform changes are tracked per slot: local matrices are then composed by the batch kernel, while propagation
+ * only composes the world matrices of changed slots and their descendants, and reports them as dirty until the next
+ * propagation.
+ */
+class VIESceneGraph {
+public:
+    static constexpr uint32_t kNoParent{std::numeric_limits<uint32_t>::max()};
+
+private:
+    // Per-slot data (depth-first order)
+    std::vector<glm::vec3> localTranslations;   ///< Local translation of each slot
+    std::vector<glm::quat> localRotations;      ///< Local rotation of each slot
+    std::vector<glm::vec3> localScales;         ///< Local scale of each slot
+    std::vector<uint32_t> parentSlots;          ///< Parent slot of each slot (kNoParent for roots)
+    std::vector<uint32_t> subtreeSizes;         ///< Number of slots in the subtree of each slot (itself included)
+    std::vector<glm::mat4x4> localMatrices;     ///< Local matrix of each slot, composed in batch when transforms change
+    std::vector<glm::mat4x4> worldMatrices;     ///< World matrix of each slot
+    std::vector<glm::mat4x4> mvpMatrices;       ///< Model-view-projection matrix of each slot
+    std::vector<uint8_t> localDirty;            ///< Local transform (or parent) of each slot changed since propagation
+    std::vector<uint8_t> worldDirty;            ///< World matrix of each slot changed by the last propagation
+
+    // Stable node indices <-> slots mapping
+    std::vector<uint32_t> nodeToSlot;
+    std::vector<uint32_t> slotToNode;
+    std::vector<uint32_t> nodeParents;          ///< Parent node of each node, used to rebuild the slot order
+
+    // Propagation partitioning, rebuilt when the hierarchy changes
+    std::vector<uint32_t> spineSlots;                           ///< Slots of subtrees too big for a single worker
+    std::vector<std::pair<uint32_t, uint32_t>> workRanges;      ///< Contiguous subtrees [first, last) per worker
+    uint32_t partitionGrainSize{kDefaultGrainSize};             ///< Grain size used to build the partition
+
+    bool isOrderDirty{false};
+    bool isPartitionDirty{true};
+    bool isTransformDirty{false};               ///< Some local transform changed since the last propagation
+
+    void sortSlots();
+    void buildPartition();
+    void propagateRange(uint32_t first, uint32_t last, const glm::mat4x4 &viewProjection);
+
+    void markDirty(uint32_t node) {
+        localDirty[nodeToSlot[node]] = 1;
+        isTransformDirty = true;
+    }
+
+public:
+    static constexpr uint32_t kDefaultGrainSize{1024};  ///< Maximum subtree size processed as a single work item
+
+    VIESceneGraph() = default;
+    VIESceneGraph(const VIESceneGraph &) = delete;
+    VIESceneGraph(VIESceneGraph &&) = default;
+    ~VIESceneGraph() = default;
+
+    /**
+     * @brief Adds a node to the hierarchy
+     * @param parentNode parent node index (kNoParent for a root node)
+     * @return stable node index
+     */
+    uint32_t addNode(uint32_t parentNode = kNoParent, const glm::vec3 &translation = glm::vec3(0),
+                     const glm::quat &rotation = glm::quat(1, 0, 0, 0), const glm::vec3 &scale = glm::vec3(1));
+
+    /**
+     * @brief Moves a node (and its whole subtree) under another parent
+     * @return false if the new parent is the node itself or one of its descendants
+     */
+    bool setParent(uint32_t node, uint32_t parentNode);
+
+    /**
+     * @brief Reserves memory for the given number of nodes
+     */
+    void reserve(size_t nodeCount);
+
+    /**
+     * @brief Propagates world and MVP matrices from roots to leaves
+     * Slots are sorted again first if the hierarchy changed since the last call.
+     * @param viewProjection camera view-projection matrix premultiplied to every world matrix
+     * @param grainSize maximum subtree size assigned as a single item to a worker
+     */
+    void updateWorldMatrices(const glm::mat4x4 &viewProjection, uint32_t grainSize = kDefaultGrainSize);
+
+    size_t size() const {
+        return nodeToSlot.size();
+    }
+
+    uint32_t getParent(uint32_t node) const {
+        return nodeParents[node];
+    }
+
+    const glm::vec3 &getLocalTranslation(uint32_t node) const {
+        return localTranslations[nodeToSlot[node]];
+    }
+
+    void setLocalTranslation(uint32_t node, const glm::vec3 &translation) {
+        localTranslations[nodeToSlot[node]] = translation;
+        markDirty(node);
+    }
+
+    const glm::quat &getLocalRotation(uint32_t node) const {
+        return localRotations[nodeToSlot[node]];
+    }
+
+    void setLocalRotation(uint32_t node, const glm::quat &rotation) {
+        localRotations[nodeToSlot[node]] = rotation;
+        markDirty(node);
+    }
+
+    const glm::vec3 &getLocalScale(uint32_t node) const {
+        return localScales[nodeToSlot[node]];
+    }
+
+    void setLocalScale(uint32_t node, const glm::vec3 &scale) {
+        localScales[nodeToSlot[node]] = scale;
+        markDirty(node);
+    }
+
+    /**
+     * @brief Whether the world matrix of a node changed in the last updateWorldMatrices() call
+     * A node is dirty when its local transform, or the one of any ancestor, was set (or it was added or moved).
+     */
+    bool isWorldDirty(uint32_t node) const {
+        return worldDirty[nodeToSlot[node]] != 0;
+    }
+
+    /**
+     * @brief Whether any local transform changed since the last updateWorldMatrices() call
+     */
+    bool hasDirtyTransforms() const {
+        return isTransformDirty;
+    }
+
+    /**
+     * @brief World matrix of a node, as computed by the last updateWorldMatrices() call
+     */
+    const glm::mat4x4 &getWorldMatrix(uint32_t node) const {
+        return worldMatrices[nodeToSlot[node]];
+    }
+
+    /**
+     * @brief MVP matrix of a node, as computed by the last updateWorldMatrices() call
+     */
+    const glm::mat4x4 &getMVPMatrix(uint32_t node) const {
+        return mvpMatrices[nodeToSlot[node]];
+    }
+
+    /**
+     * @brief World matrices in slot order, for bulk upload
+     */
+    const std::vector<glm::mat4x4> &getWorldMatrices() const {
+        return worldMatrices;
+    }
+
+    /**
+     * @brief MVP matrices in slot order, for bulk upload
+     */
+    const std::vector<glm::mat4x4> &getMVPMatrices() const {
+        return mvpMatrices;
+    }
+
+    /**
+     * @brief Slot currently holding the node data (changes when the hierarchy is sorted again)
+     */
+    uint32_t getSlot(uint32_t node) const {
+        return nodeToSlot[node];
+    }
+};
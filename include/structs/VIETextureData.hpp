@@ -0,0 +1,85 @@
+/* Created by LordRibblesdale on 18/10/2026.
+ * MIT License
+ */
+
+#pragma once
+
+#include <string>
+#include <vector>
+#include <cstdint>
+
+/**
+ * VIEMipFilter enumerator for the filter used to generate mip chains
+ */
+enum class VIEMipFilter : uint8_t {
+    BOX     = 0,    ///< 2x2 average, fastest
+    KAISER  = 1,    ///< Kaiser-windowed sinc, sharper minification
+};
+
+/**
+ * VIETextureFormat enumerator for the texel encoding of VIETextureData
+ * Block compressed formats encode 4x4 texel blocks, so levels smaller than a block still take a whole block.
+ */
+enum class VIETextureFormat : uint8_t {
+    RGBA8   = 0,    ///< Uncompressed, 4 bytes per texel
+    BC1     = 1,    ///< RGB, 8 bytes per block
+    BC3     = 2,    ///< RGBA (BC4 alpha and BC1 color), 16 bytes per block
+    BC5     = 3,    ///< Two linear channels (normal maps), 16 bytes per block
+    BC7     = 4,    ///< RGBA, high quality, 16 bytes per block
+};
+
+/**
+ * VIETextureCompression enumerator for the block compression applied when baking textures
+ */
+enum class VIETextureCompression : uint8_t {
+    NONE    = 0,    ///< RGBA8
+    BC      = 1,    ///< BC1 (opaque) or BC3 (with alpha) for color, BC5 for linear data
+    BC7     = 2,    ///< BC7 for color, BC5 for linear data
+};
+
+/**
+ * @return size in bytes of a texture level of the given format
+ */
+inline size_t getTextureLevelSize(VIETextureFormat format, uint32_t width, uint32_t height) {
+    if (format == VIETextureFormat::RGBA8) {
+        return static_cast<size_t>(width) * height * 4;
+    }
+
+    const size_t blockSize = format == VIETextureFormat::BC1 ? 8 : 16;
+
+    return static_cast<size_t>((width + 3) / 4) * ((height + 3) / 4) * blockSize;
+}
+
+/**
+ * @brief Single level of a mip chain, stored in VIETextureData::pixels
+ */
+struct VIEMipLevel {
+    size_t offset{0};       ///< First byte of the level in the pixel array
+    size_t size{0};         ///< Size in bytes of the level
+    uint32_t width{0};
+    uint32_t height{0};
+};
+
+/**
+ * @brief VIETextureData structure for CPU side textures (whole mip chain stored contiguously)
+ */
+struct VIETextureData {
+    std::string location{};     ///< Source file of the texture
+    bool isSRGB{true};          ///< Color data (sRGB) or linear data (normal maps, masks...)
+    VIETextureFormat format{VIETextureFormat::RGBA8};
+
+    std::vector<VIEMipLevel> mipLevels;
+    std::vector<uint8_t> pixels;
+
+    uint32_t getWidth() const {
+        return mipLevels.empty() ? 0 : mipLevels.front().width;
+    }
+
+    uint32_t getHeight() const {
+        return mipLevels.empty() ? 0 : mipLevels.front().height;
+    }
+
+    bool isLoaded() const {
+        return !mipLevels.empty();
+    }
+};
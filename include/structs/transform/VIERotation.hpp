@@ -7,11 +7,20 @@
 #include <glm/mat4x4.hpp>
 #include <glm/gtc/quaternion.hpp>
 
+/**
+ * @brief VIERotation class storing a rotation as quaternion only, Euler angles are derived on demand
+ * Derived angles are the canonical ones of glm::eulerAngles (pitch within [-90, 90] degrees), and setting a single
+ * angle keeps the other two as derived: a triple with a pitch outside that range is to be set at once with setAngles.
+ */
 class VIERotation {
     glm::quat quaternion{1, 0, 0, 0};
-    float roll{0};
-    float pitch{0};
-    float yaw{0};
+
+    // https://en.wikipedia.org/wiki/Conversion_between_quaternions_and_Euler_angles
+    // http://www.euclideanspace.com/maths/geometry/rotations/conversions/quaternionToEuler/
+    // glm::quat is built from (pitch, yaw, roll) around (x, y, z): roll, pitch and yaw are stored as x, y and z
+    glm::vec3 getRadians() const {
+        return glm::eulerAngles(quaternion);
+    }
 
 public:
     VIERotation() = default;
@@ -26,54 +35,46 @@ public:
 
     void setQuaternion(const glm::quat &quaternion) {
         VIERotation::quaternion = quaternion;
-
-        // https://en.wikipedia.org/wiki/Conversion_between_quaternions_and_Euler_angles
-        // http://www.euclideanspace.com/maths/geometry/rotations/conversions/quaternionToEuler/
-        // TODO understand why glm::quat generates a 321 rotation, but importing it is necessary a 312 setup
-        yaw = glm::roll(quaternion);
-        roll = glm::pitch(quaternion);
-        pitch = glm::yaw(quaternion);
     }
 
     float getRoll() const {
-        return roll;
+        return getRadians().x;
     }
 
     void setRoll(float roll) {
-        VIERotation::roll = glm::radians(roll);
+        glm::vec3 angles(getRadians());
+        angles.x = glm::radians(roll);
 
-        quaternion = glm::quat({VIERotation::roll, pitch, yaw});
+        quaternion = glm::quat(angles);
     }
 
     float getPitch() const {
-        return pitch;
+        return getRadians().y;
     }
 
     void setPitch(float pitch) {
-        VIERotation::pitch = glm::radians(pitch);
+        glm::vec3 angles(getRadians());
+        angles.y = glm::radians(pitch);
 
-        quaternion = glm::quat ({roll, VIERotation::pitch, yaw});
+        quaternion = glm::quat(angles);
     }
 
     float getYaw() const {
-        return yaw;
+        return getRadians().z;
     }
 
     void setYaw(float yaw) {
-        VIERotation::yaw = glm::radians(yaw);
+        glm::vec3 angles(getRadians());
+        angles.z = glm::radians(yaw);
 
-        quaternion = glm::quat({roll, pitch, VIERotation::yaw});
+        quaternion = glm::quat(angles);
     }
 
     auto getAngles() const {
-        return glm::degrees<3, float, glm::defaultp>({roll, pitch, yaw});
+        return glm::degrees<3, float, glm::defaultp>(getRadians());
     }
 
     void setAngles(const glm::vec3 &angles) {
-        roll = angles.x;
-        pitch = angles.y;
-        yaw = angles.z;
-
-        quaternion = glm::quat({roll, pitch, yaw});
+        quaternion = glm::quat(angles);
     }
-};
\ No newline at end of file
+};
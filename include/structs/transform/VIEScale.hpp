@@ -5,62 +5,52 @@
 #pragma once
 
 #include <glm/mat4x4.hpp>
-#include <glm/gtc/quaternion.hpp>
+#include <glm/gtc/matrix_transform.hpp>
 
+/**
+ * @brief VIEScale class storing a per-axis scale vector, matrices are generated on demand
+ */
 class VIEScale {
-    glm::mat4x4 scaleMatrix;
-    float xScale;
-    float yScale;
-    float zScale;
+    glm::vec3 scale{1};
 
 public:
-    const glm::mat4x4 &getScaleMatrix() const {
-        return scaleMatrix;
+    glm::mat4x4 getScaleMatrix() const {
+        return glm::scale(glm::identity<glm::mat4x4>(), scale);
     }
 
     void setScaleMatrix(const glm::mat4x4 &scaleMatrix) {
-        VIEScale::scaleMatrix = scaleMatrix;
-
-        xScale = scaleMatrix[0].x;
-        yScale = scaleMatrix[1].y;
-        zScale = scaleMatrix[2].z;
+        scale = glm::vec3(scaleMatrix[0].x, scaleMatrix[1].y, scaleMatrix[2].z);
     }
 
     void setScaleMatrix(const glm::vec3 &scaleVector) {
-        scaleMatrix = glm::scale(glm::identity<glm::mat4x4>(), scaleVector);
+        scale = scaleVector;
+    }
 
-        xScale = scaleMatrix[0].x;
-        yScale = scaleMatrix[1].y;
-        zScale = scaleMatrix[2].z;
+    const glm::vec3 &getScale() const {
+        return scale;
     }
 
     float getXScale() const {
-        return xScale;
+        return scale.x;
     }
 
     void setXScale(float xScale) {
-        VIEScale::xScale = xScale;
-
-        scaleMatrix = glm::scale(glm::identity<glm::mat4x4>(), {xScale, yScale, zScale});
+        scale.x = xScale;
     }
 
     float getYScale() const {
-        return yScale;
+        return scale.y;
     }
 
     void setYScale(float yScale) {
-        VIEScale::yScale = yScale;
-
-        scaleMatrix = glm::scale(glm::identity<glm::mat4x4>(), {xScale, yScale, zScale});
+        scale.y = yScale;
     }
 
     float getZScale() const {
-        return zScale;
+        return scale.z;
     }
 
     void setZScale(float zScale) {
-        VIEScale::zScale = zScale;
-
-        scaleMatrix = glm::scale(glm::identity<glm::mat4x4>(), {xScale, yScale, zScale});
+        scale.z = zScale;
     }
-};
\ No newline at end of file
+};
@@ -4,6 +4,8 @@
 
 #pragma once
 
+#include <span>
+
 #include "structs/transform/VIETranslation.hpp"
 #include "structs/transform/VIERotation.hpp"
 #include "structs/transform/VIEScale.hpp"
@@ -12,10 +14,56 @@ struct VIELocalTransform {
     VIETranslation localTranslation;
     VIEScale localScale;
     VIERotation localRotation;
+
+    glm::mat4x4 getLocalMatrix() const;
 };
 
 struct VIEGlobalTransform {
     VIETranslation globalTranslation;
     VIEScale globalScale;
     VIERotation globalRotation;
-};
\ No newline at end of file
+
+    glm::mat4x4 getGlobalMatrix() const;
+};
+
+// Position, rotation and scale only: matrices are never stored next to the transform
+static_assert(sizeof(VIELocalTransform) == 40, "VIELocalTransform is expected to be a compact TRS (40 bytes)");
+static_assert(sizeof(VIEGlobalTransform) == 40, "VIEGlobalTransform is expected to be a compact TRS (40 bytes)");
+
+namespace transform {
+    /**
+     * @brief Builds the T * R * S matrix directly from its components, without intermediate matrix products
+     */
+    inline glm::mat4x4 composeMatrix(const glm::vec3 &t, const glm::quat &q, const glm::vec3 &s) {
+        const float xx = q.x * q.x;
+        const float yy = q.y * q.y;
+        const float zz = q.z * q.z;
+        const float xy = q.x * q.y;
+        const float xz = q.x * q.z;
+        const float yz = q.y * q.z;
+        const float wx = q.w * q.x;
+        const float wy = q.w * q.y;
+        const float wz = q.w * q.z;
+
+        return {
+                glm::vec4((1.0f - 2.0f * (yy + zz)) * s.x, 2.0f * (xy + wz) * s.x, 2.0f * (xz - wy) * s.x, 0.0f),
+                glm::vec4(2.0f * (xy - wz) * s.y, (1.0f - 2.0f * (xx + zz)) * s.y, 2.0f * (yz + wx) * s.y, 0.0f),
+                glm::vec4(2.0f * (xz + wy) * s.z, 2.0f * (yz - wx) * s.z, (1.0f - 2.0f * (xx + yy)) * s.z, 0.0f),
+                glm::vec4(t.x, t.y, t.z, 1.0f)
+        };
+    }
+
+    /**
+     * @brief Batch kernel generating the matrices of a range of transforms (matrices.size() >= transforms.size())
+     * Large batches are split across workers.
+     */
+    void composeMatrices(std::span<const VIELocalTransform> transforms, std::span<glm::mat4x4> matrices);
+
+    void composeMatrices(std::span<const VIEGlobalTransform> transforms, std::span<glm::mat4x4> matrices);
+
+    /**
+     * @brief Batch kernel for transforms stored as separate component arrays
+     */
+    void composeMatrices(std::span<const glm::vec3> translations, std::span<const glm::quat> rotations,
+                         std::span<const glm::vec3> scales, std::span<glm::mat4x4> matrices);
+}
@@ -5,63 +5,52 @@
 #pragma once
 
 #include <glm/mat4x4.hpp>
-#include <glm/gtc/quaternion.hpp>
+#include <glm/gtc/matrix_transform.hpp>
 
+/**
+ * @brief VIETranslation class storing a translation vector, matrices are generated on demand
+ */
 class VIETranslation {
-    glm::mat4x4 translationMatrix;
-    float xTranslation;
-    float yTranslation;
-    float zTranslation;
+    glm::vec3 translation{0};
 
 public:
-    const glm::mat4x4 &getTranslationMatrix() const {
-        return translationMatrix;
+    glm::mat4x4 getTranslationMatrix() const {
+        return glm::translate(glm::identity<glm::mat4x4>(), translation);
     }
 
     void setTranslationMatrix(const glm::mat4x4 &translationMatrix) {
-        VIETranslation::translationMatrix = translationMatrix;
-
-        xTranslation = translationMatrix[3].x;
-        yTranslation = translationMatrix[3].y;
-        zTranslation = translationMatrix[3].z;
+        translation = glm::vec3(translationMatrix[3].x, translationMatrix[3].y, translationMatrix[3].z);
     }
 
     void setTranslationMatrix(const glm::vec3 &translationVector) {
-        translationMatrix = glm::translate(glm::identity<glm::mat4x4>(), translationVector);
+        translation = translationVector;
+    }
 
-        xTranslation = translationVector.x;
-        yTranslation = translationVector.y;
-        zTranslation = translationVector.z;
+    const glm::vec3 &getTranslation() const {
+        return translation;
     }
 
     float getX() const {
-        return xTranslation;
+        return translation.x;
     }
 
     void setX(float x) {
-        VIETranslation::xTranslation = x;
-
-        translationMatrix = glm::translate(glm::identity<glm::mat4x4>(), {x, yTranslation, zTranslation});
+        translation.x = x;
     }
 
     float getY() const {
-        return yTranslation;
+        return translation.y;
     }
 
     void setY(float y) {
-        VIETranslation::yTranslation = y;
-
-        translationMatrix = glm::translate(glm::identity<glm::mat4x4>(), {xTranslation, y, zTranslation});
+        translation.y = y;
     }
 
     float getZ() const {
-        return zTranslation;
+        return translation.z;
     }
 
     void setZ(float z) {
-        VIETranslation::zTranslation = z;
-
-        translationMatrix = glm::translate(glm::identity<glm::mat4x4>(), {xTranslation, yTranslation, z});
+        translation.z = z;
     }
 };
-
@@ -0,0 +1,21 @@
+/* Created by LordRibblesdale on 18/10/2026.
+ * MIT License
+ */
+
+#pragma once
+
+#include "structs/VIETextureData.hpp"
+
+namespace tools {
+    /**
+     * @brief Block format used to bake a texture, depending on its content (linear data, alpha) and compression
+     */
+    VIETextureFormat selectBlockFormat(const VIETextureData &texture, VIETextureCompression compression);
+
+    /**
+     * @brief Encodes every level of an RGBA8 texture into a block compressed format
+     * Blocks are independent, so rows of blocks of every level are encoded in parallel. Edge blocks of levels not
+     * multiple of 4 replicate the last row and column.
+     */
+    void compressTexture(VIETextureData &texture, VIETextureFormat format);
+}
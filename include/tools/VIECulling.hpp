@@ -0,0 +1,91 @@
+/* Created by LordRibblesdale on 18/10/2026.
+ * MIT License
+ */
+
+#pragma once
+
+#include <vector>
+#include <cstdint>
+
+#include "structs/VIEFrustum.hpp"
+
+/**
+ * @brief Bounding spheres in structure of arrays form, as read by the culling kernels
+ */
+struct VIESphereSet {
+    std::vector<float> centerX;
+    std::vector<float> centerY;
+    std::vector<float> centerZ;
+    std::vector<float> radius;
+
+    void resize(size_t count) {
+        centerX.resize(count);
+        centerY.resize(count);
+        centerZ.resize(count);
+        radius.resize(count);
+    }
+
+    size_t size() const {
+        return radius.size();
+    }
+};
+
+/**
+ * @brief Axis aligned boxes (center and half extent) in structure of arrays form, as read by the culling kernels
+ */
+struct VIEBoxSet {
+    std::vector<float> centerX;
+    std::vector<float> centerY;
+    std::vector<float> centerZ;
+    std::vector<float> extentX;
+    std::vector<float> extentY;
+    std::vector<float> extentZ;
+
+    void resize(size_t count) {
+        centerX.resize(count);
+        centerY.resize(count);
+        centerZ.resize(count);
+        extentX.resize(count);
+        extentY.resize(count);
+        extentZ.resize(count);
+    }
+
+    size_t size() const {
+        return centerX.size();
+    }
+};
+
+/**
+ * VIECullingKernel enumerator for the implementations of the frustum culling kernels
+ */
+enum class VIECullingKernel : uint8_t {
+    SCALAR  = 0,    ///< Portable, one element at a time
+    SSE2    = 1,    ///< 4 elements at a time (x86)
+    AVX2    = 2,    ///< 8 elements at a time (x86, selected at runtime if supported)
+};
+
+namespace tools {
+    /**
+     * @brief Fastest culling kernel supported by the running CPU
+     */
+    VIECullingKernel getCullingKernel();
+
+    const char *getCullingKernelName(VIECullingKernel kernel);
+
+    /**
+     * @brief Tests bounding spheres against the six frustum planes, writing the indices of the visible ones in order
+     * Large sets are split across workers.
+     * @param visible receives the compacted visible indices (previous content is discarded)
+     * @param kernel implementation to use (unsupported ones fall back to the best supported one)
+     * @return number of visible spheres
+     */
+    size_t cullSpheres(const VIEFrustum &frustum, const VIESphereSet &spheres, std::vector<uint32_t> &visible,
+                       VIECullingKernel kernel = getCullingKernel());
+
+    /**
+     * @brief Tests boxes against the six frustum planes, writing the indices of the visible ones in order
+     * @see cullSpheres
+     */
+    size_t cullBoxes(const VIEFrustum &frustum, const VIEBoxSet &boxes, std::vector<uint32_t> &visible,
+                     VIECullingKernel kernel = getCullingKernel());
+}
@@ -0,0 +1,88 @@
+/* Created by LordRibblesdale on 18/10/2026.
+ * MIT License
+ */
+
+#pragma once
+
+#include <mutex>
+#include <atomic>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+
+using VIEJob = std::function<void()>;
+
+/**
+ * @brief VIEJobCounter class, jobs of a group not completed yet
+ * Jobs are added to a counter when submitted, and removed when they return. Counters can be waited on, or make jobs
+ * depend on them: those are submitted once the counter reaches zero.
+ */
+class VIEJobCounter {
+    std::atomic<uint32_t> pendingCount{0};
+    std::atomic<uint32_t> completingCount{0};       ///< Jobs leaving the counter, still using it
+    std::mutex continuationMutex;
+    std::vector<VIEJob> continuations;              ///< Jobs submitted when the counter reaches zero
+
+    friend class VIEJobScheduler;
+
+public:
+    VIEJobCounter() = default;
+    VIEJobCounter(const VIEJobCounter &) = delete;
+    ~VIEJobCounter() = default;
+
+    bool isDone() const {
+        return pendingCount.load(std::memory_order_seq_cst) == 0 &&
+               completingCount.load(std::memory_order_seq_cst) == 0;
+    }
+};
+
+namespace tools {
+    /**
+     * @brief Number of workers (main thread included) running jobs
+     */
+    size_t getWorkerCount();
+
+    /**
+     * @brief Starts the workers, the calling thread becomes the main thread
+     * Otherwise the job system is started on first use, and the thread using it first is its main thread.
+     */
+    void startJobSystem();
+
+    bool isMainThread();
+
+    /**
+     * @brief Queues a job on the deque of the calling worker, from which idle workers steal
+     * @param counter counter of the group of the job (optional)
+     */
+    void runJob(VIEJob job, VIEJobCounter *counter = nullptr);
+
+    /**
+     * @brief Queues a job once every job of dependency has completed
+     * The job is added to counter right away, so that waiting on counter also waits for dependency.
+     */
+    void runJobAfter(VIEJobCounter &dependency, VIEJob job, VIEJobCounter *counter = nullptr);
+
+    /**
+     * @brief Queues a job run by the main thread only (for example for GLFW or queue submissions)
+     * Main thread jobs are run by runMainThreadJobs, and while the main thread waits on a counter.
+     */
+    void runOnMainThread(VIEJob job, VIEJobCounter *counter = nullptr);
+
+    /**
+     * @brief Runs the main thread jobs queued so far, to be called by the main thread
+     * Jobs queued by those jobs are left to the next call, so that a job can poll once a frame by queueing itself.
+     * Without workers (a single hardware thread), a pool job is run as well.
+     */
+    void runMainThreadJobs();
+
+    /**
+     * @brief Runs other jobs until every job of counter has completed
+     */
+    void waitForCounter(const VIEJobCounter &counter);
+
+    /**
+     * @brief Runs other jobs (and main thread jobs, on the main thread) until isDone returns true
+     */
+    void waitUntil(const std::function<bool()> &isDone);
+}
@@ -0,0 +1,30 @@
+/* Created by LordRibblesdale on 18/10/2026.
+ * MIT License
+ */
+
+#pragma once
+
+#include <string>
+#include <vulkan/vulkan.h>
+
+#include "structs/VIETextureData.hpp"
+
+namespace tools {
+    /**
+     * @brief Vulkan format of a texture, sRGB variant for color data (BC5 has linear data only)
+     */
+    VkFormat getTextureVkFormat(VIETextureFormat format, bool isSRGB);
+
+    /**
+     * @brief Writes a texture and its whole mip chain into a KTX2 container (no supercompression)
+     * @param sourceStamp optional value stored in the key/value data, to detect stale baked textures
+     */
+    bool writeKTX2(const std::string &location, const VIETextureData &texture, const std::string &sourceStamp = {});
+
+    /**
+     * @brief Reads a KTX2 container with a 2D texture of one of the VIETextureFormat formats
+     * Levels are stored as they are in the container, ready to be copied into an image without transcoding.
+     * @param sourceStamp if not null, receives the source stamp stored by writeKTX2 (empty if missing)
+     */
+    bool readKTX2(const std::string &location, VIETextureData &texture, std::string *sourceStamp = nullptr);
+}
@@ -0,0 +1,74 @@
+/* Created by LordRibblesdale on 18/10/2026.
+ * MIT License
+ */
+
+#pragma once
+
+#include <cstdint>
+
+#define FMT_HEADER_ONLY
+#include <fmt/format.h>
+
+// Messages below this level are compiled out (0 verbose, 1 info, 2 warning, 3 error)
+#ifndef VIE_LOG_MIN_LEVEL
+#define VIE_LOG_MIN_LEVEL 0
+#endif
+
+/**
+ * @brief Severity of a log message (FAILURE instead of ERROR, which is a macro of Windows headers)
+ */
+enum class VIELogLevel : uint8_t {
+    VERBOSE = 0,
+    INFO = 1,
+    WARNING = 2,
+    FAILURE = 3
+};
+
+namespace tools {
+    /**
+     * @brief Formats a message directly into a free slot of the log ring, written to the console by the logging thread
+     * Never blocks: the ring is lock-free for any number of producers, and a message is dropped (and counted) if the
+     * ring is full. Messages longer than a slot are truncated.
+     */
+    void vlog(VIELogLevel level, fmt::string_view format, fmt::format_args args);
+
+    template <typename... Args>
+    void log(VIELogLevel level, fmt::format_string<Args...> format, Args &&...args) {
+        if (static_cast<int>(level) >= VIE_LOG_MIN_LEVEL) {
+            vlog(level, format, fmt::make_format_args(args...));
+        }
+    }
+
+    /**
+     * @brief Waits until the messages logged so far by any thread have been written
+     */
+    void flushLog();
+}
+
+#define log_verbose(...)                                                    \
+do {                                                                        \
+    if constexpr (VIE_LOG_MIN_LEVEL <= 0) {                                 \
+        tools::log(VIELogLevel::VERBOSE, __VA_ARGS__);                      \
+    }                                                                       \
+} while (false)
+
+#define log_info(...)                                                       \
+do {                                                                        \
+    if constexpr (VIE_LOG_MIN_LEVEL <= 1) {                                 \
+        tools::log(VIELogLevel::INFO, __VA_ARGS__);                         \
+    }                                                                       \
+} while (false)
+
+#define log_warning(...)                                                    \
+do {                                                                        \
+    if constexpr (VIE_LOG_MIN_LEVEL <= 2) {                                 \
+        tools::log(VIELogLevel::WARNING, __VA_ARGS__);                      \
+    }                                                                       \
+} while (false)
+
+#define log_error(...)                                                      \
+do {                                                                        \
+    if constexpr (VIE_LOG_MIN_LEVEL <= 3) {                                 \
+        tools::log(VIELogLevel::FAILURE, __VA_ARGS__);                      \
+    }                                                                       \
+} while (false)
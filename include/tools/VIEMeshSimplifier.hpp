@@ -0,0 +1,39 @@
+/* Created by LordRibblesdale on 18/10/2026.
+ * MIT License
+ */
+
+#pragma once
+
+#include <span>
+#include <vector>
+#include <cstdint>
+
+#include "structs/VIEVertex.hpp"
+
+/**
+ * @brief Simplified level of a mesh, indexing the vertices of the full mesh
+ */
+struct VIELodLevel {
+    std::vector<uint32_t> indices;
+    float error{0.0f};      ///< Geometric error from the full mesh (model space distance)
+};
+
+namespace tools {
+    /**
+     * @brief Simplifies a mesh by edge collapses ordered by quadric error (with normal and UV penalties)
+     * Vertices are never moved or created, so the result indexes the same vertex array. Open borders are kept.
+     * @param targetIndexCount index count to reach (the result can be larger if no more collapses are allowed)
+     * @param error geometric error of the result
+     */
+    std::vector<uint32_t> simplifyMesh(std::span<const VIEVertex> vertices, std::span<const uint32_t> indices,
+                                       size_t targetIndexCount, float &error);
+
+    /**
+     * @brief Generates a chain of levels of detail, each one simplified from the previous one
+     * The chain stops early when a level cannot be reduced enough.
+     * @param maxLevels maximum number of levels generated (full mesh excluded)
+     * @param reductionRatio ratio between the index counts of consecutive levels
+     */
+    std::vector<VIELodLevel> generateLodChain(std::span<const VIEVertex> vertices, std::span<const uint32_t> indices,
+                                              uint32_t maxLevels, float reductionRatio);
+}
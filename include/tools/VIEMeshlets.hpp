@@ -0,0 +1,45 @@
+/* Created by LordRibblesdale on 18/10/2026.
+ * MIT License
+ */
+
+#pragma once
+
+#include <span>
+#include <vector>
+#include <cstdint>
+#include <glm/mat4x4.hpp>
+
+#include "structs/VIEVertex.hpp"
+#include "structs/VIEMeshlet.hpp"
+#include "structs/VIEFrustum.hpp"
+
+namespace tools {
+    /**
+     * @brief Partitions a mesh into meshlets of at most VIEMeshlet::kMaxVertices vertices and kMaxTriangles triangles
+     * Triangles are gathered greedily by adjacency (preferring the ones adding fewer vertices, then the closest ones),
+     * so meshlets are compact and their bounds tight. Meshlets and their data are appended to the given arrays, with
+     * offsets relative to their beginning.
+     * @param meshletVertices receives mesh vertex indices
+     * @param meshletTriangles receives triplets of meshlet vertex indices
+     */
+    void buildMeshlets(std::span<const VIEVertex> vertices, std::span<const uint32_t> indices,
+                       std::vector<VIEMeshlet> &meshlets, std::vector<uint32_t> &meshletVertices,
+                       std::vector<uint8_t> &meshletTriangles);
+
+    /**
+     * @brief Reference test of a meshlet against the frustum and its normal cone (all triangles facing away)
+     * The cone test is skipped for non uniformly scaled instances, as their normals are not transformed rigidly.
+     * @param modelMatrix world matrix of the instance
+     */
+    bool isMeshletVisible(const VIEMeshlet &meshlet, const glm::mat4x4 &modelMatrix, const VIEFrustum &frustum,
+                          const glm::vec3 &cameraPosition);
+
+    /**
+     * @brief CPU reference culler, matching the tests expected from GPU culling passes
+     * @param visibleMeshlets receives the indices of the visible meshlets (previous content is discarded)
+     * @return number of visible meshlets
+     */
+    size_t cullMeshlets(std::span<const VIEMeshlet> meshlets, const glm::mat4x4 &modelMatrix,
+                        const VIEFrustum &frustum, const glm::vec3 &cameraPosition,
+                        std::vector<uint32_t> &visibleMeshlets);
+}
@@ -0,0 +1,22 @@
+/* Created by LordRibblesdale on 18/10/2026.
+ * MIT License
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <functional>
+
+#include "tools/VIEJobSystem.hpp"
+
+namespace tools {
+    /**
+     * @brief Splits [0, count) in batches of (at least) grainSize elements and runs them on all workers
+     * Batches run as jobs of the job system. The calling thread takes part in the work and the function returns when
+     * every batch has been processed.
+     * @param count number of elements to process
+     * @param grainSize minimum number of elements given to a worker in one go
+     * @param task callable invoked as task(begin, end) on each batch
+     */
+    void parallelFor(size_t count, size_t grainSize, const std::function<void(size_t, size_t)> &task);
+}
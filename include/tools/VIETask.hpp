@@ -0,0 +1,247 @@
+/* Created by LordRibblesdale on 18/10/2026.
+ * MIT License
+ */
+
+#pragma once
+
+#include <atomic>
+#include <utility>
+#include <optional>
+#include <exception>
+#include <functional>
+#include <coroutine>
+#include <type_traits>
+
+#include "tools/VIEJobSystem.hpp"
+
+/**
+ * @brief Promise data shared by every VIETask, whatever its result
+ */
+struct VIETaskPromiseBase {
+    std::coroutine_handle<> continuation{};         ///< Coroutine awaiting the task, resumed when it returns
+    std::atomic<bool> isDone{false};
+
+    /**
+     * @brief Resumes the awaiting coroutine (if any) on the thread completing the task
+     */
+    struct FinalAwaiter {
+        bool await_ready() const noexcept {
+            return false;
+        }
+
+        template<typename Promise>
+        std::coroutine_handle<> await_suspend(std::coroutine_handle<Promise> handle) const noexcept {
+            // Read before the task is marked as done, its owner may destroy it right after
+            std::coroutine_handle<> continuation(handle.promise().continuation);
+            handle.promise().isDone.store(true, std::memory_order_release);
+
+            return continuation ? continuation : std::noop_coroutine();
+        }
+
+        void await_resume() const noexcept {}
+    };
+
+    std::suspend_always initial_suspend() const noexcept {
+        return {};
+    }
+
+    FinalAwaiter final_suspend() const noexcept {
+        return {};
+    }
+
+    void unhandled_exception() const noexcept {
+        std::terminate();
+    }
+};
+
+template<typename T>
+struct VIETaskPromiseResult {
+    std::optional<T> result;
+
+    template<typename U>
+    void return_value(U &&value) {
+        result.emplace(std::forward<U>(value));
+    }
+};
+
+template<>
+struct VIETaskPromiseResult<void> {
+    void return_void() const {}
+};
+
+/**
+ * @brief VIETask class, lazily started coroutine returning a T
+ * A task runs when awaited by another coroutine (resuming it when it returns), or when started by its owner, which then
+ * polls isDone (or waits for it with tools::waitForTask) before reading the result. Tasks move between threads by
+ * awaiting tools::switchToWorker and tools::switchToMainThread, and must be done before being destroyed.
+ */
+template<typename T = void>
+class VIETask {
+public:
+    struct promise_type : VIETaskPromiseBase, VIETaskPromiseResult<T> {
+        VIETask get_return_object() {
+            return VIETask(std::coroutine_handle<promise_type>::from_promise(*this));
+        }
+    };
+
+private:
+    std::coroutine_handle<promise_type> handle{};
+    bool isStarted{false};
+
+    explicit VIETask(std::coroutine_handle<promise_type> handle) : handle(handle) {}
+
+public:
+    VIETask() = default;
+    VIETask(const VIETask &) = delete;
+
+    VIETask(VIETask &&other) noexcept : handle(std::exchange(other.handle, {})),
+                                        isStarted(std::exchange(other.isStarted, false)) {}
+
+    VIETask &operator=(VIETask &&other) noexcept {
+        if (this != &other) {
+            if (handle) {
+                handle.destroy();
+            }
+
+            handle = std::exchange(other.handle, {});
+            isStarted = std::exchange(other.isStarted, false);
+        }
+
+        return *this;
+    }
+
+    ~VIETask() {
+        if (handle) {
+            handle.destroy();
+        }
+    }
+
+    /**
+     * @brief Runs the task on the calling thread until its first suspension
+     */
+    void start() {
+        if (handle && !isStarted) {
+            isStarted = true;
+            handle.resume();
+        }
+    }
+
+    bool isValid() const {
+        return static_cast<bool>(handle);
+    }
+
+    bool isDone() const {
+        return !handle || handle.promise().isDone.load(std::memory_order_acquire);
+    }
+
+    /**
+     * @brief Result of a task done (not to be called on tasks of void)
+     */
+    T &getResult() requires (!std::is_void_v<T>) {
+        return *handle.promise().result;
+    }
+
+    bool await_ready() const noexcept {
+        return !handle || handle.promise().isDone.load(std::memory_order_acquire);
+    }
+
+    /**
+     * @brief Starts the task, the awaiting coroutine is resumed when it returns
+     */
+    std::coroutine_handle<> await_suspend(std::coroutine_handle<> awaiting) noexcept {
+        handle.promise().continuation = awaiting;
+        isStarted = true;
+
+        return handle;
+    }
+
+    T await_resume() {
+        if constexpr (!std::is_void_v<T>) {
+            return std::move(*handle.promise().result);
+        }
+    }
+};
+
+/**
+ * @brief Resumes the awaiting coroutine as a job of the worker pool
+ */
+struct VIEWorkerAwaiter {
+    bool await_ready() const noexcept {
+        return false;
+    }
+
+    void await_suspend(std::coroutine_handle<> handle) const {
+        tools::runJob([handle]() {
+            handle.resume();
+        });
+    }
+
+    void await_resume() const noexcept {}
+};
+
+/**
+ * @brief Resumes the awaiting coroutine on the main thread (right away if already there)
+ */
+struct VIEMainThreadAwaiter {
+    bool await_ready() const {
+        return tools::isMainThread();
+    }
+
+    void await_suspend(std::coroutine_handle<> handle) const {
+        tools::runOnMainThread([handle]() {
+            handle.resume();
+        });
+    }
+
+    void await_resume() const noexcept {}
+};
+
+/**
+ * @brief Resumes the awaiting coroutine on the main thread once isReady returns true
+ * The condition is checked by each run of the main thread jobs (once a frame), and only ever on the main thread.
+ */
+struct VIEPollAwaiter {
+    std::function<bool()> isReady;
+
+    bool await_ready() const {
+        return tools::isMainThread() && isReady();
+    }
+
+    void await_suspend(std::coroutine_handle<> handle) const {
+        // Queued again for the next run until the condition holds
+        tools::runOnMainThread([awaiter = *this, handle]() {
+            if (awaiter.await_ready()) {
+                handle.resume();
+            } else {
+                awaiter.await_suspend(handle);
+            }
+        });
+    }
+
+    void await_resume() const noexcept {}
+};
+
+namespace tools {
+    inline VIEWorkerAwaiter switchToWorker() {
+        return {};
+    }
+
+    inline VIEMainThreadAwaiter switchToMainThread() {
+        return {};
+    }
+
+    inline VIEPollAwaiter pollOnMainThread(std::function<bool()> isReady) {
+        return {std::move(isReady)};
+    }
+
+    /**
+     * @brief Starts the task (if not started yet) and runs other jobs until it is done
+     */
+    template<typename T>
+    void waitForTask(VIETask<T> &task) {
+        task.start();
+        waitUntil([&task]() {
+            return task.isDone();
+        });
+    }
+}
@@ -0,0 +1,41 @@
+/* Created by LordRibblesdale on 18/10/2026.
+ * MIT License
+ */
+
+#pragma once
+
+#include <span>
+#include <string>
+#include <vector>
+#include <cstdint>
+
+#include "structs/VIETextureData.hpp"
+
+namespace tools {
+    /**
+     * @brief Decodes an image file into RGBA8 texels
+     * Supported formats: TGA (true color and grayscale, raw or RLE) and binary PNM (PGM P5, PPM P6, 8 bit).
+     */
+    bool decodeImage(const std::string &location, uint32_t &width, uint32_t &height, std::vector<uint8_t> &pixels);
+
+    /**
+     * @brief Generates the whole mip chain of a texture from its first level (any previous level is discarded)
+     */
+    void generateMipChain(VIETextureData &texture, VIEMipFilter filter);
+
+    /**
+     * @brief Loads a texture (decoding, mip chain and block compression) through a cache of baked KTX2 textures
+     * The baked texture is keyed by source location, filter and compression, and is discarded when the source file
+     * changes. KTX2 sources are read as they are.
+     * @param cacheDirectory directory of baked textures (empty for no cache)
+     */
+    bool loadTexture(VIETextureData &texture, VIEMipFilter filter, VIETextureCompression compression,
+                     const std::string &cacheDirectory);
+
+    /**
+     * @brief Loads many textures in parallel
+     * @return number of textures correctly loaded
+     */
+    size_t loadTextures(std::span<VIETextureData> textures, VIEMipFilter filter, VIETextureCompression compression,
+                        const std::string &cacheDirectory);
+}
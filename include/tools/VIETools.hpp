@@ -10,12 +10,13 @@
 #include <vector>
 #include <algorithm>
 #include <limits>
+#include <coroutine>
 #include "engine/VIESettings.hpp"
+#include "tools/VIELogger.hpp"
 
-// TODO fix with logger
 #define return_log_if(if_condition, string, ret_condition)  \
 if (if_condition) {                                         \
-    std::cout << (string) << std::endl;                     \
+    log_error("{}", string);                                \
     return ret_condition;                                   \
 }
 
@@ -36,27 +37,27 @@ namespace debug {
                                                         VkDebugUtilsMessageTypeFlagsEXT messageType,
                                                         const VkDebugUtilsMessengerCallbackDataEXT* pCallbackData,
                                                         void* pUserData) {
-        std::string severity;
+        VIELogLevel level{VIELogLevel::INFO};
 
         switch (messageSeverity) {
             case VK_DEBUG_UTILS_MESSAGE_SEVERITY_VERBOSE_BIT_EXT:
-                severity = "VERBOSE";
+                level = VIELogLevel::VERBOSE;
                 break;
             case VK_DEBUG_UTILS_MESSAGE_SEVERITY_INFO_BIT_EXT:
-                severity = "INFO";
+                level = VIELogLevel::INFO;
                 break;
             case VK_DEBUG_UTILS_MESSAGE_SEVERITY_WARNING_BIT_EXT:
-                severity = "WARNING";
+                level = VIELogLevel::WARNING;
                 break;
             case VK_DEBUG_UTILS_MESSAGE_SEVERITY_ERROR_BIT_EXT:
-                severity = "ERROR";
+                level = VIELogLevel::FAILURE;
                 break;
             case VK_DEBUG_UTILS_MESSAGE_SEVERITY_FLAG_BITS_MAX_ENUM_EXT:
-                severity = "GENERIC";
                 break;
         }
 
-        std::cout << fmt::format("[{}] Validation layer: {}", severity, pCallbackData->pMessage) << std::endl;
+        // Queued for the logging thread, the validation layer is never blocked
+        tools::log(level, "Validation layer: {}", pCallbackData->pMessage);
 
         return VK_FALSE;
     }
@@ -83,4 +84,77 @@ namespace tools {
                               std::vector<VkSurfaceFormatKHR> &formats,
                               std::vector<VkPresentModeKHR> &presentationModes,
                               const VIESettings &settings);
+
+    /**
+     * @brief Selects the most precise depth format usable as attachment (and sampled, for the depth pyramid)
+     */
+    bool selectDepthFormat(const VkPhysicalDevice &physicalDevice, VkFormat &depthFormat);
+
+    /**
+     * @brief Looks for a memory type of the device compatible with typeFilter and with all the required properties
+     */
+    bool findMemoryType(const VkPhysicalDevice &physicalDevice, uint32_t typeFilter,
+                        VkMemoryPropertyFlags requiredProperties, uint32_t &memoryType);
+
+    /**
+     * @brief Creates a buffer and binds to it a dedicated allocation with the required properties
+     */
+    bool createBuffer(const VkDevice &device, const VkPhysicalDevice &physicalDevice, VkDeviceSize size,
+                      VkBufferUsageFlags usage, VkMemoryPropertyFlags requiredProperties, VkBuffer &buffer,
+                      VkDeviceMemory &bufferMemory);
+
+    /**
+     * @brief Allocates a primary command buffer from the pool and begins it for a single submission
+     */
+    VkCommandBuffer beginSingleTimeCommands(const VkDevice &device, const VkCommandPool &commandPool);
+
+    /**
+     * @brief Ends and submits a command buffer from beginSingleTimeCommands, waits for the queue and frees it
+     * @return false if the submission failed
+     */
+    bool endSingleTimeCommands(const VkDevice &device, const VkCommandPool &commandPool, const VkQueue &queue,
+                               VkCommandBuffer commandBuffer);
+
+    /**
+     * @brief Ends and submits a command buffer from beginSingleTimeCommands, signaling fence once it has completed
+     * The command buffer is not freed, nor waited for (see VIEFenceAwaiter).
+     * @return false if the submission failed
+     */
+    bool submitSingleTimeCommands(const VkQueue &queue, VkCommandBuffer commandBuffer, const VkFence &fence);
+
+    /**
+     * @brief Resident memory of the process (bytes), 0 if not available on the platform
+     */
+    size_t getResidentMemory();
+
+    /**
+     * @brief Creates a device local buffer and fills it with data through a temporary staging buffer
+     * The copy is submitted to the given queue and waited for before returning.
+     */
+    bool createDeviceLocalBuffer(const VkDevice &device, const VkPhysicalDevice &physicalDevice,
+                                 const VkCommandPool &commandPool, const VkQueue &queue, const void *data,
+                                 VkDeviceSize size, VkBufferUsageFlags usage, VkBuffer &buffer,
+                                 VkDeviceMemory &bufferMemory);
 }
+
+/**
+ * @brief Resumes the awaiting coroutine on the main thread once the fence is signaled
+ * The fence is polled by each run of the main thread jobs (once a frame), so that the frame loop never waits for it.
+ */
+struct VIEFenceAwaiter {
+    VkDevice device{};
+    VkFence fence{};
+
+    bool await_ready() const {
+        return vkGetFenceStatus(device, fence) != VK_NOT_READY;
+    }
+
+    void await_suspend(std::coroutine_handle<> handle) const;
+
+    /**
+     * @return VK_SUCCESS, or the error stopping the fence from being signaled (for example VK_ERROR_DEVICE_LOST)
+     */
+    VkResult await_resume() const {
+        return vkGetFenceStatus(device, fence);
+    }
+};
@@ -0,0 +1,82 @@
+/* Created by LordRibblesdale on 18/10/2026.
+ * MIT License
+ */
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <cstdint>
+
+namespace tools {
+    extern std::atomic<bool> tracingEnabled;        ///< Read by every zone, so that disabled zones record nothing
+
+    /**
+     * @brief Starts or stops recording zones (already recorded zones are kept)
+     */
+    void setTracingEnabled(bool enabled);
+
+    inline bool isTracingEnabled() {
+        return tracingEnabled.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Names the trace buffer of the calling thread, shown as thread name in the trace
+     * @param name string literal (or with static storage), not copied
+     */
+    void setTraceThreadName(const char *name);
+
+    /**
+     * @brief Writes every recorded zone of every thread as Chrome trace JSON (chrome://tracing or Perfetto)
+     * Can be called at any time: zones still being recorded by other threads are simply not included.
+     */
+    bool writeTrace(const std::string &traceLocation);
+
+    /**
+     * @brief Nanoseconds of the monotonic clock
+     */
+    inline uint64_t traceTimestamp() {
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now().time_since_epoch()).count());
+    }
+
+    /**
+     * @brief Appends a completed zone to the buffer of the calling thread (without locking)
+     */
+    void recordTraceZone(const char *name, uint64_t begin, uint64_t end);
+
+    /**
+     * @brief TraceZone class, records its lifetime as a zone of the calling thread if tracing is enabled
+     */
+    class TraceZone {
+        const char *name{nullptr};      ///< Null if tracing was disabled when the zone began
+        uint64_t begin{0};
+
+    public:
+        explicit TraceZone(const char *zoneName) {
+            if (isTracingEnabled()) {
+                name = zoneName;
+                begin = traceTimestamp();
+            }
+        }
+
+        TraceZone(const TraceZone &) = delete;
+        TraceZone &operator=(const TraceZone &) = delete;
+
+        ~TraceZone() {
+            if (name) {
+                recordTraceZone(name, begin, traceTimestamp());
+            }
+        }
+    };
+}
+
+// Zones are compiled out entirely with VIE_DISABLE_TRACING, otherwise they cost a relaxed load while disabled
+#ifdef VIE_DISABLE_TRACING
+#define VIE_TRACE_ZONE(name)
+#else
+#define VIE_TRACE_CONCAT_IMPL(a, b) a##b
+#define VIE_TRACE_CONCAT(a, b) VIE_TRACE_CONCAT_IMPL(a, b)
+#define VIE_TRACE_ZONE(name) const tools::TraceZone VIE_TRACE_CONCAT(traceZone, __LINE__){name}
+#endif
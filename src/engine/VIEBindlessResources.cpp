@@ -0,0 +1,178 @@
+/* Created by LordRibblesdale on 18/10/2026.
+ * MIT License
+ */
+
+#include "engine/VIEBindlessResources.hpp"
+#include "structs/VIEMaterial.hpp"
+#include "tools/VIETools.hpp"
+
+#include <array>
+
+bool VIEBindlessResources::create(const VkDevice &device, const VkPhysicalDevice &physicalDevice,
+                                  uint32_t requestedMaxTextures) {
+    VkPhysicalDeviceVulkan12Properties vulkan12Properties{
+            .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_PROPERTIES
+    };
+
+    VkPhysicalDeviceProperties2 properties{
+            .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2,
+            .pNext = &vulkan12Properties
+    };
+
+    vkGetPhysicalDeviceProperties2(physicalDevice, &properties);
+
+    maxTextures = std::min({requestedMaxTextures, vulkan12Properties.maxPerStageDescriptorUpdateAfterBindSampledImages,
+                            vulkan12Properties.maxDescriptorSetUpdateAfterBindSampledImages});
+
+    VkSamplerCreateInfo samplerCreateInfo{
+            .sType = VK_STRUCTURE_TYPE_SAMPLER_CREATE_INFO,
+            .magFilter = VK_FILTER_LINEAR,
+            .minFilter = VK_FILTER_LINEAR,
+            .mipmapMode = VK_SAMPLER_MIPMAP_MODE_LINEAR,
+            .addressModeU = VK_SAMPLER_ADDRESS_MODE_REPEAT,
+            .addressModeV = VK_SAMPLER_ADDRESS_MODE_REPEAT,
+            .addressModeW = VK_SAMPLER_ADDRESS_MODE_REPEAT,
+            .mipLodBias = 0.0f,
+            .anisotropyEnable = VK_FALSE,
+            .maxAnisotropy = 1.0f,
+            .compareEnable = VK_FALSE,
+            .compareOp = VK_COMPARE_OP_ALWAYS,
+            .minLod = 0.0f,
+            .maxLod = VK_LOD_CLAMP_NONE,
+            .borderColor = VK_BORDER_COLOR_INT_OPAQUE_BLACK,
+            .unnormalizedCoordinates = VK_FALSE
+    };
+
+    return_log_if(vkCreateSampler(device, &samplerCreateInfo, nullptr, &defaultSampler) != VK_SUCCESS,
+                  "Cannot create bindless sampler...", false)
+
+    std::array<VkDescriptorSetLayoutBinding, 3> bindings{
+            VkDescriptorSetLayoutBinding{
+                    .binding = kMaterialBinding,
+                    .descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+                    .descriptorCount = 1,
+                    .stageFlags = VK_SHADER_STAGE_FRAGMENT_BIT
+            },
+            VkDescriptorSetLayoutBinding{
+                    .binding = kDrawBinding,
+                    .descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+                    .descriptorCount = 1,
+                    .stageFlags = VK_SHADER_STAGE_VERTEX_BIT
+            },
+            VkDescriptorSetLayoutBinding{
+                    .binding = kTextureBinding,
+                    .descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
+                    .descriptorCount = maxTextures,
+                    .stageFlags = VK_SHADER_STAGE_FRAGMENT_BIT
+            }
+    };
+
+    std::array<VkDescriptorBindingFlags, 3> bindingFlags{
+            0,
+            0,
+            VK_DESCRIPTOR_BINDING_PARTIALLY_BOUND_BIT | VK_DESCRIPTOR_BINDING_VARIABLE_DESCRIPTOR_COUNT_BIT |
+            VK_DESCRIPTOR_BINDING_UPDATE_AFTER_BIND_BIT
+    };
+
+    VkDescriptorSetLayoutBindingFlagsCreateInfo bindingFlagsCreateInfo{
+            .sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_BINDING_FLAGS_CREATE_INFO,
+            .bindingCount = static_cast<uint32_t>(bindingFlags.size()),
+            .pBindingFlags = bindingFlags.data()
+    };
+
+    VkDescriptorSetLayoutCreateInfo setLayoutCreateInfo{
+            .sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO,
+            .pNext = &bindingFlagsCreateInfo,
+            .flags = VK_DESCRIPTOR_SET_LAYOUT_CREATE_UPDATE_AFTER_BIND_POOL_BIT,
+            .bindingCount = static_cast<uint32_t>(bindings.size()),
+            .pBindings = bindings.data()
+    };
+
+    return_log_if(vkCreateDescriptorSetLayout(device, &setLayoutCreateInfo, nullptr, &setLayout) != VK_SUCCESS,
+                  "Cannot create bindless descriptor set layout...", false)
+
+    std::array<VkDescriptorPoolSize, 2> poolSizes{
+            VkDescriptorPoolSize{VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 2},
+            VkDescriptorPoolSize{VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, maxTextures}
+    };
+
+    VkDescriptorPoolCreateInfo descriptorPoolCreateInfo{
+            .sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO,
+            .flags = VK_DESCRIPTOR_POOL_CREATE_UPDATE_AFTER_BIND_BIT,
+            .maxSets = 1,
+            .poolSizeCount = static_cast<uint32_t>(poolSizes.size()),
+            .pPoolSizes = poolSizes.data()
+    };
+
+    return_log_if(vkCreateDescriptorPool(device, &descriptorPoolCreateInfo, nullptr, &descriptorPool) != VK_SUCCESS,
+                  "Cannot create bindless descriptor pool...", false)
+
+    VkDescriptorSetVariableDescriptorCountAllocateInfo variableCountAllocateInfo{
+            .sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_VARIABLE_DESCRIPTOR_COUNT_ALLOCATE_INFO,
+            .descriptorSetCount = 1,
+            .pDescriptorCounts = &maxTextures
+    };
+
+    VkDescriptorSetAllocateInfo setAllocateInfo{
+            .sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO,
+            .pNext = &variableCountAllocateInfo,
+            .descriptorPool = descriptorPool,
+            .descriptorSetCount = 1,
+            .pSetLayouts = &setLayout
+    };
+
+    return_log_if(vkAllocateDescriptorSets(device, &setAllocateInfo, &descriptorSet) != VK_SUCCESS,
+                  "Cannot allocate bindless descriptor set...", false)
+
+    return true;
+}
+
+void VIEBindlessResources::destroy(const VkDevice &device) {
+    vkDestroyDescriptorPool(device, descriptorPool, nullptr);
+    vkDestroyDescriptorSetLayout(device, setLayout, nullptr);
+    vkDestroySampler(device, defaultSampler, nullptr);
+
+    descriptorPool = VK_NULL_HANDLE;
+    setLayout = VK_NULL_HANDLE;
+    defaultSampler = VK_NULL_HANDLE;
+    descriptorSet = VK_NULL_HANDLE;
+    textureCount = 0;
+}
+
+void VIEBindlessResources::setStorageBuffer(const VkDevice &device, uint32_t binding, const VkBuffer &buffer,
+                                            VkDeviceSize range) {
+    VkDescriptorBufferInfo bufferInfo{buffer, 0, range};
+
+    VkWriteDescriptorSet descriptorWrite{
+            .sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET,
+            .dstSet = descriptorSet,
+            .dstBinding = binding,
+            .descriptorCount = 1,
+            .descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+            .pBufferInfo = &bufferInfo
+    };
+
+    vkUpdateDescriptorSets(device, 1, &descriptorWrite, 0, nullptr);
+}
+
+uint32_t VIEBindlessResources::registerTexture(const VkDevice &device, const VkImageView &imageView) {
+    if (textureCount == maxTextures) {
+        return VIEMaterial::kNoTexture;
+    }
+
+    VkDescriptorImageInfo imageInfo{defaultSampler, imageView, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL};
+
+    VkWriteDescriptorSet descriptorWrite{
+            .sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET,
+            .dstSet = descriptorSet,
+            .dstBinding = kTextureBinding,
+            .dstArrayElement = textureCount,
+            .descriptorCount = 1,
+            .descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
+            .pImageInfo = &imageInfo
+    };
+
+    vkUpdateDescriptorSets(device, 1, &descriptorWrite, 0, nullptr);
+
+    return textureCount++;
+}
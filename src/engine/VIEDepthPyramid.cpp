@@ -0,0 +1,329 @@
+/* Created by LordRibblesdale on 18/10/2026.
+ * MIT License
+ */
+
+#include "engine/VIEDepthPyramid.hpp"
+#include "tools/VIETools.hpp"
+
+#include <bit>
+#include <array>
+#include <algorithm>
+
+namespace {
+    // Push constants of the reduction shader
+    struct ReductionData {
+        int32_t sourceWidth;
+        int32_t sourceHeight;
+        int32_t width;
+        int32_t height;
+    };
+}
+
+bool VIEDepthPyramid::create(const VkDevice &device, const VkPhysicalDevice &physicalDevice,
+                             const VkCommandPool &commandPool, const VkQueue &queue, VkImage depthImage,
+                             VkFormat depthFormat, VkExtent2D depthImageExtent, VkShaderModule reductionModule) {
+    // Power of two levels: every texel of a level covers exactly 2x2 texels of the next one
+    depthExtent = depthImageExtent;
+    extent = VkExtent2D{std::bit_floor(depthExtent.width), std::bit_floor(depthExtent.height)};
+    const auto levelCount = static_cast<uint32_t>(std::bit_width(std::max(extent.width, extent.height)));
+
+    VkImageCreateInfo imageCreateInfo{
+            .sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO,
+            .imageType = VK_IMAGE_TYPE_2D,
+            .format = VK_FORMAT_R32_SFLOAT,
+            .extent = {extent.width, extent.height, 1},
+            .mipLevels = levelCount,
+            .arrayLayers = 1,
+            .samples = VK_SAMPLE_COUNT_1_BIT,
+            .tiling = VK_IMAGE_TILING_OPTIMAL,
+            .usage = VK_IMAGE_USAGE_SAMPLED_BIT | VK_IMAGE_USAGE_STORAGE_BIT,
+            .sharingMode = VK_SHARING_MODE_EXCLUSIVE,
+            .initialLayout = VK_IMAGE_LAYOUT_UNDEFINED
+    };
+
+    return_log_if(vkCreateImage(device, &imageCreateInfo, nullptr, &image) != VK_SUCCESS,
+                  "Cannot create depth pyramid image...", false)
+
+    VkMemoryRequirements memoryRequirements;
+    vkGetImageMemoryRequirements(device, image, &memoryRequirements);
+
+    uint32_t memoryType;
+    return_log_if(!tools::findMemoryType(physicalDevice, memoryRequirements.memoryTypeBits,
+                                         VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, memoryType),
+                  "No compatible memory type found for depth pyramid...", false)
+
+    VkMemoryAllocateInfo memoryAllocateInfo{
+            .sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO,
+            .allocationSize = memoryRequirements.size,
+            .memoryTypeIndex = memoryType
+    };
+
+    return_log_if(vkAllocateMemory(device, &memoryAllocateInfo, nullptr, &imageMemory) != VK_SUCCESS,
+                  "Cannot allocate depth pyramid memory...", false)
+
+    vkBindImageMemory(device, image, imageMemory, 0);
+
+    VkImageViewCreateInfo imageViewCreateInfo{
+            .sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO,
+            .image = image,
+            .viewType = VK_IMAGE_VIEW_TYPE_2D,
+            .format = VK_FORMAT_R32_SFLOAT,
+            .subresourceRange = {VK_IMAGE_ASPECT_COLOR_BIT, 0, levelCount, 0, 1}
+    };
+
+    return_log_if(vkCreateImageView(device, &imageViewCreateInfo, nullptr, &imageView) != VK_SUCCESS,
+                  "Cannot create depth pyramid view...", false)
+
+    levelViews.resize(levelCount, VK_NULL_HANDLE);
+
+    for (uint32_t level = 0; VkImageView &levelView: levelViews) {
+        imageViewCreateInfo.subresourceRange = {VK_IMAGE_ASPECT_COLOR_BIT, level++, 1, 0, 1};
+
+        return_log_if(vkCreateImageView(device, &imageViewCreateInfo, nullptr, &levelView) != VK_SUCCESS,
+                      "Cannot create depth pyramid level view...", false)
+    }
+
+    // Stereo depth buffers have a layer for each eye, the pyramid is built from the first one
+    VkImageViewCreateInfo depthViewCreateInfo{
+            .sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO,
+            .image = depthImage,
+            .viewType = VK_IMAGE_VIEW_TYPE_2D,
+            .format = depthFormat,
+            .subresourceRange = {VK_IMAGE_ASPECT_DEPTH_BIT, 0, 1, 0, 1}
+    };
+
+    return_log_if(vkCreateImageView(device, &depthViewCreateInfo, nullptr, &depthView) != VK_SUCCESS,
+                  "Cannot create depth buffer view for the depth pyramid...", false)
+
+    VkSamplerCreateInfo samplerCreateInfo{
+            .sType = VK_STRUCTURE_TYPE_SAMPLER_CREATE_INFO,
+            .magFilter = VK_FILTER_NEAREST,
+            .minFilter = VK_FILTER_NEAREST,
+            .mipmapMode = VK_SAMPLER_MIPMAP_MODE_NEAREST,
+            .addressModeU = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE,
+            .addressModeV = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE,
+            .addressModeW = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE,
+            .minLod = 0.0f,
+            .maxLod = static_cast<float>(levelCount)
+    };
+
+    return_log_if(vkCreateSampler(device, &samplerCreateInfo, nullptr, &sampler) != VK_SUCCESS,
+                  "Cannot create depth pyramid sampler...", false)
+
+    /// -- Reduction pipeline --
+    std::array<VkDescriptorSetLayoutBinding, 2> bindings{
+            VkDescriptorSetLayoutBinding{
+                    .binding = 0,
+                    .descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
+                    .descriptorCount = 1,
+                    .stageFlags = VK_SHADER_STAGE_COMPUTE_BIT
+            },
+            VkDescriptorSetLayoutBinding{
+                    .binding = 1,
+                    .descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_IMAGE,
+                    .descriptorCount = 1,
+                    .stageFlags = VK_SHADER_STAGE_COMPUTE_BIT
+            }
+    };
+
+    VkDescriptorSetLayoutCreateInfo setLayoutCreateInfo{
+            .sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO,
+            .bindingCount = static_cast<uint32_t>(bindings.size()),
+            .pBindings = bindings.data()
+    };
+
+    return_log_if(vkCreateDescriptorSetLayout(device, &setLayoutCreateInfo, nullptr, &setLayout) != VK_SUCCESS,
+                  "Cannot create depth pyramid descriptor set layout...", false)
+
+    std::array<VkDescriptorPoolSize, 2> poolSizes{
+            VkDescriptorPoolSize{VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, levelCount},
+            VkDescriptorPoolSize{VK_DESCRIPTOR_TYPE_STORAGE_IMAGE, levelCount}
+    };
+
+    VkDescriptorPoolCreateInfo descriptorPoolCreateInfo{
+            .sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO,
+            .maxSets = levelCount,
+            .poolSizeCount = static_cast<uint32_t>(poolSizes.size()),
+            .pPoolSizes = poolSizes.data()
+    };
+
+    return_log_if(vkCreateDescriptorPool(device, &descriptorPoolCreateInfo, nullptr, &descriptorPool) != VK_SUCCESS,
+                  "Cannot create depth pyramid descriptor pool...", false)
+
+    std::vector<VkDescriptorSetLayout> setLayouts(levelCount, setLayout);
+    levelSets.resize(levelCount);
+
+    VkDescriptorSetAllocateInfo setAllocateInfo{
+            .sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO,
+            .descriptorPool = descriptorPool,
+            .descriptorSetCount = levelCount,
+            .pSetLayouts = setLayouts.data()
+    };
+
+    return_log_if(vkAllocateDescriptorSets(device, &setAllocateInfo, levelSets.data()) != VK_SUCCESS,
+                  "Cannot allocate depth pyramid descriptor sets...", false)
+
+    for (uint32_t level = 0; level < levelCount; ++level) {
+        // Each level reads the previous one, the first level reads the depth buffer
+        VkDescriptorImageInfo sourceInfo{
+                .sampler = sampler,
+                .imageView = level == 0 ? depthView : levelViews[level - 1],
+                .imageLayout = level == 0 ? VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL : VK_IMAGE_LAYOUT_GENERAL
+        };
+
+        VkDescriptorImageInfo destinationInfo{
+                .imageView = levelViews[level],
+                .imageLayout = VK_IMAGE_LAYOUT_GENERAL
+        };
+
+        std::array<VkWriteDescriptorSet, 2> descriptorWrites{
+                VkWriteDescriptorSet{
+                        .sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET,
+                        .dstSet = levelSets[level],
+                        .dstBinding = 0,
+                        .descriptorCount = 1,
+                        .descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
+                        .pImageInfo = &sourceInfo
+                },
+                VkWriteDescriptorSet{
+                        .sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET,
+                        .dstSet = levelSets[level],
+                        .dstBinding = 1,
+                        .descriptorCount = 1,
+                        .descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_IMAGE,
+                        .pImageInfo = &destinationInfo
+                }
+        };
+
+        vkUpdateDescriptorSets(device, static_cast<uint32_t>(descriptorWrites.size()), descriptorWrites.data(), 0,
+                               nullptr);
+    }
+
+    VkPushConstantRange pushConstantRange{
+            .stageFlags = VK_SHADER_STAGE_COMPUTE_BIT,
+            .offset = 0,
+            .size = sizeof(ReductionData)
+    };
+
+    VkPipelineLayoutCreateInfo pipelineLayoutCreateInfo{
+            .sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO,
+            .setLayoutCount = 1,
+            .pSetLayouts = &setLayout,
+            .pushConstantRangeCount = 1,
+            .pPushConstantRanges = &pushConstantRange
+    };
+
+    return_log_if(vkCreatePipelineLayout(device, &pipelineLayoutCreateInfo, nullptr, &pipelineLayout) != VK_SUCCESS,
+                  "Cannot create depth pyramid pipeline layout...", false)
+
+    VkComputePipelineCreateInfo pipelineCreateInfo{
+            .sType = VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO,
+            .stage = VkPipelineShaderStageCreateInfo{
+                    .sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO,
+                    .stage = VK_SHADER_STAGE_COMPUTE_BIT,
+                    .module = reductionModule,
+                    .pName = "main"
+            },
+            .layout = pipelineLayout
+    };
+
+    return_log_if(vkCreateComputePipelines(device, VK_NULL_HANDLE, 1, &pipelineCreateInfo, nullptr, &pipeline) !=
+                  VK_SUCCESS, "Cannot create depth pyramid pipeline...", false)
+
+    // Levels are always kept in general layout, for both storage writes and sampling
+    VkCommandBuffer commandBuffer(tools::beginSingleTimeCommands(device, commandPool));
+
+    VkImageMemoryBarrier layoutBarrier{
+            .sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER,
+            .srcAccessMask = 0,
+            .dstAccessMask = VK_ACCESS_SHADER_WRITE_BIT,
+            .oldLayout = VK_IMAGE_LAYOUT_UNDEFINED,
+            .newLayout = VK_IMAGE_LAYOUT_GENERAL,
+            .srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+            .dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+            .image = image,
+            .subresourceRange = {VK_IMAGE_ASPECT_COLOR_BIT, 0, levelCount, 0, 1}
+    };
+
+    vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, 0,
+                         0, nullptr, 0, nullptr, 1, &layoutBarrier);
+
+    return_log_if(!tools::endSingleTimeCommands(device, commandPool, queue, commandBuffer),
+                  "Cannot prepare depth pyramid layout...", false)
+
+    return true;
+}
+
+void VIEDepthPyramid::destroy(const VkDevice &device) {
+    vkDestroyPipeline(device, pipeline, nullptr);
+    vkDestroyPipelineLayout(device, pipelineLayout, nullptr);
+    vkDestroyDescriptorPool(device, descriptorPool, nullptr);
+    vkDestroyDescriptorSetLayout(device, setLayout, nullptr);
+    vkDestroySampler(device, sampler, nullptr);
+    vkDestroyImageView(device, depthView, nullptr);
+
+    for (VkImageView levelView: levelViews) {
+        vkDestroyImageView(device, levelView, nullptr);
+    }
+
+    vkDestroyImageView(device, imageView, nullptr);
+    vkDestroyImage(device, image, nullptr);
+    vkFreeMemory(device, imageMemory, nullptr);
+
+    pipeline = VK_NULL_HANDLE;
+    pipelineLayout = VK_NULL_HANDLE;
+    descriptorPool = VK_NULL_HANDLE;
+    setLayout = VK_NULL_HANDLE;
+    sampler = VK_NULL_HANDLE;
+    depthView = VK_NULL_HANDLE;
+    levelViews.clear();
+    levelSets.clear();
+    imageView = VK_NULL_HANDLE;
+    image = VK_NULL_HANDLE;
+    imageMemory = VK_NULL_HANDLE;
+}
+
+void VIEDepthPyramid::record(const VkCommandBuffer &commandBuffer) const {
+    // Reads of the previous frame are completed before levels are written again
+    vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, 0,
+                         0, nullptr, 0, nullptr, 0, nullptr);
+
+    vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, pipeline);
+
+    ReductionData reduction{
+            .sourceWidth = static_cast<int32_t>(depthExtent.width),
+            .sourceHeight = static_cast<int32_t>(depthExtent.height),
+            .width = static_cast<int32_t>(extent.width),
+            .height = static_cast<int32_t>(extent.height)
+    };
+
+    for (uint32_t level = 0; level < levelSets.size(); ++level) {
+        vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, pipelineLayout, 0, 1, &levelSets[level],
+                                0, nullptr);
+        vkCmdPushConstants(commandBuffer, pipelineLayout, VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(ReductionData),
+                           &reduction);
+        vkCmdDispatch(commandBuffer, (reduction.width + kGroupSize - 1) / kGroupSize,
+                      (reduction.height + kGroupSize - 1) / kGroupSize, 1);
+
+        // The level is read by the next reduction (and by culling after the last one)
+        VkImageMemoryBarrier levelBarrier{
+                .sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER,
+                .srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT,
+                .dstAccessMask = VK_ACCESS_SHADER_READ_BIT,
+                .oldLayout = VK_IMAGE_LAYOUT_GENERAL,
+                .newLayout = VK_IMAGE_LAYOUT_GENERAL,
+                .srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+                .dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+                .image = image,
+                .subresourceRange = {VK_IMAGE_ASPECT_COLOR_BIT, level, 1, 0, 1}
+        };
+
+        vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+                             0, 0, nullptr, 0, nullptr, 1, &levelBarrier);
+
+        reduction.sourceWidth = reduction.width;
+        reduction.sourceHeight = reduction.height;
+        reduction.width = std::max(reduction.width / 2, 1);
+        reduction.height = std::max(reduction.height / 2, 1);
+    }
+}
@@ -0,0 +1,718 @@
+/* Created by LordRibblesdale on 18/10/2026.
+ * MIT License
+ */
+
+#include "engine/VIEGeometryStreamer.hpp"
+#include "tools/VIETools.hpp"
+#include "tools/VIETrace.hpp"
+#include "tools/VIEParallel.hpp"
+#include "tools/VIEJobSystem.hpp"
+
+#include <queue>
+#include <cstring>
+#include <fstream>
+#include <algorithm>
+#include <filesystem>
+
+namespace {
+    struct Request {
+        float importance{0.0f};
+        uint32_t block{0};
+
+        bool operator<(const Request &other) const {
+            return importance < other.importance;
+        }
+    };
+
+    constexpr double kMebibyte{1024.0 * 1024.0};
+}
+
+void VIEGeometryStreamer::RangeHeap::reset(uint32_t capacity) {
+    freeRanges.clear();
+
+    if (capacity > 0) {
+        freeRanges.emplace_back(0, capacity);
+    }
+}
+
+std::optional<uint32_t> VIEGeometryStreamer::RangeHeap::allocate(uint32_t count) {
+    if (count == 0) {
+        return 0;
+    }
+
+    auto freeRange = std::ranges::find_if(freeRanges, [count](const auto &range) {
+        return range.second >= count;
+    });
+
+    if (freeRange == freeRanges.end()) {
+        return std::nullopt;
+    }
+
+    const uint32_t first = freeRange->first;
+
+    if (freeRange->second == count) {
+        freeRanges.erase(freeRange);
+    } else {
+        freeRange->first += count;
+        freeRange->second -= count;
+    }
+
+    return first;
+}
+
+void VIEGeometryStreamer::RangeHeap::release(uint32_t first, uint32_t count) {
+    if (count == 0) {
+        return;
+    }
+
+    auto position = std::ranges::lower_bound(freeRanges, first, {},
+                                             [](const auto &freeRange) { return freeRange.first; });
+    position = freeRanges.emplace(position, first, count);
+
+    if (auto next = position + 1; next != freeRanges.end() && position->first + position->second == next->first) {
+        position->second += next->second;
+        freeRanges.erase(next);
+    }
+
+    if (position != freeRanges.begin()) {
+        if (auto previous = position - 1; previous->first + previous->second == position->first) {
+            previous->second += position->second;
+            freeRanges.erase(position);
+        }
+    }
+}
+
+VkDeviceSize VIEGeometryStreamer::getVertexStride() const {
+    return sizeof(VIEVertex) + (hasPositions ? sizeof(glm::vec3) : 0);
+}
+
+VkDeviceSize VIEGeometryStreamer::getDeviceSize(const Block &block) const {
+    return block.vertexCount * getVertexStride() + block.indexCount * sizeof(uint32_t);
+}
+
+size_t VIEGeometryStreamer::getHostSize(const Block &block) {
+    return block.vertices.size() * sizeof(VIEVertex) + block.indices.size() * sizeof(uint32_t);
+}
+
+void VIEGeometryStreamer::dropHostCopy(Block &block) {
+    hostBytes -= getHostSize(block);
+
+    // Swapped with empty vectors, clearing would keep the capacity
+    std::vector<VIEVertex>().swap(block.vertices);
+    std::vector<uint32_t>().swap(block.indices);
+    block.state = BlockState::SPILLED;
+}
+
+bool VIEGeometryStreamer::build(const VIEScene &scene, const Budget &budget) {
+    VIE_TRACE_ZONE("buildGeometryBlocks");
+
+    const VIEMeshPool &meshPool = scene.getMeshPool();
+    const std::vector<VIEModel> &sceneModels(scene.getModels());
+
+    hasPositions = budget.hasPositions;
+    uploadBudget = budget.upload;
+    hostBudget = budget.host;
+    spillLocation = budget.spillLocation;
+
+    blocks.clear();
+    models.clear();
+    drawCommandCount = 0;
+    meshCount = 0;
+
+    for (const VIEModel &model: sceneModels) {
+        const auto modelMeshCount = static_cast<uint32_t>(meshPool.getMeshes(model.meshes).size());
+
+        models.push_back({static_cast<uint32_t>(blocks.size()), model.lodCount, modelMeshCount});
+        blocks.resize(blocks.size() + model.lodCount);
+        blocks.back().isPinned = true;
+
+        drawCommandCount += static_cast<size_t>(modelMeshCount) * model.lodCount;
+        meshCount += modelMeshCount;
+    }
+
+    // Each level only keeps the vertices its indices reference, so coarse levels are also smaller on the device
+    tools::parallelFor(models.size(), 1, [&](size_t begin, size_t end) {
+        std::vector<uint32_t> remap;
+
+        for (size_t m = begin; m < end; ++m) {
+            const std::span<const VIEMesh> meshes(meshPool.getMeshes(sceneModels[m].meshes));
+
+            for (uint32_t level = 0; level < models[m].levelCount; ++level) {
+                Block &block = blocks[models[m].firstBlock + level];
+                block.parts.resize(meshes.size());
+
+                for (size_t i = 0; i < meshes.size(); ++i) {
+                    const VIEMesh &mesh = meshes[i];
+                    const VIEMeshLod &lod = mesh.lods[std::min(level, mesh.lodCount - 1)];
+
+                    block.parts[i] = Part{
+                            .firstIndex = static_cast<uint32_t>(block.indices.size()),
+                            .indexCount = lod.indexCount,
+                            .vertexOffset = static_cast<uint32_t>(block.vertices.size())
+                    };
+
+                    remap.assign(mesh.vertexCount, kUint32Max);
+
+                    for (uint32_t k = 0; k < lod.indexCount; ++k) {
+                        const uint32_t index = meshPool.getIndices()[mesh.firstIndex + lod.firstIndex + k];
+
+                        if (remap[index] == kUint32Max) {
+                            remap[index] = static_cast<uint32_t>(block.vertices.size()) - block.parts[i].vertexOffset;
+                            block.vertices.push_back(meshPool.getVertices()[mesh.firstVertex + index]);
+                        }
+
+                        block.indices.push_back(remap[index]);
+                    }
+                }
+
+                block.vertexCount = static_cast<uint32_t>(block.vertices.size());
+                block.indexCount = static_cast<uint32_t>(block.indices.size());
+            }
+        }
+    });
+
+    uint64_t vertexTotal = 0;
+    uint64_t indexTotal = 0;
+    uint64_t pinnedVertices = 0;
+    uint64_t pinnedIndices = 0;
+    uint32_t largestVertices = 0;
+    uint32_t largestIndices = 0;
+    hostBytes = 0;
+
+    for (const Block &block: blocks) {
+        vertexTotal += block.vertexCount;
+        indexTotal += block.indexCount;
+        hostBytes += getHostSize(block);
+
+        if (block.isPinned) {
+            pinnedVertices += block.vertexCount;
+            pinnedIndices += block.indexCount;
+        } else {
+            largestVertices = std::max(largestVertices, block.vertexCount);
+            largestIndices = std::max(largestIndices, block.indexCount);
+        }
+    }
+
+    // Heaps are split as the whole scene is, so that both fill up at about the same time
+    const VkDeviceSize totalBytes = vertexTotal * getVertexStride() + indexTotal * sizeof(uint32_t);
+    const double share = totalBytes > budget.device ? static_cast<double>(budget.device) / totalBytes : 1.0;
+    uint64_t vertexHeapSize = static_cast<uint64_t>(vertexTotal * share);
+    uint64_t indexHeapSize = static_cast<uint64_t>(indexTotal * share);
+
+    // Pinned levels are always resident, with room for at least one finer level
+    if (vertexHeapSize < pinnedVertices + largestVertices || indexHeapSize < pinnedIndices + largestIndices) {
+        vertexHeapSize = std::max(vertexHeapSize, std::min(vertexTotal, pinnedVertices + largestVertices));
+        indexHeapSize = std::max(indexHeapSize, std::min(indexTotal, pinnedIndices + largestIndices));
+
+        log_warning("Geometry device budget cannot hold the coarsest levels and a finer one, raised to {:.1f} MiB",
+                    (vertexHeapSize * getVertexStride() + indexHeapSize * sizeof(uint32_t)) / kMebibyte);
+    }
+
+    vertexCapacity = static_cast<uint32_t>(std::min<uint64_t>(vertexHeapSize, kUint32Max));
+    indexCapacity = static_cast<uint32_t>(std::min<uint64_t>(indexHeapSize, kUint32Max));
+
+    if (hostBytes > hostBudget && spillLocation.empty()) {
+        log_warning("Geometry exceeds the host budget by {:.1f} MiB, without a spill file",
+                    (hostBytes - hostBudget) / kMebibyte);
+    } else if (hostBytes > hostBudget) {
+        // Coarser levels stay in memory first, as they are requested from farther away and cost less to keep
+        std::vector<std::pair<uint32_t, uint32_t>> spillOrder;
+        size_t keptBytes = 0;
+
+        for (const ModelBlocks &model: models) {
+            for (uint32_t level = 0; level < model.levelCount; ++level) {
+                const Block &block = blocks[model.firstBlock + level];
+
+                if (block.isPinned) {
+                    keptBytes += getHostSize(block);
+                } else {
+                    spillOrder.emplace_back(level, model.firstBlock + level);
+                }
+            }
+        }
+
+        std::ranges::stable_sort(spillOrder, std::ranges::greater{}, &std::pair<uint32_t, uint32_t>::first);
+
+        std::error_code error;
+        if (const std::filesystem::path directory(std::filesystem::path(spillLocation).parent_path());
+                !directory.empty()) {
+            std::filesystem::create_directories(directory, error);
+        }
+
+        std::ofstream file(spillLocation, std::ios::binary | std::ios::trunc);
+        return_log_if(!file, fmt::format("Cannot create geometry spill file {}...", spillLocation), false)
+
+        uint64_t offset = 0;
+
+        for (const auto &[level, index]: spillOrder) {
+            Block &block = blocks[index];
+            const size_t size = getHostSize(block);
+
+            if (keptBytes + size <= hostBudget) {
+                keptBytes += size;
+                continue;
+            }
+
+            file.write(reinterpret_cast<const char *>(block.vertices.data()),
+                       static_cast<std::streamsize>(block.vertices.size() * sizeof(VIEVertex)));
+            file.write(reinterpret_cast<const char *>(block.indices.data()),
+                       static_cast<std::streamsize>(block.indices.size() * sizeof(uint32_t)));
+
+            block.spillOffset = offset;
+            offset += size;
+            dropHostCopy(block);
+        }
+
+        return_log_if(!file, fmt::format("Cannot write geometry spill file {}...", spillLocation), false)
+    }
+
+    drawLevels.assign(blocks.size(), kUint32Max);
+    loadDoneFlags = std::make_unique<std::atomic<bool>[]>(blocks.size());
+
+    log_info("Geometry streaming: {} levels of detail in {:.1f} MiB, {:.1f} MiB on the device, {:.1f} MiB in memory",
+             blocks.size(), totalBytes / kMebibyte,
+             (vertexCapacity * getVertexStride() + indexCapacity * sizeof(uint32_t)) / kMebibyte,
+             hostBytes / kMebibyte);
+
+    return true;
+}
+
+bool VIEGeometryStreamer::create(const VkDevice &device, const VkPhysicalDevice &physicalDevice,
+                                 const VkCommandPool &commandPool, const VkQueue &queue, const Buffers &buffers,
+                                 uint32_t frameCount) {
+    framesInFlight = frameCount;
+    frameNumber = 0;
+    residentBytes = 0;
+    vertexHeap.reset(vertexCapacity);
+    indexHeap.reset(indexCapacity);
+
+    return_log_if(!stagingBuffer.create(device, physicalDevice, uploadBudget, frameCount),
+                  "Cannot create geometry staging buffer...", false)
+
+    // Pinned levels may exceed the upload budget of a frame, so they get their own staging buffer
+    VkDeviceSize pinnedSize = 0;
+    for (const Block &block: blocks) {
+        pinnedSize += block.isPinned ? getDeviceSize(block) : 0;
+    }
+
+    if (pinnedSize > 0) {
+        VkBuffer pinnedBuffer;
+        VkDeviceMemory pinnedMemory;
+
+        return_log_if(!tools::createBuffer(device, physicalDevice, pinnedSize, VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+                                           VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+                                           pinnedBuffer, pinnedMemory),
+                      "Cannot create pinned geometry staging buffer...", false)
+
+        void *data;
+        vkMapMemory(device, pinnedMemory, 0, pinnedSize, 0, &data);
+
+        VkDeviceSize offset = 0;
+        bool isAllocated = true;
+
+        for (Block &block: blocks) {
+            skip_if(!block.isPinned)
+
+            // Heaps hold every pinned level, see build
+            std::optional<uint32_t> firstVertex(vertexHeap.allocate(block.vertexCount));
+            std::optional<uint32_t> firstIndex(indexHeap.allocate(block.indexCount));
+
+            if (!firstVertex || !firstIndex) {
+                isAllocated = false;
+                break;
+            }
+
+            block.firstVertex = *firstVertex;
+            block.firstIndex = *firstIndex;
+            writeBlock(block, static_cast<uint8_t *>(data) + offset, offset);
+
+            block.isResident = true;
+            residentBytes += getDeviceSize(block);
+            offset += getDeviceSize(block);
+        }
+
+        vkUnmapMemory(device, pinnedMemory);
+
+        bool isUploaded = false;
+        if (isAllocated) {
+            VkCommandBuffer commandBuffer(tools::beginSingleTimeCommands(device, commandPool));
+            recordCopies(commandBuffer, pinnedBuffer, buffers);
+            isUploaded = tools::endSingleTimeCommands(device, commandPool, queue, commandBuffer);
+        }
+
+        vkDestroyBuffer(device, pinnedBuffer, nullptr);
+        vkFreeMemory(device, pinnedMemory, nullptr);
+
+        vertexCopies.clear();
+        positionCopies.clear();
+        indexCopies.clear();
+
+        return_log_if(!isAllocated, "Geometry heaps cannot hold the coarsest levels of detail...", false)
+        return_log_if(!isUploaded, "Cannot upload the coarsest levels of detail...", false)
+
+        // Pinned levels are never uploaded again
+        for (Block &block: blocks) {
+            if (block.isPinned) {
+                dropHostCopy(block);
+            }
+        }
+    }
+
+    return true;
+}
+
+void VIEGeometryStreamer::destroy(const VkDevice &device) {
+    // Workers write into the blocks they read until they are done
+    tools::waitUntil([this]() {
+        return std::ranges::all_of(loadingBlocks, [this](uint32_t block) {
+            return loadDoneFlags[block].load(std::memory_order_acquire);
+        });
+    });
+
+    loadingBlocks.clear();
+    stagingBuffer.destroy(device);
+
+    blocks.clear();
+    models.clear();
+    drawLevels.clear();
+    pendingReleases.clear();
+    pendingVertexCount = 0;
+    pendingIndexCount = 0;
+    hostBytes = 0;
+    residentBytes = 0;
+}
+
+void VIEGeometryStreamer::startLoad(uint32_t block) {
+    blocks[block].state = BlockState::LOADING;
+    loadDoneFlags[block].store(false, std::memory_order_relaxed);
+    loadingBlocks.push_back(block);
+
+    // Only the geometry of the block is written by the worker, the main thread leaves it alone until the flag is set
+    tools::runJob([this, block]() {
+        VIE_TRACE_ZONE("loadGeometryBlock");
+
+        Block &loadedBlock = blocks[block];
+        loadedBlock.vertices.resize(loadedBlock.vertexCount);
+        loadedBlock.indices.resize(loadedBlock.indexCount);
+
+        std::ifstream file(spillLocation, std::ios::binary);
+        file.seekg(static_cast<std::streamoff>(*loadedBlock.spillOffset));
+        file.read(reinterpret_cast<char *>(loadedBlock.vertices.data()),
+                  static_cast<std::streamsize>(loadedBlock.vertices.size() * sizeof(VIEVertex)));
+        file.read(reinterpret_cast<char *>(loadedBlock.indices.data()),
+                  static_cast<std::streamsize>(loadedBlock.indices.size() * sizeof(uint32_t)));
+
+        if (!file) {
+            log_error("Cannot read geometry from spill file {}...", spillLocation);
+            std::vector<VIEVertex>().swap(loadedBlock.vertices);
+            std::vector<uint32_t>().swap(loadedBlock.indices);
+        }
+
+        loadDoneFlags[block].store(true, std::memory_order_release);
+    });
+}
+
+void VIEGeometryStreamer::finishLoads() {
+    std::erase_if(loadingBlocks, [this](uint32_t index) {
+        if (!loadDoneFlags[index].load(std::memory_order_acquire)) {
+            return false;
+        }
+
+        Block &block = blocks[index];
+        const bool isRead = block.vertices.size() == block.vertexCount && block.indices.size() == block.indexCount;
+
+        block.state = isRead ? BlockState::IN_HOST : BlockState::FAILED;
+        hostBytes += getHostSize(block);
+
+        return true;
+    });
+}
+
+bool VIEGeometryStreamer::allocateBlock(Block &block, float importance) {
+    std::optional<uint32_t> firstVertex(vertexHeap.allocate(block.vertexCount));
+    std::optional<uint32_t> firstIndex(indexHeap.allocate(block.indexCount));
+
+    if (firstVertex && firstIndex) {
+        block.firstVertex = *firstVertex;
+        block.firstIndex = *firstIndex;
+        return true;
+    }
+
+    if (firstVertex) {
+        vertexHeap.release(*firstVertex, block.vertexCount);
+    }
+
+    if (firstIndex) {
+        indexHeap.release(*firstIndex, block.indexCount);
+    }
+
+    // Ranges being released are available in a few frames, otherwise a block makes room (one for each request)
+    if ((firstVertex || pendingVertexCount >= block.vertexCount) &&
+        (firstIndex || pendingIndexCount >= block.indexCount)) {
+        return false;
+    }
+
+    // Blocks not requested by this frame go first (least recently drawn first), then the less important ones
+    auto isEvictedBefore([this](const Block &a, const Block &b) {
+        const bool isARequested = a.lastRequestedFrame == frameNumber;
+        const bool isBRequested = b.lastRequestedFrame == frameNumber;
+
+        if (isARequested != isBRequested) {
+            return !isARequested;
+        }
+
+        return isARequested ? a.importance < b.importance : a.lastUsedFrame < b.lastUsedFrame;
+    });
+
+    uint32_t victim = kUint32Max;
+
+    for (uint32_t i = 0; i < blocks.size(); ++i) {
+        const Block &candidate = blocks[i];
+
+        skip_if(!candidate.isResident || candidate.isPinned)
+        skip_if(candidate.lastRequestedFrame == frameNumber && candidate.importance >= importance)
+
+        if (victim == kUint32Max || isEvictedBefore(candidate, blocks[victim])) {
+            victim = i;
+        }
+    }
+
+    if (victim != kUint32Max) {
+        evictBlock(victim);
+    }
+
+    return false;
+}
+
+void VIEGeometryStreamer::evictBlock(uint32_t block) {
+    Block &evictedBlock = blocks[block];
+
+    // Frames in flight may still draw the block, its ranges are only reused once they are done
+    pendingReleases.push_back({block, evictedBlock.firstVertex, evictedBlock.firstIndex, frameNumber});
+    pendingVertexCount += evictedBlock.vertexCount;
+    pendingIndexCount += evictedBlock.indexCount;
+
+    evictedBlock.isResident = false;
+    residentBytes -= getDeviceSize(evictedBlock);
+}
+
+void VIEGeometryStreamer::writeBlock(const Block &block, uint8_t *data, VkDeviceSize sourceOffset) {
+    const VkDeviceSize vertexSize = block.vertices.size() * sizeof(VIEVertex);
+    const VkDeviceSize indexSize = block.indices.size() * sizeof(uint32_t);
+    VkDeviceSize offset = 0;
+
+    // Copies cannot be empty
+    if (vertexSize > 0) {
+        std::memcpy(data, block.vertices.data(), vertexSize);
+        vertexCopies.push_back({sourceOffset, block.firstVertex * sizeof(VIEVertex), vertexSize});
+        offset += vertexSize;
+
+        if (hasPositions) {
+            for (size_t i = 0; const VIEVertex &vertex: block.vertices) {
+                std::memcpy(data + offset + sizeof(glm::vec3) * i++, &vertex.pos, sizeof(glm::vec3));
+            }
+
+            positionCopies.push_back({sourceOffset + offset, block.firstVertex * sizeof(glm::vec3),
+                                      block.vertices.size() * sizeof(glm::vec3)});
+            offset += block.vertices.size() * sizeof(glm::vec3);
+        }
+    }
+
+    if (indexSize > 0) {
+        std::memcpy(data + offset, block.indices.data(), indexSize);
+        indexCopies.push_back({sourceOffset + offset, block.firstIndex * sizeof(uint32_t), indexSize});
+    }
+}
+
+void VIEGeometryStreamer::update(const VIEScene &scene, uint32_t frame) {
+    VIE_TRACE_ZONE("updateGeometryStreaming");
+
+    ++frameNumber;
+    stagingBuffer.beginFrame(frame);
+    vertexCopies.clear();
+    positionCopies.clear();
+    indexCopies.clear();
+
+    // The frame evicting a block is done once the same frame in flight begins again
+    std::erase_if(pendingReleases, [this](const PendingRelease &release) {
+        if (release.frame + framesInFlight > frameNumber) {
+            return false;
+        }
+
+        const Block &block = blocks[release.block];
+        vertexHeap.release(release.firstVertex, block.vertexCount);
+        indexHeap.release(release.firstIndex, block.indexCount);
+        pendingVertexCount -= block.vertexCount;
+        pendingIndexCount -= block.indexCount;
+
+        return true;
+    });
+
+    finishLoads();
+
+    const std::vector<uint8_t> &modelLods(scene.getModelLods());
+    const std::vector<float> &modelCoverage(scene.getModelCoverage());
+    std::priority_queue<Request> requests;
+
+    for (size_t m = 0; m < models.size() && m < modelLods.size(); ++m) {
+        const uint32_t index = models[m].firstBlock + std::min<uint32_t>(modelLods[m], models[m].levelCount - 1);
+        Block &block = blocks[index];
+
+        block.lastRequestedFrame = frameNumber;
+        block.importance = modelCoverage[m];
+
+        if (!block.isResident && block.state != BlockState::FAILED) {
+            requests.push({modelCoverage[m], index});
+        }
+    }
+
+    // Largest projected models first, until the staging memory of the frame runs out
+    while (!requests.empty()) {
+        const Request request(requests.top());
+        requests.pop();
+
+        Block &block = blocks[request.block];
+
+        if (block.state == BlockState::SPILLED) {
+            startLoad(request.block);
+            continue;
+        }
+
+        skip_if(block.state != BlockState::IN_HOST || !allocateBlock(block, request.importance))
+
+        std::optional<VIERingAllocation> staging(stagingBuffer.allocate(getDeviceSize(block)));
+
+        if (!staging) {
+            // Not read by any frame yet
+            vertexHeap.release(block.firstVertex, block.vertexCount);
+            indexHeap.release(block.firstIndex, block.indexCount);
+            break;
+        }
+
+        writeBlock(block, static_cast<uint8_t *>(staging->data), staging->offset);
+        block.isResident = true;
+        residentBytes += getDeviceSize(block);
+    }
+
+    // Geometry that can be read again is dropped when on the device, or not needed by this frame
+    for (Block &block: blocks) {
+        if (hostBytes <= hostBudget) {
+            break;
+        }
+
+        skip_if(!block.spillOffset || block.state != BlockState::IN_HOST)
+
+        if (block.isResident || block.lastRequestedFrame != frameNumber) {
+            dropHostCopy(block);
+        }
+    }
+
+    updateDrawLevels(scene);
+}
+
+void VIEGeometryStreamer::updateDrawLevels(const VIEScene &scene) {
+    const std::vector<VIEDrawCommand> &drawCommands(scene.getFrameDrawCommands());
+    size_t command = 0;
+
+    for (const ModelBlocks &model: models) {
+        for (uint32_t level = 0; level < model.levelCount; ++level) {
+            // Nearest coarser level resident, otherwise the nearest finer one
+            uint32_t drawnLevel = kUint32Max;
+
+            for (uint32_t coarser = level; coarser < model.levelCount && drawnLevel == kUint32Max; ++coarser) {
+                drawnLevel = blocks[model.firstBlock + coarser].isResident ? coarser : kUint32Max;
+            }
+
+            for (uint32_t finer = level; finer-- > 0 && drawnLevel == kUint32Max;) {
+                drawnLevel = blocks[model.firstBlock + finer].isResident ? finer : kUint32Max;
+            }
+
+            drawLevels[model.firstBlock + level] = drawnLevel;
+
+            // Draws of the first mesh tell whether any instance uses the level
+            const bool isDrawn = model.meshCount > 0 && command + level < drawCommands.size() &&
+                                 drawCommands[command + level].instanceCount > 0;
+
+            if (drawnLevel != kUint32Max && isDrawn) {
+                blocks[model.firstBlock + drawnLevel].lastUsedFrame = frameNumber;
+            }
+        }
+
+        command += static_cast<size_t>(model.meshCount) * model.levelCount;
+    }
+}
+
+void VIEGeometryStreamer::recordCopies(const VkCommandBuffer &commandBuffer, VkBuffer source,
+                                       const Buffers &buffers) const {
+    if (!vertexCopies.empty()) {
+        vkCmdCopyBuffer(commandBuffer, source, buffers.vertices, static_cast<uint32_t>(vertexCopies.size()),
+                        vertexCopies.data());
+    }
+
+    if (!positionCopies.empty() && buffers.positions != VK_NULL_HANDLE) {
+        vkCmdCopyBuffer(commandBuffer, source, buffers.positions, static_cast<uint32_t>(positionCopies.size()),
+                        positionCopies.data());
+    }
+
+    if (!indexCopies.empty()) {
+        vkCmdCopyBuffer(commandBuffer, source, buffers.indices, static_cast<uint32_t>(indexCopies.size()),
+                        indexCopies.data());
+    }
+}
+
+void VIEGeometryStreamer::recordUploads(const VkCommandBuffer &commandBuffer, const Buffers &buffers) const {
+    recordCopies(commandBuffer, stagingBuffer.getBuffer(), buffers);
+}
+
+void VIEGeometryStreamer::patchDrawCommands(std::span<VIEDrawCommand> drawCommands) const {
+    if (drawCommands.size() != drawCommandCount) {
+        return;
+    }
+
+    // Same order of VIEScene::buildDrawCommands: levels of each mesh of each model
+    size_t command = 0;
+
+    for (const ModelBlocks &model: models) {
+        for (uint32_t mesh = 0; mesh < model.meshCount; ++mesh) {
+            for (uint32_t level = 0; level < model.levelCount; ++level) {
+                VIEDrawCommand &drawCommand = drawCommands[command++];
+                const uint32_t drawnLevel = drawLevels[model.firstBlock + level];
+
+                if (drawnLevel == kUint32Max) {
+                    drawCommand.instanceCount = 0;
+                    continue;
+                }
+
+                const Block &block = blocks[model.firstBlock + drawnLevel];
+                const Part &part = block.parts[mesh];
+
+                drawCommand.indexCount = part.indexCount;
+                drawCommand.firstIndex = block.firstIndex + part.firstIndex;
+                drawCommand.vertexOffset = static_cast<int32_t>(block.firstVertex + part.vertexOffset);
+            }
+        }
+    }
+}
+
+void VIEGeometryStreamer::patchShadowDrawCommands(std::span<VIEDrawCommand> drawCommands) const {
+    if (drawCommands.size() != 2 * meshCount) {
+        return;
+    }
+
+    // Static casters of each mesh, then dynamic ones in the same order
+    size_t command = 0;
+
+    for (const ModelBlocks &model: models) {
+        const Block &block = blocks[model.firstBlock + model.levelCount - 1];
+
+        for (const Part &part: block.parts) {
+            for (size_t half: {command, meshCount + command}) {
+                drawCommands[half].indexCount = part.indexCount;
+                drawCommands[half].firstIndex = block.firstIndex + part.firstIndex;
+                drawCommands[half].vertexOffset = static_cast<int32_t>(block.firstVertex + part.vertexOffset);
+            }
+
+            ++command;
+        }
+    }
+}
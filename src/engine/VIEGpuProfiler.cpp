@@ -0,0 +1,127 @@
+/* Created by LordRibblesdale on 18/10/2026.
+ * MIT License
+ */
+
+#include "engine/VIEGpuProfiler.hpp"
+#include "tools/VIETools.hpp"
+
+bool VIEGpuProfiler::create(const VkDevice &device, const VkPhysicalDevice &physicalDevice,
+                            uint32_t queueFamilyIndex, uint32_t framesInFlight, uint32_t scopeCount) {
+    uint32_t queueFamilyCount = 0;
+    vkGetPhysicalDeviceQueueFamilyProperties(physicalDevice, &queueFamilyCount, nullptr);
+    std::vector<VkQueueFamilyProperties> queueFamilies(queueFamilyCount);
+    vkGetPhysicalDeviceQueueFamilyProperties(physicalDevice, &queueFamilyCount, queueFamilies.data());
+
+    return_log_if(queueFamilyIndex >= queueFamilyCount, "Invalid queue family for timestamps...", false)
+
+    const uint32_t validBits = queueFamilies[queueFamilyIndex].timestampValidBits;
+
+    // Not an error: the frame is simply not profiled
+    if (validBits == 0) {
+        log_warning("Timestamps not supported by the graphics queue, GPU profiling disabled");
+        return true;
+    }
+
+    VkPhysicalDeviceProperties properties;
+    vkGetPhysicalDeviceProperties(physicalDevice, &properties);
+
+    timestampPeriod = properties.limits.timestampPeriod;
+    timestampMask = validBits >= 64 ? ~0ull : (1ull << validBits) - 1;
+    maxScopes = scopeCount;
+
+    VkQueryPoolCreateInfo queryPoolCreateInfo{
+            .sType = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO,
+            .queryType = VK_QUERY_TYPE_TIMESTAMP,
+            .queryCount = 2 * maxScopes
+    };
+
+    queryPools.resize(framesInFlight, VK_NULL_HANDLE);
+    frameScopes.resize(framesInFlight);
+    results.resize(2 * maxScopes);
+
+    for (uint32_t i = 0; i < framesInFlight; ++i) {
+        return_log_if(vkCreateQueryPool(device, &queryPoolCreateInfo, nullptr, &queryPools[i]) != VK_SUCCESS,
+                      fmt::format("Cannot create timestamp query pool {}...", i), false)
+    }
+
+    return true;
+}
+
+void VIEGpuProfiler::destroy(const VkDevice &device) {
+    for (VkQueryPool &queryPool: queryPools) {
+        vkDestroyQueryPool(device, queryPool, nullptr);
+    }
+
+    queryPools.clear();
+    frameScopes.clear();
+}
+
+void VIEGpuProfiler::beginFrame(const VkDevice &device, const VkCommandBuffer &commandBuffer, uint32_t frame) {
+    if (queryPools.empty()) {
+        return;
+    }
+
+    currentFrame = frame;
+    std::vector<uint32_t> &scopes(frameScopes[currentFrame]);
+
+    // Queries of a frame never recorded are not reset yet, and cannot be read
+    if (!scopes.empty()) {
+        const auto queryCount = static_cast<uint32_t>(2 * scopes.size());
+
+        if (vkGetQueryPoolResults(device, queryPools[currentFrame], 0, queryCount,
+                                  queryCount * sizeof(uint64_t), results.data(), sizeof(uint64_t),
+                                  VK_QUERY_RESULT_64_BIT) == VK_SUCCESS) {
+            for (size_t scope = 0; scope < scopes.size(); ++scope) {
+                const uint64_t ticks = (results[2 * scope + 1] - results[2 * scope]) & timestampMask;
+                const double milliseconds = static_cast<double>(ticks) * timestampPeriod * 1e-6;
+
+                PassHistory &history(histories[scopes[scope]]);
+
+                history.sum += milliseconds - history.samples[history.nextSample];
+                history.samples[history.nextSample] = milliseconds;
+                history.nextSample = (history.nextSample + 1) % kHistorySize;
+                history.sampleCount = std::min(history.sampleCount + 1, kHistorySize);
+
+                VIEGpuTiming &timing(timings[scopes[scope]]);
+                timing.lastMs = milliseconds;
+                timing.averageMs = history.sum / history.sampleCount;
+            }
+        }
+    }
+
+    scopes.clear();
+    vkCmdResetQueryPool(commandBuffer, queryPools[currentFrame], 0, 2 * maxScopes);
+}
+
+uint32_t VIEGpuProfiler::beginScope(const VkCommandBuffer &commandBuffer, const std::string &name) {
+    if (queryPools.empty() || frameScopes[currentFrame].size() == maxScopes) {
+        return kUint32Max;
+    }
+
+    // Passes are few, a linear search is enough
+    auto pass(std::find_if(timings.begin(), timings.end(), [&name](const VIEGpuTiming &timing) {
+        return timing.name == name;
+    }));
+
+    if (pass == timings.end()) {
+        timings.push_back(VIEGpuTiming{.name = name});
+        histories.emplace_back();
+        pass = timings.end() - 1;
+    }
+
+    std::vector<uint32_t> &scopes(frameScopes[currentFrame]);
+    const auto scope = static_cast<uint32_t>(scopes.size());
+    scopes.push_back(static_cast<uint32_t>(pass - timings.begin()));
+
+    vkCmdWriteTimestamp(commandBuffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, queryPools[currentFrame], 2 * scope);
+
+    return scope;
+}
+
+void VIEGpuProfiler::endScope(const VkCommandBuffer &commandBuffer, uint32_t scope) const {
+    if (scope == kUint32Max) {
+        return;
+    }
+
+    vkCmdWriteTimestamp(commandBuffer, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, queryPools[currentFrame], 2 * scope + 1);
+}
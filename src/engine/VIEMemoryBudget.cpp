@@ -0,0 +1,88 @@
+/* Created by LordRibblesdale on 18/10/2026.
+ * MIT License
+ */
+
+#include "engine/VIEMemoryBudget.hpp"
+#include "tools/VIETools.hpp"
+
+#include <string_view>
+
+bool VIEMemoryBudget::isExtensionSupported(const VkPhysicalDevice &physicalDevice) {
+    uint32_t extensionCount;
+    std::vector<VkExtensionProperties> availableExtensions;
+    tools::gatherVkData(vkEnumerateDeviceExtensionProperties, availableExtensions, extensionCount, physicalDevice,
+                        nullptr);
+
+    return std::ranges::any_of(availableExtensions, [](const VkExtensionProperties &extensionProperties) {
+        return std::string_view(VK_EXT_MEMORY_BUDGET_EXTENSION_NAME) == extensionProperties.extensionName;
+    });
+}
+
+void VIEMemoryBudget::create(const VkPhysicalDevice &physicalDevice, bool isExtensionEnabled, float usageShare) {
+    this->isExtensionEnabled = isExtensionEnabled;
+    this->usageShare = std::clamp(usageShare, 0.01f, 1.0f);
+
+    if (!isExtensionEnabled) {
+        log_warning("VK_EXT_memory_budget not supported, device memory is not tracked");
+    }
+
+    update(physicalDevice);
+
+    for (uint32_t i = 0; const VIEHeapBudget &heap: heaps) {
+        log_info("Memory heap {}{}: {} MiB, budget {} MiB, used {} MiB", i++, heap.isDeviceLocal ? " (device)" : "",
+                 heap.size >> 20, heap.budget >> 20, heap.usage >> 20);
+    }
+}
+
+void VIEMemoryBudget::update(const VkPhysicalDevice &physicalDevice) {
+    VkPhysicalDeviceMemoryBudgetPropertiesEXT budgetProperties{
+            .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MEMORY_BUDGET_PROPERTIES_EXT
+    };
+
+    VkPhysicalDeviceMemoryProperties2 memoryProperties{
+            .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MEMORY_PROPERTIES_2,
+            .pNext = isExtensionEnabled ? &budgetProperties : nullptr
+    };
+
+    vkGetPhysicalDeviceMemoryProperties2(physicalDevice, &memoryProperties);
+
+    const VkPhysicalDeviceMemoryProperties &properties(memoryProperties.memoryProperties);
+    heaps.resize(properties.memoryHeapCount);
+
+    for (uint32_t i = 0; i < properties.memoryHeapCount; ++i) {
+        heaps[i] = {
+                .size = properties.memoryHeaps[i].size,
+                .budget = isExtensionEnabled ? budgetProperties.heapBudget[i] : properties.memoryHeaps[i].size,
+                .usage = isExtensionEnabled ? budgetProperties.heapUsage[i] : 0,
+                .isDeviceLocal = (properties.memoryHeaps[i].flags & VK_MEMORY_HEAP_DEVICE_LOCAL_BIT) != 0
+        };
+    }
+}
+
+VkDeviceSize VIEMemoryBudget::getDeviceHeadroom() const {
+    VkDeviceSize headroom = 0;
+    VkDeviceSize largestSize = 0;
+
+    // Device local allocations go to the largest heap (smaller ones are usually host visible windows)
+    for (const VIEHeapBudget &heap: heaps) {
+        skip_if(!heap.isDeviceLocal || heap.size <= largestSize)
+
+        const auto plannedBudget = static_cast<VkDeviceSize>(static_cast<double>(heap.budget) * usageShare);
+        headroom = plannedBudget > heap.usage ? plannedBudget - heap.usage : 0;
+        largestSize = heap.size;
+    }
+
+    return headroom;
+}
+
+VkDeviceSize VIEMemoryBudget::getDeviceUsage() const {
+    VkDeviceSize usage = 0;
+
+    for (const VIEHeapBudget &heap: heaps) {
+        if (heap.isDeviceLocal) {
+            usage += heap.usage;
+        }
+    }
+
+    return usage;
+}
@@ -0,0 +1,507 @@
+/* Created by LordRibblesdale on 18/10/2026.
+ * MIT License
+ */
+
+#include "engine/VIERenderGraph.hpp"
+#include "tools/VIETools.hpp"
+
+namespace {
+    constexpr VkAccessFlags kWriteAccess{VK_ACCESS_SHADER_WRITE_BIT | VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT |
+                                         VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT | VK_ACCESS_TRANSFER_WRITE_BIT |
+                                         VK_ACCESS_HOST_WRITE_BIT | VK_ACCESS_MEMORY_WRITE_BIT};
+
+    /**
+     * @brief Uses of a resource since its last write (or layout transition), while planning barriers
+     */
+    struct ResourceState {
+        VkPipelineStageFlags writeStages{0};
+        VkAccessFlags writeAccess{0};
+        VkPipelineStageFlags readStages{0};
+        VkAccessFlags readAccess{0};
+        VkImageLayout layout{VK_IMAGE_LAYOUT_UNDEFINED};
+    };
+}
+
+void VIERenderGraph::reset() {
+    resources.clear();
+    passes.clear();
+}
+
+VIERenderGraph::ResourceHandle VIERenderGraph::importImage(const std::string &name, VkImage image,
+                                                           VkImageAspectFlags aspect, const Usage &initialUsage,
+                                                           const Usage &finalUsage, bool isOutput) {
+    resources.push_back(Resource{
+            .name = name,
+            .isImage = true,
+            .isOutput = isOutput,
+            .image = image,
+            .description = ImageDescription{.aspect = aspect},
+            .initialUsage = initialUsage,
+            .finalUsage = finalUsage
+    });
+
+    return static_cast<ResourceHandle>(resources.size() - 1);
+}
+
+VIERenderGraph::ResourceHandle VIERenderGraph::importBuffer(const std::string &name, VkBuffer buffer,
+                                                            const Usage &initialUsage, bool isOutput) {
+    resources.push_back(Resource{
+            .name = name,
+            .isImage = false,
+            .isOutput = isOutput,
+            .buffer = buffer,
+            .initialUsage = initialUsage
+    });
+
+    return static_cast<ResourceHandle>(resources.size() - 1);
+}
+
+VIERenderGraph::ResourceHandle VIERenderGraph::createImage(const std::string &name,
+                                                           const ImageDescription &description) {
+    resources.push_back(Resource{
+            .name = name,
+            .isImage = true,
+            .isTransient = true,
+            .description = description
+    });
+
+    return static_cast<ResourceHandle>(resources.size() - 1);
+}
+
+uint32_t VIERenderGraph::addPass(const std::string &name, ExecuteCallback execute, bool hasSideEffects) {
+    passes.push_back(Pass{
+            .name = name,
+            .execute = std::move(execute),
+            .hasSideEffects = hasSideEffects
+    });
+
+    return static_cast<uint32_t>(passes.size() - 1);
+}
+
+void VIERenderGraph::read(uint32_t pass, ResourceHandle resource, const Usage &usage) {
+    passes.at(pass).accesses.push_back(Access{resource, usage, false});
+}
+
+void VIERenderGraph::write(uint32_t pass, ResourceHandle resource, const Usage &usage) {
+    passes.at(pass).accesses.push_back(Access{resource, usage, true});
+}
+
+std::vector<uint64_t> VIERenderGraph::buildKey() const {
+    std::vector<uint64_t> key;
+    key.reserve(4 + resources.size() * 8 + passes.size() * 8);
+
+    auto appendUsage([&key](const Usage &usage) {
+        key.push_back((static_cast<uint64_t>(usage.stages) << 32) | usage.access);
+        key.push_back(static_cast<uint64_t>(usage.layout));
+    });
+
+    // Handles and callbacks are left out, they change from frame to frame
+    key.push_back(resources.size());
+    for (const Resource &resource: resources) {
+        const ImageDescription &description(resource.description);
+
+        key.push_back(static_cast<uint64_t>(resource.isImage) | static_cast<uint64_t>(resource.isTransient) << 1 |
+                      static_cast<uint64_t>(resource.isOutput) << 2);
+        key.push_back((static_cast<uint64_t>(description.format) << 32) | description.layerCount);
+        key.push_back((static_cast<uint64_t>(description.extent.width) << 32) | description.extent.height);
+        key.push_back((static_cast<uint64_t>(description.usage) << 32) | description.aspect);
+        appendUsage(resource.initialUsage);
+        appendUsage(resource.finalUsage);
+    }
+
+    key.push_back(passes.size());
+    for (const Pass &pass: passes) {
+        key.push_back((static_cast<uint64_t>(pass.accesses.size()) << 1) | pass.hasSideEffects);
+
+        for (const Access &access: pass.accesses) {
+            key.push_back((static_cast<uint64_t>(access.resource) << 1) | access.isWrite);
+            appendUsage(access.usage);
+        }
+    }
+
+    return key;
+}
+
+void VIERenderGraph::cullPasses(std::vector<bool> &isPassAlive) const {
+    std::vector<bool> isNeeded(resources.size());
+    for (size_t i = 0; i < resources.size(); ++i) {
+        isNeeded[i] = resources[i].isOutput;
+    }
+
+    // From the last pass back: a pass is kept if a later kept pass (or the outputs) reads what it writes
+    isPassAlive.assign(passes.size(), false);
+    for (size_t i = passes.size(); i-- > 0;) {
+        const Pass &pass(passes[i]);
+
+        isPassAlive[i] = pass.hasSideEffects || std::ranges::any_of(pass.accesses, [&isNeeded](const Access &access) {
+            return access.isWrite && isNeeded[access.resource];
+        });
+
+        if (isPassAlive[i]) {
+            for (const Access &access: pass.accesses) {
+                if (!access.isWrite) {
+                    isNeeded[access.resource] = true;
+                }
+            }
+        }
+    }
+}
+
+bool VIERenderGraph::createTransients(const VkDevice &device, const VkPhysicalDevice &physicalDevice,
+                                      const std::vector<bool> &isPassAlive) {
+    // Lifetime of each transient, as first and last kept pass using it
+    std::vector<std::pair<uint32_t, uint32_t>> lifetimes(resources.size(), {kUint32Max, 0});
+
+    for (uint32_t i = 0; i < passes.size(); ++i) {
+        skip_if(!isPassAlive[i])
+
+        for (const Access &access: passes[i].accesses) {
+            lifetimes[access.resource].first = std::min(lifetimes[access.resource].first, i);
+            lifetimes[access.resource].second = std::max(lifetimes[access.resource].second, i);
+        }
+    }
+
+    transientImages.assign(resources.size(), TransientImage{});
+    std::vector<VkMemoryRequirements> requirements(resources.size());
+    std::vector<ResourceHandle> transients;
+
+    for (ResourceHandle i = 0; i < resources.size(); ++i) {
+        const Resource &resource(resources[i]);
+
+        // Transients used by culled passes only are not created at all
+        skip_if(!resource.isTransient || lifetimes[i].first == kUint32Max)
+
+        const ImageDescription &description(resource.description);
+        VkImageCreateInfo imageCreateInfo{
+                .sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO,
+                .imageType = VK_IMAGE_TYPE_2D,
+                .format = description.format,
+                .extent = {description.extent.width, description.extent.height, 1},
+                .mipLevels = 1,
+                .arrayLayers = description.layerCount,
+                .samples = VK_SAMPLE_COUNT_1_BIT,
+                .tiling = VK_IMAGE_TILING_OPTIMAL,
+                .usage = description.usage,
+                .sharingMode = VK_SHARING_MODE_EXCLUSIVE,
+                .initialLayout = VK_IMAGE_LAYOUT_UNDEFINED
+        };
+
+        return_log_if(vkCreateImage(device, &imageCreateInfo, nullptr, &transientImages[i].image) != VK_SUCCESS,
+                      fmt::format("Cannot create transient image {}...", resource.name), false)
+
+        vkGetImageMemoryRequirements(device, transientImages[i].image, &requirements[i]);
+        transients.push_back(i);
+    }
+
+    // Largest first, each one in the first block of compatible memory whose transients do not overlap its lifetime
+    std::ranges::sort(transients, [&requirements](ResourceHandle a, ResourceHandle b) {
+        return requirements[a].size > requirements[b].size;
+    });
+
+    struct MemoryBlock {
+        VkDeviceSize size{0};
+        uint32_t memoryTypeBits{0};
+        std::vector<std::pair<uint32_t, uint32_t>> lifetimes;
+    };
+
+    std::vector<MemoryBlock> blocks;
+    transientRequestedSize = 0;
+
+    for (ResourceHandle transient: transients) {
+        const std::pair<uint32_t, uint32_t> &lifetime(lifetimes[transient]);
+        transientRequestedSize += requirements[transient].size;
+
+        auto block(std::ranges::find_if(blocks, [&](const MemoryBlock &memoryBlock) {
+            return (memoryBlock.memoryTypeBits & requirements[transient].memoryTypeBits) != 0 &&
+                   std::ranges::none_of(memoryBlock.lifetimes, [&lifetime](const auto &other) {
+                       return lifetime.first <= other.second && other.first <= lifetime.second;
+                   });
+        }));
+
+        if (block == blocks.end()) {
+            blocks.push_back(MemoryBlock{.memoryTypeBits = requirements[transient].memoryTypeBits});
+            block = blocks.end() - 1;
+        }
+
+        block->size = std::max(block->size, requirements[transient].size);
+        block->memoryTypeBits &= requirements[transient].memoryTypeBits;
+        block->lifetimes.push_back(lifetime);
+        transientImages[transient].memoryBlock = static_cast<uint32_t>(block - blocks.begin());
+    }
+
+    memoryBlocks.assign(blocks.size(), VK_NULL_HANDLE);
+    transientMemorySize = 0;
+
+    for (size_t i = 0; i < blocks.size(); ++i) {
+        uint32_t memoryType;
+        return_log_if(!tools::findMemoryType(physicalDevice, blocks[i].memoryTypeBits,
+                                             VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, memoryType),
+                      "No compatible memory type found for transient images...", false)
+
+        VkMemoryAllocateInfo memoryAllocateInfo{
+                .sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO,
+                .allocationSize = blocks[i].size,
+                .memoryTypeIndex = memoryType
+        };
+
+        return_log_if(vkAllocateMemory(device, &memoryAllocateInfo, nullptr, &memoryBlocks[i]) != VK_SUCCESS,
+                      "Cannot allocate transient image memory...", false)
+
+        transientMemorySize += blocks[i].size;
+    }
+
+    // Every transient starts at the beginning of its block, contents are discarded on first use
+    for (ResourceHandle transient: transients) {
+        TransientImage &transientImage(transientImages[transient]);
+        const ImageDescription &description(resources[transient].description);
+
+        vkBindImageMemory(device, transientImage.image, memoryBlocks[transientImage.memoryBlock], 0);
+
+        VkImageViewCreateInfo imageViewCreateInfo{
+                .sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO,
+                .image = transientImage.image,
+                .viewType = description.layerCount > 1 ? VK_IMAGE_VIEW_TYPE_2D_ARRAY : VK_IMAGE_VIEW_TYPE_2D,
+                .format = description.format,
+                .subresourceRange = {description.aspect, 0, 1, 0, description.layerCount}
+        };
+
+        return_log_if(vkCreateImageView(device, &imageViewCreateInfo, nullptr, &transientImage.imageView) !=
+                      VK_SUCCESS, fmt::format("Cannot create transient view {}...", resources[transient].name), false)
+    }
+
+    return true;
+}
+
+void VIERenderGraph::planBarriers(const std::vector<bool> &isPassAlive) {
+    std::vector<ResourceState> states(resources.size());
+
+    // Uses of every transient sharing the memory of each block, which may still run from the previous frame
+    std::vector<ResourceState> blockUses(memoryBlocks.size());
+    for (uint32_t i = 0; i < passes.size(); ++i) {
+        skip_if(!isPassAlive[i])
+
+        for (const Access &access: passes[i].accesses) {
+            skip_if(!resources[access.resource].isTransient)
+
+            ResourceState &blockUse(blockUses[transientImages[access.resource].memoryBlock]);
+            blockUse.writeStages |= access.usage.stages;
+            blockUse.writeAccess |= access.usage.access & kWriteAccess;
+        }
+    }
+
+    for (ResourceHandle i = 0; i < resources.size(); ++i) {
+        const Resource &resource(resources[i]);
+
+        if (resource.isTransient) {
+            if (transientImages[i].image != VK_NULL_HANDLE) {
+                states[i] = blockUses[transientImages[i].memoryBlock];
+            }
+        } else if (const VkAccessFlags writeAccess = resource.initialUsage.access & kWriteAccess; writeAccess != 0) {
+            states[i] = ResourceState{.writeStages = resource.initialUsage.stages, .writeAccess = writeAccess,
+                                      .layout = resource.initialUsage.layout};
+        } else {
+            states[i] = ResourceState{.readStages = resource.initialUsage.stages,
+                                      .readAccess = resource.initialUsage.access,
+                                      .layout = resource.initialUsage.layout};
+        }
+    }
+
+    auto addUse([this, &states](BarrierBatch &batch, ResourceHandle resource, const Usage &usage, bool isWrite) {
+        ResourceState &state(states[resource]);
+        const bool isImage = resources[resource].isImage;
+        const bool isLayoutChange = isImage && usage.layout != state.layout;
+
+        if (isLayoutChange || isWrite) {
+            // Writes (and transitions) wait for every use since the last write
+            const VkPipelineStageFlags srcStages = state.writeStages | state.readStages;
+
+            if (isLayoutChange || state.writeAccess != 0) {
+                (isImage ? batch.imageBarriers : batch.bufferBarriers).push_back(Barrier{
+                        .resource = resource,
+                        .srcAccess = state.writeAccess,
+                        .dstAccess = usage.access,
+                        .oldLayout = state.layout,
+                        .newLayout = isImage ? usage.layout : VK_IMAGE_LAYOUT_UNDEFINED
+                });
+            }
+
+            if (isLayoutChange || srcStages != 0) {
+                batch.srcStages |= srcStages;
+                batch.dstStages |= usage.stages;
+            }
+
+            state = ResourceState{
+                    .writeStages = usage.stages,
+                    .writeAccess = isWrite ? usage.access & kWriteAccess : 0,
+                    .readStages = isWrite ? 0 : usage.stages,
+                    .readAccess = isWrite ? 0 : usage.access,
+                    .layout = isImage ? usage.layout : VK_IMAGE_LAYOUT_UNDEFINED
+            };
+        } else {
+            // Reads only wait for the last write, unless an earlier read already did for the same stages
+            const bool isCovered = (usage.stages & ~state.readStages) == 0 && (usage.access & ~state.readAccess) == 0;
+
+            if (state.writeStages != 0 && !isCovered) {
+                if (state.writeAccess != 0) {
+                    (isImage ? batch.imageBarriers : batch.bufferBarriers).push_back(Barrier{
+                            .resource = resource,
+                            .srcAccess = state.writeAccess,
+                            .dstAccess = usage.access,
+                            .oldLayout = state.layout,
+                            .newLayout = state.layout
+                    });
+                }
+
+                batch.srcStages |= state.writeStages;
+                batch.dstStages |= usage.stages;
+            }
+
+            state.readStages |= usage.stages;
+            state.readAccess |= usage.access;
+        }
+    });
+
+    steps.clear();
+    for (uint32_t i = 0; i < passes.size(); ++i) {
+        skip_if(!isPassAlive[i])
+
+        Step &step(steps.emplace_back(Step{.pass = i}));
+
+        for (const Access &access: passes[i].accesses) {
+            addUse(step.barriers, access.resource, access.usage, access.isWrite);
+        }
+    }
+
+    finalBarriers = BarrierBatch{};
+    for (ResourceHandle i = 0; i < resources.size(); ++i) {
+        const Resource &resource(resources[i]);
+
+        if (resource.isImage && !resource.isTransient && resource.finalUsage.layout != VK_IMAGE_LAYOUT_UNDEFINED) {
+            addUse(finalBarriers, i, resource.finalUsage, false);
+        }
+    }
+}
+
+bool VIERenderGraph::compile(const VkDevice &device, const VkPhysicalDevice &physicalDevice) {
+    std::vector<uint64_t> key(buildKey());
+
+    if (key == compiledKey) {
+        return true;
+    }
+
+    // Transients of the previous plan may still be used by frames in flight
+    if (!memoryBlocks.empty()) {
+        vkDeviceWaitIdle(device);
+    }
+
+    destroyTransients(device);
+    compiledKey.clear();
+
+    std::vector<bool> isPassAlive;
+    cullPasses(isPassAlive);
+
+    if (!createTransients(device, physicalDevice, isPassAlive)) {
+        destroyTransients(device);
+        return false;
+    }
+
+    planBarriers(isPassAlive);
+    compiledKey = std::move(key);
+
+    log_info("Render graph: {} of {} passes, {} KiB of transient memory ({} KiB without aliasing)", steps.size(),
+             passes.size(), transientMemorySize / 1024, transientRequestedSize / 1024);
+
+    return true;
+}
+
+void VIERenderGraph::recordBarriers(const VkCommandBuffer &commandBuffer, const BarrierBatch &batch) const {
+    if (batch.srcStages == 0 && batch.dstStages == 0 && batch.imageBarriers.empty()) {
+        return;
+    }
+
+    std::vector<VkImageMemoryBarrier> imageBarriers;
+    imageBarriers.reserve(batch.imageBarriers.size());
+
+    for (const Barrier &barrier: batch.imageBarriers) {
+        imageBarriers.push_back(VkImageMemoryBarrier{
+                .sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER,
+                .srcAccessMask = barrier.srcAccess,
+                .dstAccessMask = barrier.dstAccess,
+                .oldLayout = barrier.oldLayout,
+                .newLayout = barrier.newLayout,
+                .srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+                .dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+                .image = getImage(barrier.resource),
+                .subresourceRange = {resources[barrier.resource].description.aspect, 0, VK_REMAINING_MIP_LEVELS, 0,
+                                     VK_REMAINING_ARRAY_LAYERS}
+        });
+    }
+
+    std::vector<VkBufferMemoryBarrier> bufferBarriers;
+    bufferBarriers.reserve(batch.bufferBarriers.size());
+
+    for (const Barrier &barrier: batch.bufferBarriers) {
+        bufferBarriers.push_back(VkBufferMemoryBarrier{
+                .sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER,
+                .srcAccessMask = barrier.srcAccess,
+                .dstAccessMask = barrier.dstAccess,
+                .srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+                .dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+                .buffer = resources[barrier.resource].buffer,
+                .offset = 0,
+                .size = VK_WHOLE_SIZE
+        });
+    }
+
+    vkCmdPipelineBarrier(commandBuffer, batch.srcStages != 0 ? batch.srcStages : VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT,
+                         batch.dstStages != 0 ? batch.dstStages : VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, 0, 0,
+                         nullptr, static_cast<uint32_t>(bufferBarriers.size()), bufferBarriers.data(),
+                         static_cast<uint32_t>(imageBarriers.size()), imageBarriers.data());
+}
+
+void VIERenderGraph::execute(const VkCommandBuffer &commandBuffer) const {
+    for (const Step &step: steps) {
+        recordBarriers(commandBuffer, step.barriers);
+        passes[step.pass].execute(commandBuffer);
+    }
+
+    recordBarriers(commandBuffer, finalBarriers);
+}
+
+void VIERenderGraph::destroyTransients(const VkDevice &device) {
+    for (TransientImage &transientImage: transientImages) {
+        vkDestroyImageView(device, transientImage.imageView, nullptr);
+        vkDestroyImage(device, transientImage.image, nullptr);
+    }
+
+    for (VkDeviceMemory &memoryBlock: memoryBlocks) {
+        vkFreeMemory(device, memoryBlock, nullptr);
+    }
+
+    transientImages.clear();
+    memoryBlocks.clear();
+    transientMemorySize = 0;
+    transientRequestedSize = 0;
+}
+
+void VIERenderGraph::destroy(const VkDevice &device) {
+    destroyTransients(device);
+
+    compiledKey.clear();
+    steps.clear();
+    finalBarriers = BarrierBatch{};
+    reset();
+}
+
+VkImage VIERenderGraph::getImage(ResourceHandle resource) const {
+    if (resource >= resources.size()) {
+        return VK_NULL_HANDLE;
+    }
+
+    return resources[resource].isTransient && resource < transientImages.size() ? transientImages[resource].image
+                                                                                 : resources[resource].image;
+}
+
+VkImageView VIERenderGraph::getImageView(ResourceHandle resource) const {
+    return resource < transientImages.size() ? transientImages[resource].imageView : VK_NULL_HANDLE;
+}
@@ -0,0 +1,131 @@
+/* Created by LordRibblesdale on 18/10/2026.
+ * MIT License
+ */
+
+#include "engine/VIERenderTarget.hpp"
+#include "tools/VIETools.hpp"
+
+#include <cstring>
+
+bool VIERenderTarget::create(const VkDevice &device, const VkPhysicalDevice &physicalDevice, VkExtent2D imageExtent,
+                             uint32_t imageLayerCount, VkFormat imageFormat, VkImageUsageFlags usage,
+                             VkImageAspectFlags aspect) {
+    format = imageFormat;
+    extent = imageExtent;
+    layerCount = imageLayerCount;
+
+    VkImageCreateInfo imageCreateInfo{
+            .sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO,
+            .imageType = VK_IMAGE_TYPE_2D,
+            .format = format,
+            .extent = {extent.width, extent.height, 1},
+            .mipLevels = 1,
+            .arrayLayers = layerCount,
+            .samples = VK_SAMPLE_COUNT_1_BIT,
+            .tiling = VK_IMAGE_TILING_OPTIMAL,
+            .usage = usage,
+            .sharingMode = VK_SHARING_MODE_EXCLUSIVE,
+            .initialLayout = VK_IMAGE_LAYOUT_UNDEFINED
+    };
+
+    return_log_if(vkCreateImage(device, &imageCreateInfo, nullptr, &image) != VK_SUCCESS,
+                  "Cannot create render target image...", false)
+
+    VkMemoryRequirements memoryRequirements;
+    vkGetImageMemoryRequirements(device, image, &memoryRequirements);
+
+    uint32_t memoryType;
+    return_log_if(!tools::findMemoryType(physicalDevice, memoryRequirements.memoryTypeBits,
+                                         VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, memoryType),
+                  "No compatible memory type found for render target...", false)
+
+    VkMemoryAllocateInfo memoryAllocateInfo{
+            .sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO,
+            .allocationSize = memoryRequirements.size,
+            .memoryTypeIndex = memoryType
+    };
+
+    return_log_if(vkAllocateMemory(device, &memoryAllocateInfo, nullptr, &imageMemory) != VK_SUCCESS,
+                  "Cannot allocate render target memory...", false)
+
+    vkBindImageMemory(device, image, imageMemory, 0);
+
+    VkImageViewCreateInfo imageViewCreateInfo{
+            .sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO,
+            .image = image,
+            .viewType = layerCount > 1 ? VK_IMAGE_VIEW_TYPE_2D_ARRAY : VK_IMAGE_VIEW_TYPE_2D,
+            .format = format,
+            .subresourceRange = VkImageSubresourceRange{
+                    .aspectMask = aspect,
+                    .baseMipLevel = 0,
+                    .levelCount = 1,
+                    .baseArrayLayer = 0,
+                    .layerCount = layerCount
+            }
+    };
+
+    return_log_if(vkCreateImageView(device, &imageViewCreateInfo, nullptr, &imageView) != VK_SUCCESS,
+                  "Cannot create render target view...", false)
+
+    return true;
+}
+
+void VIERenderTarget::destroy(const VkDevice &device) {
+    vkDestroyImageView(device, imageView, nullptr);
+    vkDestroyImage(device, image, nullptr);
+    vkFreeMemory(device, imageMemory, nullptr);
+
+    imageView = VK_NULL_HANDLE;
+    image = VK_NULL_HANDLE;
+    imageMemory = VK_NULL_HANDLE;
+}
+
+bool VIERenderTarget::readPixels(const VkDevice &device, const VkPhysicalDevice &physicalDevice,
+                                 const VkCommandPool &commandPool, const VkQueue &queue,
+                                 std::vector<uint8_t> &pixels) const {
+    const VkDeviceSize size = static_cast<VkDeviceSize>(extent.width) * extent.height * layerCount * 4;
+
+    VkBuffer readbackBuffer{};
+    VkDeviceMemory readbackMemory{};
+
+    if (!tools::createBuffer(device, physicalDevice, size, VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+                             VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+                             readbackBuffer, readbackMemory)) {
+        vkDestroyBuffer(device, readbackBuffer, nullptr);
+        vkFreeMemory(device, readbackMemory, nullptr);
+        return false;
+    }
+
+    VkCommandBuffer commandBuffer(tools::beginSingleTimeCommands(device, commandPool));
+
+    // Layers are tightly packed one after the other
+    VkBufferImageCopy copyRegion{
+            .bufferOffset = 0,
+            .bufferRowLength = 0,
+            .bufferImageHeight = 0,
+            .imageSubresource = {VK_IMAGE_ASPECT_COLOR_BIT, 0, 0, layerCount},
+            .imageOffset = {0, 0, 0},
+            .imageExtent = {extent.width, extent.height, 1}
+    };
+
+    vkCmdCopyImageToBuffer(commandBuffer, image, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, readbackBuffer, 1,
+                           &copyRegion);
+
+    bool isCopied = tools::endSingleTimeCommands(device, commandPool, queue, commandBuffer);
+
+    if (isCopied) {
+        pixels.resize(size);
+
+        void *mappedMemory;
+        vkMapMemory(device, readbackMemory, 0, size, 0, &mappedMemory);
+        std::memcpy(pixels.data(), mappedMemory, size);
+        vkUnmapMemory(device, readbackMemory);
+    }
+
+    vkDestroyBuffer(device, readbackBuffer, nullptr);
+    vkFreeMemory(device, readbackMemory, nullptr);
+
+    return_log_if(!isCopied, "Cannot copy render target to host memory...", false)
+
+    return true;
+}
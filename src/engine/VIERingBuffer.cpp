@@ -0,0 +1,63 @@
+/* Created by LordRibblesdale on 18/10/2026.
+ * MIT License
+ */
+
+#include "engine/VIERingBuffer.hpp"
+#include "tools/VIETools.hpp"
+
+bool VIERingBuffer::create(const VkDevice &device, const VkPhysicalDevice &physicalDevice,
+                           VkDeviceSize requestedFrameSize, uint32_t framesInFlight) {
+    VkPhysicalDeviceProperties properties;
+    vkGetPhysicalDeviceProperties(physicalDevice, &properties);
+
+    // Offset alignments are powers of two, the biggest one satisfies both
+    alignment = std::max(properties.limits.minUniformBufferOffsetAlignment,
+                         properties.limits.minStorageBufferOffsetAlignment);
+    frameSize = (requestedFrameSize + alignment - 1) & ~(alignment - 1);
+
+    return_log_if(!tools::createBuffer(device, physicalDevice, frameSize * framesInFlight,
+                                       VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT | VK_BUFFER_USAGE_STORAGE_BUFFER_BIT |
+                                       VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+                                       VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+                                       buffer, bufferMemory),
+                  "Cannot create ring buffer...", false)
+
+    void *memory;
+    return_log_if(vkMapMemory(device, bufferMemory, 0, VK_WHOLE_SIZE, 0, &memory) != VK_SUCCESS,
+                  "Cannot map ring buffer memory...", false)
+
+    mappedMemory = static_cast<uint8_t *>(memory);
+
+    return true;
+}
+
+void VIERingBuffer::destroy(const VkDevice &device) {
+    if (mappedMemory) {
+        vkUnmapMemory(device, bufferMemory);
+        mappedMemory = nullptr;
+    }
+
+    vkDestroyBuffer(device, buffer, nullptr);
+    vkFreeMemory(device, bufferMemory, nullptr);
+
+    buffer = VK_NULL_HANDLE;
+    bufferMemory = VK_NULL_HANDLE;
+}
+
+std::optional<VIERingAllocation> VIERingBuffer::allocate(VkDeviceSize size) {
+    VkDeviceSize alignedSize = (size + alignment - 1) & ~(alignment - 1);
+
+    if (!mappedMemory || head + alignedSize > frameSize) {
+        return std::nullopt;
+    }
+
+    VIERingAllocation allocation{
+            .data = mappedMemory + frameBegin + head,
+            .offset = frameBegin + head,
+            .size = size
+    };
+
+    head += alignedSize;
+
+    return allocation;
+}
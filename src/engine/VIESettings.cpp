@@ -3,8 +3,11 @@
  */
 
 #include "engine/VIESettings.hpp"
+#include "structs/VIEScene.hpp"
+#include "tools/VIELogger.hpp"
 
 #include <fstream>
+#include <algorithm>
 #include <filesystem>
 #include <pugixml.hpp>
 
@@ -20,7 +23,7 @@ VIESettings::VIESettings(const std::string &configLocation) {
     std::ifstream file(configLocation);
 
     if (!file.is_open()) {
-        std::cout << "<ERROR> loadXMLSettings: file not opened." << std::endl;
+        log_error("loadXMLSettings: file not opened.");
         setDefaultValues();
         return;
     }
@@ -28,7 +31,7 @@ VIESettings::VIESettings(const std::string &configLocation) {
     pugi::xml_document xmlDocument;
 
     if (pugi::xml_parse_result result(xmlDocument.load_file(configLocation.c_str())); !result) {
-        std::cout << "<ERROR> result loadXMLSettings: XML file not loaded.";
+        log_error("loadXMLSettings: XML file not loaded.");
         setDefaultValues();
         return;
     }
@@ -81,17 +84,98 @@ VIESettings::VIESettings(const std::string &configLocation) {
         VkPhysicalDeviceProperties deviceProperties;
         vkGetPhysicalDeviceProperties(device, &deviceProperties);
 
-        VkPhysicalDeviceFeatures deviceFeatures;
-        vkGetPhysicalDeviceFeatures(device, &deviceFeatures);
-
-        return deviceProperties.deviceType == selectedDeviceType && deviceFeatures.multiDrawIndirect &&
-               deviceFeatures.multiViewport;
+        VkPhysicalDeviceVulkan12Features vulkan12Features{
+                .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_FEATURES
+        };
+        VkPhysicalDeviceVulkan11Features vulkan11Features{
+                .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_1_FEATURES,
+                .pNext = &vulkan12Features
+        };
+        VkPhysicalDeviceFeatures2 deviceFeatures{
+                .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2,
+                .pNext = &vulkan11Features
+        };
+        vkGetPhysicalDeviceFeatures2(device, &deviceFeatures);
+
+        // Indirect draws with per-draw data and bindless (descriptor indexed) textures
+        bool isBindlessSupported = vulkan11Features.shaderDrawParameters && vulkan12Features.runtimeDescriptorArray &&
+                                   vulkan12Features.descriptorBindingPartiallyBound &&
+                                   vulkan12Features.descriptorBindingVariableDescriptorCount &&
+                                   vulkan12Features.descriptorBindingSampledImageUpdateAfterBind &&
+                                   vulkan12Features.shaderSampledImageArrayNonUniformIndexing;
+
+        // Shaders select their camera through gl_ViewIndex, also when rendering a single view
+        return deviceProperties.deviceType == selectedDeviceType && deviceFeatures.features.multiDrawIndirect &&
+               deviceFeatures.features.drawIndirectFirstInstance && deviceFeatures.features.multiViewport &&
+               vulkan11Features.multiview && isBindlessSupported;
     };
 
     current = root.child("Shaders");
     std::filesystem::path directory(current.attribute("directory").value());
     vertexShaderLocation = (directory / current.attribute("vertex").value()).string();
     fragmentShaderLocation = (directory / current.attribute("fragment").value()).string();
+    depthVertexShaderLocation = (directory / current.attribute("depthVertex").as_string("depth.vert")).string();
+    depthPyramidShaderLocation = (directory / current.attribute("depthPyramid").as_string("depth_pyramid.comp"))
+            .string();
+    shadowVertexShaderLocation = (directory / current.attribute("shadowVertex").as_string("shadow.vert")).string();
+
+    current = root.child("Scenario");
+    scenarioLocation = (std::filesystem::path(current.attribute("directory").value()) /
+                        current.attribute("file").value()).string();
+
+    current = root.child("Textures");
+    textureCacheLocation = current.attribute("cacheDirectory").value();
+    if (std::string mipFilterType(current.attribute("mipFilter").value()); mipFilterType == "kaiser") {
+        mipFilter = VIEMipFilter::KAISER;
+    }
+
+    if (std::string compression(current.attribute("compression").value()); compression == "bc") {
+        textureCompression = VIETextureCompression::BC;
+    } else if (compression == "bc7") {
+        textureCompression = VIETextureCompression::BC7;
+    }
+
+    current = root.child("LevelOfDetail");
+    lodLevels = current.attribute("levels").as_uint(0);
+    lodReduction = std::clamp(current.attribute("reduction").as_float(0.5f), 0.05f, 0.95f);
+    lodErrorThreshold = current.attribute("errorThreshold").as_float(1.0f);
+
+    generateMeshlets = root.child("Meshlets").attribute("enabled").as_bool();
+
+    // Budgets are given in MiB
+    current = root.child("Streaming");
+    isGeometryStreamingEnabled = current.attribute("enabled").as_bool();
+    geometryDeviceBudget = static_cast<VkDeviceSize>(current.attribute("deviceBudget").as_uint(256)) << 20;
+    geometryHostBudget = static_cast<size_t>(current.attribute("hostBudget").as_uint(512)) << 20;
+    geometryUploadBudget = static_cast<VkDeviceSize>(std::max(current.attribute("uploadBudget").as_uint(4), 1u)) << 20;
+    geometrySpillLocation = current.attribute("spillFile").as_string();
+
+    memoryBudgetShare = std::clamp(root.child("Memory").attribute("budgetShare").as_float(0.9f), 0.01f, 1.0f);
+
+    current = root.child("Stereo");
+    isStereoEnabled = current.attribute("enabled").as_bool();
+    stereoXRes = std::max(current.attribute("width").as_uint(1440), 1u);
+    stereoYRes = std::max(current.attribute("height").as_uint(1600), 1u);
+    interpupillaryDistance = current.attribute("interpupillaryDistance").as_float(0.064f);
+
+    current = root.child("Depth");
+    isDepthPrepassEnabled = current.attribute("prepass").as_bool();
+    isDepthPyramidEnabled = current.attribute("pyramid").as_bool();
+
+    current = root.child("Shadows");
+    isShadowEnabled = current.attribute("enabled").as_bool();
+    shadowCascadeCount = std::clamp(current.attribute("cascades").as_uint(4), 1u, VIEShadowData::kMaxCascades);
+    shadowResolution = std::max(current.attribute("resolution").as_uint(2048), 1u);
+    shadowDistance = current.attribute("distance").as_float(200.0f);
+    shadowSplitLambda = std::clamp(current.attribute("splitLambda").as_float(0.75f), 0.0f, 1.0f);
+    shadowCasterDistance = current.attribute("casterDistance").as_float(100.0f);
+    shadowDepthBiasConstant = current.attribute("depthBiasConstant").as_float(1.25f);
+    shadowDepthBiasSlope = current.attribute("depthBiasSlope").as_float(1.75f);
+
+    current = root.child("Profiling");
+    isGpuProfilingEnabled = current.attribute("gpuTimestamps").as_bool();
+    traceLocation = current.attribute("cpuTrace").as_string();
+    startupReportLocation = current.attribute("startupReport").as_string();
 
     current = root.child("Debug");
     enableMessageCallback = current.attribute("message").as_bool();
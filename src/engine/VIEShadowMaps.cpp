@@ -0,0 +1,542 @@
+/* Created by LordRibblesdale on 18/10/2026.
+ * MIT License
+ */
+
+#include "engine/VIEShadowMaps.hpp"
+#include "tools/VIETools.hpp"
+
+#include <cmath>
+#include <algorithm>
+
+namespace {
+    /**
+     * @brief Depth only render pass of a single layer
+     * @param loadOp clear for the cache layers, load for the shadow layers (copied from the cache)
+     */
+    bool createLayerPass(const VkDevice &device, VkFormat depthFormat, VkAttachmentLoadOp loadOp,
+                         VkImageLayout initialLayout, VkImageLayout finalLayout,
+                         const std::array<VkSubpassDependency, 2> &dependencies, VkRenderPass &renderPass) {
+        VkAttachmentDescription depthAttachment{
+                .format = depthFormat,
+                .samples = VK_SAMPLE_COUNT_1_BIT,
+                .loadOp = loadOp,
+                .storeOp = VK_ATTACHMENT_STORE_OP_STORE,
+                .stencilLoadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE,
+                .stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE,
+                .initialLayout = initialLayout,
+                .finalLayout = finalLayout
+        };
+
+        VkAttachmentReference depthAttachmentReference{
+                .attachment = 0,
+                .layout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL
+        };
+
+        VkSubpassDescription subpassDescription{
+                .pipelineBindPoint = VK_PIPELINE_BIND_POINT_GRAPHICS,
+                .colorAttachmentCount = 0,
+                .pDepthStencilAttachment = &depthAttachmentReference
+        };
+
+        VkRenderPassCreateInfo renderPassCreateInfo{
+                .sType = VK_STRUCTURE_TYPE_RENDER_PASS_CREATE_INFO,
+                .attachmentCount = 1,
+                .pAttachments = &depthAttachment,
+                .subpassCount = 1,
+                .pSubpasses = &subpassDescription,
+                .dependencyCount = static_cast<uint32_t>(dependencies.size()),
+                .pDependencies = dependencies.data()
+        };
+
+        return vkCreateRenderPass(device, &renderPassCreateInfo, nullptr, &renderPass) == VK_SUCCESS;
+    }
+
+    bool createLayerViews(const VkDevice &device, const VIERenderTarget &target, uint32_t layerCount,
+                          std::vector<VkImageView> &layerViews) {
+        layerViews.resize(layerCount, VK_NULL_HANDLE);
+
+        for (uint32_t layer = 0; VkImageView &layerView: layerViews) {
+            VkImageViewCreateInfo imageViewCreateInfo{
+                    .sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO,
+                    .image = target.getImage(),
+                    .viewType = VK_IMAGE_VIEW_TYPE_2D,
+                    .format = target.getFormat(),
+                    .subresourceRange = {VK_IMAGE_ASPECT_DEPTH_BIT, 0, 1, layer++, 1}
+            };
+
+            if (vkCreateImageView(device, &imageViewCreateInfo, nullptr, &layerView) != VK_SUCCESS) {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    bool createLayerFramebuffers(const VkDevice &device, const VkRenderPass &renderPass,
+                                 const std::vector<VkImageView> &layerViews, uint32_t resolution,
+                                 std::vector<VkFramebuffer> &framebuffers) {
+        framebuffers.resize(layerViews.size(), VK_NULL_HANDLE);
+
+        for (size_t i = 0; i < layerViews.size(); ++i) {
+            VkFramebufferCreateInfo framebufferCreateInfo{
+                    .sType = VK_STRUCTURE_TYPE_FRAMEBUFFER_CREATE_INFO,
+                    .renderPass = renderPass,
+                    .attachmentCount = 1,
+                    .pAttachments = &layerViews[i],
+                    .width = resolution,
+                    .height = resolution,
+                    .layers = 1
+            };
+
+            if (vkCreateFramebuffer(device, &framebufferCreateInfo, nullptr, &framebuffers[i]) != VK_SUCCESS) {
+                return false;
+            }
+        }
+
+        return true;
+    }
+}
+
+bool VIEShadowMaps::create(const VkDevice &device, const VkPhysicalDevice &physicalDevice,
+                           const VkCommandPool &commandPool, const VkQueue &queue, VkFormat depthFormat,
+                           uint32_t shadowCascadeCount, uint32_t shadowResolution,
+                           VkDescriptorSetLayout frameSetLayout, VkShaderModule vertexModule, float depthBiasConstant,
+                           float depthBiasSlope) {
+    cascadeCount = std::min(shadowCascadeCount, VIEShadowData::kMaxCascades);
+    resolution = cascadeCount > 0 ? shadowResolution : 1;
+
+    const uint32_t layerCount = std::max(cascadeCount, 1u);
+
+    return_log_if(!shadowTarget.create(device, physicalDevice, {resolution, resolution}, layerCount, depthFormat,
+                                       VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT | VK_IMAGE_USAGE_SAMPLED_BIT |
+                                       VK_IMAGE_USAGE_TRANSFER_DST_BIT, VK_IMAGE_ASPECT_DEPTH_BIT),
+                  "Cannot create shadow map layers...", false)
+
+    VkImageViewCreateInfo arrayViewCreateInfo{
+            .sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO,
+            .image = shadowTarget.getImage(),
+            .viewType = VK_IMAGE_VIEW_TYPE_2D_ARRAY,
+            .format = depthFormat,
+            .subresourceRange = {VK_IMAGE_ASPECT_DEPTH_BIT, 0, 1, 0, layerCount}
+    };
+
+    return_log_if(vkCreateImageView(device, &arrayViewCreateInfo, nullptr, &arrayView) != VK_SUCCESS,
+                  "Cannot create shadow map view...", false)
+
+    // Outside of every cascade (and beyond the far plane of the light) fragments are lit
+    VkSamplerCreateInfo samplerCreateInfo{
+            .sType = VK_STRUCTURE_TYPE_SAMPLER_CREATE_INFO,
+            .magFilter = VK_FILTER_LINEAR,
+            .minFilter = VK_FILTER_LINEAR,
+            .mipmapMode = VK_SAMPLER_MIPMAP_MODE_NEAREST,
+            .addressModeU = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_BORDER,
+            .addressModeV = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_BORDER,
+            .addressModeW = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_BORDER,
+            .compareEnable = VK_TRUE,
+            .compareOp = VK_COMPARE_OP_LESS_OR_EQUAL,
+            .minLod = 0.0f,
+            .maxLod = 0.0f,
+            .borderColor = VK_BORDER_COLOR_FLOAT_OPAQUE_WHITE
+    };
+
+    return_log_if(vkCreateSampler(device, &samplerCreateInfo, nullptr, &sampler) != VK_SUCCESS,
+                  "Cannot create shadow map sampler...", false)
+
+    // Layers are sampled before being rendered, or never rendered without cascades
+    VkCommandBuffer commandBuffer(tools::beginSingleTimeCommands(device, commandPool));
+
+    VkImageMemoryBarrier layoutBarrier{
+            .sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER,
+            .srcAccessMask = 0,
+            .dstAccessMask = VK_ACCESS_SHADER_READ_BIT,
+            .oldLayout = VK_IMAGE_LAYOUT_UNDEFINED,
+            .newLayout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL,
+            .srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+            .dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+            .image = shadowTarget.getImage(),
+            .subresourceRange = {VK_IMAGE_ASPECT_DEPTH_BIT, 0, 1, 0, layerCount}
+    };
+
+    vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, 0,
+                         0, nullptr, 0, nullptr, 1, &layoutBarrier);
+
+    return_log_if(!tools::endSingleTimeCommands(device, commandPool, queue, commandBuffer),
+                  "Cannot prepare shadow map layout...", false)
+
+    if (cascadeCount == 0) {
+        return true;
+    }
+
+    return_log_if(!cacheTarget.create(device, physicalDevice, {resolution, resolution}, cascadeCount, depthFormat,
+                                      VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT,
+                                      VK_IMAGE_ASPECT_DEPTH_BIT),
+                  "Cannot create shadow cache layers...", false)
+
+    /// -- Render passes --
+    // Cache layers are cleared after the copy of the previous frame, and copied after static casters are drawn
+    std::array<VkSubpassDependency, 2> cacheDependencies{
+            VkSubpassDependency{
+                    .srcSubpass = VK_SUBPASS_EXTERNAL,
+                    .dstSubpass = 0,
+                    .srcStageMask = VK_PIPELINE_STAGE_TRANSFER_BIT,
+                    .dstStageMask = VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT |
+                                    VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT,
+                    .srcAccessMask = 0,
+                    .dstAccessMask = VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT
+            },
+            VkSubpassDependency{
+                    .srcSubpass = 0,
+                    .dstSubpass = VK_SUBPASS_EXTERNAL,
+                    .srcStageMask = VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT,
+                    .dstStageMask = VK_PIPELINE_STAGE_TRANSFER_BIT,
+                    .srcAccessMask = VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT,
+                    .dstAccessMask = VK_ACCESS_TRANSFER_READ_BIT
+            }
+    };
+
+    // Shadow layers receive the copy first, and are sampled by shading afterwards
+    std::array<VkSubpassDependency, 2> shadowDependencies{
+            VkSubpassDependency{
+                    .srcSubpass = VK_SUBPASS_EXTERNAL,
+                    .dstSubpass = 0,
+                    .srcStageMask = VK_PIPELINE_STAGE_TRANSFER_BIT,
+                    .dstStageMask = VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT |
+                                    VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT,
+                    .srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT,
+                    .dstAccessMask = VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_READ_BIT |
+                                     VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT
+            },
+            VkSubpassDependency{
+                    .srcSubpass = 0,
+                    .dstSubpass = VK_SUBPASS_EXTERNAL,
+                    .srcStageMask = VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT,
+                    .dstStageMask = VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT,
+                    .srcAccessMask = VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT,
+                    .dstAccessMask = VK_ACCESS_SHADER_READ_BIT
+            }
+    };
+
+    return_log_if(!createLayerPass(device, depthFormat, VK_ATTACHMENT_LOAD_OP_CLEAR, VK_IMAGE_LAYOUT_UNDEFINED,
+                                   VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, cacheDependencies, cachePass),
+                  "Cannot create shadow cache render pass...", false)
+
+    return_log_if(!createLayerPass(device, depthFormat, VK_ATTACHMENT_LOAD_OP_LOAD,
+                                   VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                                   VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL, shadowDependencies, shadowPass),
+                  "Cannot create shadow render pass...", false)
+
+    return_log_if(!createLayerViews(device, cacheTarget, cascadeCount, cacheLayerViews) ||
+                  !createLayerViews(device, shadowTarget, cascadeCount, shadowLayerViews),
+                  "Cannot create shadow layer views...", false)
+
+    return_log_if(!createLayerFramebuffers(device, cachePass, cacheLayerViews, resolution, cacheFramebuffers) ||
+                  !createLayerFramebuffers(device, shadowPass, shadowLayerViews, resolution, shadowFramebuffers),
+                  "Cannot create shadow framebuffers...", false)
+
+    /// -- Caster pipeline --
+    VkPushConstantRange pushConstantRange{
+            .stageFlags = VK_SHADER_STAGE_VERTEX_BIT,
+            .offset = 0,
+            .size = sizeof(glm::mat4x4)
+    };
+
+    VkPipelineLayoutCreateInfo pipelineLayoutCreateInfo{
+            .sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO,
+            .setLayoutCount = 1,
+            .pSetLayouts = &frameSetLayout,
+            .pushConstantRangeCount = 1,
+            .pPushConstantRanges = &pushConstantRange
+    };
+
+    return_log_if(vkCreatePipelineLayout(device, &pipelineLayoutCreateInfo, nullptr, &pipelineLayout) != VK_SUCCESS,
+                  "Cannot create shadow pipeline layout...", false)
+
+    VkPipelineShaderStageCreateInfo shaderStageCreateInfo{
+            .sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO,
+            .stage = VK_SHADER_STAGE_VERTEX_BIT,
+            .module = vertexModule,
+            .pName = "main"
+    };
+
+    VkVertexInputBindingDescription positionBinding{
+            .binding = 0,
+            .stride = sizeof(glm::vec3),
+            .inputRate = VK_VERTEX_INPUT_RATE_VERTEX
+    };
+
+    VkVertexInputAttributeDescription positionAttribute{0, 0, VK_FORMAT_R32G32B32_SFLOAT, 0};
+
+    VkPipelineVertexInputStateCreateInfo vertexInputCreateInfo{
+            .sType = VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO,
+            .vertexBindingDescriptionCount = 1,
+            .pVertexBindingDescriptions = &positionBinding,
+            .vertexAttributeDescriptionCount = 1,
+            .pVertexAttributeDescriptions = &positionAttribute
+    };
+
+    VkPipelineInputAssemblyStateCreateInfo inputAssemblyCreateInfo{
+            .sType = VK_STRUCTURE_TYPE_PIPELINE_INPUT_ASSEMBLY_STATE_CREATE_INFO,
+            .topology = VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST,
+            .primitiveRestartEnable = VK_FALSE
+    };
+
+    VkViewport viewport{0.0f, 0.0f, static_cast<float>(resolution), static_cast<float>(resolution), 0.0f, 1.0f};
+    VkRect2D scissorRectangle{{0, 0}, {resolution, resolution}};
+
+    VkPipelineViewportStateCreateInfo viewportStateCreateInfo{
+            .sType = VK_STRUCTURE_TYPE_PIPELINE_VIEWPORT_STATE_CREATE_INFO,
+            .viewportCount = 1,
+            .pViewports = &viewport,
+            .scissorCount = 1,
+            .pScissors = &scissorRectangle
+    };
+
+    // Both faces are drawn, as meshes are not guaranteed to be closed, and depth bias moves them away from the light
+    VkPipelineRasterizationStateCreateInfo rasterizationCreateInfo{
+            .sType = VK_STRUCTURE_TYPE_PIPELINE_RASTERIZATION_STATE_CREATE_INFO,
+            .depthClampEnable = VK_FALSE,
+            .rasterizerDiscardEnable = VK_FALSE,
+            .polygonMode = VK_POLYGON_MODE_FILL,
+            .cullMode = VK_CULL_MODE_NONE,
+            .frontFace = VK_FRONT_FACE_COUNTER_CLOCKWISE,
+            .depthBiasEnable = VK_TRUE,
+            .depthBiasConstantFactor = depthBiasConstant,
+            .depthBiasClamp = 0.0f,
+            .depthBiasSlopeFactor = depthBiasSlope,
+            .lineWidth = 1.0f
+    };
+
+    VkPipelineMultisampleStateCreateInfo multisampleCreateInfo{
+            .sType = VK_STRUCTURE_TYPE_PIPELINE_MULTISAMPLE_STATE_CREATE_INFO,
+            .rasterizationSamples = VK_SAMPLE_COUNT_1_BIT,
+            .sampleShadingEnable = VK_FALSE
+    };
+
+    // Shadow depth is not reversed: orthographic depth is linear, and 0 is the nearest to the light
+    VkPipelineDepthStencilStateCreateInfo depthStencilCreateInfo{
+            .sType = VK_STRUCTURE_TYPE_PIPELINE_DEPTH_STENCIL_STATE_CREATE_INFO,
+            .depthTestEnable = VK_TRUE,
+            .depthWriteEnable = VK_TRUE,
+            .depthCompareOp = VK_COMPARE_OP_LESS,
+            .depthBoundsTestEnable = VK_FALSE,
+            .stencilTestEnable = VK_FALSE,
+            .minDepthBounds = 0.0f,
+            .maxDepthBounds = 1.0f
+    };
+
+    VkGraphicsPipelineCreateInfo pipelineCreateInfo{
+            .sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO,
+            .stageCount = 1,
+            .pStages = &shaderStageCreateInfo,
+            .pVertexInputState = &vertexInputCreateInfo,
+            .pInputAssemblyState = &inputAssemblyCreateInfo,
+            .pViewportState = &viewportStateCreateInfo,
+            .pRasterizationState = &rasterizationCreateInfo,
+            .pMultisampleState = &multisampleCreateInfo,
+            .pDepthStencilState = &depthStencilCreateInfo,
+            .layout = pipelineLayout,
+            .renderPass = cachePass,
+            .subpass = 0,
+            .basePipelineHandle = VK_NULL_HANDLE,
+            .basePipelineIndex = -1
+    };
+
+    // Both passes are compatible (same attachment), so the pipeline is used by both
+    return_log_if(vkCreateGraphicsPipelines(device, VK_NULL_HANDLE, 1, &pipelineCreateInfo, nullptr, &pipeline) !=
+                  VK_SUCCESS, "Cannot create shadow pipeline...", false)
+
+    return true;
+}
+
+void VIEShadowMaps::destroy(const VkDevice &device) {
+    vkDestroyPipeline(device, pipeline, nullptr);
+    vkDestroyPipelineLayout(device, pipelineLayout, nullptr);
+
+    for (std::vector<VkFramebuffer> *framebuffers: {&cacheFramebuffers, &shadowFramebuffers}) {
+        for (VkFramebuffer framebuffer: *framebuffers) {
+            vkDestroyFramebuffer(device, framebuffer, nullptr);
+        }
+
+        framebuffers->clear();
+    }
+
+    for (std::vector<VkImageView> *layerViews: {&cacheLayerViews, &shadowLayerViews}) {
+        for (VkImageView layerView: *layerViews) {
+            vkDestroyImageView(device, layerView, nullptr);
+        }
+
+        layerViews->clear();
+    }
+
+    vkDestroyRenderPass(device, shadowPass, nullptr);
+    vkDestroyRenderPass(device, cachePass, nullptr);
+    vkDestroySampler(device, sampler, nullptr);
+    vkDestroyImageView(device, arrayView, nullptr);
+
+    cacheTarget.destroy(device);
+    shadowTarget.destroy(device);
+
+    pipeline = VK_NULL_HANDLE;
+    pipelineLayout = VK_NULL_HANDLE;
+    shadowPass = VK_NULL_HANDLE;
+    cachePass = VK_NULL_HANDLE;
+    sampler = VK_NULL_HANDLE;
+    arrayView = VK_NULL_HANDLE;
+}
+
+void VIEShadowMaps::update(const VIECamera &camera, float aspectRatio, const glm::vec3 &lightDirection,
+                           float distance, float splitLambda, float casterDistance, uint64_t staticCasterVersion,
+                           bool hasDynamicCasters, VIEShadowData &shadowData) {
+    shadowData.lightDirection = glm::vec4(lightDirection, 0.0f);
+    shadowData.cascadeCount = cascadeCount;
+
+    staticRedrawMask = 0;
+    layerRedrawMask = 0;
+
+    if (cascadeCount == 0) {
+        return;
+    }
+
+    const float nearDepth = camera.nearPlane;
+    const float farDepth = std::max(std::min(distance, camera.farPlane), nearDepth * 2.0f);
+
+    // Squared ratio between the radius of a view slice and its depth
+    const float tanHalfHeight = std::tan(glm::radians(camera.fieldOfView) * 0.5f);
+    const float slope = tanHalfHeight * tanHalfHeight * (1.0f + aspectRatio * aspectRatio);
+
+    const glm::vec3 eye(camera.center);
+    const glm::vec3 forward(glm::normalize(glm::vec3(camera.lookAt - camera.center)));
+
+    // Light space has a fixed orientation, so that snapped cascades do not depend on the camera direction
+    const glm::vec3 lightUp(std::abs(lightDirection.y) > 0.99f ? glm::vec3(0, 0, 1) : glm::vec3(0, 1, 0));
+    const glm::mat4x4 lightView(glm::lookAt(glm::vec3(0.0f), -lightDirection, lightUp));
+
+    const uint32_t cascadeMask = (1u << cascadeCount) - 1;
+    const bool isLightChanged = lightDirection != cachedLightDirection;
+    cachedLightDirection = lightDirection;
+
+    float sliceNear = nearDepth;
+
+    for (uint32_t i = 0; i < cascadeCount; ++i) {
+        // Practical split scheme: blend of logarithmic and uniform splits
+        const float ratio = static_cast<float>(i + 1) / static_cast<float>(cascadeCount);
+        const float sliceFar = splitLambda * nearDepth * std::pow(farDepth / nearDepth, ratio) +
+                               (1.0f - splitLambda) * (nearDepth + (farDepth - nearDepth) * ratio);
+
+        // Smallest sphere around the slice, centered on the view axis: it only depends on the projection, so the
+        // radius does not change while the camera moves or turns
+        const float centerDepth = std::min((sliceNear + sliceFar) * (1.0f + slope) * 0.5f, sliceFar);
+        const float radius = std::sqrt((sliceFar - centerDepth) * (sliceFar - centerDepth) +
+                                       slope * sliceFar * sliceFar);
+
+        // Snapping to cells of whole texels: the cascade moves only when the center leaves its cell
+        float halfSize = radius * (1.0f + kGuardBand);
+        const float texelSize = 2.0f * halfSize / static_cast<float>(resolution);
+        const float cellSize = std::max(std::round(radius * kGuardBand / texelSize), 1.0f) * texelSize;
+        halfSize = radius + cellSize;
+
+        const glm::vec3 center(lightView * glm::vec4(eye + forward * centerDepth, 1.0f));
+
+        CascadeKey key{
+                .x = static_cast<int32_t>(std::floor(center.x / cellSize + 0.5f)),
+                .y = static_cast<int32_t>(std::floor(center.y / cellSize + 0.5f)),
+                .z = static_cast<int32_t>(std::floor(center.z / cellSize + 0.5f)),
+                .halfSize = halfSize
+        };
+
+        const glm::vec3 snappedCenter(glm::vec3(static_cast<float>(key.x), static_cast<float>(key.y),
+                                                static_cast<float>(key.z)) * cellSize);
+
+        // Light space looks along -Z: casters up to casterDistance towards the light are still included
+        glm::mat4x4 projection(glm::orthoRH_ZO(snappedCenter.x - halfSize, snappedCenter.x + halfSize,
+                                               snappedCenter.y - halfSize, snappedCenter.y + halfSize,
+                                               -snappedCenter.z - halfSize - casterDistance,
+                                               -snappedCenter.z + halfSize));
+        projection[1][1] *= -1;
+
+        viewProjections[i] = projection * lightView;
+        shadowData.viewProjections[i] = viewProjections[i];
+        shadowData.splitDepths[static_cast<int>(i)] = sliceFar;
+
+        if (isLightChanged || !(key == cachedKeys[i]) || cachedVersions[i] != staticCasterVersion) {
+            staticRedrawMask |= 1u << i;
+            cachedKeys[i] = key;
+            cachedVersions[i] = staticCasterVersion;
+        }
+
+        sliceNear = sliceFar;
+    }
+
+    // Layers with dynamic casters of the previous frame are restored from the cache, even without dynamic casters now
+    layerRedrawMask = staticRedrawMask | dynamicLayerMask | (hasDynamicCasters ? cascadeMask : 0u);
+    dynamicLayerMask = hasDynamicCasters ? cascadeMask : 0u;
+}
+
+void VIEShadowMaps::record(const VkCommandBuffer &commandBuffer, const DrawCallback &drawCasters) const {
+    VkClearValue clearDepth{};
+    clearDepth.depthStencil = {1.0f, 0};
+
+    for (uint32_t i = 0; i < cascadeCount; ++i) {
+        if ((layerRedrawMask & (1u << i)) == 0) {
+            continue;
+        }
+
+        VkRenderPassBeginInfo renderPassBeginInfo{
+                .sType = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO,
+                .renderPass = cachePass,
+                .framebuffer = cacheFramebuffers[i],
+                .renderArea = VkRect2D{{0, 0}, {resolution, resolution}},
+                .clearValueCount = 1,
+                .pClearValues = &clearDepth
+        };
+
+        if (staticRedrawMask & (1u << i)) {
+            vkCmdBeginRenderPass(commandBuffer, &renderPassBeginInfo, VK_SUBPASS_CONTENTS_INLINE);
+            vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, pipeline);
+            vkCmdPushConstants(commandBuffer, pipelineLayout, VK_SHADER_STAGE_VERTEX_BIT, 0, sizeof(glm::mat4x4),
+                               &viewProjections[i]);
+            drawCasters(commandBuffer, pipelineLayout, true);
+            vkCmdEndRenderPass(commandBuffer);
+        }
+
+        // Shading of the previous frame has finished reading the layer before it is overwritten
+        VkImageMemoryBarrier layerBarrier{
+                .sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER,
+                .srcAccessMask = 0,
+                .dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT,
+                .oldLayout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL,
+                .newLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                .srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+                .dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+                .image = shadowTarget.getImage(),
+                .subresourceRange = {VK_IMAGE_ASPECT_DEPTH_BIT, 0, 1, i, 1}
+        };
+
+        vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, 0,
+                             0, nullptr, 0, nullptr, 1, &layerBarrier);
+
+        VkImageCopy layerCopy{
+                .srcSubresource = {VK_IMAGE_ASPECT_DEPTH_BIT, 0, i, 1},
+                .srcOffset = {0, 0, 0},
+                .dstSubresource = {VK_IMAGE_ASPECT_DEPTH_BIT, 0, i, 1},
+                .dstOffset = {0, 0, 0},
+                .extent = {resolution, resolution, 1}
+        };
+
+        vkCmdCopyImage(commandBuffer, cacheTarget.getImage(), VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+                       shadowTarget.getImage(), VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &layerCopy);
+
+        // The pass also returns the layer to its sampled layout when there are no dynamic casters
+        renderPassBeginInfo.renderPass = shadowPass;
+        renderPassBeginInfo.framebuffer = shadowFramebuffers[i];
+        renderPassBeginInfo.clearValueCount = 0;
+        renderPassBeginInfo.pClearValues = nullptr;
+
+        vkCmdBeginRenderPass(commandBuffer, &renderPassBeginInfo, VK_SUBPASS_CONTENTS_INLINE);
+        vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, pipeline);
+        vkCmdPushConstants(commandBuffer, pipelineLayout, VK_SHADER_STAGE_VERTEX_BIT, 0, sizeof(glm::mat4x4),
+                           &viewProjections[i]);
+        drawCasters(commandBuffer, pipelineLayout, false);
+        vkCmdEndRenderPass(commandBuffer);
+    }
+}
@@ -0,0 +1,169 @@
+/* Created by LordRibblesdale on 18/10/2026.
+ * MIT License
+ */
+
+#include "engine/VIETextureImage.hpp"
+#include "tools/VIEKTX2.hpp"
+#include "tools/VIETools.hpp"
+
+#include <cstring>
+
+bool VIETextureImage::create(const VkDevice &device, const VkPhysicalDevice &physicalDevice,
+                             const VkCommandPool &commandPool, const VkQueue &queue, const VIETextureData &texture) {
+    VkCommandBuffer commandBuffer(tools::beginSingleTimeCommands(device, commandPool));
+    const bool isRecorded = recordUpload(device, physicalDevice, commandBuffer, texture);
+
+    // Submitted even if nothing was recorded, so that the command buffer is freed
+    const bool isCopied = tools::endSingleTimeCommands(device, commandPool, queue, commandBuffer) && isRecorded;
+
+    return_log_if(!isCopied, "Cannot copy texture to image...", false)
+
+    return finishUpload(device);
+}
+
+bool VIETextureImage::recordUpload(const VkDevice &device, const VkPhysicalDevice &physicalDevice,
+                                   const VkCommandBuffer &commandBuffer, const VIETextureData &texture) {
+    return_log_if(!texture.isLoaded(), "Cannot create image of a texture not loaded...", false)
+
+    format = tools::getTextureVkFormat(texture.format, texture.isSRGB);
+    mipCount = static_cast<uint32_t>(texture.mipLevels.size());
+
+    VkImageCreateInfo imageCreateInfo{
+            .sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO,
+            .imageType = VK_IMAGE_TYPE_2D,
+            .format = format,
+            .extent = {texture.getWidth(), texture.getHeight(), 1},
+            .mipLevels = mipCount,
+            .arrayLayers = 1,
+            .samples = VK_SAMPLE_COUNT_1_BIT,
+            .tiling = VK_IMAGE_TILING_OPTIMAL,
+            .usage = VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_SAMPLED_BIT,
+            .sharingMode = VK_SHARING_MODE_EXCLUSIVE,
+            .initialLayout = VK_IMAGE_LAYOUT_UNDEFINED
+    };
+
+    return_log_if(vkCreateImage(device, &imageCreateInfo, nullptr, &image) != VK_SUCCESS,
+                  "Cannot create texture image...", false)
+
+    VkMemoryRequirements memoryRequirements;
+    vkGetImageMemoryRequirements(device, image, &memoryRequirements);
+
+    uint32_t memoryType;
+    return_log_if(!tools::findMemoryType(physicalDevice, memoryRequirements.memoryTypeBits,
+                                         VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, memoryType),
+                  "No compatible memory type found for texture image...", false)
+
+    VkMemoryAllocateInfo memoryAllocateInfo{
+            .sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO,
+            .allocationSize = memoryRequirements.size,
+            .memoryTypeIndex = memoryType
+    };
+
+    return_log_if(vkAllocateMemory(device, &memoryAllocateInfo, nullptr, &imageMemory) != VK_SUCCESS,
+                  "Cannot allocate texture image memory...", false)
+
+    vkBindImageMemory(device, image, imageMemory, 0);
+
+    // Whole mip chain copied at once: levels (compressed or not) are already packed in the pixel array
+    if (!tools::createBuffer(device, physicalDevice, texture.pixels.size(), VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+                             VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+                             stagingBuffer, stagingMemory)) {
+        return false;
+    }
+
+    void *mappedMemory;
+    vkMapMemory(device, stagingMemory, 0, texture.pixels.size(), 0, &mappedMemory);
+    std::memcpy(mappedMemory, texture.pixels.data(), texture.pixels.size());
+    vkUnmapMemory(device, stagingMemory);
+
+    VkImageSubresourceRange subresourceRange{
+            .aspectMask = VK_IMAGE_ASPECT_COLOR_BIT,
+            .baseMipLevel = 0,
+            .levelCount = mipCount,
+            .baseArrayLayer = 0,
+            .layerCount = 1
+    };
+
+    VkImageMemoryBarrier transferBarrier{
+            .sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER,
+            .srcAccessMask = 0,
+            .dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT,
+            .oldLayout = VK_IMAGE_LAYOUT_UNDEFINED,
+            .newLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+            .srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+            .dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+            .image = image,
+            .subresourceRange = subresourceRange
+    };
+
+    vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, 0,
+                         0, nullptr, 0, nullptr, 1, &transferBarrier);
+
+    std::vector<VkBufferImageCopy> copyRegions;
+    copyRegions.reserve(mipCount);
+
+    for (uint32_t level = 0; const VIEMipLevel &mipLevel: texture.mipLevels) {
+        copyRegions.push_back({
+                .bufferOffset = mipLevel.offset,
+                .bufferRowLength = 0,
+                .bufferImageHeight = 0,
+                .imageSubresource = {VK_IMAGE_ASPECT_COLOR_BIT, level++, 0, 1},
+                .imageOffset = {0, 0, 0},
+                .imageExtent = {mipLevel.width, mipLevel.height, 1}
+        });
+    }
+
+    vkCmdCopyBufferToImage(commandBuffer, stagingBuffer, image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                           mipCount, copyRegions.data());
+
+    VkImageMemoryBarrier samplingBarrier{
+            .sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER,
+            .srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT,
+            .dstAccessMask = VK_ACCESS_SHADER_READ_BIT,
+            .oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+            .newLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+            .srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+            .dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+            .image = image,
+            .subresourceRange = subresourceRange
+    };
+
+    vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, 0,
+                         0, nullptr, 0, nullptr, 1, &samplingBarrier);
+
+    return true;
+}
+
+bool VIETextureImage::finishUpload(const VkDevice &device) {
+    vkDestroyBuffer(device, stagingBuffer, nullptr);
+    vkFreeMemory(device, stagingMemory, nullptr);
+    stagingBuffer = VK_NULL_HANDLE;
+    stagingMemory = VK_NULL_HANDLE;
+
+    VkImageViewCreateInfo imageViewCreateInfo{
+            .sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO,
+            .image = image,
+            .viewType = VK_IMAGE_VIEW_TYPE_2D,
+            .format = format,
+            .subresourceRange = {VK_IMAGE_ASPECT_COLOR_BIT, 0, mipCount, 0, 1}
+    };
+
+    return_log_if(vkCreateImageView(device, &imageViewCreateInfo, nullptr, &imageView) != VK_SUCCESS,
+                  "Cannot create texture image view...", false)
+
+    return true;
+}
+
+void VIETextureImage::destroy(const VkDevice &device) {
+    vkDestroyBuffer(device, stagingBuffer, nullptr);
+    vkFreeMemory(device, stagingMemory, nullptr);
+    vkDestroyImageView(device, imageView, nullptr);
+    vkDestroyImage(device, image, nullptr);
+    vkFreeMemory(device, imageMemory, nullptr);
+
+    stagingBuffer = VK_NULL_HANDLE;
+    stagingMemory = VK_NULL_HANDLE;
+    imageView = VK_NULL_HANDLE;
+    image = VK_NULL_HANDLE;
+    imageMemory = VK_NULL_HANDLE;
+}
@@ -2,17 +2,40 @@
  * MIT License
  */
 
+#include <span>
+#include <chrono>
 #include <ranges>
+#include <cstddef>
+#include <cstring>
+#include <fstream>
 #include "engine/VIEngine.hpp"
 #include "engine/VIESettings.hpp"
 #include "tools/VIETools.hpp"
+#include "tools/VIETrace.hpp"
+#include "tools/VIEJobSystem.hpp"
+#include "tools/VIEParallel.hpp"
+#include "tools/VIETextureLoader.hpp"
+
+VIEngine::VIEngine(VIESettings settings) : settings(std::move(settings)) {
+    if (!this->settings.traceLocation.empty()) {
+        tools::setTracingEnabled(true);
+        tools::setTraceThreadName("main");
+    }
+
+    // Jobs affine to the main thread (windowing, queues) are run by the thread owning the engine
+    tools::startJobSystem();
 
-VIEngine::VIEngine(VIESettings settings) : settings(std::move(settings)) {}
+    lastHostMemory = tools::getResidentMemory();
+}
 
 VIEngine::~VIEngine() {
     if (engineStatus != VIEStatus::UNINITIALISED) {
         cleanEngine();
     }
+
+    if (!settings.traceLocation.empty()) {
+        tools::writeTrace(settings.traceLocation);
+    }
 }
 
 void VIEngine::framebufferResizeCallback(GLFWwindow *window, int width, int height) {
@@ -20,104 +43,48 @@ void VIEngine::framebufferResizeCallback(GLFWwindow *window, int width, int heig
     engine->isFramebufferResized = true;
 }
 
-bool VIEngine::generateRendererCore() {
-    vkGetPhysicalDeviceSurfaceCapabilitiesKHR(vkPhysicalDevice, surface, &surfaceCapabilities);
-
-    /// -- Swap chain --
-    // Selecting surface format (channels and color space)
-    return_log_if(!tools::selectSurfaceFormat(surfaceAvailableFormats, settings.kDefaultFormat,
-                                              settings.kDefaultColorSpace, chosenSurfaceFormat),
-                  "No compatible surface format found for main physical device...", false)
-
-    // Selecting presentation mode by a swap chain (describing how and when images are represented on screen)
-    chosenSurfacePresentationMode = tools::selectSurfacePresentation(surfacePresentationModes,
-                                                                     settings.preferredPresentMode);
+void VIEngine::mouseButtonCallback(GLFWwindow *window, int button, int action, int mods) {
+    auto engine = static_cast<VIEngine*>(glfwGetWindowUserPointer(window));
+    const VIECamera *camera = engine->scene.getScreenCamera();
 
-    // Selecting swap extent (resolution of the swap chain images in pixels)
-    if (surfaceCapabilities.currentExtent.width != kUint32Max) {
-        chosenSwapExtent = surfaceCapabilities.currentExtent;
-        std::cout << fmt::format("W: {}, H: {}", chosenSwapExtent.width, chosenSwapExtent.height) << std::endl;
-    } else {
-        int width;
-        int height;
-        glfwGetFramebufferSize(glfwWindow, &width, &height);
-        std::cout << fmt::format("W: {}, H: {}", width, height) << std::endl;
+    int width = 0;
+    int height = 0;
+    glfwGetWindowSize(window, &width, &height);
 
-        chosenSwapExtent = VkExtent2D{
-                .width = std::clamp(static_cast<uint32_t>(width), surfaceCapabilities.minImageExtent.width,
-                                    surfaceCapabilities.maxImageExtent.width),
-                .height = std::clamp(static_cast<uint32_t>(height), surfaceCapabilities.minImageExtent.height,
-                                     surfaceCapabilities.maxImageExtent.height)
-        };
+    if (button != GLFW_MOUSE_BUTTON_LEFT || action != GLFW_PRESS || !camera || width == 0 || height == 0) {
+        return;
     }
 
-    // Setting the number of images that the swap chain needs to create, depending on a necessary minimum and maximum
-    uint32_t swapChainImagesCount = std::min(surfaceCapabilities.minImageCount + 1, surfaceCapabilities.maxImageCount);
-
-    // Choosing frame handling mode by swap chain
-    std::array<uint32_t, 2> queueIndices({selectedQueueFamily, selectedPresentFamily});
-
-    // VIESettings how swap chain will be created
-    VkSwapchainCreateInfoKHR swapChainCreationInfo{
-            .sType = VK_STRUCTURE_TYPE_SWAPCHAIN_CREATE_INFO_KHR,
-            .surface = surface,
-            .minImageCount = swapChainImagesCount,
-            .imageFormat = chosenSurfaceFormat.format,
-            .imageColorSpace = chosenSurfaceFormat.colorSpace,
-            .imageExtent = chosenSwapExtent,
-            .imageArrayLayers = 1,
-            .imageUsage = VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT,
-            .imageSharingMode = (selectedQueueFamily != selectedPresentFamily) ? VK_SHARING_MODE_CONCURRENT
-                                                                               : VK_SHARING_MODE_EXCLUSIVE,
-            .queueFamilyIndexCount = (selectedQueueFamily != selectedPresentFamily) ? 2u : 0u,
-            .pQueueFamilyIndices = (selectedQueueFamily != selectedPresentFamily) ? queueIndices.data() : nullptr,
-            .preTransform = surfaceCapabilities.currentTransform,
-            .compositeAlpha = VK_COMPOSITE_ALPHA_OPAQUE_BIT_KHR,
-            .presentMode = chosenSurfacePresentationMode,
-            .clipped = VK_TRUE,
-            .oldSwapchain = VK_NULL_HANDLE
-    };
-
-    return_log_if(vkCreateSwapchainKHR(vkDevice, &swapChainCreationInfo, nullptr, &swapChain) != VK_SUCCESS,
-                  "Cannot create swap chain for main device!", false)
+    double cursorX = 0.0;
+    double cursorY = 0.0;
+    glfwGetCursorPos(window, &cursorX, &cursorY);
 
-    tools::gatherVkData(vkGetSwapchainImagesKHR, swapChainImages, swapChainImagesCount, vkDevice, swapChain);
+    // Cursor in clip space (Y points down as in the window), from the near plane (depth 1) to the far one (depth 0)
+    const auto clipX = static_cast<float>(2.0 * cursorX / width - 1.0);
+    const auto clipY = static_cast<float>(2.0 * cursorY / height - 1.0);
+    const glm::mat4x4 inverseViewProjection(glm::inverse(camera->getViewProjection()));
+    const glm::vec4 nearPoint(inverseViewProjection * glm::vec4(clipX, clipY, 1.0f, 1.0f));
+    const glm::vec4 farPoint(inverseViewProjection * glm::vec4(clipX, clipY, 0.0f, 1.0f));
 
-    engineStatus = VIEStatus::VULKAN_SWAP_CHAIN_CREATED;
+    const glm::vec3 origin(nearPoint / nearPoint.w);
+    const glm::vec3 direction(glm::vec3(farPoint / farPoint.w) - origin);
 
-    /// -- Image views --
-    swapChainImageViews.resize(swapChainImages.size());
-
-    for (size_t i = 0; VkImageView &imageView: swapChainImageViews) {
-        VkImageViewCreateInfo imageViewCreationInfo{
-                .sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO,
-                .image = swapChainImages.at(i),
-                .viewType = VK_IMAGE_VIEW_TYPE_2D,
-                .format = chosenSurfaceFormat.format,
-                .components = VkComponentMapping{
-                        .r = VK_COMPONENT_SWIZZLE_IDENTITY,
-                        .g = VK_COMPONENT_SWIZZLE_IDENTITY,
-                        .b = VK_COMPONENT_SWIZZLE_IDENTITY,
-                        .a = VK_COMPONENT_SWIZZLE_IDENTITY
-                },
-                .subresourceRange = VkImageSubresourceRange{
-                        .aspectMask = VK_IMAGE_ASPECT_COLOR_BIT,
-                        .baseMipLevel = 0,
-                        .levelCount = 1,
-                        .baseArrayLayer = 0,
-                        .layerCount = 1
-                }
-        };
+    // The ray spans the whole frustum depth, so distances are fractions of it
+    float distance = 1.0f;
+    uint32_t instance = kUint32Max;
 
-        return_log_if(vkCreateImageView(vkDevice, &imageViewCreationInfo, nullptr, &imageView) != VK_SUCCESS,
-                      fmt::format("Cannot generate image view {}.", i), false)
-
-        ++i;
+    if (engine->scene.pickInstance(origin, direction, distance, instance)) {
+        log_info("Picked instance {} at distance {:.2f}", instance, distance * glm::length(direction));
     }
 
-    engineStatus = VIEStatus::VULKAN_IMAGE_VIEWS_CREATED;
+    engine->pickedInstance = instance;
+}
+
+bool VIEngine::createPipelines(const VkExtent2D &renderExtent) {
+    VIE_TRACE_ZONE("createPipelines");
 
     /// -- Render passes --
+    // Attachments are transitioned (and synchronised with other passes) by the render graph
     VkAttachmentDescription colorAttachment{
             .format = chosenSurfaceFormat.format,
             .samples = VK_SAMPLE_COUNT_1_BIT,
@@ -125,15 +92,51 @@ bool VIEngine::generateRendererCore() {
             .storeOp = VK_ATTACHMENT_STORE_OP_STORE,
             .stencilLoadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE,
             .stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE,
-            .initialLayout = VK_IMAGE_LAYOUT_UNDEFINED,
-            .finalLayout = VK_IMAGE_LAYOUT_PRESENT_SRC_KHR
+            .initialLayout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL,
+            .finalLayout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL
+    };
+
+    if (depthFormat == VK_FORMAT_UNDEFINED) {
+        return_log_if(!tools::selectDepthFormat(vkPhysicalDevice, depthFormat), "No depth format supported...", false)
+    }
+
+    // Depth is only kept after the pass if the depth pyramid reads it
+    VkAttachmentDescription depthAttachment{
+            .format = depthFormat,
+            .samples = VK_SAMPLE_COUNT_1_BIT,
+            .loadOp = VK_ATTACHMENT_LOAD_OP_CLEAR,
+            .storeOp = settings.isDepthPyramidEnabled ? VK_ATTACHMENT_STORE_OP_STORE
+                                                      : VK_ATTACHMENT_STORE_OP_DONT_CARE,
+            .stencilLoadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE,
+            .stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE,
+            .initialLayout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL,
+            .finalLayout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL
     };
 
+    std::array<VkAttachmentDescription, 2> attachments{colorAttachment, depthAttachment};
+
     VkAttachmentReference colorAttachmentReference{
             .attachment = 0,
             .layout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL
     };
 
+    VkAttachmentReference depthAttachmentReference{
+            .attachment = 1,
+            .layout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL
+    };
+
+    // After the prepass, the main subpass only tests depth
+    VkAttachmentReference depthReadOnlyReference{
+            .attachment = 1,
+            .layout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL
+    };
+
+    VkSubpassDescription prepassDescription{
+            .pipelineBindPoint = VK_PIPELINE_BIND_POINT_GRAPHICS,
+            .colorAttachmentCount = 0,
+            .pDepthStencilAttachment = &depthAttachmentReference
+    };
+
     VkSubpassDescription subpassDescription{
             .pipelineBindPoint = VK_PIPELINE_BIND_POINT_GRAPHICS,
             // .inputAttachmentCount = 0,
@@ -141,40 +144,69 @@ bool VIEngine::generateRendererCore() {
             .colorAttachmentCount = 1,
             .pColorAttachments = &colorAttachmentReference,
             // .pResolveAttachments = nullptr,
-            // .pDepthStencilAttachment = nullptr,
+            .pDepthStencilAttachment = settings.isDepthPrepassEnabled ? &depthReadOnlyReference
+                                                                      : &depthAttachmentReference,
             // .preserveAttachmentCount = 0,
             // .pPreserveAttachments = nullptr
     };
 
-    VkSubpassDependency dependency{
-            .srcSubpass = VK_SUBPASS_EXTERNAL,
-            .dstSubpass = 0,
-            .srcStageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT,
-            .dstStageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT,
-            .srcAccessMask = 0,
-            .dstAccessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT,
+    std::vector<VkSubpassDescription> subpasses;
+    if (settings.isDepthPrepassEnabled) {
+        subpasses.push_back(prepassDescription);
+    }
+    subpasses.push_back(subpassDescription);
+
+    const auto mainSubpass = static_cast<uint32_t>(subpasses.size() - 1);
+
+    std::vector<VkSubpassDependency> dependencies;
+
+    if (settings.isDepthPrepassEnabled) {
+        // Depth of the prepass is complete before the main subpass tests against it
+        dependencies.push_back(VkSubpassDependency{
+                .srcSubpass = 0,
+                .dstSubpass = mainSubpass,
+                .srcStageMask = VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT,
+                .dstStageMask = VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT,
+                .srcAccessMask = VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT,
+                .dstAccessMask = VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_READ_BIT,
+                .dependencyFlags = VK_DEPENDENCY_BY_REGION_BIT
+        });
+    }
+
+    // Each view of a subpass is broadcast to its own layer, and views are rendered concurrently where possible
+    const uint32_t viewMask = (1u << VIEViewData::kMaxViews) - 1;
+    std::vector<uint32_t> viewMasks(subpasses.size(), viewMask);
+
+    VkRenderPassMultiviewCreateInfo multiviewCreateInfo{
+            .sType = VK_STRUCTURE_TYPE_RENDER_PASS_MULTIVIEW_CREATE_INFO,
+            .subpassCount = static_cast<uint32_t>(viewMasks.size()),
+            .pViewMasks = viewMasks.data(),
+            .correlationMaskCount = 1,
+            .pCorrelationMasks = &viewMask
     };
 
     VkRenderPassCreateInfo renderPassCreateInfo{
             .sType = VK_STRUCTURE_TYPE_RENDER_PASS_CREATE_INFO,
-            .attachmentCount = 1,
-            .pAttachments = &colorAttachment,
-            .subpassCount = 1,
-            .pSubpasses = &subpassDescription,
-            .dependencyCount = 1,
-            .pDependencies = &dependency
+            .pNext = settings.isStereoEnabled ? &multiviewCreateInfo : nullptr,
+            .attachmentCount = static_cast<uint32_t>(attachments.size()),
+            .pAttachments = attachments.data(),
+            .subpassCount = static_cast<uint32_t>(subpasses.size()),
+            .pSubpasses = subpasses.data(),
+            .dependencyCount = static_cast<uint32_t>(dependencies.size()),
+            .pDependencies = dependencies.data()
     };
 
     return_log_if(vkCreateRenderPass(vkDevice, &renderPassCreateInfo, nullptr, &renderPass) != VK_SUCCESS,
                   "Failed to create render pass...", false)
 
-    engineStatus = VIEStatus::VULKAN_RENDER_PASSES_GENERATED;
-
     /// -- Pipeline functions --
+    // Set 0: per-frame data (dynamic offsets), set 1: bindless scene resources
+    std::array<VkDescriptorSetLayout, 2> setLayouts{frameSetLayout, bindlessResources.getSetLayout()};
+
     VkPipelineLayoutCreateInfo pipelineLayoutCreateInfo{
             .sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO,
-            .setLayoutCount = 0,
-            .pSetLayouts = nullptr,
+            .setLayoutCount = static_cast<uint32_t>(setLayouts.size()),
+            .pSetLayouts = setLayouts.data(),
             .pushConstantRangeCount = 0,
             .pPushConstantRanges = nullptr
     };
@@ -183,8 +215,6 @@ bool VIEngine::generateRendererCore() {
             vkCreatePipelineLayout(vkDevice, &pipelineLayoutCreateInfo, nullptr, &pipelineLayout) != VK_SUCCESS,
             "Failed to create pipeline layout...", false)
 
-    engineStatus = VIEStatus::VULKAN_PIPELINE_STATES_PREPARED;
-
     /// -- Graphics pipeline --
     // Shader creation info for stage/pipeline definition (vertex) (phase 2)
     // TODO move into shader and define a config file in order to tell "pName" if necessary
@@ -210,13 +240,30 @@ bool VIEngine::generateRendererCore() {
             fragmentShaderStageCreationInfo
     };
 
+    // Instance data is read from the object storage buffer through gl_InstanceIndex
+    std::array<VkVertexInputBindingDescription, 1> vertexBindings{
+            VkVertexInputBindingDescription{
+                    .binding = 0,
+                    .stride = sizeof(VIEVertex),
+                    .inputRate = VK_VERTEX_INPUT_RATE_VERTEX
+            }
+    };
+
+    std::array<VkVertexInputAttributeDescription, 5> vertexAttributes{
+            VkVertexInputAttributeDescription{0, 0, VK_FORMAT_R32G32B32_SFLOAT, offsetof(VIEVertex, pos)},
+            VkVertexInputAttributeDescription{1, 0, VK_FORMAT_R32G32B32_SFLOAT, offsetof(VIEVertex, normal)},
+            VkVertexInputAttributeDescription{2, 0, VK_FORMAT_R32G32_SFLOAT, offsetof(VIEVertex, uvCoords)},
+            VkVertexInputAttributeDescription{3, 0, VK_FORMAT_R32G32B32_SFLOAT, offsetof(VIEVertex, tangent)},
+            VkVertexInputAttributeDescription{4, 0, VK_FORMAT_R32G32B32_SFLOAT, offsetof(VIEVertex, bitangent)}
+    };
+
     // Shader creation info for rendering phase 0: vertex data handling
     VkPipelineVertexInputStateCreateInfo vertexShaderInputStageCreationInfo{
             .sType = VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO,
-            .vertexBindingDescriptionCount = 0,
-            .pVertexBindingDescriptions = nullptr,
-            .vertexAttributeDescriptionCount = 0,
-            .pVertexAttributeDescriptions = nullptr
+            .vertexBindingDescriptionCount = static_cast<uint32_t>(vertexBindings.size()),
+            .pVertexBindingDescriptions = vertexBindings.data(),
+            .vertexAttributeDescriptionCount = static_cast<uint32_t>(vertexAttributes.size()),
+            .pVertexAttributeDescriptions = vertexAttributes.data()
     };
 
     // Shader creation info for rendering phase 1: input assembly
@@ -226,17 +273,17 @@ bool VIEngine::generateRendererCore() {
             .primitiveRestartEnable = VK_FALSE
     };
 
-    // Setting viewport size wrt framebuffers/swap chain
+    // Setting viewport size wrt framebuffers/swap chain (or eye resolution)
     VkViewport viewport{
             .x = 0,
             .y = 0,
-            .width = static_cast<float>(chosenSwapExtent.width),
-            .height = static_cast<float>(chosenSwapExtent.height),
+            .width = static_cast<float>(renderExtent.width),
+            .height = static_cast<float>(renderExtent.height),
             .minDepth = 0.0f,
             .maxDepth = 1.0f
     };
 
-    VkRect2D scissorRectangle{.offset = {0, 0}, .extent = chosenSwapExtent};
+    VkRect2D scissorRectangle{.offset = {0, 0}, .extent = renderExtent};
 
     // Shader viewport creation info
     VkPipelineViewportStateCreateInfo viewportStateCreateInfo{
@@ -247,16 +294,15 @@ bool VIEngine::generateRendererCore() {
             .pScissors = &scissorRectangle
     };
 
-    // TODO enable for shadow mapping, requires a GPU feature to check in function-like "enableShadowMapping" (maybe presets for each module and submodule)
-    // Shader creation info for rendering phase 5: rasterization
-    // TODO CW or CCW?
+    // Shader creation info for rendering phase 5: rasterization (depth bias is only used by the shadow pipeline)
+    // OBJ faces are counter-clockwise, and stay so with the Y flip in the camera projection
     VkPipelineRasterizationStateCreateInfo rasterizationCreationInfo{
             .sType = VK_STRUCTURE_TYPE_PIPELINE_RASTERIZATION_STATE_CREATE_INFO,
             .depthClampEnable = VK_FALSE,
             .rasterizerDiscardEnable = VK_FALSE,
             .polygonMode = VK_POLYGON_MODE_FILL,
-            .cullMode = VK_CULL_MODE_BACK_BIT,      // FRONT for Shadow Mapping
-            .frontFace = VK_FRONT_FACE_CLOCKWISE,
+            .cullMode = VK_CULL_MODE_BACK_BIT,
+            .frontFace = VK_FRONT_FACE_COUNTER_CLOCKWISE,
             .depthBiasEnable = VK_FALSE,
             .depthBiasConstantFactor = 0.0f,
             .depthBiasClamp = 0.0f,
@@ -276,11 +322,21 @@ bool VIEngine::generateRendererCore() {
             .alphaToCoverageEnable = VK_FALSE,
             .alphaToOneEnable = VK_FALSE
     };
-
-    // TODO implement DEPTH STENCIL TEST
-    // VkPipelineDepthStencilStateCreateInfo
      */
 
+    // Reversed depth: nearer fragments have greater depth. After the prepass, depth is already resolved, so only the
+    // visible fragment of each pixel is shaded
+    VkPipelineDepthStencilStateCreateInfo depthStencilCreateInfo{
+            .sType = VK_STRUCTURE_TYPE_PIPELINE_DEPTH_STENCIL_STATE_CREATE_INFO,
+            .depthTestEnable = VK_TRUE,
+            .depthWriteEnable = settings.isDepthPrepassEnabled ? VK_FALSE : VK_TRUE,
+            .depthCompareOp = settings.isDepthPrepassEnabled ? VK_COMPARE_OP_EQUAL : VK_COMPARE_OP_GREATER,
+            .depthBoundsTestEnable = VK_FALSE,
+            .stencilTestEnable = VK_FALSE,
+            .minDepthBounds = 0.0f,
+            .maxDepthBounds = 1.0f
+    };
+
     // https://vulkan-tutorial.com/Drawing_a_triangle/Graphics_pipeline_basics/Fixed_functions
     VkPipelineColorBlendAttachmentState colorBlendAttachmentState{
             .blendEnable = VK_FALSE,
@@ -323,13 +379,13 @@ bool VIEngine::generateRendererCore() {
             .pRasterizationState = &rasterizationCreationInfo,
             .pMultisampleState = nullptr,
             // .pMultisampleState = &multisamplingCreationInfo,
-            .pDepthStencilState = nullptr,
+            .pDepthStencilState = &depthStencilCreateInfo,
             .pColorBlendState = &colorBlendStateCreateInfo,
             .pDynamicState = nullptr,   // TODO check why dynamicStateCreateInfo doesn't work (black screen)
             //.pDynamicState = &dynamicStateCreateInfo,
             .layout = pipelineLayout,
             .renderPass = renderPass,
-            .subpass = 0,
+            .subpass = mainSubpass,
             .basePipelineHandle = VK_NULL_HANDLE,
             .basePipelineIndex = -1
     };
@@ -338,33 +394,251 @@ bool VIEngine::generateRendererCore() {
                                             &graphicsPipeline) != VK_SUCCESS,
                   "Failed to create graphics pipeline...", false)
 
-    engineStatus = VIEStatus::VULKAN_GRAPHICS_PIPELINE_GENERATED;
+    if (settings.isDepthPrepassEnabled) {
+        // Depth only: positions are read from their own tightly packed stream, and there is no fragment shader
+        VkPipelineShaderStageCreateInfo depthShaderStageCreationInfo{
+                .sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO,
+                .stage = VK_SHADER_STAGE_VERTEX_BIT,
+                .module = depthVertexModule,
+                .pName = "main"
+        };
+
+        VkVertexInputBindingDescription positionBinding{
+                .binding = 0,
+                .stride = sizeof(glm::vec3),
+                .inputRate = VK_VERTEX_INPUT_RATE_VERTEX
+        };
+
+        VkVertexInputAttributeDescription positionAttribute{0, 0, VK_FORMAT_R32G32B32_SFLOAT, 0};
+
+        VkPipelineVertexInputStateCreateInfo positionInputCreationInfo{
+                .sType = VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO,
+                .vertexBindingDescriptionCount = 1,
+                .pVertexBindingDescriptions = &positionBinding,
+                .vertexAttributeDescriptionCount = 1,
+                .pVertexAttributeDescriptions = &positionAttribute
+        };
+
+        VkPipelineDepthStencilStateCreateInfo prepassDepthStencilCreateInfo(depthStencilCreateInfo);
+        prepassDepthStencilCreateInfo.depthWriteEnable = VK_TRUE;
+        prepassDepthStencilCreateInfo.depthCompareOp = VK_COMPARE_OP_GREATER;
+
+        VkGraphicsPipelineCreateInfo depthPipelineCreateInfo(pipelineCreateInfo);
+        depthPipelineCreateInfo.stageCount = 1;
+        depthPipelineCreateInfo.pStages = &depthShaderStageCreationInfo;
+        depthPipelineCreateInfo.pVertexInputState = &positionInputCreationInfo;
+        depthPipelineCreateInfo.pDepthStencilState = &prepassDepthStencilCreateInfo;
+        depthPipelineCreateInfo.pColorBlendState = nullptr;
+        depthPipelineCreateInfo.subpass = 0;
+
+        return_log_if(vkCreateGraphicsPipelines(vkDevice, VK_NULL_HANDLE, 1, &depthPipelineCreateInfo, nullptr,
+                                                &depthPipeline) != VK_SUCCESS,
+                      "Failed to create depth prepass pipeline...", false)
+    }
+
+    return true;
+}
+
+bool VIEngine::generateRendererCore() {
+    VIE_TRACE_ZONE("generateRendererCore");
+
+    vkGetPhysicalDeviceSurfaceCapabilitiesKHR(vkPhysicalDevice, surface, &surfaceCapabilities);
+
+    /// -- Swap chain --
+    // Selecting surface format (channels and color space)
+    return_log_if(!tools::selectSurfaceFormat(surfaceAvailableFormats, settings.kDefaultFormat,
+                                              settings.kDefaultColorSpace, chosenSurfaceFormat),
+                  "No compatible surface format found for main physical device...", false)
+
+    // Selecting presentation mode by a swap chain (describing how and when images are represented on screen)
+    chosenSurfacePresentationMode = tools::selectSurfacePresentation(surfacePresentationModes,
+                                                                     settings.preferredPresentMode);
+
+    // Selecting swap extent (resolution of the swap chain images in pixels)
+    if (surfaceCapabilities.currentExtent.width != kUint32Max) {
+        chosenSwapExtent = surfaceCapabilities.currentExtent;
+        log_verbose("W: {}, H: {}", chosenSwapExtent.width, chosenSwapExtent.height);
+    } else {
+        int width;
+        int height;
+        glfwGetFramebufferSize(glfwWindow, &width, &height);
+        log_verbose("W: {}, H: {}", width, height);
+
+        chosenSwapExtent = VkExtent2D{
+                .width = std::clamp(static_cast<uint32_t>(width), surfaceCapabilities.minImageExtent.width,
+                                    surfaceCapabilities.maxImageExtent.width),
+                .height = std::clamp(static_cast<uint32_t>(height), surfaceCapabilities.minImageExtent.height,
+                                     surfaceCapabilities.maxImageExtent.height)
+        };
+    }
+
+    if (VIECamera *camera = scene.getScreenCamera()) {
+        camera->updateProjection(static_cast<float>(chosenSwapExtent.width) /
+                                 static_cast<float>(chosenSwapExtent.height));
+    }
+
+    // Eyes are rendered with their own resolution, then scaled to the two halves of the swap chain images
+    const VkExtent2D renderExtent(getRenderExtent());
+
+    return_log_if(settings.isStereoEnabled &&
+                  !(surfaceCapabilities.supportedUsageFlags & VK_IMAGE_USAGE_TRANSFER_DST_BIT),
+                  "Surface does not support copying the stereo target...", false)
+
+    // Render pass and pipelines only depend on formats and extents, a worker creates them along with the swap chain
+    VIEJobCounter pipelineJob;
+    bool arePipelinesCreated = false;
+    tools::runJob([this, renderExtent, &arePipelinesCreated]() {
+        arePipelinesCreated = createPipelines(renderExtent);
+    }, &pipelineJob);
+
+    auto createSwapChain([&]() {
+        VIE_TRACE_ZONE("createSwapChain");
+
+        // Setting the number of images that the swap chain needs to create, depending on a necessary minimum and
+        // maximum
+        uint32_t swapChainImagesCount = std::min(surfaceCapabilities.minImageCount + 1,
+                                                 surfaceCapabilities.maxImageCount);
+
+        // Choosing frame handling mode by swap chain
+        std::array<uint32_t, 2> queueIndices({selectedQueueFamily, selectedPresentFamily});
+
+        // VIESettings how swap chain will be created
+        VkSwapchainCreateInfoKHR swapChainCreationInfo{
+                .sType = VK_STRUCTURE_TYPE_SWAPCHAIN_CREATE_INFO_KHR,
+                .surface = surface,
+                .minImageCount = swapChainImagesCount,
+                .imageFormat = chosenSurfaceFormat.format,
+                .imageColorSpace = chosenSurfaceFormat.colorSpace,
+                .imageExtent = chosenSwapExtent,
+                .imageArrayLayers = 1,
+                .imageUsage = VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT |
+                              (settings.isStereoEnabled ? VK_IMAGE_USAGE_TRANSFER_DST_BIT : 0u),
+                .imageSharingMode = (selectedQueueFamily != selectedPresentFamily) ? VK_SHARING_MODE_CONCURRENT
+                                                                                   : VK_SHARING_MODE_EXCLUSIVE,
+                .queueFamilyIndexCount = (selectedQueueFamily != selectedPresentFamily) ? 2u : 0u,
+                .pQueueFamilyIndices = (selectedQueueFamily != selectedPresentFamily) ? queueIndices.data()
+                                                                                      : nullptr,
+                .preTransform = surfaceCapabilities.currentTransform,
+                .compositeAlpha = VK_COMPOSITE_ALPHA_OPAQUE_BIT_KHR,
+                .presentMode = chosenSurfacePresentationMode,
+                .clipped = VK_TRUE,
+                .oldSwapchain = VK_NULL_HANDLE
+        };
+
+        return_log_if(vkCreateSwapchainKHR(vkDevice, &swapChainCreationInfo, nullptr, &swapChain) != VK_SUCCESS,
+                      "Cannot create swap chain for main device!", false)
+
+        tools::gatherVkData(vkGetSwapchainImagesKHR, swapChainImages, swapChainImagesCount, vkDevice, swapChain);
+
+        setStatus(VIEStatus::VULKAN_SWAP_CHAIN_CREATED, "createSwapChain");
+
+        /// -- Image views --
+        swapChainImageViews.resize(swapChainImages.size());
+
+        for (size_t i = 0; VkImageView &imageView: swapChainImageViews) {
+            VkImageViewCreateInfo imageViewCreationInfo{
+                    .sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO,
+                    .image = swapChainImages.at(i),
+                    .viewType = VK_IMAGE_VIEW_TYPE_2D,
+                    .format = chosenSurfaceFormat.format,
+                    .components = VkComponentMapping{
+                            .r = VK_COMPONENT_SWIZZLE_IDENTITY,
+                            .g = VK_COMPONENT_SWIZZLE_IDENTITY,
+                            .b = VK_COMPONENT_SWIZZLE_IDENTITY,
+                            .a = VK_COMPONENT_SWIZZLE_IDENTITY
+                    },
+                    .subresourceRange = VkImageSubresourceRange{
+                            .aspectMask = VK_IMAGE_ASPECT_COLOR_BIT,
+                            .baseMipLevel = 0,
+                            .levelCount = 1,
+                            .baseArrayLayer = 0,
+                            .layerCount = 1
+                    }
+            };
+
+            return_log_if(vkCreateImageView(vkDevice, &imageViewCreationInfo, nullptr, &imageView) != VK_SUCCESS,
+                          fmt::format("Cannot generate image view {}.", i), false)
+
+            ++i;
+        }
+
+        return true;
+    });
+
+    const bool isSwapChainCreated = createSwapChain();
+    tools::waitForCounter(pipelineJob);
+
+    return_log_if(!isSwapChainCreated, "Cannot create swap chain...", false)
+    setStatus(VIEStatus::VULKAN_IMAGE_VIEWS_CREATED, "createImageViews");
+
+    return_log_if(!arePipelinesCreated, "Cannot create pipelines...", false)
+    setStatus(VIEStatus::VULKAN_GRAPHICS_PIPELINE_GENERATED, "createPipelines");
 
     /// -- Framebuffers --
+    // The depth buffer (with a layer for each view) is a transient of the render graph, created when it is compiled
+    declareRenderGraph(0, FrameOffsets{});
+    return_log_if(!renderGraph.compile(vkDevice, vkPhysicalDevice), "Cannot compile render graph...", false)
+
+    const VkImageView depthView(renderGraph.getImageView(depthResource));
+
+    if (settings.isStereoEnabled) {
+        return_log_if(!stereoTarget.create(vkDevice, vkPhysicalDevice, renderExtent, VIEViewData::kMaxViews,
+                                           chosenSurfaceFormat.format,
+                                           VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT,
+                                           VK_IMAGE_ASPECT_COLOR_BIT),
+                      "Cannot create stereo target...", false)
+
+        std::array<VkImageView, 2> stereoViews{stereoTarget.getImageView(), depthView};
+
+        // Multiview framebuffers have a single layer, views select the layers of the attachments
+        VkFramebufferCreateInfo framebufferCreateInfo{
+                .sType = VK_STRUCTURE_TYPE_FRAMEBUFFER_CREATE_INFO,
+                .renderPass = renderPass,
+                .attachmentCount = static_cast<uint32_t>(stereoViews.size()),
+                .pAttachments = stereoViews.data(),
+                .width = renderExtent.width,
+                .height = renderExtent.height,
+                .layers = 1
+        };
+
+        return_log_if(vkCreateFramebuffer(vkDevice, &framebufferCreateInfo, nullptr, &stereoFramebuffer) !=
+                      VK_SUCCESS, "Cannot create stereo framebuffer", false)
+    }
+
     // Framebuffers linked to swap chains and image views
-    swapChainFramebuffers.resize(swapChainImageViews.size());
+    swapChainFramebuffers.resize(settings.isStereoEnabled ? 0 : swapChainImageViews.size());
+
+    for (size_t i = 0; VkFramebuffer &framebuffer: swapChainFramebuffers) {
+        std::array<VkImageView, 2> framebufferViews{swapChainImageViews.at(i), depthView};
 
-    for (size_t i = 0; const VkImageView &attachment: swapChainImageViews) {
         VkFramebufferCreateInfo framebufferCreateInfo{
                 .sType = VK_STRUCTURE_TYPE_FRAMEBUFFER_CREATE_INFO,
                 .renderPass = renderPass,
-                .attachmentCount = 1,
-                .pAttachments = &attachment,
+                .attachmentCount = static_cast<uint32_t>(framebufferViews.size()),
+                .pAttachments = framebufferViews.data(),
                 .width = chosenSwapExtent.width,
                 .height = chosenSwapExtent.height,
                 .layers = 1
         };
 
-        return_log_if(vkCreateFramebuffer(vkDevice, &framebufferCreateInfo, nullptr, &swapChainFramebuffers.at(i)) !=
-                      VK_SUCCESS, fmt::format("Cannot create framebuffer {}", i), false)
+        return_log_if(vkCreateFramebuffer(vkDevice, &framebufferCreateInfo, nullptr, &framebuffer) != VK_SUCCESS,
+                      fmt::format("Cannot create framebuffer {}", i), false)
 
         ++i;
     }
 
-    engineStatus = VIEStatus::VULKAN_FRAMEBUFFERS_CREATED;
+    if (settings.isDepthPyramidEnabled) {
+        return_log_if(!depthPyramid.create(vkDevice, vkPhysicalDevice, commandPool, graphicsQueue,
+                                           renderGraph.getImage(depthResource), depthFormat, renderExtent,
+                                           depthPyramidModule),
+                      "Cannot create depth pyramid...", false)
+    }
+
+    setStatus(VIEStatus::VULKAN_FRAMEBUFFERS_CREATED, "createFramebuffers");
 
     /// -- Command buffers --
-    commandBuffers.resize(swapChainFramebuffers.size());
+    // One for each frame in flight, recorded again every frame with the offsets of its per-frame data
+    commandBuffers.resize(settings.kMaxFramesInFlight);
 
     VkCommandBufferAllocateInfo commandBufferAllocateInfo{
             .sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO,
@@ -377,44 +651,418 @@ bool VIEngine::generateRendererCore() {
             vkAllocateCommandBuffers(vkDevice, &commandBufferAllocateInfo, commandBuffers.data()) != VK_SUCCESS,
             "Cannot create command buffers...", false)
 
-    engineStatus = VIEStatus::VULKAN_COMMAND_BUFFERS_PREPARED;
+    setStatus(VIEStatus::VULKAN_COMMAND_BUFFERS_PREPARED, "createCommandBuffers");
 
-    // TODO integrate custom render pass and draw commands so that others could implement their shaders and related commands
-    //  maybe to split in separate function in order to implement one or more lambdas
-    for (size_t i = 0; const VkCommandBuffer &buffer: commandBuffers) {
-        VkCommandBufferBeginInfo commandBufferBeginInfo{
-                .sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO,
-                .pInheritanceInfo = nullptr
-        };
+    return true;
+}
+
+bool VIEngine::writeFrameData(FrameOffsets &frameOffsets) {
+    VIE_TRACE_ZONE("writeFrameData");
+
+    VIECamera *camera = scene.getScreenCamera();
+    VIEViewData viewData{};
+
+    // Moved instances are gathered again, and become dynamic shadow casters
+    if (scene.hasDirtyTransforms()) {
+        scene.updateInstances();
+    }
+
+    if (settings.isStereoEnabled && camera) {
+        const VkExtent2D renderExtent(getRenderExtent());
+        scene.updateEyeCameras(settings.interpupillaryDistance,
+                               static_cast<float>(renderExtent.width) / static_cast<float>(renderExtent.height));
+
+        viewData.cameras = {scene.getLeftEyeCamera()->getData(), scene.getRightEyeCamera()->getData()};
+    } else if (camera) {
+        viewData.cameras.fill(camera->getData());
+    }
+
+    // Instances outside the views are culled, the others are grouped by level of detail, so matrices and draws are
+    // rebuilt every frame. Eyes share the selection (and the draws) of the screen camera, which is between them
+    std::vector<VIEFrustum> frusta;
+    if (settings.isStereoEnabled && camera) {
+        frusta = {scene.getLeftEyeCamera()->getFrustum(), scene.getRightEyeCamera()->getFrustum()};
+    } else if (camera) {
+        frusta = {camera->getFrustum()};
+    }
+
+    scene.updateLods(camera ? *camera : VIECamera{}, static_cast<float>(getRenderExtent().height),
+                     settings.lodErrorThreshold, frusta);
+
+    // Levels selected but not resident are requested, and drawn with the nearest resident one meanwhile
+    const bool isGeometryStreamed = settings.isGeometryStreamingEnabled && vertexBuffer != VK_NULL_HANDLE;
+    if (isGeometryStreamed) {
+        geometryStreamer.update(scene, currentFrame);
+    }
+
+    // Cascades follow the screen camera also in stereo, as both eyes are within their bounds
+    const VkExtent2D renderExtent(getRenderExtent());
+    shadowMaps.update(camera ? *camera : VIECamera{},
+                      static_cast<float>(renderExtent.width) / static_cast<float>(renderExtent.height),
+                      scene.getLightDirection(), settings.shadowDistance, settings.shadowSplitLambda,
+                      settings.shadowCasterDistance, scene.getStaticCasterVersion(),
+                      scene.getDynamicInstanceCount() > 0, viewData.shadows);
+
+    std::optional<VIERingAllocation> cameraAllocation(frameRingBuffer.allocate(sizeof(VIEViewData)));
+    std::optional<VIERingAllocation> objectAllocation(frameRingBuffer.allocate(objectDataRange));
+    std::optional<VIERingAllocation> drawAllocation(frameRingBuffer.allocate(drawCount * sizeof(VIEDrawCommand)));
+
+    return_log_if(!cameraAllocation || !objectAllocation || !drawAllocation, "Frame ring buffer is full...", false)
+
+    if (shadowMaps.getRedrawnCascadeCount() > 0) {
+        // Shadow casters are only written when some cascade is rendered again
+        const std::vector<glm::mat4x4> &casterMatrices(scene.getShadowInstanceMatrices());
+        const std::vector<VIEDrawCommand> &casterCommands(scene.getShadowDrawCommands());
+
+        std::optional<VIERingAllocation> casterAllocation(frameRingBuffer.allocate(objectDataRange));
+        std::optional<VIERingAllocation> casterDrawAllocation(
+                frameRingBuffer.allocate(casterCommands.size() * sizeof(VIEDrawCommand)));
+
+        return_log_if(!casterAllocation || !casterDrawAllocation, "Frame ring buffer is full...", false)
+
+        std::memcpy(casterAllocation->data, casterMatrices.data(), casterMatrices.size() * sizeof(glm::mat4x4));
+        std::memcpy(casterDrawAllocation->data, casterCommands.data(),
+                    casterCommands.size() * sizeof(VIEDrawCommand));
+
+        if (isGeometryStreamed) {
+            geometryStreamer.patchShadowDrawCommands(
+                    std::span(static_cast<VIEDrawCommand *>(casterDrawAllocation->data), casterCommands.size()));
+        }
+
+        frameOffsets.shadowDynamicOffsets = {static_cast<uint32_t>(cameraAllocation->offset),
+                                             static_cast<uint32_t>(casterAllocation->offset)};
+        frameOffsets.shadowDrawOffset = casterDrawAllocation->offset;
+    }
+
+    std::memcpy(cameraAllocation->data, &viewData, sizeof(VIEViewData));
+
+    const std::vector<glm::mat4x4> &instanceMatrices(scene.getFrameInstanceMatrices());
+    std::memcpy(objectAllocation->data, instanceMatrices.data(), instanceMatrices.size() * sizeof(glm::mat4x4));
+
+    const std::vector<VIEDrawCommand> &drawCommands(scene.getFrameDrawCommands());
+    std::memcpy(drawAllocation->data, drawCommands.data(), drawCommands.size() * sizeof(VIEDrawCommand));
+
+    if (isGeometryStreamed) {
+        geometryStreamer.patchDrawCommands(
+                std::span(static_cast<VIEDrawCommand *>(drawAllocation->data), drawCommands.size()));
+    }
+
+    frameOffsets.dynamicOffsets = {static_cast<uint32_t>(cameraAllocation->offset),
+                                   static_cast<uint32_t>(objectAllocation->offset)};
+    frameOffsets.drawOffset = drawAllocation->offset;
+
+    return true;
+}
+
+bool VIEngine::recordCommandBuffer(const VkCommandBuffer &buffer, uint32_t imageIndex,
+                                   const FrameOffsets &frameOffsets) {
+    VIE_TRACE_ZONE("recordCommandBuffer");
 
-        return_log_if(vkBeginCommandBuffer(buffer, &commandBufferBeginInfo) != VK_SUCCESS,
-                      fmt::format("Cannot begin recording command buffer {}", i), false)
+    vkResetCommandBuffer(buffer, 0);
+
+    VkCommandBufferBeginInfo commandBufferBeginInfo{
+            .sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO,
+            .flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT,
+            .pInheritanceInfo = nullptr
+    };
+
+    return_log_if(vkBeginCommandBuffer(buffer, &commandBufferBeginInfo) != VK_SUCCESS,
+                  fmt::format("Cannot begin recording command buffer {}", currentFrame), false)
+
+    // Declarations match the compiled ones, only the swap chain image and the frame offsets change
+    declareRenderGraph(imageIndex, frameOffsets);
+    return_log_if(!renderGraph.compile(vkDevice, vkPhysicalDevice), "Cannot compile render graph...", false)
+
+    // Results of the previous use of this frame are read here, its fence has been waited
+    gpuProfiler.beginFrame(vkDevice, buffer, currentFrame);
+    const uint32_t frameScope = gpuProfiler.beginScope(buffer, "frame");
+
+    renderGraph.execute(buffer);
+
+    gpuProfiler.endScope(buffer, frameScope);
+
+    return_log_if(vkEndCommandBuffer(buffer) != VK_SUCCESS, "Failed to record command buffer...", false)
+
+    return true;
+}
+
+void VIEngine::declareRenderGraph(uint32_t imageIndex, const FrameOffsets &frameOffsets) {
+    using Usage = VIERenderGraph::Usage;
+
+    renderGraph.reset();
+
+    const VkExtent2D renderExtent(getRenderExtent());
+
+    // Swap chain images come from the presentation engine, made available at the stage the submit waits for
+    const VIERenderGraph::ResourceHandle swapChainResource(renderGraph.importImage(
+            "swap chain", swapChainImages.at(imageIndex), VK_IMAGE_ASPECT_COLOR_BIT,
+            Usage{settings.isStereoEnabled ? VK_PIPELINE_STAGE_TRANSFER_BIT
+                                           : VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT, 0,
+                  VK_IMAGE_LAYOUT_UNDEFINED},
+            VIERenderGraph::kPresent, true));
+
+    // The stereo target is left ready to be copied (or read back), its contents are cleared by the scene pass
+    const VIERenderGraph::ResourceHandle colorResource(
+            settings.isStereoEnabled ? renderGraph.importImage("stereo target", stereoTarget.getImage(),
+                                                               VK_IMAGE_ASPECT_COLOR_BIT,
+                                                               Usage{VK_PIPELINE_STAGE_TRANSFER_BIT,
+                                                                     VK_ACCESS_TRANSFER_READ_BIT,
+                                                                     VK_IMAGE_LAYOUT_UNDEFINED},
+                                                               VIERenderGraph::kTransferSource, true)
+                                     : swapChainResource);
+
+    depthResource = renderGraph.createImage("depth", VIERenderGraph::ImageDescription{
+            .format = depthFormat,
+            .extent = renderExtent,
+            .layerCount = settings.isStereoEnabled ? VIEViewData::kMaxViews : 1,
+            .usage = VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT |
+                     (settings.isDepthPyramidEnabled ? VK_IMAGE_USAGE_SAMPLED_BIT : 0u),
+            .aspect = VK_IMAGE_ASPECT_DEPTH_BIT
+    });
+
+    // Cached layers of the shadow maps are kept from frame to frame
+    const VIERenderGraph::ResourceHandle shadowResource(renderGraph.importImage(
+            "shadow maps", shadowMaps.getImage(), VK_IMAGE_ASPECT_DEPTH_BIT,
+            Usage{VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, VK_ACCESS_SHADER_READ_BIT,
+                  VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL}, Usage{}, true));
+
+    const Usage shadowRead{VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, VK_ACCESS_SHADER_READ_BIT,
+                           VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL};
+
+    // Levels of detail uploaded this frame, declared for every frame so that the plan is kept
+    std::optional<VIERenderGraph::ResourceHandle> vertexResource;
+    std::optional<VIERenderGraph::ResourceHandle> positionResource;
+    std::optional<VIERenderGraph::ResourceHandle> indexResource;
+    const Usage vertexRead{VK_PIPELINE_STAGE_VERTEX_INPUT_BIT, VK_ACCESS_VERTEX_ATTRIBUTE_READ_BIT};
+    const Usage indexRead{VK_PIPELINE_STAGE_VERTEX_INPUT_BIT, VK_ACCESS_INDEX_READ_BIT};
+
+    if (settings.isGeometryStreamingEnabled && vertexBuffer != VK_NULL_HANDLE) {
+        vertexResource = renderGraph.importBuffer("vertices", vertexBuffer, vertexRead, true);
+        indexResource = renderGraph.importBuffer("indices", indexBuffer, indexRead, true);
+
+        if (positionBuffer != VK_NULL_HANDLE) {
+            positionResource = renderGraph.importBuffer("positions", positionBuffer, vertexRead, true);
+        }
+
+        const uint32_t geometryPass = renderGraph.addPass("geometry upload", [this](const VkCommandBuffer &buffer) {
+            geometryStreamer.recordUploads(buffer, {vertexBuffer, positionBuffer, indexBuffer});
+        });
+
+        const Usage geometryWrite{VK_PIPELINE_STAGE_TRANSFER_BIT, VK_ACCESS_TRANSFER_WRITE_BIT};
+        renderGraph.write(geometryPass, *vertexResource, geometryWrite);
+        renderGraph.write(geometryPass, *indexResource, geometryWrite);
+
+        if (positionResource) {
+            renderGraph.write(geometryPass, *positionResource, geometryWrite);
+        }
+    }
+
+    // Static and dynamic caster draws are the two halves of the shadow draws, layers are transitioned by shadowMaps
+    const uint32_t shadowPass = renderGraph.addPass("shadows", [this, frameOffsets](const VkCommandBuffer &buffer) {
+        const uint32_t shadowScope = gpuProfiler.beginScope(buffer, "shadows");
+        shadowMaps.record(buffer, [&](const VkCommandBuffer &shadowBuffer, const VkPipelineLayout &shadowLayout,
+                                      bool isStatic) {
+            const uint32_t casterDrawCount = scene.getShadowDrawCount() / 2;
+
+            if (vertexBuffer == VK_NULL_HANDLE || (!isStatic && scene.getDynamicInstanceCount() == 0)) {
+                return;
+            }
+
+            vkCmdBindDescriptorSets(shadowBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, shadowLayout, 0, 1,
+                                    &frameDescriptorSet,
+                                    static_cast<uint32_t>(frameOffsets.shadowDynamicOffsets.size()),
+                                    frameOffsets.shadowDynamicOffsets.data());
+
+            VkDeviceSize positionBufferOffset = 0;
+            vkCmdBindVertexBuffers(shadowBuffer, 0, 1, &positionBuffer, &positionBufferOffset);
+            vkCmdBindIndexBuffer(shadowBuffer, indexBuffer, 0, VK_INDEX_TYPE_UINT32);
+            vkCmdDrawIndexedIndirect(shadowBuffer, frameRingBuffer.getBuffer(),
+                                     frameOffsets.shadowDrawOffset + (isStatic ? 0 : casterDrawCount) *
+                                                                     sizeof(VIEDrawCommand),
+                                     casterDrawCount, sizeof(VIEDrawCommand));
+        });
+        gpuProfiler.endScope(buffer, shadowScope);
+    });
+
+    renderGraph.write(shadowPass, shadowResource,
+                      Usage{VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_TRANSFER_BIT,
+                            VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT | VK_ACCESS_TRANSFER_WRITE_BIT,
+                            VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL});
+
+    if (positionResource && settings.isShadowEnabled) {
+        renderGraph.read(shadowPass, *positionResource, vertexRead);
+        renderGraph.read(shadowPass, *indexResource, indexRead);
+    }
+
+    // Materials of the textures streamed since the last frame, declared for every frame so that the plan is kept
+    std::optional<VIERenderGraph::ResourceHandle> materialResource;
+    const Usage materialRead{VK_PIPELINE_STAGE_VERTEX_SHADER_BIT | VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT,
+                             VK_ACCESS_SHADER_READ_BIT};
+
+    if (materialBuffer != VK_NULL_HANDLE && !scene.getTextures().empty()) {
+        materialResource = renderGraph.importBuffer("materials", materialBuffer, materialRead, true);
+
+        const uint32_t materialPass = renderGraph.addPass("material update", [this](const VkCommandBuffer &buffer) {
+            if (!areMaterialsDirty) {
+                return;
+            }
+
+            // Updates are limited to 65536 bytes each
+            constexpr VkDeviceSize kMaxUpdateSize{65536};
+            const auto *data = reinterpret_cast<const std::byte *>(deviceMaterials.data());
+            const VkDeviceSize size = deviceMaterials.size() * sizeof(VIEMaterial);
+
+            for (VkDeviceSize offset = 0; offset < size; offset += kMaxUpdateSize) {
+                vkCmdUpdateBuffer(buffer, materialBuffer, offset, std::min(kMaxUpdateSize, size - offset),
+                                  data + offset);
+            }
+
+            areMaterialsDirty = false;
+        });
+
+        renderGraph.write(materialPass, *materialResource,
+                          Usage{VK_PIPELINE_STAGE_TRANSFER_BIT, VK_ACCESS_TRANSFER_WRITE_BIT});
+    }
+
+    const uint32_t scenePass = renderGraph.addPass("scene", [this, frameOffsets, imageIndex,
+                                                             renderExtent](const VkCommandBuffer &buffer) {
+        const std::array<uint32_t, 2> &dynamicOffsets(frameOffsets.dynamicOffsets);
+        const VkDeviceSize drawOffset(frameOffsets.drawOffset);
+
+        // TODO integrate custom render pass and draw commands so that others could implement their shaders and related commands
+        // Reversed depth is cleared to the far plane
+        std::array<VkClearValue, 2> clearValues{};
+        clearValues[0].color = {{0.0f, 0.0f, 0.0f, 1.0f}};
+        clearValues[1].depthStencil = {0.0f, 0};
 
-        VkClearValue clearColor{{{0.0f, 0.0f, 0.0f, 1.0f}}};
         VkRenderPassBeginInfo renderPassBeginInfo{
                 .sType = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO,
                 .renderPass = renderPass,
-                .framebuffer = swapChainFramebuffers.at(i),
-                .renderArea = VkRect2D{{0, 0}, chosenSwapExtent},
-                .clearValueCount = 1,
-                .pClearValues = &clearColor
+                .framebuffer = settings.isStereoEnabled ? stereoFramebuffer : swapChainFramebuffers.at(imageIndex),
+                .renderArea = VkRect2D{{0, 0}, renderExtent},
+                .clearValueCount = static_cast<uint32_t>(clearValues.size()),
+                .pClearValues = clearValues.data()
         };
 
+        // Scopes bracket whole render pass instances, multiview would write a query for each view inside them
+        const uint32_t sceneScope = gpuProfiler.beginScope(buffer, "scene");
         vkCmdBeginRenderPass(buffer, &renderPassBeginInfo, VK_SUBPASS_CONTENTS_INLINE);
+
+        if (vertexBuffer != VK_NULL_HANDLE) {
+            std::array<VkDescriptorSet, 2> descriptorSets{frameDescriptorSet, bindlessResources.getDescriptorSet()};
+            vkCmdBindDescriptorSets(buffer, VK_PIPELINE_BIND_POINT_GRAPHICS, pipelineLayout, 0,
+                                    static_cast<uint32_t>(descriptorSets.size()), descriptorSets.data(),
+                                    static_cast<uint32_t>(dynamicOffsets.size()), dynamicOffsets.data());
+            vkCmdBindIndexBuffer(buffer, indexBuffer, 0, VK_INDEX_TYPE_UINT32);
+        }
+
+        if (settings.isDepthPrepassEnabled) {
+            // Same draws with positions only, so that the main subpass shades each pixel once
+            if (vertexBuffer != VK_NULL_HANDLE) {
+                vkCmdBindPipeline(buffer, VK_PIPELINE_BIND_POINT_GRAPHICS, depthPipeline);
+
+                VkDeviceSize positionBufferOffset = 0;
+                vkCmdBindVertexBuffers(buffer, 0, 1, &positionBuffer, &positionBufferOffset);
+                vkCmdDrawIndexedIndirect(buffer, frameRingBuffer.getBuffer(), drawOffset, drawCount,
+                                         sizeof(VIEDrawCommand));
+            }
+
+            vkCmdNextSubpass(buffer, VK_SUBPASS_CONTENTS_INLINE);
+        }
+
         vkCmdBindPipeline(buffer, VK_PIPELINE_BIND_POINT_GRAPHICS, graphicsPipeline);
 
-        vkCmdDraw(buffer, 3, 1, 0, 0);
+        if (vertexBuffer != VK_NULL_HANDLE) {
+            VkDeviceSize vertexBufferOffset = 0;
+            vkCmdBindVertexBuffers(buffer, 0, 1, &vertexBuffer, &vertexBufferOffset);
+
+            // The whole scene in a single call: each draw renders one level of detail of a mesh for the instances of
+            // its model using it, materials are selected in shaders through the draw index (and cameras through the
+            // view)
+            vkCmdDrawIndexedIndirect(buffer, frameRingBuffer.getBuffer(), drawOffset, drawCount,
+                                     sizeof(VIEDrawCommand));
+        }
 
         vkCmdEndRenderPass(buffer);
+        gpuProfiler.endScope(buffer, sceneScope);
+    });
 
-        return_log_if(vkEndCommandBuffer(buffer) != VK_SUCCESS, "Failed to record command buffer...", false)
+    renderGraph.write(scenePass, colorResource, VIERenderGraph::kColorAttachment);
+    renderGraph.write(scenePass, depthResource, VIERenderGraph::kDepthAttachment);
+    renderGraph.read(scenePass, shadowResource, shadowRead);
 
-        ++i;
+    if (materialResource) {
+        renderGraph.read(scenePass, *materialResource, materialRead);
     }
 
-    engineStatus = VIEStatus::VULKAN_COMMAND_POOL_CREATED;
+    if (vertexResource) {
+        renderGraph.read(scenePass, *vertexResource, vertexRead);
+        renderGraph.read(scenePass, *indexResource, indexRead);
 
-    return true;
+        if (positionResource && settings.isDepthPrepassEnabled) {
+            renderGraph.read(scenePass, *positionResource, vertexRead);
+        }
+    }
+
+    if (settings.isDepthPyramidEnabled) {
+        // Levels are synchronised with each other by depthPyramid
+        const VIERenderGraph::ResourceHandle pyramidResource(renderGraph.importImage(
+                "depth pyramid", depthPyramid.getImage(), VK_IMAGE_ASPECT_COLOR_BIT,
+                Usage{VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT,
+                      VK_IMAGE_LAYOUT_GENERAL}, Usage{}, true));
+
+        const uint32_t pyramidPass = renderGraph.addPass("depth pyramid", [this](const VkCommandBuffer &buffer) {
+            const uint32_t pyramidScope = gpuProfiler.beginScope(buffer, "depth pyramid");
+            depthPyramid.record(buffer);
+            gpuProfiler.endScope(buffer, pyramidScope);
+        });
+
+        renderGraph.read(pyramidPass, depthResource, Usage{VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+                                                           VK_ACCESS_SHADER_READ_BIT,
+                                                           VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL});
+        renderGraph.write(pyramidPass, pyramidResource,
+                          Usage{VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+                                VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT, VK_IMAGE_LAYOUT_GENERAL});
+    }
+
+    if (settings.isStereoEnabled) {
+        const uint32_t stereoPass = renderGraph.addPass("stereo copy", [this, imageIndex](
+                const VkCommandBuffer &buffer) {
+            const uint32_t stereoScope = gpuProfiler.beginScope(buffer, "stereo copy");
+
+            // Left eye on the left half, right eye on the right half
+            const VkExtent2D eyeExtent(stereoTarget.getExtent());
+            const auto halfWidth = static_cast<int32_t>(chosenSwapExtent.width / 2);
+            const auto height = static_cast<int32_t>(chosenSwapExtent.height);
+            std::array<VkImageBlit, VIEViewData::kMaxViews> blitRegions{};
+
+            for (uint32_t eye = 0; VkImageBlit &blitRegion: blitRegions) {
+                blitRegion = VkImageBlit{
+                        .srcSubresource = {VK_IMAGE_ASPECT_COLOR_BIT, 0, eye, 1},
+                        .srcOffsets = {VkOffset3D{0, 0, 0}, VkOffset3D{static_cast<int32_t>(eyeExtent.width),
+                                                                       static_cast<int32_t>(eyeExtent.height), 1}},
+                        .dstSubresource = {VK_IMAGE_ASPECT_COLOR_BIT, 0, 0, 1},
+                        .dstOffsets = {VkOffset3D{halfWidth * static_cast<int32_t>(eye), 0, 0},
+                                       VkOffset3D{halfWidth * static_cast<int32_t>(eye + 1), height, 1}}
+                };
+
+                ++eye;
+            }
+
+            vkCmdBlitImage(buffer, stereoTarget.getImage(), VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+                           swapChainImages.at(imageIndex), VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                           static_cast<uint32_t>(blitRegions.size()), blitRegions.data(), VK_FILTER_LINEAR);
+
+            gpuProfiler.endScope(buffer, stereoScope);
+        });
+
+        renderGraph.read(stereoPass, colorResource, VIERenderGraph::kTransferSource);
+        renderGraph.write(stereoPass, swapChainResource, VIERenderGraph::kTransferDestination);
+    }
+}
+
+VkExtent2D VIEngine::getRenderExtent() const {
+    return settings.isStereoEnabled ? VkExtent2D{settings.stereoXRes, settings.stereoYRes} : chosenSwapExtent;
 }
 
 bool VIEngine::regenerateRendererCore() {
@@ -437,16 +1085,243 @@ bool VIEngine::regenerateRendererCore() {
 }
 
 bool VIEngine::loadScenario() {
+    VIE_TRACE_ZONE("loadScenario");
+
+    VIETask<bool> task(loadScenarioAsync(loadStopSource.get_token()));
+    tools::waitForTask(task);
+
+    return task.getResult();
+}
+
+VIETask<bool> VIEngine::loadScenarioAsync(std::stop_token stopToken) {
+    co_await tools::switchToWorker();
+
+    // Trace zones are kept within a thread, the task may resume elsewhere
+    {
+        VIE_TRACE_ZONE("loadScenarioAsync");
+
+        if (!scene.loadFromXML(settings.scenarioLocation)) {
+            log_error("Error loading scenario {}...", settings.scenarioLocation);
+            co_return false;
+        }
+
+        if (settings.lodLevels > 0 && !stopToken.stop_requested()) {
+            scene.generateLods(settings.lodLevels, settings.lodReduction);
+        }
+
+        if (settings.generateMeshlets && !stopToken.stop_requested()) {
+            scene.generateMeshlets();
+        }
+    }
+
+    // Engine state is only changed by the main thread
+    co_await tools::switchToMainThread();
+
+    if (stopToken.stop_requested()) {
+        co_return false;
+    }
+
+    // Loaded while the engine is prepared, whose status is further already: the load is recorded all the same
+    setStatus(VIEStatus::SCENARIO_LOADED, "loadScenario");
+
+    co_return true;
+}
+
+void VIEngine::cancelLoading() {
+    loadStopSource.request_stop();
+
+    // Textures being uploaded are waited for by the stream itself
+    tools::waitForTask(textureStream);
+    textureStream = {};
+
+    loadStopSource = std::stop_source();
+}
+
+VIETask<bool> VIEngine::streamTextures(std::stop_token stopToken) {
+    std::vector<VIETextureData> &textures(scene.getTextures());
+    const std::vector<VIEMaterial> &materials(scene.getMaterials());
+    const size_t batchSize = tools::getWorkerCount();
+    size_t streamedCount = 0;
+
+    for (size_t first = 0; first < textures.size() && !stopToken.stop_requested(); first += batchSize) {
+        const size_t last = std::min(first + batchSize, textures.size());
+
+        // Decoding (or reading from the cache) and mip generation, a texture for each worker
+        co_await tools::switchToWorker();
+        tools::parallelFor(last - first, 1, [&](size_t begin, size_t end) {
+            for (size_t i = first + begin; i < first + end; ++i) {
+                tools::loadTexture(textures[i], settings.mipFilter, settings.textureCompression,
+                                   settings.textureCacheLocation);
+            }
+        });
+
+        // Command pool and queue are only used by the main thread
+        co_await tools::switchToMainThread();
+
+        // Uploads wait (checked once a frame) until the device memory budget can hold the batch
+        VkDeviceSize batchBytes = 0;
+        for (size_t i = first; i < last; ++i) {
+            batchBytes += textures[i].pixels.size();
+        }
+
+        if (!memoryBudget.canAllocate(batchBytes)) {
+            log_warning("Texture streaming waiting for {} MiB of device memory...", batchBytes >> 20);
+            co_await tools::pollOnMainThread([this, batchBytes, &stopToken]() {
+                return stopToken.stop_requested() || memoryBudget.canAllocate(batchBytes);
+            });
+        }
+
+        if (stopToken.stop_requested()) {
+            break;
+        }
+
+        VkCommandBuffer commandBuffer(tools::beginSingleTimeCommands(vkDevice, commandPool));
+        std::vector<size_t> recordedTextures;
+
+        for (size_t i = first; i < last; ++i) {
+            if (!textures[i].isLoaded() ||
+                !textureImages[i].recordUpload(vkDevice, vkPhysicalDevice, commandBuffer, textures[i])) {
+                log_error("Cannot upload texture {}...", textures[i].location);
+                continue;
+            }
+
+            recordedTextures.push_back(i);
+        }
+
+        // The whole batch in a single submission, whose fence is polled once a frame
+        VkFenceCreateInfo fenceCreateInfo{.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO};
+        VkFence fence{};
+        VkResult uploadResult = VK_ERROR_INITIALIZATION_FAILED;
+
+        if (vkCreateFence(vkDevice, &fenceCreateInfo, nullptr, &fence) == VK_SUCCESS &&
+            tools::submitSingleTimeCommands(graphicsQueue, commandBuffer, fence)) {
+            uploadResult = co_await VIEFenceAwaiter{vkDevice, fence};
+        }
+
+        vkDestroyFence(vkDevice, fence, nullptr);
+        vkFreeCommandBuffers(vkDevice, commandPool, 1, &commandBuffer);
+
+        if (uploadResult != VK_SUCCESS) {
+            log_error("Cannot upload textures...");
+            co_return false;
+        }
+
+        for (size_t i: recordedTextures) {
+            // Slots not referenced by materials yet can be written while frames are pending
+            const uint32_t slot = textureImages[i].finishUpload(vkDevice)
+                                  ? bindlessResources.registerTexture(vkDevice, textureImages[i].getImageView())
+                                  : VIEMaterial::kNoTexture;
+
+            if (slot == VIEMaterial::kNoTexture) {
+                log_error("Cannot register texture {}...", textures[i].location);
+                continue;
+            }
+
+            auto remap([i, slot](uint32_t sceneTexture, uint32_t &deviceTexture) {
+                if (sceneTexture == i) {
+                    deviceTexture = slot;
+                }
+            });
+
+            for (size_t m = 0; m < materials.size(); ++m) {
+                remap(materials[m].diffuseTexture, deviceMaterials[m].diffuseTexture);
+                remap(materials[m].normalTexture, deviceMaterials[m].normalTexture);
+                remap(materials[m].specularTexture, deviceMaterials[m].specularTexture);
+            }
+
+            areMaterialsDirty = true;
+            ++streamedCount;
+
+            // Texels are only needed by the device from now on
+            textures[i].pixels = {};
+        }
+    }
 
+    log_info("{} of {} textures streamed", streamedCount, textures.size());
+
+    co_return streamedCount == textures.size();
 }
 
 bool VIEngine::prepareEngine() {
+    VIE_TRACE_ZONE("prepareEngine");
+
     std::vector<const char*> vGlfwExtensions;    ///< GLFW extensions count for Vulkan ext. initialisation
     float mainQueueFamilyPriority = 1.0f;                   ///< Main queue family priority
 
+    // Stages not needing the device run on workers while GLFW, the instance and the device are created on the main
+    // thread: GLSL compilation, and the scenario if not loaded yet
+    VIEJobCounter shaderJobs;
+    std::vector<uint32_t> depthVertexCode;
+    std::vector<uint32_t> shadowVertexCode;
+    std::vector<uint32_t> depthPyramidCode;
+    VIETask<bool> scenarioLoad;
+
+    // Workers write into the locals above, so they are waited for however prepareEngine returns
+    struct StartupJobsGuard {
+        VIEJobCounter &shaderJobs;
+        VIETask<bool> &scenarioLoad;
+
+        ~StartupJobsGuard() {
+            tools::waitForCounter(shaderJobs);
+            tools::waitForTask(scenarioLoad);
+        }
+    } startupJobsGuard{shaderJobs, scenarioLoad};
+
+    if (!uberShader) {
+        tools::runJob([this]() {
+            uberShader = std::make_unique<VIEUberShader>(settings.vertexShaderLocation,
+                                                         settings.fragmentShaderLocation);
+        }, &shaderJobs);
+    }
+
+    auto compileShader([&shaderJobs](const std::string &location, shaderc_shader_kind kind,
+                                     std::vector<uint32_t> &code) {
+        tools::runJob([&location, kind, &code]() {
+            code = VIEUberShader::compileFile(location, kind);
+        }, &shaderJobs);
+    });
+
+    if (settings.isDepthPrepassEnabled) {
+        compileShader(settings.depthVertexShaderLocation, shaderc_glsl_vertex_shader, depthVertexCode);
+    }
+
+    if (settings.isShadowEnabled) {
+        compileShader(settings.shadowVertexShaderLocation, shaderc_glsl_vertex_shader, shadowVertexCode);
+    }
+
+    if (settings.isDepthPyramidEnabled) {
+        compileShader(settings.depthPyramidShaderLocation, shaderc_glsl_compute_shader, depthPyramidCode);
+    }
+
+    if (engineStatus < VIEStatus::SCENARIO_LOADED) {
+        scenarioLoad = loadScenarioAsync(loadStopSource.get_token());
+        scenarioLoad.start();
+    }
+
+    // Wall time of each stage on the main thread (waits for the workers included), reported once prepared
+    std::vector<std::pair<std::string_view, double>> stageTimes;
+    const auto startTime(std::chrono::steady_clock::now());
+
+    // Stages completed are also recorded in the status timings, along with the status they reach (if any)
+    auto runStage([this, &stageTimes](std::string_view name, const auto &stage,
+                                      std::optional<VIEStatus> status = std::nullopt) {
+        const auto stageStart(std::chrono::steady_clock::now());
+        const bool isDone = stage();
+        stageTimes.emplace_back(name, std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() -
+                                                                                stageStart).count());
+
+        if (isDone) {
+            setStatus(status.value_or(engineStatus), name);
+        }
+
+        return isDone;
+    });
+
     // GLFW initialization lambda
     // https://www.glfw.org/docs/3.3/group__init.html
     auto initializeGlfw([this, &vGlfwExtensions]() {
+        VIE_TRACE_ZONE("initializeGlfw");
+
         // Initializing GLFW library
         /* Calling glfwInit() -> GLFW_TRUE(1) or GLFW_FALSE(0) */
         return_log_if(!glfwInit(), "GLFW not initialised...", false)
@@ -476,10 +1351,15 @@ bool VIEngine::prepareEngine() {
         // Setting up window resize callback
         glfwSetFramebufferSizeCallback(glfwWindow, framebufferResizeCallback);
 
+        // Setting up instance picking on clicks
+        glfwSetMouseButtonCallback(glfwWindow, mouseButtonCallback);
+
         return true;
     });
 
     auto createVulkanInstance([this, &vGlfwExtensions]() {
+        VIE_TRACE_ZONE("createVulkanInstance");
+
         // Creating the application details
         // https://www.khronos.org/registry/vulkan/specs/1.3-extensions/man/html/VkApplicationInfo.html
         //TODO update to 1.3
@@ -538,6 +1418,8 @@ bool VIEngine::prepareEngine() {
     });
 
     auto createWindowSurface([this]() {
+        VIE_TRACE_ZONE("createWindowSurface");
+
 #if _WIN64
         // Creating Vulkan surface based on WindowsNT native bindings
         VkWin32SurfaceCreateInfoKHR ntWindowSurfaceCreationInfo{
@@ -558,6 +1440,8 @@ bool VIEngine::prepareEngine() {
     });
 
     auto preparePhysicalDevice([this]() {
+        VIE_TRACE_ZONE("preparePhysicalDevice");
+
         // Looking for devices
         uint32_t devicesCount = 0;
         std::vector<VkPhysicalDevice> availableDevices;
@@ -584,10 +1468,23 @@ bool VIEngine::prepareEngine() {
 
         return_log_if(!isDeviceSet, "Error looking for physical device...", false)
 
+        // Baked textures are uploaded as they are, without transcoding: without BC support they are not compressed
+        if (settings.textureCompression != VIETextureCompression::NONE) {
+            VkPhysicalDeviceFeatures deviceFeatures;
+            vkGetPhysicalDeviceFeatures(vkPhysicalDevice, &deviceFeatures);
+
+            if (!deviceFeatures.textureCompressionBC) {
+                log_warning("BC texture compression not supported, textures are uploaded uncompressed");
+                settings.textureCompression = VIETextureCompression::NONE;
+            }
+        }
+
         return true;
     });
 
     auto prepareLogicalDevice([this, &mainQueueFamilyPriority]() {
+        VIE_TRACE_ZONE("prepareLogicalDevice");
+
         // Preparing command queue family for the main device
         std::vector<VkDeviceQueueCreateInfo> deviceQueuesCreateInfo{
                 VkDeviceQueueCreateInfo{
@@ -604,18 +1501,54 @@ bool VIEngine::prepareEngine() {
                 }
         };
 
-        VkPhysicalDeviceFeatures vkPhysicalDeviceFeatures{};
+        // Descriptor indexing for bindless textures, draw parameters for gl_DrawID
+        VkPhysicalDeviceVulkan12Features vulkan12Features{
+                .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_FEATURES,
+                .descriptorIndexing = VK_TRUE,
+                .shaderSampledImageArrayNonUniformIndexing = VK_TRUE,
+                .descriptorBindingSampledImageUpdateAfterBind = VK_TRUE,
+                .descriptorBindingPartiallyBound = VK_TRUE,
+                .descriptorBindingVariableDescriptorCount = VK_TRUE,
+                .runtimeDescriptorArray = VK_TRUE
+        };
+
+        // Multiview for gl_ViewIndex (stereo passes render both eyes at once)
+        VkPhysicalDeviceVulkan11Features vulkan11Features{
+                .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_1_FEATURES,
+                .pNext = &vulkan12Features,
+                .multiview = VK_TRUE,
+                .shaderDrawParameters = VK_TRUE
+        };
+
+        VkPhysicalDeviceFeatures2 vkPhysicalDeviceFeatures{
+                .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2,
+                .pNext = &vulkan11Features,
+                .features = VkPhysicalDeviceFeatures{
+                        .multiDrawIndirect = VK_TRUE,
+                        .drawIndirectFirstInstance = VK_TRUE,
+                        .textureCompressionBC = settings.textureCompression != VIETextureCompression::NONE
+                }
+        };
+
+        // Heap budgets are tracked when the device reports them
+        const bool isMemoryBudgetSupported = VIEMemoryBudget::isExtensionSupported(vkPhysicalDevice);
+        std::vector<const char *> deviceExtensions(settings.kDeviceExtensions);
+
+        if (isMemoryBudgetSupported) {
+            deviceExtensions.push_back(VK_EXT_MEMORY_BUDGET_EXTENSION_NAME);
+        }
 
         // Defining logical device creation, basing on queue priority, validation layers and physical device features
         VkDeviceCreateInfo vkDeviceCreateInfo{
                 .sType = VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO,
+                .pNext = &vkPhysicalDeviceFeatures,
                 .queueCreateInfoCount = static_cast<uint32_t>(deviceQueuesCreateInfo.size()),
                 .pQueueCreateInfos = deviceQueuesCreateInfo.data(),
                 .enabledLayerCount = static_cast<uint32_t>(settings.validationLayers.size()),
                 .ppEnabledLayerNames = settings.validationLayers.data(),
-                .enabledExtensionCount = static_cast<uint32_t>(settings.kDeviceExtensions.size()),
-                .ppEnabledExtensionNames = settings.kDeviceExtensions.data(),
-                .pEnabledFeatures = &vkPhysicalDeviceFeatures,
+                .enabledExtensionCount = static_cast<uint32_t>(deviceExtensions.size()),
+                .ppEnabledExtensionNames = deviceExtensions.data(),
+                .pEnabledFeatures = nullptr,
         };
 
         return_log_if(vkCreateDevice(vkPhysicalDevice, &vkDeviceCreateInfo, nullptr, &vkDevice) != VK_SUCCESS,
@@ -625,37 +1558,337 @@ bool VIEngine::prepareEngine() {
         vkGetDeviceQueue(vkDevice, selectedQueueFamily, 0, &graphicsQueue);
         vkGetDeviceQueue(vkDevice, selectedPresentFamily, 0, &presentQueue);
 
+        memoryBudget.create(vkPhysicalDevice, isMemoryBudgetSupported, settings.memoryBudgetShare);
+
         return true;
     });
 
-    auto generateShaderModules([this]() {
-        // TODO make generic for every pipeline and every input shader and both code and binary
-        if (!uberShader) {
-            uberShader = std::make_unique<VIEUberShader>("./shaders/debug/shader.vert", "./shaders/debug/shader.frag");
-        }
+    auto generateShaderModules([&]() {
+        VIE_TRACE_ZONE("generateShaderModules");
+
+        // Compiled on workers since prepareEngine started
+        tools::waitForCounter(shaderJobs);
 
+        // TODO make generic for every pipeline and every input shader and both code and binary
         vertexModule = uberShader->createVertexModuleFromSPIRV(vkDevice);
         return_log_if(vertexModule == nullptr, "Cannot create vertex module...", false)
 
         fragmentModule = uberShader->createFragmentModuleFromSPIRV(vkDevice);
         return_log_if(fragmentModule == nullptr, "Cannot create fragment module...", false)
 
+        if (settings.isDepthPrepassEnabled) {
+            depthVertexModule = VIEUberShader::createModule(vkDevice, depthVertexCode);
+            return_log_if(depthVertexModule == nullptr, "Cannot create depth vertex module...", false)
+        }
+
+        if (settings.isShadowEnabled) {
+            shadowVertexModule = VIEUberShader::createModule(vkDevice, shadowVertexCode);
+            return_log_if(shadowVertexModule == nullptr, "Cannot create shadow vertex module...", false)
+        }
+
+        if (settings.isDepthPyramidEnabled) {
+            depthPyramidModule = VIEUberShader::createModule(vkDevice, depthPyramidCode);
+            return_log_if(depthPyramidModule == nullptr, "Cannot create depth pyramid module...", false)
+        }
+
         return true;
     });
 
     auto createCommandPool([this]() {
+        VIE_TRACE_ZONE("createCommandPool");
+
         VkCommandPoolCreateInfo commandPoolCreateInfo{
                 .sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO,
+                .flags = VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT,
                 .queueFamilyIndex = selectedQueueFamily
         };
 
         return_log_if(vkCreateCommandPool(vkDevice, &commandPoolCreateInfo, nullptr, &commandPool) != VK_SUCCESS,
                       "Cannot create command pool...", false)
 
+        // Frame, shadows, scene, depth pyramid and stereo copy scopes
+        if (settings.isGpuProfilingEnabled) {
+            return_log_if(!gpuProfiler.create(vkDevice, vkPhysicalDevice, selectedQueueFamily,
+                                              settings.kMaxFramesInFlight, 8),
+                          "Cannot create GPU profiler...", false)
+        }
+
+        return true;
+    });
+
+    auto createSceneBuffers([this]() {
+        VIE_TRACE_ZONE("createSceneBuffers");
+
+        const VIEMeshPool &meshPool = scene.getMeshPool();
+
+        // Nothing to draw without a scenario
+        if (meshPool.getVertices().empty() || scene.getInstanceCount() == 0) {
+            return true;
+        }
+
+        const bool hasPositions = settings.isDepthPrepassEnabled || settings.isShadowEnabled;
+
+        if (settings.isGeometryStreamingEnabled) {
+            if (settings.lodLevels == 0) {
+                log_warning("Geometry streaming without levels of detail keeps every model pinned");
+            }
+
+            // Heaps are allocated once, within half of the memory left (the rest goes to the streamed textures)
+            VkDeviceSize deviceBudget = settings.geometryDeviceBudget;
+
+            if (memoryBudget.isTracked() && deviceBudget > memoryBudget.getDeviceHeadroom() / 2) {
+                deviceBudget = memoryBudget.getDeviceHeadroom() / 2;
+                log_warning("Geometry device budget lowered to {} MiB by the device memory budget", deviceBudget >> 20);
+            }
+
+            const VIEGeometryStreamer::Budget budget{deviceBudget, settings.geometryHostBudget,
+                                                     settings.geometryUploadBudget, settings.geometrySpillLocation,
+                                                     hasPositions};
+            return_log_if(!geometryStreamer.build(scene, budget), "Cannot build geometry blocks...", false)
+
+            // Geometry is now held by the blocks (or the spill file)
+            scene.getMeshPool().releaseGeometry();
+
+            return_log_if(!tools::createBuffer(vkDevice, vkPhysicalDevice,
+                                               geometryStreamer.getVertexCapacity() * sizeof(VIEVertex),
+                                               VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+                                               VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, vertexBuffer, vertexBufferMemory),
+                          "Cannot create vertex buffer...", false)
+
+            if (hasPositions) {
+                return_log_if(!tools::createBuffer(vkDevice, vkPhysicalDevice,
+                                                   geometryStreamer.getVertexCapacity() * sizeof(glm::vec3),
+                                                   VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+                                                   VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, positionBuffer,
+                                                   positionBufferMemory),
+                              "Cannot create position buffer...", false)
+            }
+
+            return_log_if(!tools::createBuffer(vkDevice, vkPhysicalDevice,
+                                               geometryStreamer.getIndexCapacity() * sizeof(uint32_t),
+                                               VK_BUFFER_USAGE_INDEX_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+                                               VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, indexBuffer, indexBufferMemory),
+                          "Cannot create index buffer...", false)
+
+            return_log_if(!geometryStreamer.create(vkDevice, vkPhysicalDevice, commandPool, graphicsQueue,
+                                                   {vertexBuffer, positionBuffer, indexBuffer},
+                                                   settings.kMaxFramesInFlight),
+                          "Cannot upload pinned geometry...", false)
+        } else {
+            return_log_if(!tools::createDeviceLocalBuffer(vkDevice, vkPhysicalDevice, commandPool, graphicsQueue,
+                                                          meshPool.getVertices().data(),
+                                                          meshPool.getVertices().size() * sizeof(VIEVertex),
+                                                          VK_BUFFER_USAGE_VERTEX_BUFFER_BIT, vertexBuffer,
+                                                          vertexBufferMemory),
+                          "Cannot create vertex buffer...", false)
+
+            if (hasPositions) {
+                std::vector<glm::vec3> positions(meshPool.getVertices().size());
+                for (size_t i = 0; const VIEVertex &vertex: meshPool.getVertices()) {
+                    positions[i++] = vertex.pos;
+                }
+
+                return_log_if(!tools::createDeviceLocalBuffer(vkDevice, vkPhysicalDevice, commandPool, graphicsQueue,
+                                                              positions.data(), positions.size() * sizeof(glm::vec3),
+                                                              VK_BUFFER_USAGE_VERTEX_BUFFER_BIT, positionBuffer,
+                                                              positionBufferMemory),
+                              "Cannot create position buffer...", false)
+            }
+
+            return_log_if(!tools::createDeviceLocalBuffer(vkDevice, vkPhysicalDevice, commandPool, graphicsQueue,
+                                                          meshPool.getIndices().data(),
+                                                          meshPool.getIndices().size() * sizeof(uint32_t),
+                                                          VK_BUFFER_USAGE_INDEX_BUFFER_BIT, indexBuffer,
+                                                          indexBufferMemory),
+                          "Cannot create index buffer...", false)
+        }
+
+        // Materials sample no texture until theirs are streamed
+        deviceMaterials = scene.getMaterials();
+        for (VIEMaterial &material: deviceMaterials) {
+            material.diffuseTexture = VIEMaterial::kNoTexture;
+            material.normalTexture = VIEMaterial::kNoTexture;
+            material.specularTexture = VIEMaterial::kNoTexture;
+        }
+
+        return_log_if(!tools::createDeviceLocalBuffer(vkDevice, vkPhysicalDevice, commandPool, graphicsQueue,
+                                                      deviceMaterials.data(),
+                                                      deviceMaterials.size() * sizeof(VIEMaterial),
+                                                      VK_BUFFER_USAGE_STORAGE_BUFFER_BIT, materialBuffer,
+                                                      materialBufferMemory),
+                      "Cannot create material buffer...", false)
+
+        std::vector<VIEDrawCommand> drawCommands(scene.buildDrawCommands());
+        drawCount = static_cast<uint32_t>(drawCommands.size());
+
+        return_log_if(!tools::createDeviceLocalBuffer(vkDevice, vkPhysicalDevice, commandPool, graphicsQueue,
+                                                      drawCommands.data(), drawCommands.size() * sizeof(VIEDrawCommand),
+                                                      VK_BUFFER_USAGE_STORAGE_BUFFER_BIT, drawBuffer, drawBufferMemory),
+                      "Cannot create draw buffer...", false)
+
+        return true;
+    });
+
+    auto createBindlessResources([this]() {
+        VIE_TRACE_ZONE("createBindlessResources");
+
+        return_log_if(!bindlessResources.create(vkDevice, vkPhysicalDevice, settings.kMaxBindlessTextures),
+                      "Cannot create bindless resources...", false)
+
+        if (drawBuffer != VK_NULL_HANDLE) {
+            bindlessResources.setStorageBuffer(vkDevice, VIEBindlessResources::kMaterialBinding, materialBuffer,
+                                               VK_WHOLE_SIZE);
+            bindlessResources.setStorageBuffer(vkDevice, VIEBindlessResources::kDrawBinding, drawBuffer,
+                                               VK_WHOLE_SIZE);
+        }
+
+        // Textures are streamed once the engine is prepared, and registered in the order they are uploaded
+        textureImages.resize(scene.getTextures().size());
+
+        return true;
+    });
+
+    auto createFrameResources([this]() {
+        VIE_TRACE_ZONE("createFrameResources");
+
+        // Object data is never empty, so that the storage buffer range is always valid
+        objectDataRange = std::max<VkDeviceSize>(scene.getInstanceCount(), 1) * sizeof(glm::mat4x4);
+
+        // View, object and draw data (and shadow casters) use at most half of each frame region
+        VkDeviceSize frameDataSize = objectDataRange + sizeof(VIEViewData) + drawCount * sizeof(VIEDrawCommand);
+        if (settings.isShadowEnabled) {
+            frameDataSize += objectDataRange + scene.getShadowDrawCount() * sizeof(VIEDrawCommand);
+        }
+
+        return_log_if(!frameRingBuffer.create(vkDevice, vkPhysicalDevice,
+                                              std::max(settings.kMinFrameDataSize, 2 * frameDataSize),
+                                              settings.kMaxFramesInFlight),
+                      "Cannot create frame ring buffer...", false)
+
+        std::array<VkDescriptorSetLayoutBinding, 3> frameBindings{
+                VkDescriptorSetLayoutBinding{
+                        .binding = 0,
+                        .descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC,
+                        .descriptorCount = 1,
+                        .stageFlags = VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT
+                },
+                VkDescriptorSetLayoutBinding{
+                        .binding = 1,
+                        .descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC,
+                        .descriptorCount = 1,
+                        .stageFlags = VK_SHADER_STAGE_VERTEX_BIT
+                },
+                // Shadow map cascades, written with the shadow maps
+                VkDescriptorSetLayoutBinding{
+                        .binding = 2,
+                        .descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
+                        .descriptorCount = 1,
+                        .stageFlags = VK_SHADER_STAGE_FRAGMENT_BIT
+                }
+        };
+
+        VkDescriptorSetLayoutCreateInfo setLayoutCreateInfo{
+                .sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO,
+                .bindingCount = static_cast<uint32_t>(frameBindings.size()),
+                .pBindings = frameBindings.data()
+        };
+
+        return_log_if(vkCreateDescriptorSetLayout(vkDevice, &setLayoutCreateInfo, nullptr, &frameSetLayout) !=
+                      VK_SUCCESS, "Cannot create frame descriptor set layout...", false)
+
+        std::array<VkDescriptorPoolSize, 3> poolSizes{
+                VkDescriptorPoolSize{VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC, 1},
+                VkDescriptorPoolSize{VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC, 1},
+                VkDescriptorPoolSize{VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, 1}
+        };
+
+        VkDescriptorPoolCreateInfo descriptorPoolCreateInfo{
+                .sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO,
+                .maxSets = 1,
+                .poolSizeCount = static_cast<uint32_t>(poolSizes.size()),
+                .pPoolSizes = poolSizes.data()
+        };
+
+        return_log_if(vkCreateDescriptorPool(vkDevice, &descriptorPoolCreateInfo, nullptr, &descriptorPool) !=
+                      VK_SUCCESS, "Cannot create descriptor pool...", false)
+
+        VkDescriptorSetAllocateInfo setAllocateInfo{
+                .sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO,
+                .descriptorPool = descriptorPool,
+                .descriptorSetCount = 1,
+                .pSetLayouts = &frameSetLayout
+        };
+
+        return_log_if(vkAllocateDescriptorSets(vkDevice, &setAllocateInfo, &frameDescriptorSet) != VK_SUCCESS,
+                      "Cannot allocate frame descriptor set...", false)
+
+        // Written once: every frame only changes the dynamic offsets
+        VkDescriptorBufferInfo cameraBufferInfo{frameRingBuffer.getBuffer(), 0, sizeof(VIEViewData)};
+        VkDescriptorBufferInfo objectBufferInfo{frameRingBuffer.getBuffer(), 0, objectDataRange};
+
+        std::array<VkWriteDescriptorSet, 2> descriptorWrites{
+                VkWriteDescriptorSet{
+                        .sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET,
+                        .dstSet = frameDescriptorSet,
+                        .dstBinding = 0,
+                        .descriptorCount = 1,
+                        .descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC,
+                        .pBufferInfo = &cameraBufferInfo
+                },
+                VkWriteDescriptorSet{
+                        .sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET,
+                        .dstSet = frameDescriptorSet,
+                        .dstBinding = 1,
+                        .descriptorCount = 1,
+                        .descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC,
+                        .pBufferInfo = &objectBufferInfo
+                }
+        };
+
+        vkUpdateDescriptorSets(vkDevice, static_cast<uint32_t>(descriptorWrites.size()), descriptorWrites.data(), 0,
+                               nullptr);
+
+        return true;
+    });
+
+    auto createShadowMaps([this]() {
+        VIE_TRACE_ZONE("createShadowMaps");
+
+        if (depthFormat == VK_FORMAT_UNDEFINED) {
+            return_log_if(!tools::selectDepthFormat(vkPhysicalDevice, depthFormat), "No depth format supported...",
+                          false)
+        }
+
+        // Without shadows a single texel map is still bound, and shaders see no cascades
+        return_log_if(!shadowMaps.create(vkDevice, vkPhysicalDevice, commandPool, graphicsQueue, depthFormat,
+                                         settings.isShadowEnabled ? settings.shadowCascadeCount : 0,
+                                         settings.shadowResolution, frameSetLayout, shadowVertexModule,
+                                         settings.shadowDepthBiasConstant, settings.shadowDepthBiasSlope),
+                      "Cannot create shadow maps...", false)
+
+        VkDescriptorImageInfo shadowImageInfo{
+                .sampler = shadowMaps.getSampler(),
+                .imageView = shadowMaps.getImageView(),
+                .imageLayout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL
+        };
+
+        VkWriteDescriptorSet descriptorWrite{
+                .sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET,
+                .dstSet = frameDescriptorSet,
+                .dstBinding = 2,
+                .descriptorCount = 1,
+                .descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
+                .pImageInfo = &shadowImageInfo
+        };
+
+        vkUpdateDescriptorSets(vkDevice, 1, &descriptorWrite, 0, nullptr);
+
         return true;
     });
 
     auto createSemaphores([this]() {
+        VIE_TRACE_ZONE("createSemaphores");
+
         imageAvailableSemaphores.resize(settings.kMaxFramesInFlight);
         renderFinishedSemaphores.resize(settings.kMaxFramesInFlight);
         inFlightFences.resize(settings.kMaxFramesInFlight);
@@ -682,98 +1915,159 @@ bool VIEngine::prepareEngine() {
         return true;
     });
 
-    return_log_if(!initializeGlfw(), "Error initializeGlfw()", false)
-    engineStatus = VIEStatus::GLFW_LOADED;
+    return_log_if(!runStage("initializeGlfw", initializeGlfw, VIEStatus::GLFW_LOADED), "Error initializeGlfw()", false)
+
+    return_log_if(!runStage("createVulkanInstance", createVulkanInstance, VIEStatus::VULKAN_INSTANCE_CREATED),
+                  "Error createVulkanInstance()", false)
 
-    return_log_if(!createVulkanInstance(), "Error createVulkanInstance()", false)
-    engineStatus = VIEStatus::VULKAN_INSTANCE_CREATED;
+    return_log_if(!runStage("createWindowSurface", createWindowSurface, VIEStatus::VULKAN_SURFACE_CREATED),
+                  "Error createWindowSurface()", false)
 
-    return_log_if(!createWindowSurface(), "Error createWindowSurface()", false)
-    engineStatus = VIEStatus::VULKAN_SURFACE_CREATED;
+    return_log_if(!runStage("preparePhysicalDevice", preparePhysicalDevice,
+                           VIEStatus::VULKAN_PHYSICAL_DEVICES_PREPARED), "Error preparePhysicalDevice()", false)
 
-    return_log_if(!preparePhysicalDevice(), "Error preparePhysicalDevice()", false)
-    engineStatus = VIEStatus::VULKAN_PHYSICAL_DEVICES_PREPARED;
+    return_log_if(!runStage("prepareLogicalDevice", prepareLogicalDevice, VIEStatus::VULKAN_LOGICAL_DEVICE_CREATED),
+                  "Error prepareLogicalDevice()", false)
 
-    return_log_if(!prepareLogicalDevice(), "Error prepareLogicalDevice()", false)
-    engineStatus = VIEStatus::VULKAN_LOGICAL_DEVICE_CREATED;
+    return_log_if(!runStage("generateShaderModules", generateShaderModules, VIEStatus::VULKAN_SHADERS_COMPILED),
+                  "Error generateShaderModules()", false)
 
-    return_log_if(!generateShaderModules(), "Error generateShaderModules()", false)
-    engineStatus = VIEStatus::VULKAN_SHADERS_COMPILED;
+    return_log_if(!runStage("createCommandPool", createCommandPool, VIEStatus::VULKAN_COMMAND_POOL_CREATED),
+                  "Error createCommandPool()", false)
 
-    return_log_if(!createCommandPool(), "Error createCommandPool()", false)
-    engineStatus = VIEStatus::VULKAN_COMMAND_POOL_CREATED;
+    // Scene buffers are the first stage reading the scenario
+    if (scenarioLoad.isValid()) {
+        return_log_if(!runStage("waitForScenario", [&scenarioLoad]() {
+                          tools::waitForTask(scenarioLoad);
+                          return scenarioLoad.getResult();
+                      }), "Error loading scenario...", false)
+    }
+
+    return_log_if(!runStage("createSceneBuffers", createSceneBuffers), "Error createSceneBuffers()", false)
+
+    return_log_if(!runStage("createBindlessResources", createBindlessResources), "Error createBindlessResources()",
+                  false)
+
+    return_log_if(!runStage("createFrameResources", createFrameResources), "Error createFrameResources()", false)
 
-    return_log_if(!generateRendererCore(), "Error generateRendererCore()", false)
-    engineStatus = VIEStatus::VULKAN_RENDERER_CORE_INIT;
+    return_log_if(!runStage("createShadowMaps", createShadowMaps), "Error createShadowMaps()", false)
 
-    return_log_if(!createSemaphores(), "Error createSemaphores()", false)
-    engineStatus = VIEStatus::VULKAN_SEMAPHORES_CREATED;
+    return_log_if(!runStage("generateRendererCore", [this]() {
+                      return generateRendererCore();
+                  }, VIEStatus::VULKAN_RENDERER_CORE_INIT), "Error generateRendererCore()", false)
+
+    return_log_if(!runStage("createSemaphores", createSemaphores, VIEStatus::VULKAN_SEMAPHORES_CREATED),
+                  "Error createSemaphores()", false)
+
+    log_info("Engine prepared in {:.1f} ms", std::chrono::duration<double, std::milli>(
+            std::chrono::steady_clock::now() - startTime).count());
+
+    for (const auto &[name, time]: stageTimes) {
+        log_info("  {}: {:.1f} ms", name, time);
+    }
+
+    // Frames are drawn (without textures) while the textures are loaded
+    textureStream = streamTextures(loadStopSource.get_token());
+    textureStream.start();
 
     return true;
 }
 
-void VIEngine::runEngine() {
+void VIEngine::runEngine(uint64_t frameLimit) {
     if (engineStatus < VIEStatus::VULKAN_SEMAPHORES_CREATED) {
         return;
     }
 
-    engineStatus = VIEStatus::VULKAN_ENGINE_RUNNING;
+    setStatus(VIEStatus::VULKAN_ENGINE_RUNNING);
+
+    if (!settings.startupReportLocation.empty()) {
+        writeStatusReport(settings.startupReportLocation);
+    }
 
     // TODO create function for defining key and mouse inputs
-    while (!glfwWindowShouldClose(glfwWindow)) {
+    for (uint64_t frame = 0; !glfwWindowShouldClose(glfwWindow) && (frameLimit == 0 || frame < frameLimit);
+         ++frame) {
         glfwPollEvents();
+        tools::runMainThreadJobs();
 
         if (!drawFrame()) {
-            std::cout << "Error drawing frame..." << std::endl;
+            log_error("Error drawing frame...");
         }
     }
 
     vkDeviceWaitIdle(vkDevice);
 }
 
-// TODO make generic also for VR!!
 bool VIEngine::drawFrame() {
+    VIE_TRACE_ZONE("drawFrame");
+
     uint32_t imageIndex = 0;
 
-    vkWaitForFences(vkDevice, 1, &inFlightFences[currentFrame], VK_TRUE, UINT64_MAX);
+    {
+        VIE_TRACE_ZONE("wait fence");
+        vkWaitForFences(vkDevice, 1, &inFlightFences[currentFrame], VK_TRUE, UINT64_MAX);
+    }
+
+    VkResult acquireResult;
+    {
+        VIE_TRACE_ZONE("acquire");
+        acquireResult = vkAcquireNextImageKHR(vkDevice, swapChain, UINT64_MAX, imageAvailableSemaphores[currentFrame],
+                                              VK_NULL_HANDLE, &imageIndex);
+    }
 
     // TODO For framerate limiter https://vkguide.dev/docs/chapter-1/vulkan_mainloop_code/
-    if (VkResult result{vkAcquireNextImageKHR(vkDevice, swapChain, UINT64_MAX, imageAvailableSemaphores[currentFrame],
-                                              VK_NULL_HANDLE, &imageIndex)};
-            result == VK_ERROR_OUT_OF_DATE_KHR) {
+    if (VkResult result{acquireResult}; result == VK_ERROR_OUT_OF_DATE_KHR) {
         regenerateRendererCore();
         return true;
     } else if (result != VK_SUCCESS && result != VK_SUBOPTIMAL_KHR) {
-        std::cout << "Error acquiring next VkImage..." << std::endl;
+        log_error("Error acquiring next VkImage...");
         return false;
     }
 
     if (imagesInFlight[imageIndex] != VK_NULL_HANDLE) {
+        VIE_TRACE_ZONE("wait image fence");
         vkWaitForFences(vkDevice, 1, &imagesInFlight[imageIndex], VK_TRUE, UINT64_MAX);
     }
     imagesInFlight[imageIndex] = inFlightFences[currentFrame];
 
-    // TODO move as constant
-    std::array<VkPipelineStageFlags, 1> waitStages{VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT};
+    // The fence of this frame has been waited, so its region of the ring buffer is not read anymore
+    frameRingBuffer.beginFrame(currentFrame);
+    memoryBudget.update(vkPhysicalDevice);
+
+    FrameOffsets frameOffsets;
+    return_log_if(!writeFrameData(frameOffsets), "Error writing frame data...", false)
+    return_log_if(!recordCommandBuffer(commandBuffers[currentFrame], imageIndex, frameOffsets),
+                  "Error recording command buffer...", false)
+
+    // Stereo frames only write the swap chain image when copying the eyes
+    std::array<VkPipelineStageFlags, 1> waitStages{
+            settings.isStereoEnabled ? VK_PIPELINE_STAGE_TRANSFER_BIT : VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT
+    };
     VkSubmitInfo submitInfo{
             .sType = VK_STRUCTURE_TYPE_SUBMIT_INFO,
             .waitSemaphoreCount = 1,
             .pWaitSemaphores = &imageAvailableSemaphores[currentFrame],
             .pWaitDstStageMask = waitStages.data(),
             .commandBufferCount = 1,
-            .pCommandBuffers = &commandBuffers.at(imageIndex),
+            .pCommandBuffers = &commandBuffers[currentFrame],
             .signalSemaphoreCount = 1,
             .pSignalSemaphores = &renderFinishedSemaphores[currentFrame],
     };
 
     vkResetFences(vkDevice, 1, &inFlightFences[currentFrame]);
 
-    if (VkResult result{vkQueueSubmit(graphicsQueue, 1, &submitInfo, inFlightFences[currentFrame])};
+    VkResult submitResult;
+    {
+        VIE_TRACE_ZONE("submit");
+        submitResult = vkQueueSubmit(graphicsQueue, 1, &submitInfo, inFlightFences[currentFrame]);
+    }
+
+    if (VkResult result{submitResult};
             result == VK_ERROR_OUT_OF_DATE_KHR || result == VK_SUBOPTIMAL_KHR || isFramebufferResized) {
         isFramebufferResized = false;
         regenerateRendererCore();
     } else if (result != VK_SUCCESS) {
-        std::cout << "Cannot submit draw command buffer..." << std::endl;
+        log_error("Cannot submit draw command buffer...");
         return false;
     }
 
@@ -788,9 +2082,12 @@ bool VIEngine::drawFrame() {
             .pResults = nullptr
     };
 
-    vkQueuePresentKHR(presentQueue, &presentInfo);
+    {
+        VIE_TRACE_ZONE("present");
+        vkQueuePresentKHR(presentQueue, &presentInfo);
 
-    vkQueueWaitIdle(presentQueue);
+        vkQueueWaitIdle(presentQueue);
+    }
 
     ++currentFrame;
     if (currentFrame == settings.kMaxFramesInFlight) {
@@ -801,24 +2098,46 @@ bool VIEngine::drawFrame() {
 }
 
 void VIEngine::cleanSwapchain() {
+    // Handles are reset, so that cleanEngine does not destroy them again if the renderer core is not generated again
     for (VkFramebuffer &framebuffer: swapChainFramebuffers) {
         vkDestroyFramebuffer(vkDevice, framebuffer, nullptr);
     }
 
-    vkFreeCommandBuffers(vkDevice, commandPool, static_cast<uint32_t>(commandBuffers.size()), commandBuffers.data());
+    swapChainFramebuffers.clear();
+
+    vkDestroyFramebuffer(vkDevice, stereoFramebuffer, nullptr);
+    stereoFramebuffer = VK_NULL_HANDLE;
+    stereoTarget.destroy(vkDevice);
+    depthPyramid.destroy(vkDevice);
+    renderGraph.destroy(vkDevice);
+
+    if (!commandBuffers.empty()) {
+        vkFreeCommandBuffers(vkDevice, commandPool, static_cast<uint32_t>(commandBuffers.size()),
+                             commandBuffers.data());
+        commandBuffers.clear();
+    }
 
     vkDestroyPipeline(vkDevice, graphicsPipeline, nullptr);
+    vkDestroyPipeline(vkDevice, depthPipeline, nullptr);
+    graphicsPipeline = VK_NULL_HANDLE;
+    depthPipeline = VK_NULL_HANDLE;
     vkDestroyPipelineLayout(vkDevice, pipelineLayout, nullptr);
     vkDestroyRenderPass(vkDevice, renderPass, nullptr);
+    pipelineLayout = VK_NULL_HANDLE;
+    renderPass = VK_NULL_HANDLE;
 
     for (VkImageView& image: swapChainImageViews) {
         vkDestroyImageView(vkDevice, image, nullptr);
     }
 
+    swapChainImageViews.clear();
     vkDestroySwapchainKHR(vkDevice, swapChain, nullptr);
+    swapChain = VK_NULL_HANDLE;
 }
 
 void VIEngine::cleanEngine() {
+    cancelLoading();
+
     if (engineStatus >= VIEStatus::VULKAN_SEMAPHORES_CREATED) {
         for (uint8_t i = 0; i < settings.kMaxFramesInFlight; ++i) {
             vkDestroyFence(vkDevice, inFlightFences[i], nullptr);
@@ -829,6 +2148,31 @@ void VIEngine::cleanEngine() {
 
     if (engineStatus >= VIEStatus::VULKAN_COMMAND_POOL_CREATED) {
         vkDestroyCommandPool(vkDevice, commandPool, nullptr);
+
+        // Scene and frame resources are created with the command pool, null handles are ignored
+        vkDestroyDescriptorPool(vkDevice, descriptorPool, nullptr);
+        vkDestroyDescriptorSetLayout(vkDevice, frameSetLayout, nullptr);
+        frameRingBuffer.destroy(vkDevice);
+        geometryStreamer.destroy(vkDevice);
+        bindlessResources.destroy(vkDevice);
+        shadowMaps.destroy(vkDevice);
+        gpuProfiler.destroy(vkDevice);
+
+        for (VIETextureImage &textureImage: textureImages) {
+            textureImage.destroy(vkDevice);
+        }
+
+        vkDestroyBuffer(vkDevice, drawBuffer, nullptr);
+        vkFreeMemory(vkDevice, drawBufferMemory, nullptr);
+        vkDestroyBuffer(vkDevice, materialBuffer, nullptr);
+        vkFreeMemory(vkDevice, materialBufferMemory, nullptr);
+
+        vkDestroyBuffer(vkDevice, indexBuffer, nullptr);
+        vkFreeMemory(vkDevice, indexBufferMemory, nullptr);
+        vkDestroyBuffer(vkDevice, vertexBuffer, nullptr);
+        vkFreeMemory(vkDevice, vertexBufferMemory, nullptr);
+        vkDestroyBuffer(vkDevice, positionBuffer, nullptr);
+        vkFreeMemory(vkDevice, positionBufferMemory, nullptr);
     }
 
     if (engineStatus >= VIEStatus::VULKAN_FRAMEBUFFERS_CREATED) {
@@ -838,17 +2182,33 @@ void VIEngine::cleanEngine() {
     }
 
     if (engineStatus >= VIEStatus::VULKAN_GRAPHICS_PIPELINE_GENERATED) {
-        vkDestroyPipeline(vkDevice, graphicsPipeline, nullptr);
+        // Stereo target and render graph transients are created with the framebuffers, null handles are ignored
+        vkDestroyFramebuffer(vkDevice, stereoFramebuffer, nullptr);
+        stereoTarget.destroy(vkDevice);
+        depthPyramid.destroy(vkDevice);
+        renderGraph.destroy(vkDevice);
     }
 
-    if (engineStatus >= VIEStatus::VULKAN_PIPELINE_STATES_PREPARED) {
+    if (engineStatus >= VIEStatus::VULKAN_LOGICAL_DEVICE_CREATED) {
+        // A worker creates these along with the swap chain, so a failure of either leaves some of them created
+        // without reaching their status: null handles (never created, or destroyed by cleanSwapchain) are ignored
+        vkDestroyPipeline(vkDevice, graphicsPipeline, nullptr);
+        vkDestroyPipeline(vkDevice, depthPipeline, nullptr);
         vkDestroyPipelineLayout(vkDevice, pipelineLayout, nullptr);
+        vkDestroyRenderPass(vkDevice, renderPass, nullptr);
+        graphicsPipeline = VK_NULL_HANDLE;
+        depthPipeline = VK_NULL_HANDLE;
+        pipelineLayout = VK_NULL_HANDLE;
+        renderPass = VK_NULL_HANDLE;
     }
 
     if (engineStatus >= VIEStatus::VULKAN_SHADERS_COMPILED) {
         // TODO extend when having multiple VIEModules, shader modules
         vkDestroyShaderModule(vkDevice, vertexModule, nullptr);
         vkDestroyShaderModule(vkDevice, fragmentModule, nullptr);
+        vkDestroyShaderModule(vkDevice, depthVertexModule, nullptr);
+        vkDestroyShaderModule(vkDevice, depthPyramidModule, nullptr);
+        vkDestroyShaderModule(vkDevice, shadowVertexModule, nullptr);
     }
 
     if (engineStatus >= VIEStatus::VULKAN_IMAGE_VIEWS_CREATED) {
@@ -879,5 +2239,78 @@ void VIEngine::cleanEngine() {
         glfwTerminate();
     }
 
+    recordTiming(VIEStatus::UNINITIALISED, "cleanEngine");
     engineStatus = VIEStatus::UNINITIALISED;
 }
+
+bool VIEngine::captureStereoFrame(std::vector<uint8_t> &pixels) {
+    return_log_if(!settings.isStereoEnabled || engineStatus < VIEStatus::VULKAN_RENDERER_CORE_INIT,
+                  "Stereo rendering not available for capture...", false)
+
+    // The last frame left the eye layers in transfer source layout
+    vkDeviceWaitIdle(vkDevice);
+
+    return stereoTarget.readPixels(vkDevice, vkPhysicalDevice, commandPool, graphicsQueue, pixels);
+}
+
+void VIEngine::recordTiming(VIEStatus status, std::string_view stage) {
+    const auto now(std::chrono::steady_clock::now());
+    const double timeMs = std::chrono::duration<double, std::milli>(now - creationTime).count();
+
+    const size_t hostMemory = tools::getResidentMemory();
+    VkDeviceSize deviceMemory = 0;
+
+    // The device is already destroyed once uninitialised
+    if (memoryBudget.isTracked() && status != VIEStatus::UNINITIALISED) {
+        memoryBudget.update(vkPhysicalDevice);
+        deviceMemory = memoryBudget.getDeviceUsage();
+    }
+
+    statusTimings.emplace_back(VIEStatusTiming{
+            .status = status,
+            .stage = stage,
+            .timeMs = timeMs,
+            .durationMs = timeMs - (statusTimings.empty() ? 0.0 : statusTimings.back().timeMs),
+            .hostMemoryDelta = static_cast<int64_t>(hostMemory) - static_cast<int64_t>(lastHostMemory),
+            .deviceMemoryDelta = static_cast<int64_t>(deviceMemory) - static_cast<int64_t>(lastDeviceMemory)
+    });
+
+    log_verbose("Engine status {} after {} in {:.1f} ms", fromVIEStatusToString(status), stage,
+                statusTimings.back().durationMs);
+
+    lastHostMemory = hostMemory;
+    lastDeviceMemory = deviceMemory;
+}
+
+void VIEngine::setStatus(VIEStatus status, std::string_view stage) {
+    recordTiming(status, stage);
+
+    // Statuses are not reached in declaration order (the swap chain is created after the command pool), and cleaning
+    // relies on the furthest one
+    engineStatus = std::max(engineStatus, status);
+}
+
+bool VIEngine::writeStatusReport(const std::string &reportLocation) const {
+    std::ofstream reportFile(reportLocation);
+
+    if (!reportFile.is_open()) {
+        log_error("Cannot write status report {}", reportLocation);
+        return false;
+    }
+
+    std::string json(fmt::format("{{\"isDeviceMemoryTracked\": {}, \"statuses\": [\n", memoryBudget.isTracked()));
+
+    for (bool isFirst = true; const VIEStatusTiming &timing: statusTimings) {
+        json.append(isFirst ? "" : ",\n");
+        json.append(fmt::format(R"({{"status": "{}", "stage": "{}", "timeMs": {:.3f}, "durationMs": {:.3f}, )"
+                                R"("hostMemoryDelta": {}, "deviceMemoryDelta": {}}})",
+                                fromVIEStatusToString(timing.status), timing.stage, timing.timeMs,
+                                timing.durationMs, timing.hostMemoryDelta, timing.deviceMemoryDelta));
+        isFirst = false;
+    }
+
+    json.append("\n]}\n");
+    reportFile << json;
+
+    return true;
+}
@@ -0,0 +1,483 @@
+/* Created by LordRibblesdale on 18/10/2026.
+ * MIT License
+ */
+
+#include "structs/VIEBVH.hpp"
+#include "tools/VIEParallel.hpp"
+
+#include <array>
+#include <mutex>
+#include <iterator>
+#include <functional>
+#include <numeric>
+#include <algorithm>
+
+namespace {
+    constexpr uint32_t kMaxSAHLeafSize{16};         ///< Leaves up to this size are created when no split is cheaper
+    constexpr uint32_t kParallelBuildSize{4096};    ///< Nodes above this size are split with parallel binning
+
+    struct Bin {
+        VIEAABB bounds;
+        uint32_t count{0};
+    };
+
+    using AxisBins = std::array<std::array<Bin, VIEBVH::kBinCount>, 3>;
+
+    uint32_t getBin(float centroid, float minimum, float scale) {
+        return std::min(static_cast<uint32_t>((centroid - minimum) * scale), VIEBVH::kBinCount - 1);
+    }
+
+    // Entry distance of the ray in the box (or a value greater than maxDistance if missed)
+    float intersectRay(const VIEAABB &box, const glm::vec3 &origin, const glm::vec3 &inverseDirection,
+                       float maxDistance) {
+        const glm::vec3 t0((box.minimum - origin) * inverseDirection);
+        const glm::vec3 t1((box.maximum - origin) * inverseDirection);
+        const glm::vec3 entries(glm::min(t0, t1));
+        const glm::vec3 exits(glm::max(t0, t1));
+
+        const float entry = std::max({entries.x, entries.y, entries.z, 0.0f});
+        const float exit = std::min({exits.x, exits.y, exits.z, maxDistance});
+
+        return entry <= exit ? entry : std::numeric_limits<float>::max();
+    }
+
+    // -1 if the box is outside the frustum, 1 if completely inside, 0 otherwise
+    int classifyBox(const VIEAABB &box, const VIEFrustum &frustum) {
+        int result = 1;
+
+        for (const glm::vec4 &plane: frustum.planes) {
+            const glm::vec3 normal(plane);
+            const glm::vec3 positive(normal.x >= 0 ? box.maximum.x : box.minimum.x,
+                                     normal.y >= 0 ? box.maximum.y : box.minimum.y,
+                                     normal.z >= 0 ? box.maximum.z : box.minimum.z);
+
+            if (glm::dot(normal, positive) + plane.w < 0.0f) {
+                return -1;
+            }
+
+            const glm::vec3 negative(normal.x >= 0 ? box.minimum.x : box.maximum.x,
+                                     normal.y >= 0 ? box.minimum.y : box.maximum.y,
+                                     normal.z >= 0 ? box.minimum.z : box.maximum.z);
+
+            if (glm::dot(normal, negative) + plane.w < 0.0f) {
+                result = 0;
+            }
+        }
+
+        return result;
+    }
+}
+
+bool VIEBVH::splitNode(std::vector<Node> &treeNodes, uint32_t node, uint32_t first, uint32_t count,
+                       const std::vector<glm::vec3> &centroids, bool isParallel, uint32_t &split) {
+    VIEAABB bounds;
+    VIEAABB centroidBounds;
+
+    // Big nodes are processed in batches, merged under a lock
+    std::mutex mergeMutex;
+    auto forEachBatch([isParallel, count](const std::function<void(size_t, size_t)> &batch) {
+        if (isParallel && count >= kParallelBuildSize) {
+            tools::parallelFor(count, kParallelBuildSize, batch);
+        } else {
+            batch(0, count);
+        }
+    });
+
+    forEachBatch([&](size_t begin, size_t end) {
+        VIEAABB batchBounds;
+        VIEAABB batchCentroids;
+
+        for (size_t i = first + begin; i < first + end; ++i) {
+            batchBounds.extend(primitiveBounds[primitiveIndices[i]]);
+            batchCentroids.extend(centroids[primitiveIndices[i]]);
+        }
+
+        std::scoped_lock lock(mergeMutex);
+        bounds.extend(batchBounds);
+        centroidBounds.extend(batchCentroids);
+    });
+
+    treeNodes[node].bounds = bounds;
+    treeNodes[node].firstChild = first;
+    treeNodes[node].primitiveCount = count;
+
+    if (count <= kMaxLeafSize) {
+        return false;
+    }
+
+    const glm::vec3 extent(centroidBounds.maximum - centroidBounds.minimum);
+    std::array<float, 3> scales{};
+    for (int axis = 0; axis < 3; ++axis) {
+        scales[axis] = extent[axis] > 0.0f ? static_cast<float>(kBinCount) / extent[axis] : 0.0f;
+    }
+
+    AxisBins bins{};
+
+    forEachBatch([&](size_t begin, size_t end) {
+        AxisBins batchBins{};
+
+        for (size_t i = first + begin; i < first + end; ++i) {
+            const uint32_t primitive = primitiveIndices[i];
+
+            for (int axis = 0; axis < 3; ++axis) {
+                if (scales[axis] > 0.0f) {
+                    Bin &bin = batchBins[axis][getBin(centroids[primitive][axis], centroidBounds.minimum[axis],
+                                                      scales[axis])];
+                    bin.bounds.extend(primitiveBounds[primitive]);
+                    ++bin.count;
+                }
+            }
+        }
+
+        std::scoped_lock lock(mergeMutex);
+        for (int axis = 0; axis < 3; ++axis) {
+            for (uint32_t b = 0; b < kBinCount; ++b) {
+                bins[axis][b].bounds.extend(batchBins[axis][b].bounds);
+                bins[axis][b].count += batchBins[axis][b].count;
+            }
+        }
+    });
+
+    // Sweeps from both sides, evaluating the SAH cost of the split after each bin
+    float bestCost = std::numeric_limits<float>::max();
+    int bestAxis = -1;
+    uint32_t bestBin = 0;
+
+    for (int axis = 0; axis < 3; ++axis) {
+        if (scales[axis] == 0.0f) {
+            continue;
+        }
+
+        std::array<float, kBinCount> rightCosts{};
+        VIEAABB rightBounds;
+        uint32_t rightCount = 0;
+
+        for (uint32_t b = kBinCount - 1; b > 0; --b) {
+            rightBounds.extend(bins[axis][b].bounds);
+            rightCount += bins[axis][b].count;
+            rightCosts[b] = rightCount > 0 ? rightBounds.getSurfaceArea() * static_cast<float>(rightCount) : -1.0f;
+        }
+
+        VIEAABB leftBounds;
+        uint32_t leftCount = 0;
+
+        for (uint32_t b = 1; b < kBinCount; ++b) {
+            leftBounds.extend(bins[axis][b - 1].bounds);
+            leftCount += bins[axis][b - 1].count;
+
+            if (leftCount == 0 || rightCosts[b] < 0.0f) {
+                continue;
+            }
+
+            const float cost = leftBounds.getSurfaceArea() * static_cast<float>(leftCount) + rightCosts[b];
+            if (cost < bestCost) {
+                bestCost = cost;
+                bestAxis = axis;
+                bestBin = b;
+            }
+        }
+    }
+
+    auto range(primitiveIndices.begin() + first);
+
+    if (bestAxis < 0) {
+        // Every centroid is in the same point: small nodes become leaves, big ones are split in half
+        if (count <= kMaxSAHLeafSize) {
+            return false;
+        }
+
+        split = count / 2;
+    } else {
+        if (bestCost >= bounds.getSurfaceArea() * static_cast<float>(count) && count <= kMaxSAHLeafSize) {
+            return false;
+        }
+
+        auto middle = std::partition(range, range + count, [&](uint32_t primitive) {
+            return getBin(centroids[primitive][bestAxis], centroidBounds.minimum[bestAxis], scales[bestAxis]) <
+                   bestBin;
+        });
+
+        split = static_cast<uint32_t>(middle - range);
+    }
+
+    const auto left = static_cast<uint32_t>(treeNodes.size());
+    treeNodes.resize(treeNodes.size() + 2);
+    treeNodes[node].firstChild = left;
+    treeNodes[node].primitiveCount = 0;
+
+    return true;
+}
+
+void VIEBVH::buildSubtree(std::vector<Node> &treeNodes, uint32_t first, uint32_t count,
+                          const std::vector<glm::vec3> &centroids) {
+    struct Task {
+        uint32_t node;
+        uint32_t first;
+        uint32_t count;
+    };
+
+    std::vector<Task> stack{{0, first, count}};
+
+    while (!stack.empty()) {
+        Task task(stack.back());
+        stack.pop_back();
+
+        uint32_t split = 0;
+        if (splitNode(treeNodes, task.node, task.first, task.count, centroids, false, split)) {
+            const uint32_t left = treeNodes[task.node].firstChild;
+            stack.push_back({left, task.first, split});
+            stack.push_back({left + 1, task.first + split, task.count - split});
+        }
+    }
+}
+
+void VIEBVH::build(std::span<const VIEAABB> bounds) {
+    primitiveBounds.assign(bounds.begin(), bounds.end());
+    primitiveIndices.resize(bounds.size());
+    std::iota(primitiveIndices.begin(), primitiveIndices.end(), 0);
+    nodes.clear();
+    builtRootArea = 0.0f;
+
+    if (bounds.empty()) {
+        return;
+    }
+
+    std::vector<glm::vec3> centroids(bounds.size());
+    tools::parallelFor(bounds.size(), kParallelBuildSize, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            centroids[i] = bounds[i].getCenter();
+        }
+    });
+
+    struct Task {
+        uint32_t node;
+        uint32_t first;
+        uint32_t count;
+    };
+
+    // Top levels are split one at a time (biggest first), until there are enough subtrees to keep workers busy
+    nodes.resize(1);
+    std::vector<Task> tasks{{0, 0, static_cast<uint32_t>(bounds.size())}};
+    const size_t subtreeCount = tools::getWorkerCount() * 4;
+
+    while (tasks.size() < subtreeCount) {
+        auto biggest = std::ranges::max_element(tasks, {}, &Task::count);
+
+        if (biggest->count < kParallelBuildSize) {
+            break;
+        }
+
+        Task task(*biggest);
+        tasks.erase(biggest);
+
+        uint32_t split = 0;
+        if (splitNode(nodes, task.node, task.first, task.count, centroids, true, split)) {
+            const uint32_t left = nodes[task.node].firstChild;
+            tasks.push_back({left, task.first, split});
+            tasks.push_back({left + 1, task.first + split, task.count - split});
+        }
+    }
+
+    std::vector<std::vector<Node>> subtrees(tasks.size());
+
+    tools::parallelFor(tasks.size(), 1, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            subtrees[i].resize(1);
+            buildSubtree(subtrees[i], tasks[i].first, tasks[i].count, centroids);
+        }
+    });
+
+    // Subtree roots replace their placeholder, the other nodes are appended (keeping children adjacent)
+    for (size_t i = 0; i < tasks.size(); ++i) {
+        const auto base = static_cast<uint32_t>(nodes.size());
+        auto relocate([base](Node node) {
+            if (!node.isLeaf()) {
+                node.firstChild = base + node.firstChild - 1;
+            }
+
+            return node;
+        });
+
+        nodes[tasks[i].node] = relocate(subtrees[i].front());
+        std::transform(subtrees[i].begin() + 1, subtrees[i].end(), std::back_inserter(nodes), relocate);
+    }
+
+    builtRootArea = nodes.front().bounds.getSurfaceArea();
+}
+
+bool VIEBVH::refit(std::span<const VIEAABB> bounds) {
+    if (bounds.size() != primitiveBounds.size()) {
+        return false;
+    }
+
+    std::copy(bounds.begin(), bounds.end(), primitiveBounds.begin());
+
+    // Children follow their parent, so a reverse pass updates them first
+    for (size_t i = nodes.size(); i-- > 0;) {
+        Node &node = nodes[i];
+        node.bounds = VIEAABB{};
+
+        if (node.isLeaf()) {
+            for (uint32_t p = node.firstChild; p < node.firstChild + node.primitiveCount; ++p) {
+                node.bounds.extend(primitiveBounds[primitiveIndices[p]]);
+            }
+        } else {
+            node.bounds.extend(nodes[node.firstChild].bounds);
+            node.bounds.extend(nodes[node.firstChild + 1].bounds);
+        }
+    }
+
+    return true;
+}
+
+void VIEBVH::queryFrustum(const VIEFrustum &frustum, std::vector<uint32_t> &results) const {
+    if (nodes.empty()) {
+        return;
+    }
+
+    // Nodes with a flag telling whether they are completely inside (no more tests needed)
+    std::vector<std::pair<uint32_t, bool>> stack{{0, false}};
+
+    while (!stack.empty()) {
+        auto [index, isInside] = stack.back();
+        stack.pop_back();
+
+        const Node &node = nodes[index];
+
+        if (!isInside) {
+            const int classification = classifyBox(node.bounds, frustum);
+
+            if (classification < 0) {
+                continue;
+            }
+
+            isInside = classification > 0;
+        }
+
+        if (node.isLeaf()) {
+            for (uint32_t p = node.firstChild; p < node.firstChild + node.primitiveCount; ++p) {
+                if (isInside || classifyBox(primitiveBounds[primitiveIndices[p]], frustum) >= 0) {
+                    results.push_back(primitiveIndices[p]);
+                }
+            }
+        } else {
+            stack.emplace_back(node.firstChild, isInside);
+            stack.emplace_back(node.firstChild + 1, isInside);
+        }
+    }
+}
+
+void VIEBVH::querySphere(const glm::vec3 &center, float radius, std::vector<uint32_t> &results) const {
+    std::vector<uint32_t> stack;
+    if (!nodes.empty()) {
+        stack.push_back(0);
+    }
+
+    while (!stack.empty()) {
+        const Node &node = nodes[stack.back()];
+        stack.pop_back();
+
+        if (!node.bounds.overlapsSphere(center, radius)) {
+            continue;
+        }
+
+        if (node.isLeaf()) {
+            for (uint32_t p = node.firstChild; p < node.firstChild + node.primitiveCount; ++p) {
+                if (primitiveBounds[primitiveIndices[p]].overlapsSphere(center, radius)) {
+                    results.push_back(primitiveIndices[p]);
+                }
+            }
+        } else {
+            stack.push_back(node.firstChild);
+            stack.push_back(node.firstChild + 1);
+        }
+    }
+}
+
+void VIEBVH::queryBox(const VIEAABB &box, std::vector<uint32_t> &results) const {
+    std::vector<uint32_t> stack;
+    if (!nodes.empty()) {
+        stack.push_back(0);
+    }
+
+    while (!stack.empty()) {
+        const Node &node = nodes[stack.back()];
+        stack.pop_back();
+
+        if (!node.bounds.overlaps(box)) {
+            continue;
+        }
+
+        if (node.isLeaf()) {
+            for (uint32_t p = node.firstChild; p < node.firstChild + node.primitiveCount; ++p) {
+                if (primitiveBounds[primitiveIndices[p]].overlaps(box)) {
+                    results.push_back(primitiveIndices[p]);
+                }
+            }
+        } else {
+            stack.push_back(node.firstChild);
+            stack.push_back(node.firstChild + 1);
+        }
+    }
+}
+
+bool VIEBVH::raycast(const glm::vec3 &origin, const glm::vec3 &direction, float &distance,
+                     uint32_t &primitive) const {
+    if (nodes.empty()) {
+        return false;
+    }
+
+    const glm::vec3 inverseDirection(1.0f / direction.x, 1.0f / direction.y, 1.0f / direction.z);
+    float closest = distance;
+    bool isHit = false;
+
+    // Nodes with their entry distance, the nearest child is visited first
+    std::vector<std::pair<uint32_t, float>> stack;
+    if (float entry = intersectRay(nodes.front().bounds, origin, inverseDirection, closest); entry <= closest) {
+        stack.emplace_back(0, entry);
+    }
+
+    while (!stack.empty()) {
+        auto [index, entry] = stack.back();
+        stack.pop_back();
+
+        if (entry > closest) {
+            continue;
+        }
+
+        const Node &node = nodes[index];
+
+        if (node.isLeaf()) {
+            for (uint32_t p = node.firstChild; p < node.firstChild + node.primitiveCount; ++p) {
+                const float hit = intersectRay(primitiveBounds[primitiveIndices[p]], origin, inverseDirection,
+                                               closest);
+
+                if (hit <= closest) {
+                    closest = hit;
+                    primitive = primitiveIndices[p];
+                    isHit = true;
+                }
+            }
+
+            continue;
+        }
+
+        const float left = intersectRay(nodes[node.firstChild].bounds, origin, inverseDirection, closest);
+        const float right = intersectRay(nodes[node.firstChild + 1].bounds, origin, inverseDirection, closest);
+        const bool isLeftNearer = left <= right;
+
+        if (std::max(left, right) <= closest) {
+            stack.emplace_back(isLeftNearer ? node.firstChild + 1 : node.firstChild, std::max(left, right));
+        }
+
+        if (std::min(left, right) <= closest) {
+            stack.emplace_back(isLeftNearer ? node.firstChild : node.firstChild + 1, std::min(left, right));
+        }
+    }
+
+    if (isHit) {
+        distance = closest;
+    }
+
+    return isHit;
+}
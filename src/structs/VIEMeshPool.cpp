@@ -0,0 +1,318 @@
+/* Created by LordRibblesdale on 18/10/2026.
+ * MIT License
+ */
+
+#include "structs/VIEMeshPool.hpp"
+
+#include <algorithm>
+#include <utility>
+
+bool VIEMeshPool::isRecordInArena(const VIEMesh &mesh) const {
+    return size_t(mesh.firstVertex) + mesh.vertexCount <= vertices.size() &&
+           size_t(mesh.firstIndex) + mesh.getIndexSpan() <= indices.size() &&
+           size_t(mesh.firstMeshlet) + mesh.meshletCount <= meshlets.size();
+}
+
+bool VIEMeshPool::isRangeValid(const VIEMeshRange &range) const {
+    if (!range.first.isValid() || size_t(range.first.index) + range.count > meshes.size() ||
+        generations[range.first.index] != range.first.generation) {
+        return false;
+    }
+
+    // Slots of a range are released together, but a single record out of its arena would be read out of bounds
+    for (uint32_t slot = range.first.index; slot < range.first.index + range.count; ++slot) {
+        if (!aliveRecords[slot] || !isRecordInArena(meshes[slot])) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+VIEMeshRange VIEMeshPool::createMeshes(uint32_t count) {
+    if (count == 0) {
+        return {};
+    }
+
+    uint32_t first;
+
+    // First-fit over released slots, otherwise the records are appended
+    if (auto freeRange = std::ranges::find_if(freeRanges, [count](const auto &range) {
+            return range.second >= count;
+        }); freeRange != freeRanges.end()) {
+        first = freeRange->first;
+
+        if (freeRange->second == count) {
+            freeRanges.erase(freeRange);
+        } else {
+            freeRange->first += count;
+            freeRange->second -= count;
+        }
+    } else {
+        first = static_cast<uint32_t>(meshes.size());
+
+        meshes.resize(meshes.size() + count);
+        generations.resize(meshes.size(), 0);
+        aliveRecords.resize(meshes.size(), 0);
+    }
+
+    for (uint32_t slot = first; slot < first + count; ++slot) {
+        meshes[slot] = VIEMesh{};
+        aliveRecords[slot] = 1;
+    }
+
+    return VIEMeshRange{.first = {first, generations[first]}, .count = count};
+}
+
+void VIEMeshPool::releaseMeshes(const VIEMeshRange &range) {
+    if (!isRangeValid(range)) {
+        return;
+    }
+
+    for (uint32_t slot = range.first.index; slot < range.first.index + range.count; ++slot) {
+        releasedVertices += meshes[slot].vertexCount;
+        releasedIndices += meshes[slot].getIndexSpan();
+        releasedMeshlets += meshes[slot].meshletCount;
+
+        meshes[slot] = VIEMesh{};
+        aliveRecords[slot] = 0;
+        ++generations[slot];
+    }
+
+    // Keeping free ranges sorted and merged, so that big ranges can be reused
+    auto position = std::ranges::lower_bound(freeRanges, range.first.index, {},
+                                             [](const auto &freeRange) { return freeRange.first; });
+    position = freeRanges.emplace(position, range.first.index, range.count);
+
+    if (auto next = position + 1; next != freeRanges.end() && position->first + position->second == next->first) {
+        position->second += next->second;
+        freeRanges.erase(next);
+    }
+
+    if (position != freeRanges.begin()) {
+        if (auto previous = position - 1; previous->first + previous->second == position->first) {
+            previous->second += position->second;
+            freeRanges.erase(position);
+        }
+    }
+}
+
+bool VIEMeshPool::setGeometry(const VIEMeshHandle &handle, std::span<const VIEVertex> meshVertices,
+                              std::span<const uint32_t> meshIndices) {
+    VIEMesh *mesh = getMesh(handle);
+
+    if (!mesh) {
+        return false;
+    }
+
+    releasedVertices += mesh->vertexCount;
+    releasedIndices += mesh->getIndexSpan();
+    releasedMeshlets += mesh->meshletCount;
+
+    mesh->firstVertex = static_cast<uint32_t>(vertices.size());
+    mesh->vertexCount = static_cast<uint32_t>(meshVertices.size());
+    mesh->firstIndex = static_cast<uint32_t>(indices.size());
+    mesh->indexCount = static_cast<uint32_t>(meshIndices.size());
+    mesh->lods[0] = {0, mesh->indexCount, 0.0f};
+    mesh->lodCount = 1;
+    mesh->firstMeshlet = 0;
+    mesh->meshletCount = 0;
+
+    vertices.insert(vertices.end(), meshVertices.begin(), meshVertices.end());
+    indices.insert(indices.end(), meshIndices.begin(), meshIndices.end());
+
+    return true;
+}
+
+bool VIEMeshPool::setLods(const VIEMeshHandle &handle, std::span<const std::vector<uint32_t>> lodIndices,
+                          std::span<const float> lodErrors) {
+    VIEMesh *mesh = getMesh(handle);
+
+    if (!mesh || lodIndices.size() != lodErrors.size() || lodIndices.size() >= VIEMesh::kMaxLods) {
+        return false;
+    }
+
+    // Levels follow the full mesh indices, so the whole chain is moved at the end of the arena
+    std::vector<uint32_t> chain(indices.begin() + mesh->firstIndex,
+                                indices.begin() + mesh->firstIndex + mesh->indexCount);
+
+    releasedIndices += mesh->getIndexSpan();
+    mesh->lodCount = 1;
+
+    for (size_t level = 0; level < lodIndices.size(); ++level) {
+        mesh->lods[mesh->lodCount++] = {static_cast<uint32_t>(chain.size()),
+                                        static_cast<uint32_t>(lodIndices[level].size()), lodErrors[level]};
+        chain.insert(chain.end(), lodIndices[level].begin(), lodIndices[level].end());
+    }
+
+    mesh->firstIndex = static_cast<uint32_t>(indices.size());
+    indices.insert(indices.end(), chain.begin(), chain.end());
+
+    return true;
+}
+
+bool VIEMeshPool::setMeshlets(const VIEMeshHandle &handle, std::span<const VIEMeshlet> meshletData,
+                              std::span<const uint32_t> vertexData, std::span<const uint8_t> triangleData) {
+    VIEMesh *mesh = getMesh(handle);
+
+    if (!mesh) {
+        return false;
+    }
+
+    releasedMeshlets += mesh->meshletCount;
+
+    mesh->firstMeshlet = static_cast<uint32_t>(meshlets.size());
+    mesh->meshletCount = static_cast<uint32_t>(meshletData.size());
+
+    const auto vertexBase = static_cast<uint32_t>(meshletVertices.size());
+    const auto triangleBase = static_cast<uint32_t>(meshletTriangles.size());
+
+    for (VIEMeshlet meshlet: meshletData) {
+        meshlet.vertexOffset += vertexBase;
+        meshlet.triangleOffset += triangleBase;
+        meshlets.push_back(meshlet);
+    }
+
+    meshletVertices.insert(meshletVertices.end(), vertexData.begin(), vertexData.end());
+    meshletTriangles.insert(meshletTriangles.end(), triangleData.begin(), triangleData.end());
+
+    return true;
+}
+
+void VIEMeshPool::compactGeometry() {
+    if (releasedVertices == 0 && releasedIndices == 0 && releasedMeshlets == 0) {
+        return;
+    }
+
+    std::vector<VIEVertex> compactVertices;
+    std::vector<uint32_t> compactIndices;
+    compactVertices.reserve(vertices.size() - releasedVertices);
+    compactIndices.reserve(indices.size() - releasedIndices);
+
+    std::vector<VIEMeshlet> compactMeshlets;
+    std::vector<uint32_t> compactMeshletVertices;
+    std::vector<uint8_t> compactMeshletTriangles;
+    compactMeshlets.reserve(meshlets.size() - releasedMeshlets);
+
+    for (size_t slot = 0; VIEMesh &mesh: meshes) {
+        // Released records have no geometry, and a record out of the arena would be copied out of bounds
+        if (!aliveRecords[slot++] || !isRecordInArena(mesh)) {
+            continue;
+        }
+
+        if (mesh.vertexCount > 0) {
+            auto firstVertex = static_cast<uint32_t>(compactVertices.size());
+            auto firstIndex = static_cast<uint32_t>(compactIndices.size());
+
+            compactVertices.insert(compactVertices.end(), vertices.begin() + mesh.firstVertex,
+                                   vertices.begin() + mesh.firstVertex + mesh.vertexCount);
+            compactIndices.insert(compactIndices.end(), indices.begin() + mesh.firstIndex,
+                                  indices.begin() + mesh.firstIndex + mesh.getIndexSpan());
+
+            mesh.firstVertex = firstVertex;
+            mesh.firstIndex = firstIndex;
+        }
+
+        // Meshlet data of a mesh is contiguous, so it is moved as a block and the offsets are rebased
+        if (mesh.meshletCount > 0) {
+            const VIEMeshlet &first = meshlets[mesh.firstMeshlet];
+            const VIEMeshlet &last = meshlets[mesh.firstMeshlet + mesh.meshletCount - 1];
+            const uint32_t vertexEnd = last.vertexOffset + last.vertexCount;
+            const uint32_t triangleEnd = last.triangleOffset + last.getTriangleSpan();
+            const auto vertexBase = static_cast<uint32_t>(compactMeshletVertices.size());
+            const auto triangleBase = static_cast<uint32_t>(compactMeshletTriangles.size());
+
+            compactMeshletVertices.insert(compactMeshletVertices.end(),
+                                          meshletVertices.begin() + first.vertexOffset,
+                                          meshletVertices.begin() + vertexEnd);
+            compactMeshletTriangles.insert(compactMeshletTriangles.end(),
+                                           meshletTriangles.begin() + first.triangleOffset,
+                                           meshletTriangles.begin() + triangleEnd);
+
+            const uint32_t vertexShift = first.vertexOffset;
+            const uint32_t triangleShift = first.triangleOffset;
+            const auto firstMeshlet = static_cast<uint32_t>(compactMeshlets.size());
+
+            for (uint32_t i = 0; i < mesh.meshletCount; ++i) {
+                VIEMeshlet meshlet(meshlets[mesh.firstMeshlet + i]);
+                meshlet.vertexOffset = meshlet.vertexOffset - vertexShift + vertexBase;
+                meshlet.triangleOffset = meshlet.triangleOffset - triangleShift + triangleBase;
+                compactMeshlets.push_back(meshlet);
+            }
+
+            mesh.firstMeshlet = firstMeshlet;
+        }
+    }
+
+    vertices.swap(compactVertices);
+    indices.swap(compactIndices);
+    meshlets.swap(compactMeshlets);
+    meshletVertices.swap(compactMeshletVertices);
+    meshletTriangles.swap(compactMeshletTriangles);
+    releasedVertices = 0;
+    releasedIndices = 0;
+    releasedMeshlets = 0;
+}
+
+void VIEMeshPool::releaseGeometry() {
+    // Records stay alive (models still address them for their levels), but no longer reference any arena range
+    for (VIEMesh &mesh: meshes) {
+        mesh.firstVertex = 0;
+        mesh.vertexCount = 0;
+        mesh.firstIndex = 0;
+        mesh.indexCount = 0;
+
+        for (VIEMeshLod &lod: mesh.lods) {
+            lod.firstIndex = 0;
+            lod.indexCount = 0;
+        }
+    }
+
+    // Swapped with empty vectors, clearing would keep the capacity
+    std::vector<VIEVertex>().swap(vertices);
+    std::vector<uint32_t>().swap(indices);
+    releasedVertices = 0;
+    releasedIndices = 0;
+}
+
+void VIEMeshPool::reserveGeometry(size_t vertexCount, size_t indexCount) {
+    vertices.reserve(vertexCount);
+    indices.reserve(indexCount);
+}
+
+VIEMeshHandle VIEMeshPool::getHandle(const VIEMeshRange &range, uint32_t i) const {
+    if (!isRangeValid(range) || i >= range.count) {
+        return {};
+    }
+
+    return {range.first.index + i, generations[range.first.index + i]};
+}
+
+VIEMesh *VIEMeshPool::getMesh(const VIEMeshHandle &handle) {
+    return const_cast<VIEMesh *>(std::as_const(*this).getMesh(handle));
+}
+
+const VIEMesh *VIEMeshPool::getMesh(const VIEMeshHandle &handle) const {
+    if (!handle.isValid() || handle.index >= meshes.size() || !aliveRecords[handle.index] ||
+        generations[handle.index] != handle.generation) {
+        return nullptr;
+    }
+
+    return &meshes[handle.index];
+}
+
+std::span<VIEMesh> VIEMeshPool::getMeshes(const VIEMeshRange &range) {
+    if (!isRangeValid(range)) {
+        return {};
+    }
+
+    return {meshes.data() + range.first.index, range.count};
+}
+
+std::span<const VIEMesh> VIEMeshPool::getMeshes(const VIEMeshRange &range) const {
+    if (!isRangeValid(range)) {
+        return {};
+    }
+
+    return {meshes.data() + range.first.index, range.count};
+}
@@ -3,3 +3,196 @@
  */
 
 #include "structs/VIEModel.hpp"
+#include "tools/VIETrace.hpp"
+#include "tools/VIELogger.hpp"
+
+#include <limits>
+#include <algorithm>
+#include <glm/glm.hpp>
+#include <unordered_map>
+
+#define TINYOBJLOADER_IMPLEMENTATION
+#include <tiny_obj_loader.h>
+
+namespace {
+    struct IndexHash {
+        size_t operator()(const tinyobj::index_t &index) const {
+            size_t hash = std::hash<int>()(index.vertex_index);
+            hash ^= std::hash<int>()(index.normal_index) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+            hash ^= std::hash<int>()(index.texcoord_index) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+
+            return hash;
+        }
+    };
+
+    struct IndexEqual {
+        bool operator()(const tinyobj::index_t &a, const tinyobj::index_t &b) const {
+            return a.vertex_index == b.vertex_index && a.normal_index == b.normal_index &&
+                   a.texcoord_index == b.texcoord_index;
+        }
+    };
+
+    // Index of the texture in the scene textures, appending it if not referenced yet
+    uint32_t addTexture(const std::filesystem::path &directory, const std::string &textureName, bool isSRGB,
+                        std::vector<VIETextureData> &textures) {
+        if (textureName.empty()) {
+            return VIEMaterial::kNoTexture;
+        }
+
+        std::string location((directory / textureName).lexically_normal().string());
+
+        auto texture(std::ranges::find(textures, location, &VIETextureData::location));
+
+        if (texture == textures.end()) {
+            textures.push_back({.location = std::move(location), .isSRGB = isSRGB});
+            return static_cast<uint32_t>(textures.size() - 1);
+        }
+
+        return static_cast<uint32_t>(texture - textures.begin());
+    }
+}
+
+bool VIEModel::loadOBJ(const std::filesystem::path &objLocation, VIEMeshPool &meshPool,
+                       std::vector<VIEMaterial> &materials, std::vector<VIETextureData> &textures) {
+    VIE_TRACE_ZONE("loadOBJ");
+
+    tinyobj::ObjReaderConfig readerConfig;
+    readerConfig.triangulate = true;
+    readerConfig.mtl_search_path = objLocation.parent_path().string();
+
+    tinyobj::ObjReader reader;
+
+    if (!reader.ParseFromFile(objLocation.string(), readerConfig)) {
+        log_error("loadOBJ: {} not loaded. {}", objLocation.string(), reader.Error());
+        return false;
+    }
+
+    if (!reader.Warning().empty()) {
+        log_warning("loadOBJ: {}", reader.Warning());
+    }
+
+    const tinyobj::attrib_t &attributes = reader.GetAttrib();
+    const std::vector<tinyobj::shape_t> &shapes = reader.GetShapes();
+
+    if (shapes.empty()) {
+        log_error("loadOBJ: {} has no shapes.", objLocation.string());
+        return false;
+    }
+
+    // MTL materials, appended after the ones of previous models (texture names are relative to the MTL file)
+    const auto firstMaterial = static_cast<uint32_t>(materials.size());
+
+    for (const tinyobj::material_t &objMaterial: reader.GetMaterials()) {
+        VIEMaterial &material = materials.emplace_back();
+
+        material.diffuseColor = glm::vec4(objMaterial.diffuse[0], objMaterial.diffuse[1], objMaterial.diffuse[2],
+                                          objMaterial.dissolve);
+        material.specularColor = glm::vec4(objMaterial.specular[0], objMaterial.specular[1], objMaterial.specular[2],
+                                           objMaterial.shininess);
+
+        const std::filesystem::path &directory(objLocation.parent_path());
+
+        material.diffuseTexture = addTexture(directory, objMaterial.diffuse_texname, true, textures);
+        material.normalTexture = addTexture(directory, objMaterial.normal_texname.empty() ?
+                                                       objMaterial.bump_texname : objMaterial.normal_texname,
+                                            false, textures);
+        material.specularTexture = addTexture(directory, objMaterial.specular_texname, true, textures);
+    }
+
+    // A shape can use many materials: its faces are split into one mesh for each of them, in order of appearance
+    std::vector<std::vector<int>> shapeMaterials(shapes.size());
+    uint32_t meshCount = 0;
+
+    for (size_t i = 0; i < shapes.size(); ++i) {
+        for (int materialId: shapes[i].mesh.material_ids) {
+            if (std::ranges::find(shapeMaterials[i], materialId) == shapeMaterials[i].end()) {
+                shapeMaterials[i].push_back(materialId);
+            }
+        }
+
+        // Shapes without faces still get a (empty) mesh
+        if (shapeMaterials[i].empty()) {
+            shapeMaterials[i].push_back(-1);
+        }
+
+        meshCount += static_cast<uint32_t>(shapeMaterials[i].size());
+    }
+
+    meshes = meshPool.createMeshes(meshCount);
+
+    std::vector<VIEVertex> meshVertices;
+    std::vector<uint32_t> meshIndices;
+    std::unordered_map<tinyobj::index_t, uint32_t, IndexHash, IndexEqual> uniqueVertices;
+
+    for (uint32_t meshIndex = 0, shapeIndex = 0; const tinyobj::shape_t &shape: shapes) {
+        for (int materialId: shapeMaterials[shapeIndex]) {
+            meshVertices.clear();
+            meshIndices.clear();
+            uniqueVertices.clear();
+
+            for (size_t face = 0; face < shape.mesh.material_ids.size(); ++face) {
+                if (shape.mesh.material_ids[face] != materialId) {
+                    continue;
+                }
+
+                for (size_t corner = 3 * face; corner < 3 * face + 3; ++corner) {
+                    const tinyobj::index_t &index = shape.mesh.indices[corner];
+                    auto [vertex, isNew] = uniqueVertices.try_emplace(index,
+                                                                      static_cast<uint32_t>(meshVertices.size()));
+
+                    if (isNew) {
+                        VIEVertex &newVertex = meshVertices.emplace_back();
+
+                        newVertex.pos = glm::vec3(attributes.vertices[3 * index.vertex_index],
+                                                  attributes.vertices[3 * index.vertex_index + 1],
+                                                  attributes.vertices[3 * index.vertex_index + 2]);
+
+                        if (index.normal_index >= 0) {
+                            newVertex.normal = glm::vec3(attributes.normals[3 * index.normal_index],
+                                                         attributes.normals[3 * index.normal_index + 1],
+                                                         attributes.normals[3 * index.normal_index + 2]);
+                        }
+
+                        // OBJ texture coordinates start from the bottom, Vulkan ones from the top
+                        if (index.texcoord_index >= 0) {
+                            newVertex.uvCoords = glm::vec2(attributes.texcoords[2 * index.texcoord_index],
+                                                           1.0f - attributes.texcoords[2 * index.texcoord_index + 1]);
+                        }
+                    }
+
+                    meshIndices.push_back(vertex->second);
+                }
+            }
+
+            VIEMeshHandle handle(meshPool.getHandle(meshes, meshIndex++));
+            meshPool.setGeometry(handle, meshVertices, meshIndices);
+
+            // Faces without material (-1) use the default material
+            meshPool.getMesh(handle)->materialId = materialId < 0 ? 0 : firstMaterial + materialId;
+        }
+
+        ++shapeIndex;
+    }
+
+    // Bounding sphere around the box of every position, used to project the level of detail errors
+    boundingBox = VIEAABB{};
+
+    for (size_t i = 0; i + 2 < attributes.vertices.size(); i += 3) {
+        boundingBox.extend(glm::vec3(attributes.vertices[i], attributes.vertices[i + 1], attributes.vertices[i + 2]));
+    }
+
+    if (!boundingBox.isEmpty()) {
+        const glm::vec3 center(boundingBox.getCenter());
+        float radius = 0.0f;
+
+        for (size_t i = 0; i + 2 < attributes.vertices.size(); i += 3) {
+            radius = std::max(radius, glm::distance(center, glm::vec3(attributes.vertices[i],
+                                                                      attributes.vertices[i + 1],
+                                                                      attributes.vertices[i + 2])));
+        }
+
+        boundingSphere = glm::vec4(center, radius);
+    }
+
+    return true;
+}
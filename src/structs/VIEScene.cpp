@@ -3,3 +3,509 @@
  */
 
 #include "structs/VIEScene.hpp"
+#include "tools/VIEParallel.hpp"
+#include "tools/VIETextureLoader.hpp"
+#include "tools/VIEMeshSimplifier.hpp"
+#include "tools/VIEMeshlets.hpp"
+#include "tools/VIETrace.hpp"
+#include "tools/VIELogger.hpp"
+
+#include <array>
+#include <cmath>
+#include <utility>
+#include <algorithm>
+#include <filesystem>
+#include <pugixml.hpp>
+
+namespace {
+    constexpr size_t kHierarchyCullingCount{1 << 17};   ///< Instances from which culling descends the hierarchy
+    constexpr uint8_t kCulledLevel{VIEMesh::kMaxLods};  ///< Level of the instances outside every view frustum
+
+    glm::vec3 readVector(const pugi::xml_node &node, const char *x = "x", const char *y = "y", const char *z = "z",
+                         float defaultValue = 0.0f) {
+        return {node.attribute(x).as_float(defaultValue), node.attribute(y).as_float(defaultValue),
+                node.attribute(z).as_float(defaultValue)};
+    }
+
+    // Rotation, Scale and Translation children of a Model or Instance node
+    void readTransform(const pugi::xml_node &node, VIELocalTransform &transform) {
+        transform.localRotation.setAngles(glm::radians(readVector(node.child("Rotation"), "roll", "pitch", "yaw")));
+        transform.localScale.setScaleMatrix(readVector(node.child("Scale"), "x", "y", "z", 1.0f));
+        transform.localTranslation.setTranslationMatrix(readVector(node.child("Translation")));
+    }
+}
+
+bool VIEScene::loadFromXML(const std::string &scenarioLocation) {
+    VIE_TRACE_ZONE("loadFromXML");
+
+    pugi::xml_document xmlDocument;
+
+    if (pugi::xml_parse_result result(xmlDocument.load_file(scenarioLocation.c_str())); !result) {
+        log_error("loadFromXML: {} not loaded. {}", scenarioLocation, result.description());
+        return false;
+    }
+
+    pugi::xml_node root(xmlDocument.child("Scenario"));
+
+    // Counting nodes first, as big instanced scenarios would reallocate the scene graph many times
+    size_t nodeCount = 0;
+    for (const pugi::xml_node &modelNode: root.children("Model")) {
+        ++nodeCount;
+
+        for ([[maybe_unused]] const pugi::xml_node &instanceNode: modelNode.children("Instance")) {
+            ++nodeCount;
+        }
+    }
+
+    sceneGraph.reserve(sceneGraph.size() + nodeCount);
+    instanceNodes.reserve(instanceNodes.size() + nodeCount);
+
+    for (const pugi::xml_node &modelNode: root.children("Model")) {
+        VIEModel model;
+        model.keyName = modelNode.attribute("keyName").value();
+
+        std::filesystem::path objLocation(std::filesystem::path(modelNode.attribute("dir").value()) /
+                                          modelNode.attribute("file").value());
+        objLocation.replace_extension(".obj");
+
+        if (!model.loadOBJ(objLocation, meshPool, materials, textures)) {
+            log_error("loadFromXML: model {} skipped.", model.keyName);
+            continue;
+        }
+
+        readTransform(modelNode, model);
+        model.sceneNode = sceneGraph.addNode(VIESceneGraph::kNoParent, model.localTranslation.getTranslation(),
+                                             model.localRotation.getQuaternion(), model.localScale.getScale());
+        model.firstInstance = static_cast<uint32_t>(instanceNodes.size());
+
+        for (const pugi::xml_node &instanceNode: modelNode.children("Instance")) {
+            VIELocalTransform instance;
+            readTransform(instanceNode, instance);
+
+            instanceNodes.push_back(sceneGraph.addNode(model.sceneNode, instance.localTranslation.getTranslation(),
+                                                       instance.localRotation.getQuaternion(),
+                                                       instance.localScale.getScale()));
+        }
+
+        if (instanceNodes.size() == model.firstInstance) {
+            instanceNodes.push_back(model.sceneNode);
+        }
+
+        model.instanceCount = static_cast<uint32_t>(instanceNodes.size()) - model.firstInstance;
+        models.push_back(std::move(model));
+    }
+
+    // TODO handle multiple cameras (keyName)
+    if (pugi::xml_node cameraNode(root.child("Camera")); cameraNode) {
+        screenCamera = std::make_unique<VIECamera>();
+        screenCamera->center = glm::vec4(readVector(cameraNode.child("Eye")), 1.0f);
+        screenCamera->lookAt = glm::vec4(readVector(cameraNode.child("LookAt")), 1.0f);
+        screenCamera->up = glm::vec4(readVector(cameraNode.child("Up")), 0.0f);
+        screenCamera->updateView();
+    }
+
+    if (pugi::xml_node lightNode(root.child("Light")); lightNode) {
+        setLightDirection(readVector(lightNode.child("Direction"), "x", "y", "z", 1.0f));
+    }
+
+    updateInstances();
+
+    return true;
+}
+
+void VIEScene::loadTextures(VIEMipFilter filter, VIETextureCompression compression,
+                            const std::string &cacheDirectory) {
+    VIE_TRACE_ZONE("loadTextures");
+
+    if (tools::loadTextures(textures, filter, compression, cacheDirectory) == textures.size()) {
+        return;
+    }
+
+    // Compacting loaded textures and remapping material references
+    std::vector<uint32_t> remap(textures.size(), VIEMaterial::kNoTexture);
+    std::vector<VIETextureData> loadedTextures;
+
+    for (uint32_t i = 0; i < textures.size(); ++i) {
+        if (textures[i].isLoaded()) {
+            remap[i] = static_cast<uint32_t>(loadedTextures.size());
+            loadedTextures.push_back(std::move(textures[i]));
+        } else {
+            log_error("loadTextures: texture {} skipped.", textures[i].location);
+        }
+    }
+
+    for (VIEMaterial &material: materials) {
+        for (uint32_t *texture: {&material.diffuseTexture, &material.normalTexture, &material.specularTexture}) {
+            if (*texture != VIEMaterial::kNoTexture) {
+                *texture = remap[*texture];
+            }
+        }
+    }
+
+    textures = std::move(loadedTextures);
+}
+
+void VIEScene::generateLods(uint32_t maxLevels, float reductionRatio) {
+    VIE_TRACE_ZONE("generateLods");
+
+    maxLevels = std::min(maxLevels, VIEMesh::kMaxLods - 1);
+
+    std::vector<VIEMeshHandle> handles;
+    for (const VIEModel &model: models) {
+        for (uint32_t i = 0; i < model.meshes.count; ++i) {
+            handles.push_back(meshPool.getHandle(model.meshes, i));
+        }
+    }
+
+    // Meshes are simplified independently, while the arena is only modified afterwards
+    std::vector<std::vector<VIELodLevel>> meshLods(handles.size());
+
+    tools::parallelFor(handles.size(), 1, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            const VIEMesh *mesh = meshPool.getMesh(handles[i]);
+
+            if (mesh && mesh->indexCount > 0) {
+                std::span<const VIEVertex> vertices(meshPool.getVertices().data() + mesh->firstVertex,
+                                                    mesh->vertexCount);
+                std::span<const uint32_t> indices(meshPool.getIndices().data() + mesh->firstIndex, mesh->indexCount);
+
+                meshLods[i] = tools::generateLodChain(vertices, indices, maxLevels, reductionRatio);
+            }
+        }
+    });
+
+    for (size_t i = 0; i < handles.size(); ++i) {
+        std::vector<std::vector<uint32_t>> lodIndices;
+        std::vector<float> lodErrors;
+
+        for (VIELodLevel &level: meshLods[i]) {
+            lodIndices.push_back(std::move(level.indices));
+            lodErrors.push_back(level.error);
+        }
+
+        meshPool.setLods(handles[i], lodIndices, lodErrors);
+    }
+
+    meshPool.compactGeometry();
+
+    // Levels of a model are selected together for all its meshes, so the model keeps the worst error of each level
+    for (VIEModel &model: models) {
+        model.lodCount = 1;
+        model.lodErrors.fill(0.0f);
+
+        for (const VIEMesh &mesh: meshPool.getMeshes(model.meshes)) {
+            model.lodCount = std::max(model.lodCount, mesh.lodCount);
+
+            for (uint32_t level = 0; level < VIEMesh::kMaxLods; ++level) {
+                const float error = mesh.lods[std::min(level, mesh.lodCount - 1)].error;
+                model.lodErrors[level] = std::max(model.lodErrors[level], error);
+            }
+        }
+    }
+}
+
+void VIEScene::generateMeshlets() {
+    VIE_TRACE_ZONE("generateMeshlets");
+
+    struct MeshletData {
+        std::vector<VIEMeshlet> meshlets;
+        std::vector<uint32_t> vertices;
+        std::vector<uint8_t> triangles;
+    };
+
+    std::vector<VIEMeshHandle> handles;
+    for (const VIEModel &model: models) {
+        for (uint32_t i = 0; i < model.meshes.count; ++i) {
+            handles.push_back(meshPool.getHandle(model.meshes, i));
+        }
+    }
+
+    std::vector<MeshletData> meshData(handles.size());
+
+    tools::parallelFor(handles.size(), 1, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            const VIEMesh *mesh = meshPool.getMesh(handles[i]);
+
+            if (mesh && mesh->indexCount > 0) {
+                std::span<const VIEVertex> vertices(meshPool.getVertices().data() + mesh->firstVertex,
+                                                    mesh->vertexCount);
+                std::span<const uint32_t> indices(meshPool.getIndices().data() + mesh->firstIndex, mesh->indexCount);
+
+                tools::buildMeshlets(vertices, indices, meshData[i].meshlets, meshData[i].vertices,
+                                     meshData[i].triangles);
+            }
+        }
+    });
+
+    for (size_t i = 0; i < handles.size(); ++i) {
+        meshPool.setMeshlets(handles[i], meshData[i].meshlets, meshData[i].vertices, meshData[i].triangles);
+    }
+
+    meshPool.compactGeometry();
+}
+
+void VIEScene::updateInstances(const glm::mat4x4 &viewProjection) {
+    VIE_TRACE_ZONE("updateInstances");
+
+    sceneGraph.updateWorldMatrices(viewProjection);
+
+    instanceMatrices.resize(instanceNodes.size());
+
+    tools::parallelFor(instanceNodes.size(), 4096, [this](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            instanceMatrices[i] = sceneGraph.getWorldMatrix(instanceNodes[i]);
+        }
+    });
+
+    const size_t instanceCount = instanceBounds.size();
+    instanceBounds.resize(instanceNodes.size());
+    instanceSpheres.resize(instanceNodes.size());
+
+    for (const VIEModel &model: models) {
+        tools::parallelFor(model.instanceCount, 4096, [&](size_t begin, size_t end) {
+            for (size_t i = model.firstInstance + begin; i < model.firstInstance + end; ++i) {
+                instanceBounds[i] = model.boundingBox.transform(instanceMatrices[i]);
+
+                const glm::vec3 center(instanceBounds[i].getCenter());
+                instanceSpheres.centerX[i] = center.x;
+                instanceSpheres.centerY[i] = center.y;
+                instanceSpheres.centerZ[i] = center.z;
+                instanceSpheres.radius[i] = glm::length(instanceBounds[i].maximum - center);
+            }
+        });
+    }
+
+    if (instanceCount != instanceBounds.size() || !instanceBVH.refit(instanceBounds) || instanceBVH.needsRebuild()) {
+        instanceBVH.build(instanceBounds);
+    }
+
+    // Newly loaded instances are static, while an instance moving for the first time leaves the static casters
+    bool areStaticCastersChanged = instanceDynamic.size() != instanceNodes.size();
+
+    if (areStaticCastersChanged) {
+        instanceDynamic.assign(instanceNodes.size(), 0);
+        dynamicInstanceCount = 0;
+    } else {
+        for (size_t i = 0; i < instanceNodes.size(); ++i) {
+            if (!instanceDynamic[i] && sceneGraph.isWorldDirty(instanceNodes[i])) {
+                instanceDynamic[i] = 1;
+                ++dynamicInstanceCount;
+                areStaticCastersChanged = true;
+            }
+        }
+    }
+
+    if (areStaticCastersChanged) {
+        ++staticCasterVersion;
+    }
+
+    updateShadowCasters();
+}
+
+void VIEScene::updateShadowCasters() {
+    uint32_t meshCount = 0;
+    for (const VIEModel &model: models) {
+        meshCount += model.meshes.count;
+    }
+
+    shadowInstanceMatrices.resize(instanceMatrices.size());
+    shadowDrawCommands.resize(2 * static_cast<size_t>(meshCount));
+
+    uint32_t command = 0;
+
+    for (const VIEModel &model: models) {
+        uint32_t staticCursor = model.firstInstance;
+        uint32_t staticCount = 0;
+
+        for (uint32_t i = model.firstInstance; i < model.firstInstance + model.instanceCount; ++i) {
+            staticCount += instanceDynamic[i] ? 0 : 1;
+        }
+
+        uint32_t dynamicCursor = model.firstInstance + staticCount;
+
+        for (uint32_t i = model.firstInstance; i < model.firstInstance + model.instanceCount; ++i) {
+            shadowInstanceMatrices[instanceDynamic[i] ? dynamicCursor++ : staticCursor++] = instanceMatrices[i];
+        }
+
+        // Shadows use the full meshes, their levels of detail are selected for the camera
+        for (const VIEMesh &mesh: meshPool.getMeshes(model.meshes)) {
+            VIEDrawCommand drawCommand{
+                    .indexCount = mesh.lods[0].indexCount,
+                    .instanceCount = staticCount,
+                    .firstIndex = mesh.firstIndex + mesh.lods[0].firstIndex,
+                    .vertexOffset = static_cast<int32_t>(mesh.firstVertex),
+                    .firstInstance = model.firstInstance,
+                    .materialId = mesh.materialId
+            };
+
+            shadowDrawCommands[command] = drawCommand;
+
+            drawCommand.instanceCount = model.instanceCount - staticCount;
+            drawCommand.firstInstance = model.firstInstance + staticCount;
+            shadowDrawCommands[meshCount + command] = drawCommand;
+
+            ++command;
+        }
+    }
+}
+
+size_t VIEScene::cullInstances(const VIEFrustum &frustum, std::vector<uint32_t> &visible) const {
+    VIE_TRACE_ZONE("cullInstances");
+
+    if (instanceBounds.size() < kHierarchyCullingCount || instanceBVH.getPrimitiveCount() != instanceBounds.size()) {
+        return tools::cullSpheres(frustum, instanceSpheres, visible);
+    }
+
+    // Subtrees outside the frustum are skipped as a whole, leaves come in tree order
+    visible.clear();
+    instanceBVH.queryFrustum(frustum, visible);
+    std::ranges::sort(visible);
+
+    return visible.size();
+}
+
+bool VIEScene::pickInstance(const glm::vec3 &origin, const glm::vec3 &direction, float &distance,
+                            uint32_t &instance) const {
+    return instanceBVH.getPrimitiveCount() == instanceBounds.size() &&
+           instanceBVH.raycast(origin, direction, distance, instance);
+}
+
+void VIEScene::updateEyeCameras(float interpupillaryDistance, float aspectRatio) {
+    if (!screenCamera) {
+        return;
+    }
+
+    if (!leftEyeCamera) {
+        leftEyeCamera = std::make_unique<VIECamera>();
+        rightEyeCamera = std::make_unique<VIECamera>();
+    }
+
+    const glm::vec3 forward(glm::normalize(glm::vec3(screenCamera->lookAt - screenCamera->center)));
+    const glm::vec4 offset(glm::normalize(glm::cross(forward, glm::vec3(screenCamera->up))) *
+                           (interpupillaryDistance * 0.5f), 0.0f);
+
+    // Parallel eye axes: both eyes keep the screen camera direction, instead of converging on its target
+    for (auto [camera, side]: {std::pair{leftEyeCamera.get(), -1.0f}, std::pair{rightEyeCamera.get(), 1.0f}}) {
+        *camera = *screenCamera;
+        camera->center += offset * side;
+        camera->lookAt += offset * side;
+        camera->updateView();
+        camera->updateProjection(aspectRatio);
+    }
+}
+
+std::vector<VIEDrawCommand> VIEScene::buildDrawCommands() const {
+    std::vector<VIEDrawCommand> drawCommands;
+
+    for (const VIEModel &model: models) {
+        for (const VIEMesh &mesh: meshPool.getMeshes(model.meshes)) {
+            for (uint32_t level = 0; level < model.lodCount; ++level) {
+                const VIEMeshLod &lod = mesh.lods[std::min(level, mesh.lodCount - 1)];
+
+                drawCommands.push_back({
+                        .indexCount = lod.indexCount,
+                        .instanceCount = level == 0 ? model.instanceCount : 0,
+                        .firstIndex = mesh.firstIndex + lod.firstIndex,
+                        .vertexOffset = static_cast<int32_t>(mesh.firstVertex),
+                        .firstInstance = model.firstInstance,
+                        .materialId = mesh.materialId
+                });
+            }
+        }
+    }
+
+    return drawCommands;
+}
+
+void VIEScene::updateLods(const VIECamera &camera, float viewportHeight, float errorThreshold,
+                          std::span<const VIEFrustum> frusta) {
+    VIE_TRACE_ZONE("updateLods");
+
+    if (frameDrawCommands.empty()) {
+        frameDrawCommands = buildDrawCommands();
+    }
+
+    // Instances are kept when within any of the views (the eyes of a stereo pair see slightly different regions)
+    instanceVisible.assign(instanceMatrices.size(), frusta.empty() ? 1 : 0);
+
+    for (const VIEFrustum &frustum: frusta) {
+        cullInstances(frustum, visibleInstances);
+
+        for (uint32_t instance: visibleInstances) {
+            instanceVisible[instance] = 1;
+        }
+    }
+
+    // Pixels covered by a model space unit at unit distance
+    const float projectionScale = viewportHeight / (2.0f * std::tan(glm::radians(camera.fieldOfView) * 0.5f));
+    const glm::vec3 eye(camera.center);
+
+    instanceLods.resize(instanceMatrices.size());
+    instanceCoverage.resize(instanceMatrices.size());
+    frameInstanceMatrices.resize(instanceMatrices.size());
+    modelLods.resize(models.size());
+    modelCoverage.resize(models.size());
+
+    for (const VIEModel &model: models) {
+        tools::parallelFor(model.instanceCount, 4096, [&](size_t begin, size_t end) {
+            for (size_t i = model.firstInstance + begin; i < model.firstInstance + end; ++i) {
+                if (!instanceVisible[i]) {
+                    instanceLods[i] = kCulledLevel;
+                    instanceCoverage[i] = 0.0f;
+                    continue;
+                }
+
+                const glm::mat4x4 &matrix = instanceMatrices[i];
+                const float scale = std::max({glm::length(glm::vec3(matrix[0])), glm::length(glm::vec3(matrix[1])),
+                                              glm::length(glm::vec3(matrix[2]))});
+                const glm::vec3 center(matrix * glm::vec4(glm::vec3(model.boundingSphere), 1.0f));
+                const float distance = std::max(glm::distance(center, eye) - model.boundingSphere.w * scale,
+                                                camera.nearPlane);
+
+                uint32_t level = 0;
+                while (level + 1 < model.lodCount &&
+                       model.lodErrors[level + 1] * scale * projectionScale / distance <= errorThreshold) {
+                    ++level;
+                }
+
+                instanceLods[i] = static_cast<uint8_t>(level);
+                instanceCoverage[i] = model.boundingSphere.w * scale * projectionScale / distance;
+            }
+        });
+    }
+
+    // Counting sort of the instances of each model by level (culled ones last), then one draw per level and mesh
+    size_t command = 0;
+
+    for (size_t m = 0; const VIEModel &model: models) {
+        std::array<uint32_t, kCulledLevel + 2> levelOffsets{};
+        modelLods[m] = static_cast<uint8_t>(model.lodCount - 1);
+        modelCoverage[m] = 0.0f;
+
+        for (uint32_t i = model.firstInstance; i < model.firstInstance + model.instanceCount; ++i) {
+            ++levelOffsets[instanceLods[i] + 1];
+            modelLods[m] = std::min(modelLods[m], instanceLods[i]);
+            modelCoverage[m] = std::max(modelCoverage[m], instanceCoverage[i]);
+        }
+
+        ++m;
+
+        for (uint32_t level = 0; level <= kCulledLevel; ++level) {
+            levelOffsets[level + 1] += levelOffsets[level];
+        }
+
+        std::array<uint32_t, kCulledLevel + 1> cursor{};
+        std::copy_n(levelOffsets.begin(), cursor.size(), cursor.begin());
+        for (uint32_t i = model.firstInstance; i < model.firstInstance + model.instanceCount; ++i) {
+            frameInstanceMatrices[model.firstInstance + cursor[instanceLods[i]]++] = instanceMatrices[i];
+        }
+
+        for (size_t mesh = 0; mesh < meshPool.getMeshes(model.meshes).size(); ++mesh) {
+            for (uint32_t level = 0; level < model.lodCount; ++level) {
+                VIEDrawCommand &drawCommand = frameDrawCommands[command++];
+                drawCommand.instanceCount = levelOffsets[level + 1] - levelOffsets[level];
+                drawCommand.firstInstance = model.firstInstance + levelOffsets[level];
+            }
+        }
+    }
+}
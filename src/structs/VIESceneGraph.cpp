@@ -0,0 +1,243 @@
+/* Created by LordRibblesdale on 18/10/2026.
+ * MIT License
+ */
+
+#include "structs/VIESceneGraph.hpp"
+#include "structs/transform/VIETransform.hpp"
+#include "tools/VIEParallel.hpp"
+
+#include <numeric>
+#include <algorithm>
+
+namespace {
+    template <typename T>
+    void gather(std::vector<T> &data, const std::vector<uint32_t> &sourceSlots) {
+        std::vector<T> sorted;
+        sorted.reserve(data.size());
+
+        for (uint32_t slot: sourceSlots) {
+            sorted.push_back(data[slot]);
+        }
+
+        data.swap(sorted);
+    }
+}
+
+uint32_t VIESceneGraph::addNode(uint32_t parentNode, const glm::vec3 &translation, const glm::quat &rotation,
+                                const glm::vec3 &scale) {
+    auto node = static_cast<uint32_t>(nodeToSlot.size());
+    auto slot = static_cast<uint32_t>(localTranslations.size());
+
+    uint32_t parentSlot = (parentNode == kNoParent) ? kNoParent : nodeToSlot[parentNode];
+
+    // Appending keeps the depth-first order only for roots or when the parent subtree ends at the last slot
+    if (!isOrderDirty && parentSlot != kNoParent && parentSlot + subtreeSizes[parentSlot] != slot) {
+        isOrderDirty = true;
+    }
+
+    localTranslations.push_back(translation);
+    localRotations.push_back(rotation);
+    localScales.push_back(scale);
+    parentSlots.push_back(parentSlot);
+    subtreeSizes.push_back(1);
+    worldMatrices.emplace_back(1.0f);
+    mvpMatrices.emplace_back(1.0f);
+    localDirty.push_back(1);
+    worldDirty.push_back(1);
+
+    nodeToSlot.push_back(slot);
+    slotToNode.push_back(node);
+    nodeParents.push_back(parentNode);
+
+    if (!isOrderDirty) {
+        for (uint32_t ancestor = parentSlot; ancestor != kNoParent; ancestor = parentSlots[ancestor]) {
+            ++subtreeSizes[ancestor];
+        }
+    }
+
+    isPartitionDirty = true;
+    isTransformDirty = true;
+
+    return node;
+}
+
+bool VIESceneGraph::setParent(uint32_t node, uint32_t parentNode) {
+    for (uint32_t ancestor = parentNode; ancestor != kNoParent; ancestor = nodeParents[ancestor]) {
+        if (ancestor == node) {
+            return false;
+        }
+    }
+
+    nodeParents[node] = parentNode;
+    isOrderDirty = true;
+    isPartitionDirty = true;
+    markDirty(node);
+
+    return true;
+}
+
+void VIESceneGraph::reserve(size_t nodeCount) {
+    localTranslations.reserve(nodeCount);
+    localRotations.reserve(nodeCount);
+    localScales.reserve(nodeCount);
+    parentSlots.reserve(nodeCount);
+    subtreeSizes.reserve(nodeCount);
+    localMatrices.reserve(nodeCount);
+    worldMatrices.reserve(nodeCount);
+    mvpMatrices.reserve(nodeCount);
+    localDirty.reserve(nodeCount);
+    worldDirty.reserve(nodeCount);
+    nodeToSlot.reserve(nodeCount);
+    slotToNode.reserve(nodeCount);
+    nodeParents.reserve(nodeCount);
+}
+
+void VIESceneGraph::sortSlots() {
+    const auto nodeCount = static_cast<uint32_t>(nodeParents.size());
+
+    // Children lists in compressed form (children of node n are in children[offsets[n], offsets[n + 1]))
+    std::vector<uint32_t> offsets(nodeCount + 1, 0);
+    for (uint32_t parent: nodeParents) {
+        if (parent != kNoParent) {
+            ++offsets[parent + 1];
+        }
+    }
+
+    std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+
+    std::vector<uint32_t> children(offsets.back());
+    std::vector<uint32_t> fill(offsets.begin(), offsets.end() - 1);
+    std::vector<uint32_t> roots;
+
+    for (uint32_t node = 0; node < nodeCount; ++node) {
+        if (uint32_t parent = nodeParents[node]; parent != kNoParent) {
+            children[fill[parent]++] = node;
+        } else {
+            roots.push_back(node);
+        }
+    }
+
+    // Depth-first (pre-order) visit, keeping siblings in node order
+    std::vector<uint32_t> order;
+    order.reserve(nodeCount);
+
+    std::vector<uint32_t> stack(roots.rbegin(), roots.rend());
+    while (!stack.empty()) {
+        uint32_t node = stack.back();
+        stack.pop_back();
+
+        order.push_back(node);
+
+        for (uint32_t i = offsets[node + 1]; i > offsets[node]; --i) {
+            stack.push_back(children[i - 1]);
+        }
+    }
+
+    std::vector<uint32_t> sourceSlots(nodeCount);
+    for (uint32_t slot = 0; slot < nodeCount; ++slot) {
+        sourceSlots[slot] = nodeToSlot[order[slot]];
+        nodeToSlot[order[slot]] = slot;
+    }
+
+    gather(localTranslations, sourceSlots);
+    gather(localRotations, sourceSlots);
+    gather(localScales, sourceSlots);
+    gather(worldMatrices, sourceSlots);
+    gather(mvpMatrices, sourceSlots);
+    gather(localDirty, sourceSlots);
+    gather(worldDirty, sourceSlots);
+    slotToNode = std::move(order);
+
+    for (uint32_t slot = 0; slot < nodeCount; ++slot) {
+        uint32_t parent = nodeParents[slotToNode[slot]];
+        parentSlots[slot] = (parent == kNoParent) ? kNoParent : nodeToSlot[parent];
+    }
+
+    // Parents precede children: accumulating backwards gives the subtree sizes
+    std::fill(subtreeSizes.begin(), subtreeSizes.end(), 1);
+    for (uint32_t slot = nodeCount; slot > 0; --slot) {
+        if (uint32_t parent = parentSlots[slot - 1]; parent != kNoParent) {
+            subtreeSizes[parent] += subtreeSizes[slot - 1];
+        }
+    }
+
+    isOrderDirty = false;
+    isPartitionDirty = true;
+}
+
+void VIESceneGraph::buildPartition() {
+    spineSlots.clear();
+    workRanges.clear();
+
+    const auto slotCount = static_cast<uint32_t>(subtreeSizes.size());
+
+    // Subtrees small enough become work items, bigger ones are split by processing their root serially first
+    for (uint32_t slot = 0; slot < slotCount;) {
+        if (subtreeSizes[slot] > partitionGrainSize) {
+            spineSlots.push_back(slot);
+            ++slot;
+            continue;
+        }
+
+        uint32_t last = slot + subtreeSizes[slot];
+
+        // Merging adjacent small subtrees, so that a flat scene does not produce one item per node
+        if (!workRanges.empty() && workRanges.back().second == slot &&
+            last - workRanges.back().first <= partitionGrainSize) {
+            workRanges.back().second = last;
+        } else {
+            workRanges.emplace_back(slot, last);
+        }
+
+        slot = last;
+    }
+
+    isPartitionDirty = false;
+}
+
+void VIESceneGraph::propagateRange(uint32_t first, uint32_t last, const glm::mat4x4 &viewProjection) {
+    for (uint32_t slot = first; slot < last; ++slot) {
+        uint32_t parent = parentSlots[slot];
+
+        // Parents precede children, so their dirty state is already known
+        worldDirty[slot] = localDirty[slot] | (parent == kNoParent ? 0 : worldDirty[parent]);
+        localDirty[slot] = 0;
+
+        if (worldDirty[slot]) {
+            worldMatrices[slot] = (parent == kNoParent) ? localMatrices[slot]
+                                                        : worldMatrices[parent] * localMatrices[slot];
+        }
+
+        mvpMatrices[slot] = viewProjection * worldMatrices[slot];
+    }
+}
+
+void VIESceneGraph::updateWorldMatrices(const glm::mat4x4 &viewProjection, uint32_t grainSize) {
+    if (isOrderDirty) {
+        sortSlots();
+    }
+
+    if (isPartitionDirty || grainSize != partitionGrainSize) {
+        partitionGrainSize = std::max(grainSize, 1u);
+        buildPartition();
+    }
+
+    // Every local matrix at once, split across workers (slots are sorted, so the arrays are in their final order)
+    if (isTransformDirty) {
+        localMatrices.resize(localTranslations.size());
+        transform::composeMatrices(localTranslations, localRotations, localScales, localMatrices);
+    }
+
+    // Roots of big subtrees are in slot order, so their parents are always already computed
+    for (uint32_t slot: spineSlots) {
+        propagateRange(slot, slot + 1, viewProjection);
+    }
+
+    tools::parallelFor(workRanges.size(), 1, [this, &viewProjection](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            propagateRange(workRanges[i].first, workRanges[i].second, viewProjection);
+        }
+    });
+
+    isTransformDirty = false;
+}
@@ -0,0 +1,46 @@
+/* Created by LordRibblesdale on 18/10/2026.
+ * MIT License
+ */
+
+#include "structs/transform/VIETransform.hpp"
+#include "tools/VIEParallel.hpp"
+
+namespace {
+    constexpr size_t kComposeGrainSize{4096};
+}
+
+glm::mat4x4 VIELocalTransform::getLocalMatrix() const {
+    return transform::composeMatrix(localTranslation.getTranslation(), localRotation.getQuaternion(),
+                                    localScale.getScale());
+}
+
+glm::mat4x4 VIEGlobalTransform::getGlobalMatrix() const {
+    return transform::composeMatrix(globalTranslation.getTranslation(), globalRotation.getQuaternion(),
+                                    globalScale.getScale());
+}
+
+void transform::composeMatrices(std::span<const VIELocalTransform> transforms, std::span<glm::mat4x4> matrices) {
+    tools::parallelFor(transforms.size(), kComposeGrainSize, [&transforms, &matrices](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            matrices[i] = transforms[i].getLocalMatrix();
+        }
+    });
+}
+
+void transform::composeMatrices(std::span<const VIEGlobalTransform> transforms, std::span<glm::mat4x4> matrices) {
+    tools::parallelFor(transforms.size(), kComposeGrainSize, [&transforms, &matrices](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            matrices[i] = transforms[i].getGlobalMatrix();
+        }
+    });
+}
+
+void transform::composeMatrices(std::span<const glm::vec3> translations, std::span<const glm::quat> rotations,
+                                std::span<const glm::vec3> scales, std::span<glm::mat4x4> matrices) {
+    tools::parallelFor(translations.size(), kComposeGrainSize,
+                       [&translations, &rotations, &scales, &matrices](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            matrices[i] = composeMatrix(translations[i], rotations[i], scales[i]);
+        }
+    });
+}
@@ -0,0 +1,488 @@
+/* Created by LordRibblesdale on 18/10/2026.
+ * MIT License
+ */
+
+#include "tools/VIEBlockCompression.hpp"
+#include "tools/VIEParallel.hpp"
+
+#include <array>
+#include <cmath>
+#include <limits>
+#include <algorithm>
+
+namespace {
+    using Block = std::array<std::array<float, 4>, 16>;     ///< 4x4 RGBA texels, row major
+
+    void fetchBlock(const uint8_t *level, uint32_t width, uint32_t height, uint32_t blockX, uint32_t blockY,
+                    Block &block) {
+        for (uint32_t y = 0; y < 4; ++y) {
+            const size_t row = std::min(blockY * 4 + y, height - 1);
+
+            for (uint32_t x = 0; x < 4; ++x) {
+                const uint8_t *texel = level + (row * width + std::min(blockX * 4 + x, width - 1)) * 4;
+
+                for (uint32_t channel = 0; channel < 4; ++channel) {
+                    block[y * 4 + x][channel] = texel[channel];
+                }
+            }
+        }
+    }
+
+    // Principal axis of the block texels (first channelCount channels) through power iteration on the covariance
+    std::array<float, 4> findPrincipalAxis(const Block &block, uint32_t channelCount, std::array<float, 4> &mean) {
+        mean.fill(0.0f);
+        for (const auto &texel: block) {
+            for (uint32_t c = 0; c < channelCount; ++c) {
+                mean[c] += texel[c] / 16.0f;
+            }
+        }
+
+        std::array<std::array<float, 4>, 4> covariance{};
+        for (const auto &texel: block) {
+            for (uint32_t i = 0; i < channelCount; ++i) {
+                for (uint32_t j = 0; j < channelCount; ++j) {
+                    covariance[i][j] += (texel[i] - mean[i]) * (texel[j] - mean[j]);
+                }
+            }
+        }
+
+        std::array<float, 4> axis{1.0f, 1.0f, 1.0f, channelCount > 3 ? 1.0f : 0.0f};
+
+        for (int iteration = 0; iteration < 8; ++iteration) {
+            std::array<float, 4> next{};
+            float length = 0.0f;
+
+            for (uint32_t i = 0; i < channelCount; ++i) {
+                for (uint32_t j = 0; j < channelCount; ++j) {
+                    next[i] += covariance[i][j] * axis[j];
+                }
+
+                length = std::max(length, std::abs(next[i]));
+            }
+
+            // Uniform blocks have no principal axis, any direction gives the same endpoints
+            if (length < 1e-6f) {
+                break;
+            }
+
+            for (uint32_t i = 0; i < channelCount; ++i) {
+                axis[i] = next[i] / length;
+            }
+        }
+
+        return axis;
+    }
+
+    // Extreme texels of the block projected on the principal axis
+    void findEndpoints(const Block &block, uint32_t channelCount, std::array<float, 4> &low,
+                       std::array<float, 4> &high) {
+        std::array<float, 4> mean{};
+        std::array<float, 4> axis(findPrincipalAxis(block, channelCount, mean));
+
+        float minProjection = std::numeric_limits<float>::max();
+        float maxProjection = std::numeric_limits<float>::lowest();
+
+        for (const auto &texel: block) {
+            float projection = 0.0f;
+            for (uint32_t c = 0; c < channelCount; ++c) {
+                projection += (texel[c] - mean[c]) * axis[c];
+            }
+
+            minProjection = std::min(minProjection, projection);
+            maxProjection = std::max(maxProjection, projection);
+        }
+
+        float axisLength = 0.0f;
+        for (uint32_t c = 0; c < channelCount; ++c) {
+            axisLength += axis[c] * axis[c];
+        }
+        axisLength = std::max(axisLength, 1e-6f);
+
+        for (uint32_t c = 0; c < 4; ++c) {
+            low[c] = std::clamp(mean[c] + axis[c] * minProjection / axisLength, 0.0f, 255.0f);
+            high[c] = std::clamp(mean[c] + axis[c] * maxProjection / axisLength, 0.0f, 255.0f);
+        }
+    }
+
+    float distance(const std::array<float, 4> &a, const std::array<float, 4> &b, uint32_t channelCount) {
+        float sum = 0.0f;
+        for (uint32_t c = 0; c < channelCount; ++c) {
+            sum += (a[c] - b[c]) * (a[c] - b[c]);
+        }
+
+        return sum;
+    }
+
+    // -- BC1 --
+
+    uint16_t packRGB565(const std::array<float, 4> &color) {
+        return static_cast<uint16_t>((static_cast<uint32_t>(std::lround(color[0] * 31.0f / 255.0f)) << 11) |
+                                     (static_cast<uint32_t>(std::lround(color[1] * 63.0f / 255.0f)) << 5) |
+                                     static_cast<uint32_t>(std::lround(color[2] * 31.0f / 255.0f)));
+    }
+
+    std::array<float, 4> unpackRGB565(uint16_t color) {
+        const uint32_t r = (color >> 11) & 31;
+        const uint32_t g = (color >> 5) & 63;
+        const uint32_t b = color & 31;
+
+        return {static_cast<float>((r << 3) | (r >> 2)), static_cast<float>((g << 2) | (g >> 4)),
+                static_cast<float>((b << 3) | (b >> 2)), 255.0f};
+    }
+
+    void encodeBC1(const Block &block, uint8_t *output) {
+        std::array<float, 4> low{};
+        std::array<float, 4> high{};
+        findEndpoints(block, 3, low, high);
+
+        // Insetting the endpoints, as extremes are rarely hit exactly by the interpolated colors
+        for (uint32_t c = 0; c < 3; ++c) {
+            const float inset = (high[c] - low[c]) / 16.0f;
+            low[c] = std::clamp(low[c] + inset, 0.0f, 255.0f);
+            high[c] = std::clamp(high[c] - inset, 0.0f, 255.0f);
+        }
+
+        uint16_t color0 = packRGB565(high);
+        uint16_t color1 = packRGB565(low);
+
+        // color0 > color1 selects the four color mode
+        if (color0 < color1) {
+            std::swap(color0, color1);
+        }
+
+        uint32_t indices = 0;
+
+        if (color0 != color1) {
+            const std::array<float, 4> endpoint0(unpackRGB565(color0));
+            const std::array<float, 4> endpoint1(unpackRGB565(color1));
+            std::array<std::array<float, 4>, 4> palette{endpoint0, endpoint1};
+
+            for (uint32_t c = 0; c < 3; ++c) {
+                palette[2][c] = (2.0f * endpoint0[c] + endpoint1[c]) / 3.0f;
+                palette[3][c] = (endpoint0[c] + 2.0f * endpoint1[c]) / 3.0f;
+            }
+
+            for (uint32_t i = 0; i < 16; ++i) {
+                uint32_t bestIndex = 0;
+                float bestDistance = std::numeric_limits<float>::max();
+
+                for (uint32_t p = 0; p < 4; ++p) {
+                    if (float d = distance(block[i], palette[p], 3); d < bestDistance) {
+                        bestDistance = d;
+                        bestIndex = p;
+                    }
+                }
+
+                indices |= bestIndex << (2 * i);
+            }
+        }
+
+        output[0] = static_cast<uint8_t>(color0);
+        output[1] = static_cast<uint8_t>(color0 >> 8);
+        output[2] = static_cast<uint8_t>(color1);
+        output[3] = static_cast<uint8_t>(color1 >> 8);
+
+        for (uint32_t i = 0; i < 4; ++i) {
+            output[4 + i] = static_cast<uint8_t>(indices >> (8 * i));
+        }
+    }
+
+    // -- BC4 (single channel, used by BC3 alpha and BC5) --
+
+    void encodeBC4(const Block &block, uint32_t channel, uint8_t *output) {
+        float minValue = 255.0f;
+        float maxValue = 0.0f;
+
+        for (const auto &texel: block) {
+            minValue = std::min(minValue, texel[channel]);
+            maxValue = std::max(maxValue, texel[channel]);
+        }
+
+        // endpoint0 > endpoint1 selects the eight value mode
+        const auto endpoint0 = static_cast<uint8_t>(std::lround(maxValue));
+        const auto endpoint1 = static_cast<uint8_t>(std::lround(minValue));
+
+        std::array<float, 8> palette{static_cast<float>(endpoint0), static_cast<float>(endpoint1)};
+        for (uint32_t i = 2; i < 8; ++i) {
+            palette[i] = (static_cast<float>(8 - i) * endpoint0 + static_cast<float>(i - 1) * endpoint1) / 7.0f;
+        }
+
+        uint64_t indices = 0;
+
+        if (endpoint0 != endpoint1) {
+            for (uint32_t i = 0; i < 16; ++i) {
+                uint64_t bestIndex = 0;
+                float bestDistance = std::numeric_limits<float>::max();
+
+                for (uint32_t p = 0; p < 8; ++p) {
+                    if (float d = std::abs(block[i][channel] - palette[p]); d < bestDistance) {
+                        bestDistance = d;
+                        bestIndex = p;
+                    }
+                }
+
+                indices |= bestIndex << (3 * i);
+            }
+        }
+
+        output[0] = endpoint0;
+        output[1] = endpoint1;
+
+        for (uint32_t i = 0; i < 6; ++i) {
+            output[2 + i] = static_cast<uint8_t>(indices >> (8 * i));
+        }
+    }
+
+    // -- BC7 (mode 6: single subset, RGBA 7.7.7.7 endpoints with unique P-bits, 4 bit indices) --
+
+    constexpr std::array<uint32_t, 16> kBC7Weights{0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64};
+
+    struct BitWriter {
+        uint8_t *output;
+        uint32_t position{0};
+
+        void write(uint32_t value, uint32_t bitCount) {
+            for (uint32_t bit = 0; bit < bitCount; ++bit, ++position) {
+                output[position / 8] |= static_cast<uint8_t>(((value >> bit) & 1) << (position % 8));
+            }
+        }
+    };
+
+    // Quantizes an endpoint to 7 bits per channel, choosing the P-bit (shared LSB) with the lowest error
+    void quantizeBC7Endpoint(const std::array<float, 4> &endpoint, std::array<uint32_t, 4> &quantized,
+                             uint32_t &pBit) {
+        float bestError = std::numeric_limits<float>::max();
+
+        for (uint32_t p = 0; p < 2; ++p) {
+            std::array<uint32_t, 4> candidate{};
+            float error = 0.0f;
+
+            for (uint32_t c = 0; c < 4; ++c) {
+                candidate[c] = static_cast<uint32_t>(std::clamp(std::lround((endpoint[c] - p) / 2.0f), 0l, 127l));
+                const float value = static_cast<float>((candidate[c] << 1) | p);
+                error += (value - endpoint[c]) * (value - endpoint[c]);
+            }
+
+            if (error < bestError) {
+                bestError = error;
+                quantized = candidate;
+                pBit = p;
+            }
+        }
+    }
+
+    // Chooses the closest palette entry for each texel, returning the total squared error
+    float findBC7Indices(const Block &block, const std::array<std::array<uint32_t, 4>, 2> &endpoints,
+                         const std::array<uint32_t, 2> &pBits, std::array<uint32_t, 16> &indices) {
+        std::array<std::array<float, 4>, 16> palette{};
+        for (uint32_t i = 0; i < 16; ++i) {
+            for (uint32_t c = 0; c < 4; ++c) {
+                const uint32_t e0 = (endpoints[0][c] << 1) | pBits[0];
+                const uint32_t e1 = (endpoints[1][c] << 1) | pBits[1];
+                palette[i][c] = static_cast<float>(((64 - kBC7Weights[i]) * e0 + kBC7Weights[i] * e1 + 32) >> 6);
+            }
+        }
+
+        float error = 0.0f;
+
+        for (uint32_t i = 0; i < 16; ++i) {
+            float bestDistance = std::numeric_limits<float>::max();
+
+            for (uint32_t p = 0; p < 16; ++p) {
+                if (float d = distance(block[i], palette[p], 4); d < bestDistance) {
+                    bestDistance = d;
+                    indices[i] = p;
+                }
+            }
+
+            error += bestDistance;
+        }
+
+        return error;
+    }
+
+    void encodeBC7(const Block &block, uint8_t *output) {
+        std::array<float, 4> low{};
+        std::array<float, 4> high{};
+        findEndpoints(block, 4, low, high);
+
+        std::array<std::array<uint32_t, 4>, 2> endpoints{};
+        std::array<uint32_t, 2> pBits{};
+        quantizeBC7Endpoint(low, endpoints[0], pBits[0]);
+        quantizeBC7Endpoint(high, endpoints[1], pBits[1]);
+
+        std::array<uint32_t, 16> indices{};
+        float error = findBC7Indices(block, endpoints, pBits, indices);
+
+        // Least squares refinement: endpoints minimizing the error for the chosen weights, kept while improving
+        for (int iteration = 0; iteration < 2 && error > 0.0f; ++iteration) {
+            float a = 0.0f;
+            float b = 0.0f;
+            float c = 0.0f;
+            std::array<float, 4> x0{};
+            std::array<float, 4> x1{};
+
+            for (uint32_t i = 0; i < 16; ++i) {
+                const float w = static_cast<float>(kBC7Weights[indices[i]]) / 64.0f;
+
+                a += (1.0f - w) * (1.0f - w);
+                b += (1.0f - w) * w;
+                c += w * w;
+
+                for (uint32_t channel = 0; channel < 4; ++channel) {
+                    x0[channel] += (1.0f - w) * block[i][channel];
+                    x1[channel] += w * block[i][channel];
+                }
+            }
+
+            const float determinant = a * c - b * b;
+            if (std::abs(determinant) < 1e-6f) {
+                break;
+            }
+
+            for (uint32_t channel = 0; channel < 4; ++channel) {
+                low[channel] = std::clamp((c * x0[channel] - b * x1[channel]) / determinant, 0.0f, 255.0f);
+                high[channel] = std::clamp((a * x1[channel] - b * x0[channel]) / determinant, 0.0f, 255.0f);
+            }
+
+            std::array<std::array<uint32_t, 4>, 2> refinedEndpoints{};
+            std::array<uint32_t, 2> refinedPBits{};
+            std::array<uint32_t, 16> refinedIndices{};
+            quantizeBC7Endpoint(low, refinedEndpoints[0], refinedPBits[0]);
+            quantizeBC7Endpoint(high, refinedEndpoints[1], refinedPBits[1]);
+
+            const float refinedError = findBC7Indices(block, refinedEndpoints, refinedPBits, refinedIndices);
+            if (refinedError >= error) {
+                break;
+            }
+
+            error = refinedError;
+            endpoints = refinedEndpoints;
+            pBits = refinedPBits;
+            indices = refinedIndices;
+        }
+
+        // The MSB of the first index is implicit (0): swapping endpoints flips every index
+        if (indices[0] & 8) {
+            std::swap(endpoints[0], endpoints[1]);
+            std::swap(pBits[0], pBits[1]);
+
+            for (uint32_t &index: indices) {
+                index = 15 - index;
+            }
+        }
+
+        std::fill_n(output, 16, 0);
+        BitWriter writer{output};
+
+        writer.write(1 << 6, 7);
+        for (uint32_t c = 0; c < 4; ++c) {
+            writer.write(endpoints[0][c], 7);
+            writer.write(endpoints[1][c], 7);
+        }
+
+        writer.write(pBits[0], 1);
+        writer.write(pBits[1], 1);
+
+        writer.write(indices[0], 3);
+        for (uint32_t i = 1; i < 16; ++i) {
+            writer.write(indices[i], 4);
+        }
+    }
+}
+
+VIETextureFormat tools::selectBlockFormat(const VIETextureData &texture, VIETextureCompression compression) {
+    if (compression == VIETextureCompression::NONE) {
+        return VIETextureFormat::RGBA8;
+    }
+
+    if (!texture.isSRGB) {
+        return VIETextureFormat::BC5;
+    }
+
+    if (compression == VIETextureCompression::BC7) {
+        return VIETextureFormat::BC7;
+    }
+
+    // Alpha is checked on the first level only, as filtering cannot make an opaque texture transparent
+    const size_t levelSize = texture.mipLevels.empty() ? 0 : texture.mipLevels.front().size;
+    for (size_t i = 3; i < levelSize; i += 4) {
+        if (texture.pixels[i] != 255) {
+            return VIETextureFormat::BC3;
+        }
+    }
+
+    return VIETextureFormat::BC1;
+}
+
+void tools::compressTexture(VIETextureData &texture, VIETextureFormat format) {
+    if (format == VIETextureFormat::RGBA8 || texture.format != VIETextureFormat::RGBA8 || !texture.isLoaded()) {
+        return;
+    }
+
+    // Laying out the compressed levels, and listing their rows of blocks as independent work items
+    struct BlockRow {
+        uint32_t level;
+        uint32_t blockY;
+    };
+
+    std::vector<VIEMipLevel> levels;
+    std::vector<BlockRow> rows;
+    size_t size = 0;
+
+    for (uint32_t level = 0; const VIEMipLevel &mipLevel: texture.mipLevels) {
+        const size_t levelSize = getTextureLevelSize(format, mipLevel.width, mipLevel.height);
+        levels.push_back({size, levelSize, mipLevel.width, mipLevel.height});
+        size += levelSize;
+
+        for (uint32_t blockY = 0; blockY < (mipLevel.height + 3) / 4; ++blockY) {
+            rows.push_back({level, blockY});
+        }
+
+        ++level;
+    }
+
+    std::vector<uint8_t> blocks(size);
+    const size_t blockSize = format == VIETextureFormat::BC1 ? 8 : 16;
+
+    tools::parallelFor(rows.size(), 4, [&texture, &levels, &rows, &blocks, format, blockSize](size_t begin,
+                                                                                             size_t end) {
+        Block block;
+
+        for (size_t i = begin; i < end; ++i) {
+            const VIEMipLevel &source = texture.mipLevels[rows[i].level];
+            const VIEMipLevel &destination = levels[rows[i].level];
+            const uint32_t blocksPerRow = (source.width + 3) / 4;
+
+            for (uint32_t blockX = 0; blockX < blocksPerRow; ++blockX) {
+                fetchBlock(&texture.pixels[source.offset], source.width, source.height, blockX, rows[i].blockY,
+                           block);
+
+                uint8_t *output = &blocks[destination.offset + (rows[i].blockY * blocksPerRow + blockX) * blockSize];
+
+                switch (format) {
+                    case VIETextureFormat::BC1:
+                        encodeBC1(block, output);
+                        break;
+                    case VIETextureFormat::BC3:
+                        encodeBC4(block, 3, output);
+                        encodeBC1(block, output + 8);
+                        break;
+                    case VIETextureFormat::BC5:
+                        encodeBC4(block, 0, output);
+                        encodeBC4(block, 1, output + 8);
+                        break;
+                    case VIETextureFormat::BC7:
+                        encodeBC7(block, output);
+                        break;
+                    default:
+                        break;
+                }
+            }
+        }
+    });
+
+    texture.format = format;
+    texture.mipLevels = std::move(levels);
+    texture.pixels = std::move(blocks);
+}
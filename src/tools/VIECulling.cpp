@@ -0,0 +1,386 @@
+/* Created by LordRibblesdale on 18/10/2026.
+ * MIT License
+ */
+
+#include "tools/VIECulling.hpp"
+#include "tools/VIEParallel.hpp"
+
+#include <array>
+#include <cmath>
+#include <cstring>
+
+// SSE2 is part of x86-64, while AVX2 kernels are compiled for their own target and only called if supported
+#if defined(__x86_64__) || defined(_M_X64)
+#define VIE_CULLING_X86
+#include <immintrin.h>
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#define VIE_TARGET_AVX2
+#else
+#define VIE_TARGET_AVX2 __attribute__((target("avx2,popcnt")))
+#endif
+#endif
+
+namespace {
+    constexpr size_t kParallelCullingSize{1 << 16};     ///< Elements culled by a worker in one go
+
+    using SphereKernel = size_t (*)(const VIEFrustum &, const VIESphereSet &, size_t, size_t, uint32_t *);
+    using BoxKernel = size_t (*)(const VIEFrustum &, const VIEBoxSet &, size_t, size_t, uint32_t *);
+
+    bool isSphereVisible(const VIEFrustum &frustum, const VIESphereSet &spheres, size_t i) {
+        bool isVisible = true;
+
+        for (const glm::vec4 &plane: frustum.planes) {
+            isVisible &= plane.x * spheres.centerX[i] + plane.y * spheres.centerY[i] + plane.z * spheres.centerZ[i] +
+                         plane.w >= -spheres.radius[i];
+        }
+
+        return isVisible;
+    }
+
+    bool isBoxVisible(const VIEFrustum &frustum, const VIEBoxSet &boxes, size_t i) {
+        bool isVisible = true;
+
+        // Distance of the center, plus the projection of the half extent on the plane normal
+        for (const glm::vec4 &plane: frustum.planes) {
+            isVisible &= plane.x * boxes.centerX[i] + plane.y * boxes.centerY[i] + plane.z * boxes.centerZ[i] +
+                         plane.w + std::abs(plane.x) * boxes.extentX[i] + std::abs(plane.y) * boxes.extentY[i] +
+                         std::abs(plane.z) * boxes.extentZ[i] >= 0.0f;
+        }
+
+        return isVisible;
+    }
+
+    size_t cullSpheresScalar(const VIEFrustum &frustum, const VIESphereSet &spheres, size_t begin, size_t end,
+                             uint32_t *visible) {
+        size_t count = 0;
+
+        for (size_t i = begin; i < end; ++i) {
+            visible[count] = static_cast<uint32_t>(i);
+            count += isSphereVisible(frustum, spheres, i);
+        }
+
+        return count;
+    }
+
+    size_t cullBoxesScalar(const VIEFrustum &frustum, const VIEBoxSet &boxes, size_t begin, size_t end,
+                           uint32_t *visible) {
+        size_t count = 0;
+
+        for (size_t i = begin; i < end; ++i) {
+            visible[count] = static_cast<uint32_t>(i);
+            count += isBoxVisible(frustum, boxes, i);
+        }
+
+        return count;
+    }
+
+#ifdef VIE_CULLING_X86
+    size_t cullSpheresSSE2(const VIEFrustum &frustum, const VIESphereSet &spheres, size_t begin, size_t end,
+                           uint32_t *visible) {
+        __m128 planes[6][4]{};
+        for (size_t p = 0; p < 6; ++p) {
+            for (int c = 0; c < 4; ++c) {
+                planes[p][c] = _mm_set1_ps(frustum.planes[p][c]);
+            }
+        }
+
+        size_t count = 0;
+        size_t i = begin;
+
+        for (; i + 4 <= end; i += 4) {
+            const __m128 x = _mm_loadu_ps(spheres.centerX.data() + i);
+            const __m128 y = _mm_loadu_ps(spheres.centerY.data() + i);
+            const __m128 z = _mm_loadu_ps(spheres.centerZ.data() + i);
+            const __m128 negativeRadius = _mm_sub_ps(_mm_setzero_ps(), _mm_loadu_ps(spheres.radius.data() + i));
+            __m128 isVisible = _mm_castsi128_ps(_mm_set1_epi32(-1));
+
+            for (const auto &plane: planes) {
+                const __m128 distance = _mm_add_ps(_mm_add_ps(_mm_mul_ps(plane[0], x), _mm_mul_ps(plane[1], y)),
+                                                   _mm_add_ps(_mm_mul_ps(plane[2], z), plane[3]));
+                isVisible = _mm_and_ps(isVisible, _mm_cmpge_ps(distance, negativeRadius));
+            }
+
+            for (int mask = _mm_movemask_ps(isVisible); mask != 0; mask &= mask - 1) {
+                int lane = 0;
+                while (!(mask & (1 << lane))) {
+                    ++lane;
+                }
+
+                visible[count++] = static_cast<uint32_t>(i + lane);
+            }
+        }
+
+        return count + cullSpheresScalar(frustum, spheres, i, end, visible + count);
+    }
+
+    size_t cullBoxesSSE2(const VIEFrustum &frustum, const VIEBoxSet &boxes, size_t begin, size_t end,
+                         uint32_t *visible) {
+        const __m128 signMask = _mm_castsi128_ps(_mm_set1_epi32(0x7FFFFFFF));
+        __m128 planes[6][7]{};
+        for (size_t p = 0; p < 6; ++p) {
+            for (int c = 0; c < 4; ++c) {
+                planes[p][c] = _mm_set1_ps(frustum.planes[p][c]);
+            }
+
+            for (int c = 0; c < 3; ++c) {
+                planes[p][4 + c] = _mm_and_ps(planes[p][c], signMask);
+            }
+        }
+
+        size_t count = 0;
+        size_t i = begin;
+
+        for (; i + 4 <= end; i += 4) {
+            const __m128 x = _mm_loadu_ps(boxes.centerX.data() + i);
+            const __m128 y = _mm_loadu_ps(boxes.centerY.data() + i);
+            const __m128 z = _mm_loadu_ps(boxes.centerZ.data() + i);
+            const __m128 extentX = _mm_loadu_ps(boxes.extentX.data() + i);
+            const __m128 extentY = _mm_loadu_ps(boxes.extentY.data() + i);
+            const __m128 extentZ = _mm_loadu_ps(boxes.extentZ.data() + i);
+            __m128 isVisible = _mm_castsi128_ps(_mm_set1_epi32(-1));
+
+            for (const auto &plane: planes) {
+                const __m128 distance = _mm_add_ps(_mm_add_ps(_mm_mul_ps(plane[0], x), _mm_mul_ps(plane[1], y)),
+                                                   _mm_add_ps(_mm_mul_ps(plane[2], z), plane[3]));
+                const __m128 radius = _mm_add_ps(_mm_add_ps(_mm_mul_ps(plane[4], extentX),
+                                                            _mm_mul_ps(plane[5], extentY)),
+                                                 _mm_mul_ps(plane[6], extentZ));
+                isVisible = _mm_and_ps(isVisible, _mm_cmpge_ps(_mm_add_ps(distance, radius), _mm_setzero_ps()));
+            }
+
+            for (int mask = _mm_movemask_ps(isVisible); mask != 0; mask &= mask - 1) {
+                int lane = 0;
+                while (!(mask & (1 << lane))) {
+                    ++lane;
+                }
+
+                visible[count++] = static_cast<uint32_t>(i + lane);
+            }
+        }
+
+        return count + cullBoxesScalar(frustum, boxes, i, end, visible + count);
+    }
+
+    // Lane permutation moving the visible lanes of each 8 bit mask to the front
+    const std::array<std::array<uint32_t, 8>, 256> kCompactionTable = []() {
+        std::array<std::array<uint32_t, 8>, 256> table{};
+
+        for (uint32_t mask = 0; mask < 256; ++mask) {
+            uint32_t count = 0;
+            for (uint32_t lane = 0; lane < 8; ++lane) {
+                if (mask & (1u << lane)) {
+                    table[mask][count++] = lane;
+                }
+            }
+        }
+
+        return table;
+    }();
+
+    // Writes the indices of the visible lanes: all 8 lanes are stored, only the visible ones are kept
+    VIE_TARGET_AVX2 size_t storeVisibleAVX2(__m256 isVisible, size_t i, uint32_t *visible) {
+        const int mask = _mm256_movemask_ps(isVisible);
+        const __m256i lanes = _mm256_add_epi32(_mm256_set1_epi32(static_cast<int>(i)),
+                                               _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7));
+        const __m256i permutation = _mm256_loadu_si256(
+                reinterpret_cast<const __m256i *>(kCompactionTable[mask].data()));
+
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(visible), _mm256_permutevar8x32_epi32(lanes, permutation));
+
+        return static_cast<size_t>(_mm_popcnt_u32(static_cast<uint32_t>(mask)));
+    }
+
+    // Full vectors never write past the last processed element, so batches can be culled concurrently
+    VIE_TARGET_AVX2 size_t cullSpheresAVX2(const VIEFrustum &frustum, const VIESphereSet &spheres, size_t begin,
+                                           size_t end, uint32_t *visible) {
+        __m256 planes[6][4]{};
+        for (size_t p = 0; p < 6; ++p) {
+            for (int c = 0; c < 4; ++c) {
+                planes[p][c] = _mm256_set1_ps(frustum.planes[p][c]);
+            }
+        }
+
+        size_t count = 0;
+        size_t i = begin;
+
+        for (; i + 8 <= end; i += 8) {
+            const __m256 x = _mm256_loadu_ps(spheres.centerX.data() + i);
+            const __m256 y = _mm256_loadu_ps(spheres.centerY.data() + i);
+            const __m256 z = _mm256_loadu_ps(spheres.centerZ.data() + i);
+            const __m256 negativeRadius = _mm256_sub_ps(_mm256_setzero_ps(),
+                                                        _mm256_loadu_ps(spheres.radius.data() + i));
+            __m256 isVisible = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+
+            for (const auto &plane: planes) {
+                const __m256 distance = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(plane[0], x),
+                                                                    _mm256_mul_ps(plane[1], y)),
+                                                      _mm256_add_ps(_mm256_mul_ps(plane[2], z), plane[3]));
+                isVisible = _mm256_and_ps(isVisible, _mm256_cmp_ps(distance, negativeRadius, _CMP_GE_OQ));
+            }
+
+            count += storeVisibleAVX2(isVisible, i, visible + count);
+        }
+
+        return count + cullSpheresScalar(frustum, spheres, i, end, visible + count);
+    }
+
+    VIE_TARGET_AVX2 size_t cullBoxesAVX2(const VIEFrustum &frustum, const VIEBoxSet &boxes, size_t begin,
+                                         size_t end, uint32_t *visible) {
+        const __m256 signMask = _mm256_castsi256_ps(_mm256_set1_epi32(0x7FFFFFFF));
+        __m256 planes[6][7]{};
+        for (size_t p = 0; p < 6; ++p) {
+            for (int c = 0; c < 4; ++c) {
+                planes[p][c] = _mm256_set1_ps(frustum.planes[p][c]);
+            }
+
+            for (int c = 0; c < 3; ++c) {
+                planes[p][4 + c] = _mm256_and_ps(planes[p][c], signMask);
+            }
+        }
+
+        size_t count = 0;
+        size_t i = begin;
+
+        for (; i + 8 <= end; i += 8) {
+            const __m256 x = _mm256_loadu_ps(boxes.centerX.data() + i);
+            const __m256 y = _mm256_loadu_ps(boxes.centerY.data() + i);
+            const __m256 z = _mm256_loadu_ps(boxes.centerZ.data() + i);
+            const __m256 extentX = _mm256_loadu_ps(boxes.extentX.data() + i);
+            const __m256 extentY = _mm256_loadu_ps(boxes.extentY.data() + i);
+            const __m256 extentZ = _mm256_loadu_ps(boxes.extentZ.data() + i);
+            __m256 isVisible = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+
+            for (const auto &plane: planes) {
+                const __m256 distance = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(plane[0], x),
+                                                                    _mm256_mul_ps(plane[1], y)),
+                                                      _mm256_add_ps(_mm256_mul_ps(plane[2], z), plane[3]));
+                const __m256 radius = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(plane[4], extentX),
+                                                                  _mm256_mul_ps(plane[5], extentY)),
+                                                    _mm256_mul_ps(plane[6], extentZ));
+                isVisible = _mm256_and_ps(isVisible, _mm256_cmp_ps(_mm256_add_ps(distance, radius),
+                                                                   _mm256_setzero_ps(), _CMP_GE_OQ));
+            }
+
+            count += storeVisibleAVX2(isVisible, i, visible + count);
+        }
+
+        return count + cullBoxesScalar(frustum, boxes, i, end, visible + count);
+    }
+
+    bool isAVX2Supported() {
+#if defined(_MSC_VER) && !defined(__clang__)
+        std::array<int, 4> info{};
+        __cpuid(info.data(), 1);
+        const bool isOSXSaveEnabled = (info[2] & (1 << 27)) != 0;
+        const bool isAVXSupported = (info[2] & (1 << 28)) != 0;
+
+        // The OS must save the YMM registers on context switches
+        if (!isOSXSaveEnabled || !isAVXSupported || (_xgetbv(0) & 0x6) != 0x6) {
+            return false;
+        }
+
+        __cpuidex(info.data(), 7, 0);
+        return (info[1] & (1 << 5)) != 0;
+#else
+        return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("popcnt");
+#endif
+    }
+#endif
+
+    // Elements are culled in fixed batches: each batch writes its visible indices at its own offset, then batches are
+    // packed together
+    template<typename Set, typename Kernel>
+    size_t runKernel(Kernel kernel, const VIEFrustum &frustum, const Set &set, std::vector<uint32_t> &visible) {
+        const size_t count = set.size();
+        visible.resize(count);
+
+        if (count <= kParallelCullingSize) {
+            visible.resize(kernel(frustum, set, 0, count, visible.data()));
+            return visible.size();
+        }
+
+        const size_t batchCount = (count + kParallelCullingSize - 1) / kParallelCullingSize;
+        std::vector<size_t> batchSizes(batchCount, 0);
+
+        tools::parallelFor(batchCount, 1, [&](size_t begin, size_t end) {
+            for (size_t batch = begin; batch < end; ++batch) {
+                const size_t first = batch * kParallelCullingSize;
+                batchSizes[batch] = kernel(frustum, set, first, std::min(first + kParallelCullingSize, count),
+                                           visible.data() + first);
+            }
+        });
+
+        size_t visibleCount = batchSizes.front();
+        for (size_t batch = 1; batch < batchCount; ++batch) {
+            std::memmove(visible.data() + visibleCount, visible.data() + batch * kParallelCullingSize,
+                         batchSizes[batch] * sizeof(uint32_t));
+            visibleCount += batchSizes[batch];
+        }
+
+        visible.resize(visibleCount);
+
+        return visibleCount;
+    }
+}
+
+VIECullingKernel tools::getCullingKernel() {
+#ifdef VIE_CULLING_X86
+    static const VIECullingKernel kernel{isAVX2Supported() ? VIECullingKernel::AVX2 : VIECullingKernel::SSE2};
+    return kernel;
+#else
+    return VIECullingKernel::SCALAR;
+#endif
+}
+
+const char *tools::getCullingKernelName(VIECullingKernel kernel) {
+    switch (kernel) {
+        case VIECullingKernel::SSE2:
+            return "SSE2";
+        case VIECullingKernel::AVX2:
+            return "AVX2";
+        default:
+            return "scalar";
+    }
+}
+
+size_t tools::cullSpheres(const VIEFrustum &frustum, const VIESphereSet &spheres, std::vector<uint32_t> &visible,
+                          VIECullingKernel kernel) {
+    SphereKernel function = cullSpheresScalar;
+
+#ifdef VIE_CULLING_X86
+    switch (std::min(kernel, getCullingKernel())) {
+        case VIECullingKernel::AVX2:
+            function = cullSpheresAVX2;
+            break;
+        case VIECullingKernel::SSE2:
+            function = cullSpheresSSE2;
+            break;
+        default:
+            break;
+    }
+#endif
+
+    return runKernel(function, frustum, spheres, visible);
+}
+
+size_t tools::cullBoxes(const VIEFrustum &frustum, const VIEBoxSet &boxes, std::vector<uint32_t> &visible,
+                        VIECullingKernel kernel) {
+    BoxKernel function = cullBoxesScalar;
+
+#ifdef VIE_CULLING_X86
+    switch (std::min(kernel, getCullingKernel())) {
+        case VIECullingKernel::AVX2:
+            function = cullBoxesAVX2;
+            break;
+        case VIECullingKernel::SSE2:
+            function = cullBoxesSSE2;
+            break;
+        default:
+            break;
+    }
+#endif
+
+    return runKernel(function, frustum, boxes, visible);
+}
@@ -0,0 +1,425 @@
+/* Created by LordRibblesdale on 18/10/2026.
+ * MIT License
+ */
+
+#include "tools/VIEJobSystem.hpp"
+#include "tools/VIETrace.hpp"
+
+#include <array>
+#include <limits>
+#include <memory>
+#include <thread>
+#include <algorithm>
+
+namespace {
+    struct Job {
+        VIEJob function;
+        VIEJobCounter *counter{nullptr};
+    };
+
+    /**
+     * @brief Work stealing deque (Chase-Lev), its owner pushes and pops at the bottom while thieves take the top
+     */
+    class JobDeque {
+        static constexpr int64_t kCapacity{4096};       ///< Power of two
+
+        std::unique_ptr<std::array<std::atomic<Job *>, kCapacity>> jobs{
+                std::make_unique<std::array<std::atomic<Job *>, kCapacity>>()};
+
+        // Separate lines, thieves only write top
+        alignas(64) std::atomic<int64_t> top{0};
+        alignas(64) std::atomic<int64_t> bottom{0};
+
+    public:
+        /**
+         * @return false if the deque is full
+         */
+        bool push(Job *job) {
+            const int64_t b = bottom.load(std::memory_order_relaxed);
+            const int64_t t = top.load(std::memory_order_acquire);
+
+            if (b - t >= kCapacity) {
+                return false;
+            }
+
+            (*jobs)[b & (kCapacity - 1)].store(job, std::memory_order_relaxed);
+            bottom.store(b + 1, std::memory_order_release);
+
+            return true;
+        }
+
+        Job *pop() {
+            const int64_t b = bottom.load(std::memory_order_relaxed) - 1;
+            bottom.store(b, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            int64_t t = top.load(std::memory_order_relaxed);
+
+            if (t > b) {
+                bottom.store(b + 1, std::memory_order_relaxed);
+                return nullptr;
+            }
+
+            Job *job = (*jobs)[b & (kCapacity - 1)].load(std::memory_order_relaxed);
+
+            // Last job, raced against thieves
+            if (t == b) {
+                if (!top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+                    job = nullptr;
+                }
+
+                bottom.store(b + 1, std::memory_order_relaxed);
+            }
+
+            return job;
+        }
+
+        Job *steal() {
+            int64_t t = top.load(std::memory_order_acquire);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            const int64_t b = bottom.load(std::memory_order_acquire);
+
+            if (t >= b) {
+                return nullptr;
+            }
+
+            Job *job = (*jobs)[t & (kCapacity - 1)].load(std::memory_order_relaxed);
+
+            if (!top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+                return nullptr;
+            }
+
+            return job;
+        }
+    };
+
+    thread_local uint32_t workerIndex{std::numeric_limits<uint32_t>::max()};   ///< Deque of the thread, if any
+    thread_local uint32_t stealSeed{0};
+}
+
+/**
+ * @brief VIEJobScheduler class, a deque for each worker (the main thread is the first one) and shared queues
+ * Jobs submitted by threads outside of the scheduler go to a shared queue, as do those of a full deque. Idle workers
+ * steal from random victims, and sleep on the submission count after a few attempts.
+ */
+class VIEJobScheduler {
+    static constexpr uint32_t kIdleAttempts{64};        ///< Failed searches before a worker sleeps
+
+    std::vector<std::unique_ptr<JobDeque>> deques;
+    std::vector<std::jthread> workers;
+
+    std::mutex sharedMutex;
+    std::vector<Job *> sharedJobs;
+    std::atomic<bool> hasSharedJobs{false};
+
+    std::mutex mainThreadMutex;
+    std::vector<Job *> mainThreadJobs;
+    std::atomic<bool> hasMainThreadJobs{false};
+
+    std::atomic<uint64_t> submissionCount{0};
+    std::atomic<uint32_t> sleepingCount{0};
+    std::atomic<bool> isRunning{true};
+
+    void wake() {
+        submissionCount.fetch_add(1, std::memory_order_seq_cst);
+
+        if (sleepingCount.load(std::memory_order_seq_cst) > 0) {
+            submissionCount.notify_all();
+        }
+    }
+
+    Job *takeShared() {
+        if (!hasSharedJobs.load(std::memory_order_acquire)) {
+            return nullptr;
+        }
+
+        std::scoped_lock lock(sharedMutex);
+
+        if (sharedJobs.empty()) {
+            return nullptr;
+        }
+
+        Job *job = sharedJobs.back();
+        sharedJobs.pop_back();
+        hasSharedJobs.store(!sharedJobs.empty(), std::memory_order_release);
+
+        return job;
+    }
+
+    /**
+     * @brief Own deque first (most recent job, still in cache), then the shared queue, then other deques
+     */
+    Job *findJob() {
+        if (workerIndex < deques.size()) {
+            if (Job *job = deques[workerIndex]->pop()) {
+                return job;
+            }
+        }
+
+        if (Job *job = takeShared()) {
+            return job;
+        }
+
+        // Xorshift, so that thieves do not all start from the same victim
+        stealSeed ^= stealSeed << 13;
+        stealSeed ^= stealSeed >> 17;
+        stealSeed ^= stealSeed << 5;
+
+        const auto dequeCount = static_cast<uint32_t>(deques.size());
+        for (uint32_t i = 0, victim = stealSeed % dequeCount; i < dequeCount; ++i, victim = (victim + 1) % dequeCount) {
+            if (victim != workerIndex) {
+                if (Job *job = deques[victim]->steal()) {
+                    return job;
+                }
+            }
+        }
+
+        return nullptr;
+    }
+
+    void workerLoop(uint32_t index) {
+        workerIndex = index;
+        stealSeed = 0x9E3779B9u * (index + 1);
+        bool isNamed = false;
+
+        for (uint32_t attempt = 0; isRunning.load(std::memory_order_acquire);) {
+            if (Job *job = findJob()) {
+                // Trace buffers are only taken by workers running while tracing
+                if (!isNamed && tools::isTracingEnabled()) {
+                    tools::setTraceThreadName("worker");
+                    isNamed = true;
+                }
+
+                execute(job);
+                attempt = 0;
+                continue;
+            }
+
+            if (++attempt < kIdleAttempts) {
+                std::this_thread::yield();
+                continue;
+            }
+
+            // Jobs submitted after the count is read wake the worker, those before it are found by the last search
+            sleepingCount.fetch_add(1, std::memory_order_seq_cst);
+            const uint64_t seenCount = submissionCount.load(std::memory_order_seq_cst);
+
+            if (Job *job = findJob()) {
+                sleepingCount.fetch_sub(1, std::memory_order_relaxed);
+                execute(job);
+                attempt = 0;
+                continue;
+            }
+
+            if (isRunning.load(std::memory_order_acquire)) {
+                submissionCount.wait(seenCount, std::memory_order_seq_cst);
+            }
+
+            sleepingCount.fetch_sub(1, std::memory_order_relaxed);
+            attempt = 0;
+        }
+    }
+
+public:
+    VIEJobScheduler() : deques(tools::getWorkerCount()) {
+        for (std::unique_ptr<JobDeque> &deque: deques) {
+            deque = std::make_unique<JobDeque>();
+        }
+
+        // The thread starting the scheduler is the main thread, and uses the first deque
+        workerIndex = 0;
+        stealSeed = 0x9E3779B9u;
+
+        workers.reserve(deques.size() - 1);
+        for (uint32_t i = 1; i < deques.size(); ++i) {
+            workers.emplace_back([this, i]() {
+                workerLoop(i);
+            });
+        }
+    }
+
+    VIEJobScheduler(const VIEJobScheduler &) = delete;
+
+    ~VIEJobScheduler() {
+        isRunning.store(false, std::memory_order_release);
+        submissionCount.fetch_add(1, std::memory_order_seq_cst);
+        submissionCount.notify_all();
+
+        workers.clear();
+    }
+
+    static bool isMainThread() {
+        return workerIndex == 0;
+    }
+
+    void submit(VIEJob function, VIEJobCounter *counter) {
+        if (counter) {
+            counter->pendingCount.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        auto *job = new Job{std::move(function), counter};
+
+        if (workerIndex >= deques.size() || !deques[workerIndex]->push(job)) {
+            std::scoped_lock lock(sharedMutex);
+            sharedJobs.push_back(job);
+            hasSharedJobs.store(true, std::memory_order_release);
+        }
+
+        wake();
+    }
+
+    void submitAfter(VIEJobCounter &dependency, VIEJob function, VIEJobCounter *counter) {
+        if (counter) {
+            counter->pendingCount.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        // Whether the counter is done is decided under its lock, as by complete(): either the job is added before
+        // the last job leaving the counter takes the continuations, or it is submitted here
+        {
+            std::scoped_lock lock(dependency.continuationMutex);
+
+            if (dependency.pendingCount.load(std::memory_order_seq_cst) > 0) {
+                dependency.continuations.push_back([this, function = std::move(function), counter]() mutable {
+                    submit(std::move(function), counter);
+                    complete(counter);
+                });
+
+                return;
+            }
+        }
+
+        submit(std::move(function), counter);
+        complete(counter);
+    }
+
+    void submitMainThread(VIEJob function, VIEJobCounter *counter) {
+        if (counter) {
+            counter->pendingCount.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        std::scoped_lock lock(mainThreadMutex);
+        mainThreadJobs.push_back(new Job{std::move(function), counter});
+        hasMainThreadJobs.store(true, std::memory_order_release);
+    }
+
+    void complete(VIEJobCounter *counter) {
+        if (!counter) {
+            return;
+        }
+
+        // The counter is not done (and cannot be destroyed by its waiters) until the last job has left it
+        counter->completingCount.fetch_add(1, std::memory_order_seq_cst);
+        std::vector<VIEJob> continuations;
+
+        // Continuations are taken under the lock only if no job was added meanwhile, otherwise the last of those
+        // takes them when it leaves
+        if (counter->pendingCount.fetch_sub(1, std::memory_order_seq_cst) == 1) {
+            std::scoped_lock lock(counter->continuationMutex);
+
+            if (counter->pendingCount.load(std::memory_order_seq_cst) == 0) {
+                continuations.swap(counter->continuations);
+            }
+        }
+
+        counter->completingCount.fetch_sub(1, std::memory_order_release);
+
+        // Dependent jobs may complete other counters, after which this one can be gone
+        for (VIEJob &continuation: continuations) {
+            continuation();
+        }
+    }
+
+    void execute(Job *job) {
+        job->function();
+        complete(job->counter);
+        delete job;
+    }
+
+    /**
+     * @brief Runs main thread jobs in submission order
+     */
+    void runMainThreadJobs() {
+        // Without workers, the main thread is the only one left to run the pool jobs (one for each call)
+        if (deques.size() == 1) {
+            if (Job *job = findJob()) {
+                execute(job);
+            }
+        }
+
+        if (!hasMainThreadJobs.load(std::memory_order_acquire)) {
+            return;
+        }
+
+        std::vector<Job *> jobs;
+        {
+            std::scoped_lock lock(mainThreadMutex);
+            jobs.swap(mainThreadJobs);
+            hasMainThreadJobs.store(false, std::memory_order_release);
+        }
+
+        for (Job *job: jobs) {
+            execute(job);
+        }
+    }
+
+    template<typename Predicate>
+    void waitUntil(const Predicate &isDone) {
+        while (!isDone()) {
+            if (isMainThread()) {
+                runMainThreadJobs();
+            }
+
+            if (Job *job = findJob()) {
+                execute(job);
+            } else {
+                std::this_thread::yield();
+            }
+        }
+    }
+};
+
+namespace {
+    // Created on first use, from the main thread
+    VIEJobScheduler &getScheduler() {
+        static VIEJobScheduler scheduler;
+        return scheduler;
+    }
+}
+
+size_t tools::getWorkerCount() {
+    static const size_t workerCount{std::max<size_t>(1, std::thread::hardware_concurrency())};
+    return workerCount;
+}
+
+void tools::startJobSystem() {
+    getScheduler();
+}
+
+void tools::runJob(VIEJob job, VIEJobCounter *counter) {
+    getScheduler().submit(std::move(job), counter);
+}
+
+void tools::runJobAfter(VIEJobCounter &dependency, VIEJob job, VIEJobCounter *counter) {
+    getScheduler().submitAfter(dependency, std::move(job), counter);
+}
+
+void tools::runOnMainThread(VIEJob job, VIEJobCounter *counter) {
+    getScheduler().submitMainThread(std::move(job), counter);
+}
+
+void tools::runMainThreadJobs() {
+    getScheduler().runMainThreadJobs();
+}
+
+bool tools::isMainThread() {
+    return getScheduler().isMainThread();
+}
+
+void tools::waitForCounter(const VIEJobCounter &counter) {
+    getScheduler().waitUntil([&counter]() {
+        return counter.isDone();
+    });
+}
+
+void tools::waitUntil(const std::function<bool()> &isDone) {
+    getScheduler().waitUntil(isDone);
+}
@@ -0,0 +1,331 @@
+/* Created by LordRibblesdale on 18/10/2026.
+ * MIT License
+ */
+
+#include "tools/VIEKTX2.hpp"
+#include "tools/VIELogger.hpp"
+
+#include <array>
+#include <vector>
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <string_view>
+
+namespace {
+    constexpr std::array<uint8_t, 12> kIdentifier{0xAB, 0x4B, 0x54, 0x58, 0x20, 0x32, 0x30, 0xBB, 0x0D, 0x0A, 0x1A,
+                                                  0x0A};
+    constexpr size_t kHeaderSize{80};       ///< Identifier, header and index
+    constexpr size_t kLevelIndexSize{24};   ///< byteOffset, byteLength, uncompressedByteLength
+    constexpr std::string_view kSourceKey{"VIEsource"};
+
+    // Data Format Descriptor values (Khronos Data Format Specification 1.3)
+    constexpr uint8_t kModelRGBSDA{1};
+    constexpr uint8_t kModelBC1A{128};
+    constexpr uint8_t kModelBC3{130};
+    constexpr uint8_t kModelBC5{132};
+    constexpr uint8_t kModelBC7{134};
+    constexpr uint8_t kPrimariesBT709{1};
+    constexpr uint8_t kTransferLinear{1};
+    constexpr uint8_t kTransferSRGB{2};
+    constexpr uint8_t kChannelAlpha{15};
+    constexpr uint8_t kSampleLinear{0x10};  ///< Sample qualifier: not affected by the transfer function
+
+    size_t getBlockSize(VIETextureFormat format) {
+        switch (format) {
+            case VIETextureFormat::RGBA8:
+                return 4;
+            case VIETextureFormat::BC1:
+                return 8;
+            default:
+                return 16;
+        }
+    }
+
+    template <typename T>
+    void append(std::vector<uint8_t> &data, T value) {
+        const size_t position = data.size();
+        data.resize(position + sizeof(T));
+        std::memcpy(&data[position], &value, sizeof(T));
+    }
+
+    template <typename T>
+    void store(std::vector<uint8_t> &data, size_t position, T value) {
+        std::memcpy(&data[position], &value, sizeof(T));
+    }
+
+    template <typename T>
+    T load(const std::vector<uint8_t> &data, size_t position) {
+        T value;
+        std::memcpy(&value, &data[position], sizeof(T));
+        return value;
+    }
+
+    void appendDataFormatDescriptor(std::vector<uint8_t> &data, VIETextureFormat format, bool isSRGB) {
+        struct Sample {
+            uint16_t bitOffset;
+            uint8_t bitLength;      ///< Length - 1
+            uint8_t channelType;
+            uint32_t sampleUpper;
+        };
+
+        uint8_t colorModel = kModelRGBSDA;
+        std::vector<Sample> samples;
+        const uint8_t alphaType = kChannelAlpha | (isSRGB ? kSampleLinear : 0);
+
+        switch (format) {
+            case VIETextureFormat::RGBA8:
+                samples = {{0, 7, 0, 255}, {8, 7, 1, 255}, {16, 7, 2, 255}, {24, 7, alphaType, 255}};
+                break;
+            case VIETextureFormat::BC1:
+                colorModel = kModelBC1A;
+                samples = {{0, 63, 0, UINT32_MAX}};
+                break;
+            case VIETextureFormat::BC3:
+                colorModel = kModelBC3;
+                samples = {{0, 63, alphaType, UINT32_MAX}, {64, 63, 0, UINT32_MAX}};
+                break;
+            case VIETextureFormat::BC5:
+                colorModel = kModelBC5;
+                samples = {{0, 63, 0, UINT32_MAX}, {64, 63, 1, UINT32_MAX}};
+                break;
+            case VIETextureFormat::BC7:
+                colorModel = kModelBC7;
+                samples = {{0, 127, 0, UINT32_MAX}};
+                break;
+        }
+
+        const auto blockSize = static_cast<uint16_t>(24 + 16 * samples.size());
+        const uint8_t blockDimension = format == VIETextureFormat::RGBA8 ? 0 : 3;
+
+        append<uint32_t>(data, 4 + blockSize);          // dfdTotalSize
+        append<uint32_t>(data, 0);                      // vendorId (Khronos), descriptorType (basic)
+        append<uint16_t>(data, 2);                      // versionNumber
+        append<uint16_t>(data, blockSize);
+        append<uint8_t>(data, colorModel);
+        append<uint8_t>(data, kPrimariesBT709);
+        append<uint8_t>(data, isSRGB ? kTransferSRGB : kTransferLinear);
+        append<uint8_t>(data, 0);                       // flags (straight alpha)
+
+        for (uint8_t dimension: {blockDimension, blockDimension, uint8_t{0}, uint8_t{0}}) {
+            append<uint8_t>(data, dimension);
+        }
+
+        append<uint8_t>(data, static_cast<uint8_t>(getBlockSize(format)));  // bytesPlane0
+        for (int plane = 1; plane < 8; ++plane) {
+            append<uint8_t>(data, 0);
+        }
+
+        for (const Sample &sample: samples) {
+            append<uint16_t>(data, sample.bitOffset);
+            append<uint8_t>(data, sample.bitLength);
+            append<uint8_t>(data, sample.channelType);
+            append<uint32_t>(data, 0);                  // samplePosition
+            append<uint32_t>(data, 0);                  // sampleLower
+            append<uint32_t>(data, sample.sampleUpper);
+        }
+    }
+
+    void appendKeyValue(std::vector<uint8_t> &data, std::string_view key, std::string_view value) {
+        append<uint32_t>(data, static_cast<uint32_t>(key.size() + 1 + value.size() + 1));
+        data.insert(data.end(), key.begin(), key.end());
+        data.push_back(0);
+        data.insert(data.end(), value.begin(), value.end());
+        data.push_back(0);
+
+        data.resize((data.size() + 3) & ~size_t{3});
+    }
+
+    bool getFormat(VkFormat vkFormat, VIETextureFormat &format, bool &isSRGB) {
+        isSRGB = true;
+
+        switch (vkFormat) {
+            case VK_FORMAT_R8G8B8A8_UNORM:
+                isSRGB = false;
+                [[fallthrough]];
+            case VK_FORMAT_R8G8B8A8_SRGB:
+                format = VIETextureFormat::RGBA8;
+                return true;
+            case VK_FORMAT_BC1_RGB_UNORM_BLOCK:
+                isSRGB = false;
+                [[fallthrough]];
+            case VK_FORMAT_BC1_RGB_SRGB_BLOCK:
+                format = VIETextureFormat::BC1;
+                return true;
+            case VK_FORMAT_BC3_UNORM_BLOCK:
+                isSRGB = false;
+                [[fallthrough]];
+            case VK_FORMAT_BC3_SRGB_BLOCK:
+                format = VIETextureFormat::BC3;
+                return true;
+            case VK_FORMAT_BC5_UNORM_BLOCK:
+                isSRGB = false;
+                format = VIETextureFormat::BC5;
+                return true;
+            case VK_FORMAT_BC7_UNORM_BLOCK:
+                isSRGB = false;
+                [[fallthrough]];
+            case VK_FORMAT_BC7_SRGB_BLOCK:
+                format = VIETextureFormat::BC7;
+                return true;
+            default:
+                return false;
+        }
+    }
+}
+
+VkFormat tools::getTextureVkFormat(VIETextureFormat format, bool isSRGB) {
+    switch (format) {
+        case VIETextureFormat::BC1:
+            return isSRGB ? VK_FORMAT_BC1_RGB_SRGB_BLOCK : VK_FORMAT_BC1_RGB_UNORM_BLOCK;
+        case VIETextureFormat::BC3:
+            return isSRGB ? VK_FORMAT_BC3_SRGB_BLOCK : VK_FORMAT_BC3_UNORM_BLOCK;
+        case VIETextureFormat::BC5:
+            return VK_FORMAT_BC5_UNORM_BLOCK;
+        case VIETextureFormat::BC7:
+            return isSRGB ? VK_FORMAT_BC7_SRGB_BLOCK : VK_FORMAT_BC7_UNORM_BLOCK;
+        default:
+            return isSRGB ? VK_FORMAT_R8G8B8A8_SRGB : VK_FORMAT_R8G8B8A8_UNORM;
+    }
+}
+
+bool tools::writeKTX2(const std::string &location, const VIETextureData &texture, const std::string &sourceStamp) {
+    if (!texture.isLoaded()) {
+        return false;
+    }
+
+    const auto levelCount = static_cast<uint32_t>(texture.mipLevels.size());
+    const bool isSRGB = texture.isSRGB && texture.format != VIETextureFormat::BC5;
+
+    std::vector<uint8_t> data(kIdentifier.begin(), kIdentifier.end());
+
+    append<uint32_t>(data, getTextureVkFormat(texture.format, texture.isSRGB));
+    append<uint32_t>(data, 1);                          // typeSize
+    append<uint32_t>(data, texture.getWidth());
+    append<uint32_t>(data, texture.getHeight());
+    append<uint32_t>(data, 0);                          // pixelDepth
+    append<uint32_t>(data, 0);                          // layerCount
+    append<uint32_t>(data, 1);                          // faceCount
+    append<uint32_t>(data, levelCount);
+    append<uint32_t>(data, 0);                          // supercompressionScheme
+
+    // Index, filled once the sections are written
+    data.resize(kHeaderSize + levelCount * kLevelIndexSize);
+
+    const size_t dfdOffset = data.size();
+    appendDataFormatDescriptor(data, texture.format, isSRGB);
+
+    // Keys are sorted by their bytes
+    const size_t kvdOffset = data.size();
+    appendKeyValue(data, "KTXwriter", "VulkanIndirectEngine");
+    if (!sourceStamp.empty()) {
+        appendKeyValue(data, kSourceKey, sourceStamp);
+    }
+    const size_t kvdSize = data.size() - kvdOffset;
+
+    store<uint32_t>(data, 48, static_cast<uint32_t>(dfdOffset));
+    store<uint32_t>(data, 52, static_cast<uint32_t>(kvdOffset - dfdOffset));
+    store<uint32_t>(data, 56, static_cast<uint32_t>(kvdOffset));
+    store<uint32_t>(data, 60, static_cast<uint32_t>(kvdSize));
+
+    // Levels are stored from the smallest to the biggest, each aligned to the block size
+    const size_t alignment = getBlockSize(texture.format);
+
+    for (uint32_t level = levelCount; level-- > 0;) {
+        const VIEMipLevel &mipLevel = texture.mipLevels[level];
+
+        data.resize((data.size() + alignment - 1) / alignment * alignment);
+
+        const size_t indexPosition = kHeaderSize + level * kLevelIndexSize;
+        store<uint64_t>(data, indexPosition, data.size());
+        store<uint64_t>(data, indexPosition + 8, mipLevel.size);
+        store<uint64_t>(data, indexPosition + 16, mipLevel.size);
+
+        data.insert(data.end(), texture.pixels.begin() + static_cast<std::ptrdiff_t>(mipLevel.offset),
+                    texture.pixels.begin() + static_cast<std::ptrdiff_t>(mipLevel.offset + mipLevel.size));
+    }
+
+    std::ofstream file(location, std::ios::binary | std::ios::trunc);
+
+    return file.is_open() && file.write(reinterpret_cast<const char *>(data.data()),
+                                        static_cast<std::streamsize>(data.size()));
+}
+
+bool tools::readKTX2(const std::string &location, VIETextureData &texture, std::string *sourceStamp) {
+    std::ifstream file(location, std::ios::binary);
+
+    if (!file.is_open()) {
+        log_error("readKTX2: {} not opened.", location);
+        return false;
+    }
+
+    std::vector<uint8_t> data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+    if (data.size() < kHeaderSize || !std::equal(kIdentifier.begin(), kIdentifier.end(), data.begin())) {
+        log_error("readKTX2: {} is not a KTX2 file.", location);
+        return false;
+    }
+
+    VIETextureFormat format;
+    bool isSRGB;
+    const uint32_t width = load<uint32_t>(data, 20);
+    const uint32_t height = load<uint32_t>(data, 24);
+    const uint32_t levelCount = load<uint32_t>(data, 40);
+
+    // Only plain 2D textures with their mip chain (depth, layers, faces and supercompression are not supported)
+    if (!getFormat(static_cast<VkFormat>(load<uint32_t>(data, 12)), format, isSRGB) || width == 0 || height == 0 ||
+        load<uint32_t>(data, 28) != 0 || load<uint32_t>(data, 32) > 1 || load<uint32_t>(data, 36) != 1 ||
+        levelCount == 0 || load<uint32_t>(data, 44) != 0 || data.size() < kHeaderSize + levelCount * kLevelIndexSize) {
+        log_error("readKTX2: {} has an unsupported layout or format.", location);
+        return false;
+    }
+
+    texture.format = format;
+    texture.isSRGB = isSRGB;
+    texture.mipLevels.clear();
+    texture.pixels.clear();
+
+    for (uint32_t level = 0, levelWidth = width, levelHeight = height; level < levelCount; ++level) {
+        const size_t indexPosition = kHeaderSize + level * kLevelIndexSize;
+        const auto byteOffset = load<uint64_t>(data, indexPosition);
+        const auto byteLength = load<uint64_t>(data, indexPosition + 8);
+        const size_t size = getTextureLevelSize(format, levelWidth, levelHeight);
+
+        if (byteLength != size || byteOffset + byteLength > data.size()) {
+            log_error("readKTX2: {} has a corrupted level {}.", location, level);
+            texture.mipLevels.clear();
+            texture.pixels.clear();
+            return false;
+        }
+
+        texture.mipLevels.push_back({texture.pixels.size(), size, levelWidth, levelHeight});
+        texture.pixels.insert(texture.pixels.end(), data.begin() + static_cast<std::ptrdiff_t>(byteOffset),
+                              data.begin() + static_cast<std::ptrdiff_t>(byteOffset + byteLength));
+
+        levelWidth = std::max(levelWidth / 2, 1u);
+        levelHeight = std::max(levelHeight / 2, 1u);
+    }
+
+    if (sourceStamp) {
+        sourceStamp->clear();
+
+        const size_t kvdOffset = load<uint32_t>(data, 56);
+        const size_t kvdEnd = std::min(kvdOffset + load<uint32_t>(data, 60), data.size());
+
+        for (size_t position = kvdOffset; position + 4 <= kvdEnd;) {
+            const size_t length = load<uint32_t>(data, position);
+            const std::string_view entry(reinterpret_cast<const char *>(&data[position + 4]),
+                                         std::min(length, kvdEnd - position - 4));
+
+            if (entry.starts_with(kSourceKey) && entry.size() > kSourceKey.size() && entry[kSourceKey.size()] == 0) {
+                std::string_view value(entry.substr(kSourceKey.size() + 1));
+                *sourceStamp = value.substr(0, value.find('\0'));
+                break;
+            }
+
+            position += (4 + length + 3) & ~size_t{3};
+        }
+    }
+
+    return true;
+}
@@ -0,0 +1,187 @@
+/* Created by LordRibblesdale on 18/10/2026.
+ * MIT License
+ */
+
+#include "tools/VIELogger.hpp"
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <thread>
+#include <algorithm>
+
+namespace {
+    /**
+     * @brief Message of the log ring, owned by producers or by the logging thread depending on its sequence
+     */
+    struct LogSlot {
+        static constexpr size_t kMessageSize{512};
+
+        std::atomic<size_t> sequence{0};
+        VIELogLevel level{VIELogLevel::INFO};
+        uint64_t timestamp{0};                          ///< Nanoseconds since the logger started
+        size_t length{0};
+        std::array<char, kMessageSize> text{};
+    };
+
+    /**
+     * @brief Logger class, bounded multi producer ring (sequence per slot) drained by a single logging thread
+     * A slot whose sequence equals a producer position is free for it; once written, its sequence is advanced by one
+     * and the logging thread can read it, then frees it for the producer a lap later.
+     */
+    class Logger {
+        static constexpr size_t kSlotCount{1024};       ///< Power of two
+
+        std::unique_ptr<std::array<LogSlot, kSlotCount>> slots{std::make_unique<std::array<LogSlot, kSlotCount>>()};
+        std::atomic<size_t> enqueuePosition{0};
+        std::atomic<size_t> writtenPosition{0};         ///< Messages before it have been written
+        std::atomic<size_t> droppedCount{0};
+        std::atomic<bool> isRunning{true};
+        std::atomic<bool> isExiting{false};             ///< Messages are written before push returns
+
+        const std::chrono::steady_clock::time_point start{std::chrono::steady_clock::now()};
+        std::thread writer;
+
+        static constexpr std::array<const char *, 4> kLevelNames{"VERBOSE", "INFO", "WARNING", "ERROR"};
+
+        /**
+         * @brief Writes every message available, in order, with a single flush
+         * @return false if there was nothing to write
+         */
+        bool drain(std::string &batch) {
+            size_t position = writtenPosition.load(std::memory_order_relaxed);
+            batch.clear();
+
+            for (LogSlot *slot = &(*slots)[position & (kSlotCount - 1)];
+                 slot->sequence.load(std::memory_order_acquire) == position + 1;
+                 slot = &(*slots)[position & (kSlotCount - 1)]) {
+                fmt::format_to(std::back_inserter(batch), "[{:10.3f}] [{}] {}\n",
+                               static_cast<double>(slot->timestamp) * 1e-6,
+                               kLevelNames[static_cast<size_t>(slot->level)],
+                               fmt::string_view(slot->text.data(), slot->length));
+
+                slot->sequence.store(position + kSlotCount, std::memory_order_release);
+                ++position;
+            }
+
+            if (const size_t dropped = droppedCount.exchange(0, std::memory_order_relaxed); dropped > 0) {
+                fmt::format_to(std::back_inserter(batch), "[{:>10}] [WARNING] Log ring full, {} messages dropped\n",
+                               "", dropped);
+            }
+
+            if (batch.empty()) {
+                return false;
+            }
+
+            std::fwrite(batch.data(), 1, batch.size(), stdout);
+            std::fflush(stdout);
+            writtenPosition.store(position, std::memory_order_release);
+
+            return true;
+        }
+
+    public:
+        Logger() {
+            for (size_t i = 0; i < kSlotCount; ++i) {
+                (*slots)[i].sequence.store(i, std::memory_order_relaxed);
+            }
+
+            writer = std::thread([this]() {
+                std::string batch;
+
+                // Polling keeps producers free of any notification
+                while (isRunning.load(std::memory_order_acquire)) {
+                    if (!drain(batch)) {
+                        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+                    }
+                }
+
+                while (drain(batch)) {}
+            });
+        }
+
+        Logger(const Logger &) = delete;
+
+        ~Logger() {
+            isRunning.store(false, std::memory_order_release);
+            writer.join();
+        }
+
+        void push(VIELogLevel level, fmt::string_view format, fmt::format_args args) {
+            size_t position = enqueuePosition.load(std::memory_order_relaxed);
+            LogSlot *slot;
+
+            for (;;) {
+                slot = &(*slots)[position & (kSlotCount - 1)];
+                const auto difference = static_cast<std::ptrdiff_t>(slot->sequence.load(std::memory_order_acquire) -
+                                                                    position);
+
+                if (difference == 0) {
+                    if (enqueuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                        break;
+                    }
+                } else if (difference < 0) {
+                    // Still to be written from the previous lap
+                    droppedCount.fetch_add(1, std::memory_order_relaxed);
+                    return;
+                } else {
+                    position = enqueuePosition.load(std::memory_order_relaxed);
+                }
+            }
+
+            slot->level = level;
+            slot->timestamp = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    std::chrono::steady_clock::now() - start).count());
+            slot->length = std::min(fmt::vformat_to_n(slot->text.data(), LogSlot::kMessageSize, format, args).size,
+                                    LogSlot::kMessageSize);
+
+            slot->sequence.store(position + 1, std::memory_order_release);
+
+            // No exit handler is left to wait for the logging thread
+            if (isExiting.load(std::memory_order_acquire)) {
+                flush();
+            }
+        }
+
+        void flush() {
+            const size_t position = enqueuePosition.load(std::memory_order_acquire);
+
+            while (writtenPosition.load(std::memory_order_acquire) < position) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+        }
+
+        /**
+         * @brief Writes the pending messages, and makes every later message written before its push returns
+         */
+        void exit() {
+            isExiting.store(true, std::memory_order_release);
+            flush();
+        }
+    };
+
+    // Leaked on purpose, so that it lives for the whole program: static objects and job system workers may still log
+    // during static destruction. Its logging thread runs until the process ends, so pending messages are written by
+    // an exit handler, and the ones logged after it are written synchronously
+    Logger &getLogger() {
+        static Logger *logger = []() {
+            auto *newLogger = new Logger();
+            std::atexit([]() { getLogger().exit(); });
+            return newLogger;
+        }();
+
+        return *logger;
+    }
+}
+
+void tools::vlog(VIELogLevel level, fmt::string_view format, fmt::format_args args) {
+    getLogger().push(level, format, args);
+}
+
+void tools::flushLog() {
+    getLogger().flush();
+}
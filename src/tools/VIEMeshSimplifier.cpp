@@ -0,0 +1,441 @@
+/* Created by LordRibblesdale on 18/10/2026.
+ * MIT License
+ */
+
+#include "tools/VIEMeshSimplifier.hpp"
+
+#include <glm/glm.hpp>
+
+#include <array>
+#include <cmath>
+#include <limits>
+#include <cstring>
+#include <algorithm>
+#include <unordered_map>
+
+namespace {
+    constexpr float kNormalWeight{0.01f};   ///< Penalty of normal changes, relative to the squared mesh extent
+    constexpr float kUVWeight{1.0f};        ///< Penalty of UV changes, relative to the squared mesh extent
+
+    /**
+     * @brief Error quadric of a set of planes (symmetric 4x4 matrix, area weighted)
+     */
+    struct Quadric {
+        std::array<double, 10> q{};     ///< a2, ab, ac, ad, b2, bc, bd, c2, cd, d2
+        double weight{0.0};
+
+        void addPlane(const glm::dvec3 &normal, double distance, double area) {
+            const double a = normal.x, b = normal.y, c = normal.z, d = distance;
+
+            q[0] += area * a * a; q[1] += area * a * b; q[2] += area * a * c; q[3] += area * a * d;
+            q[4] += area * b * b; q[5] += area * b * c; q[6] += area * b * d;
+            q[7] += area * c * c; q[8] += area * c * d;
+            q[9] += area * d * d;
+            weight += area;
+        }
+
+        void add(const Quadric &other) {
+            for (size_t i = 0; i < q.size(); ++i) {
+                q[i] += other.q[i];
+            }
+
+            weight += other.weight;
+        }
+
+        double evaluate(const glm::vec3 &p) const {
+            const double x = p.x, y = p.y, z = p.z;
+            const double result = q[0] * x * x + 2 * q[1] * x * y + 2 * q[2] * x * z + 2 * q[3] * x +
+                                  q[4] * y * y + 2 * q[5] * y * z + 2 * q[6] * y +
+                                  q[7] * z * z + 2 * q[8] * z +
+                                  q[9];
+
+            return std::max(result, 0.0);
+        }
+    };
+
+    struct Collapse {
+        float cost{0.0f};
+        uint32_t source{0};     ///< Group removed by the collapse
+        uint32_t target{0};     ///< Group receiving the source triangles
+    };
+
+    /**
+     * @brief Simplification state of a mesh, kept between consecutive levels of detail
+     * Vertices sharing the same position are welded in groups, so that attribute seams collapse together.
+     */
+    class QuadricSimplifier {
+        std::span<const VIEVertex> vertices;
+
+        std::vector<uint32_t> vertexGroups;     ///< Group of each vertex
+        std::vector<uint32_t> groupOffsets;     ///< Vertices of each group (CSR offsets in groupVertices)
+        std::vector<uint32_t> groupVertices;
+        std::vector<glm::vec3> groupPositions;
+        std::vector<Quadric> quadrics;
+        std::vector<uint8_t> lockedGroups;      ///< Groups on open borders
+
+        std::vector<uint32_t> triangles;        ///< Current indices
+        float attributeScale{1.0f};
+        float error{0.0f};
+
+        void weldVertices() {
+            std::unordered_map<uint64_t, std::vector<uint32_t>> buckets;
+            vertexGroups.assign(vertices.size(), 0);
+
+            for (uint32_t v = 0; v < vertices.size(); ++v) {
+                std::array<uint32_t, 3> bits{};
+                std::memcpy(bits.data(), &vertices[v].pos, sizeof(bits));
+                const uint64_t key = (bits[0] * 73856093ull) ^ (bits[1] * 19349663ull) ^ (bits[2] * 83492791ull);
+
+                auto &bucket = buckets[key];
+                auto match = std::find_if(bucket.begin(), bucket.end(), [&](uint32_t group) {
+                    return groupPositions[group] == vertices[v].pos;
+                });
+
+                if (match == bucket.end()) {
+                    bucket.push_back(static_cast<uint32_t>(groupPositions.size()));
+                    vertexGroups[v] = static_cast<uint32_t>(groupPositions.size());
+                    groupPositions.push_back(vertices[v].pos);
+                } else {
+                    vertexGroups[v] = *match;
+                }
+            }
+
+            groupOffsets.assign(groupPositions.size() + 1, 0);
+            for (uint32_t group: vertexGroups) {
+                ++groupOffsets[group + 1];
+            }
+
+            for (size_t group = 0; group < groupPositions.size(); ++group) {
+                groupOffsets[group + 1] += groupOffsets[group];
+            }
+
+            groupVertices.resize(vertices.size());
+            std::vector<uint32_t> cursor(groupOffsets.begin(), groupOffsets.end() - 1);
+            for (uint32_t v = 0; v < vertices.size(); ++v) {
+                groupVertices[cursor[vertexGroups[v]]++] = v;
+            }
+        }
+
+        void computeQuadrics() {
+            quadrics.assign(groupPositions.size(), {});
+
+            for (size_t t = 0; t < triangles.size(); t += 3) {
+                const glm::dvec3 p0 = vertices[triangles[t]].pos;
+                const glm::dvec3 p1 = vertices[triangles[t + 1]].pos;
+                const glm::dvec3 p2 = vertices[triangles[t + 2]].pos;
+
+                glm::dvec3 normal = glm::cross(p1 - p0, p2 - p0);
+                const double length = glm::length(normal);
+
+                if (length <= 0.0) {
+                    continue;
+                }
+
+                normal /= length;
+                const double area = length * 0.5;
+
+                for (uint32_t corner = 0; corner < 3; ++corner) {
+                    quadrics[vertexGroups[triangles[t + corner]]].addPlane(normal, -glm::dot(normal, p0), area);
+                }
+            }
+        }
+
+        void lockBorders() {
+            // An edge used by a single triangle is an open border
+            std::vector<std::pair<uint32_t, uint32_t>> edges;
+            edges.reserve(triangles.size());
+
+            for (size_t t = 0; t < triangles.size(); t += 3) {
+                for (uint32_t corner = 0; corner < 3; ++corner) {
+                    uint32_t a = vertexGroups[triangles[t + corner]];
+                    uint32_t b = vertexGroups[triangles[t + (corner + 1) % 3]];
+                    edges.emplace_back(std::min(a, b), std::max(a, b));
+                }
+            }
+
+            std::sort(edges.begin(), edges.end());
+            lockedGroups.assign(groupPositions.size(), 0);
+
+            for (size_t i = 0; i < edges.size();) {
+                size_t j = i;
+                while (j < edges.size() && edges[j] == edges[i]) {
+                    ++j;
+                }
+
+                if (j - i == 1) {
+                    lockedGroups[edges[i].first] = 1;
+                    lockedGroups[edges[i].second] = 1;
+                }
+
+                i = j;
+            }
+        }
+
+        // Vertex of the target group closest to the attributes of vertex v, with the attribute distance
+        std::pair<uint32_t, float> findClosestVertex(uint32_t v, uint32_t targetGroup) const {
+            std::pair<uint32_t, float> closest{groupVertices[groupOffsets[targetGroup]],
+                                               std::numeric_limits<float>::max()};
+
+            for (uint32_t i = groupOffsets[targetGroup]; i < groupOffsets[targetGroup + 1]; ++i) {
+                const VIEVertex &candidate = vertices[groupVertices[i]];
+                const glm::vec2 uvDelta = candidate.uvCoords - vertices[v].uvCoords;
+                const float distance = kNormalWeight * (1.0f - glm::dot(candidate.normal, vertices[v].normal)) +
+                                       kUVWeight * glm::dot(uvDelta, uvDelta);
+
+                if (distance < closest.second) {
+                    closest = {groupVertices[i], distance};
+                }
+            }
+
+            return closest;
+        }
+
+        float computeCost(uint32_t source, uint32_t target) const {
+            Quadric combined = quadrics[source];
+            combined.add(quadrics[target]);
+
+            float attributeDistance = 0.0f;
+            for (uint32_t i = groupOffsets[source]; i < groupOffsets[source + 1]; ++i) {
+                attributeDistance = std::max(attributeDistance, findClosestVertex(groupVertices[i], target).second);
+            }
+
+            return static_cast<float>(combined.evaluate(groupPositions[target]) +
+                                      quadrics[source].weight * attributeScale * attributeDistance);
+        }
+
+        // Moving the source group on the target must not flip the triangles that survive the collapse
+        bool isCollapseValid(uint32_t source, uint32_t target, std::span<const uint32_t> sourceTriangles) const {
+            for (uint32_t t: sourceTriangles) {
+                std::array<uint32_t, 3> groups{vertexGroups[triangles[t]], vertexGroups[triangles[t + 1]],
+                                               vertexGroups[triangles[t + 2]]};
+
+                if (std::find(groups.begin(), groups.end(), target) != groups.end()) {
+                    continue;
+                }
+
+                std::array<glm::vec3, 3> before{groupPositions[groups[0]], groupPositions[groups[1]],
+                                                groupPositions[groups[2]]};
+                std::array<glm::vec3, 3> after{before};
+                for (uint32_t corner = 0; corner < 3; ++corner) {
+                    if (groups[corner] == source) {
+                        after[corner] = groupPositions[target];
+                    }
+                }
+
+                const glm::vec3 normalBefore = glm::cross(before[1] - before[0], before[2] - before[0]);
+                const glm::vec3 normalAfter = glm::cross(after[1] - after[0], after[2] - after[0]);
+
+                if (glm::dot(normalBefore, normalAfter) <= 0.0f) {
+                    return false;
+                }
+            }
+
+            return true;
+        }
+
+        // Single pass of independent collapses, returns false if none was applied
+        bool collapsePass(size_t targetIndexCount) {
+            const size_t groupCount = groupPositions.size();
+
+            // Triangles around each group
+            std::vector<uint32_t> triangleOffsets(groupCount + 1, 0);
+            for (uint32_t index: triangles) {
+                ++triangleOffsets[vertexGroups[index] + 1];
+            }
+
+            for (size_t group = 0; group < groupCount; ++group) {
+                triangleOffsets[group + 1] += triangleOffsets[group];
+            }
+
+            std::vector<uint32_t> groupTriangles(triangles.size());
+            std::vector<uint32_t> cursor(triangleOffsets.begin(), triangleOffsets.end() - 1);
+            for (uint32_t i = 0; i < triangles.size(); ++i) {
+                groupTriangles[cursor[vertexGroups[triangles[i]]]++] = i - i % 3;
+            }
+
+            std::vector<std::pair<uint32_t, uint32_t>> edges;
+            edges.reserve(triangles.size());
+            for (size_t t = 0; t < triangles.size(); t += 3) {
+                for (uint32_t corner = 0; corner < 3; ++corner) {
+                    uint32_t a = vertexGroups[triangles[t + corner]];
+                    uint32_t b = vertexGroups[triangles[t + (corner + 1) % 3]];
+                    edges.emplace_back(std::min(a, b), std::max(a, b));
+                }
+            }
+
+            std::sort(edges.begin(), edges.end());
+            edges.erase(std::unique(edges.begin(), edges.end()), edges.end());
+
+            std::vector<Collapse> collapses;
+            collapses.reserve(edges.size());
+            for (auto [a, b]: edges) {
+                const float costAB = lockedGroups[a] ? std::numeric_limits<float>::max() : computeCost(a, b);
+                const float costBA = lockedGroups[b] ? std::numeric_limits<float>::max() : computeCost(b, a);
+
+                if (costAB != std::numeric_limits<float>::max() || costBA != std::numeric_limits<float>::max()) {
+                    collapses.push_back(costAB <= costBA ? Collapse{costAB, a, b} : Collapse{costBA, b, a});
+                }
+            }
+
+            std::sort(collapses.begin(), collapses.end(), [](const Collapse &a, const Collapse &b) {
+                return a.cost < b.cost;
+            });
+
+            // Each collapse removes about two triangles
+            const size_t maxCollapses = (triangles.size() - targetIndexCount) / 6 + 1;
+            std::vector<uint8_t> touched(groupCount, 0);
+            std::vector<uint32_t> vertexRemap(vertices.size());
+            for (uint32_t v = 0; v < vertexRemap.size(); ++v) {
+                vertexRemap[v] = v;
+            }
+
+            size_t collapseCount = 0;
+            for (const Collapse &collapse: collapses) {
+                if (collapseCount >= maxCollapses) {
+                    break;
+                }
+
+                if (touched[collapse.source] || touched[collapse.target]) {
+                    continue;
+                }
+
+                std::span<const uint32_t> sourceTriangles(groupTriangles.data() + triangleOffsets[collapse.source],
+                                                          triangleOffsets[collapse.source + 1] -
+                                                          triangleOffsets[collapse.source]);
+
+                if (!isCollapseValid(collapse.source, collapse.target, sourceTriangles)) {
+                    continue;
+                }
+
+                for (uint32_t t: sourceTriangles) {
+                    for (uint32_t corner = 0; corner < 3; ++corner) {
+                        touched[vertexGroups[triangles[t + corner]]] = 1;
+                    }
+                }
+
+                for (uint32_t i = groupOffsets[collapse.source]; i < groupOffsets[collapse.source + 1]; ++i) {
+                    vertexRemap[groupVertices[i]] = findClosestVertex(groupVertices[i], collapse.target).first;
+                }
+
+                quadrics[collapse.target].add(quadrics[collapse.source]);
+                ++collapseCount;
+            }
+
+            if (collapseCount == 0) {
+                return false;
+            }
+
+            // Remaps the indices, removing the triangles collapsed to an edge
+            size_t size = 0;
+            for (size_t t = 0; t < triangles.size(); t += 3) {
+                const uint32_t i0 = vertexRemap[triangles[t]];
+                const uint32_t i1 = vertexRemap[triangles[t + 1]];
+                const uint32_t i2 = vertexRemap[triangles[t + 2]];
+                const uint32_t g0 = vertexGroups[i0], g1 = vertexGroups[i1], g2 = vertexGroups[i2];
+
+                if (g0 != g1 && g1 != g2 && g0 != g2) {
+                    triangles[size++] = i0;
+                    triangles[size++] = i1;
+                    triangles[size++] = i2;
+                }
+            }
+
+            triangles.resize(size);
+
+            return true;
+        }
+
+        void updateError() {
+            std::vector<uint8_t> usedGroups(groupPositions.size(), 0);
+            for (uint32_t index: triangles) {
+                usedGroups[vertexGroups[index]] = 1;
+            }
+
+            for (size_t group = 0; group < groupPositions.size(); ++group) {
+                if (usedGroups[group] && quadrics[group].weight > 0.0) {
+                    const double distance = quadrics[group].evaluate(groupPositions[group]) / quadrics[group].weight;
+                    error = std::max(error, static_cast<float>(std::sqrt(distance)));
+                }
+            }
+        }
+
+    public:
+        QuadricSimplifier(std::span<const VIEVertex> meshVertices, std::span<const uint32_t> indices)
+                : vertices(meshVertices) {
+            weldVertices();
+
+            // Triangles already degenerate are removed upfront
+            triangles.reserve(indices.size());
+            for (size_t t = 0; t + 2 < indices.size(); t += 3) {
+                const uint32_t g0 = vertexGroups[indices[t]];
+                const uint32_t g1 = vertexGroups[indices[t + 1]];
+                const uint32_t g2 = vertexGroups[indices[t + 2]];
+
+                if (g0 != g1 && g1 != g2 && g0 != g2) {
+                    triangles.insert(triangles.end(), {indices[t], indices[t + 1], indices[t + 2]});
+                }
+            }
+
+            computeQuadrics();
+            lockBorders();
+
+            glm::vec3 minimum(std::numeric_limits<float>::max());
+            glm::vec3 maximum(std::numeric_limits<float>::lowest());
+            for (const glm::vec3 &position: groupPositions) {
+                minimum = glm::min(minimum, position);
+                maximum = glm::max(maximum, position);
+            }
+
+            const glm::vec3 extent = groupPositions.empty() ? glm::vec3(1.0f) : maximum - minimum;
+            attributeScale = glm::dot(extent, extent);
+        }
+
+        const std::vector<uint32_t> &simplify(size_t targetIndexCount) {
+            while (triangles.size() > targetIndexCount && collapsePass(targetIndexCount)) {}
+            updateError();
+
+            return triangles;
+        }
+
+        float getError() const {
+            return error;
+        }
+    };
+}
+
+std::vector<uint32_t> tools::simplifyMesh(std::span<const VIEVertex> vertices, std::span<const uint32_t> indices,
+                                          size_t targetIndexCount, float &error) {
+    QuadricSimplifier simplifier(vertices, indices);
+    std::vector<uint32_t> result = simplifier.simplify(targetIndexCount - targetIndexCount % 3);
+    error = simplifier.getError();
+
+    return result;
+}
+
+std::vector<VIELodLevel> tools::generateLodChain(std::span<const VIEVertex> vertices, std::span<const uint32_t> indices,
+                                                 uint32_t maxLevels, float reductionRatio) {
+    std::vector<VIELodLevel> levels;
+    QuadricSimplifier simplifier(vertices, indices);
+    size_t indexCount = indices.size();
+
+    for (uint32_t level = 0; level < maxLevels; ++level) {
+        auto target = static_cast<size_t>(static_cast<float>(indexCount) * reductionRatio);
+        target -= target % 3;
+
+        if (target < 3) {
+            break;
+        }
+
+        const std::vector<uint32_t> &simplified = simplifier.simplify(target);
+
+        // A level saving less than 10% of the previous one is not worth the memory
+        if (simplified.empty() || simplified.size() * 10 > indexCount * 9) {
+            break;
+        }
+
+        levels.push_back({simplified, simplifier.getError()});
+        indexCount = simplified.size();
+    }
+
+    return levels;
+}
@@ -0,0 +1,257 @@
+/* Created by LordRibblesdale on 18/10/2026.
+ * MIT License
+ */
+
+#include "tools/VIEMeshlets.hpp"
+
+#include <glm/glm.hpp>
+
+#include <array>
+#include <cmath>
+#include <limits>
+#include <algorithm>
+
+namespace {
+    constexpr uint8_t kNotInMeshlet{0xFF};
+    constexpr float kMinConeDot{0.1f};      ///< Cones wider than this (cosine of the angle) are not worth testing
+
+    // Bounding sphere and normal cone of the meshlet
+    void computeBounds(std::span<const VIEVertex> vertices, const std::vector<uint32_t> &meshletVertices,
+                       const std::vector<uint8_t> &meshletTriangles, VIEMeshlet &meshlet) {
+        glm::vec3 minimum(std::numeric_limits<float>::max());
+        glm::vec3 maximum(std::numeric_limits<float>::lowest());
+
+        for (uint32_t i = 0; i < meshlet.vertexCount; ++i) {
+            const glm::vec3 &position = vertices[meshletVertices[meshlet.vertexOffset + i]].pos;
+            minimum = glm::min(minimum, position);
+            maximum = glm::max(maximum, position);
+        }
+
+        const glm::vec3 center((minimum + maximum) * 0.5f);
+        float radius = 0.0f;
+
+        for (uint32_t i = 0; i < meshlet.vertexCount; ++i) {
+            radius = std::max(radius, glm::distance(center, vertices[meshletVertices[meshlet.vertexOffset + i]].pos));
+        }
+
+        meshlet.boundingSphere = glm::vec4(center, radius);
+
+        // Cone around the face normals, with the apex placed so that every triangle plane is behind it
+        std::array<glm::vec3, VIEMeshlet::kMaxTriangles> normals{};
+        std::array<glm::vec3, VIEMeshlet::kMaxTriangles> corners{};
+        uint32_t normalCount = 0;
+        glm::vec3 axis(0.0f);
+
+        for (uint32_t t = 0; t < meshlet.triangleCount; ++t) {
+            const uint8_t *triangle = meshletTriangles.data() + meshlet.triangleOffset + t * 3;
+            const glm::vec3 &p0 = vertices[meshletVertices[meshlet.vertexOffset + triangle[0]]].pos;
+            const glm::vec3 &p1 = vertices[meshletVertices[meshlet.vertexOffset + triangle[1]]].pos;
+            const glm::vec3 &p2 = vertices[meshletVertices[meshlet.vertexOffset + triangle[2]]].pos;
+
+            const glm::vec3 normal(glm::cross(p1 - p0, p2 - p0));
+            const float length = glm::length(normal);
+
+            if (length > 0.0f) {
+                normals[normalCount] = normal / length;
+                corners[normalCount++] = p0;
+                axis += normal / length;
+            }
+        }
+
+        meshlet.coneAxis = glm::vec4(0.0f, 0.0f, 0.0f, 1.0f);
+        meshlet.coneApex = glm::vec4(center, 1.0f);
+
+        if (normalCount == 0 || glm::length(axis) <= 0.0f) {
+            return;
+        }
+
+        axis = glm::normalize(axis);
+
+        float minimumDot = 1.0f;
+        for (uint32_t i = 0; i < normalCount; ++i) {
+            minimumDot = std::min(minimumDot, glm::dot(axis, normals[i]));
+        }
+
+        if (minimumDot <= kMinConeDot) {
+            return;
+        }
+
+        float apexDistance = 0.0f;
+        for (uint32_t i = 0; i < normalCount; ++i) {
+            apexDistance = std::max(apexDistance, glm::dot(center - corners[i], normals[i]) /
+                                                  glm::dot(axis, normals[i]));
+        }
+
+        meshlet.coneApex = glm::vec4(center - axis * apexDistance, 1.0f);
+        meshlet.coneAxis = glm::vec4(axis, std::sqrt(1.0f - minimumDot * minimumDot));
+    }
+}
+
+void tools::buildMeshlets(std::span<const VIEVertex> vertices, std::span<const uint32_t> indices,
+                          std::vector<VIEMeshlet> &meshlets, std::vector<uint32_t> &meshletVertices,
+                          std::vector<uint8_t> &meshletTriangles) {
+    const size_t triangleCount = indices.size() / 3;
+
+    // Triangles around each vertex
+    std::vector<uint32_t> triangleOffsets(vertices.size() + 1, 0);
+    for (size_t i = 0; i < triangleCount * 3; ++i) {
+        ++triangleOffsets[indices[i] + 1];
+    }
+
+    for (size_t v = 0; v < vertices.size(); ++v) {
+        triangleOffsets[v + 1] += triangleOffsets[v];
+    }
+
+    std::vector<uint32_t> vertexTriangles(triangleCount * 3);
+    std::vector<uint32_t> cursor(triangleOffsets.begin(), triangleOffsets.end() - 1);
+    for (size_t i = 0; i < triangleCount * 3; ++i) {
+        vertexTriangles[cursor[indices[i]]++] = static_cast<uint32_t>(i / 3);
+    }
+
+    std::vector<uint8_t> emitted(triangleCount, 0);
+    std::vector<uint8_t> localIndices(vertices.size(), kNotInMeshlet);
+    size_t seed = 0;
+
+    VIEMeshlet meshlet{
+            .vertexOffset = static_cast<uint32_t>(meshletVertices.size()),
+            .triangleOffset = static_cast<uint32_t>(meshletTriangles.size())
+    };
+    glm::vec3 centroidSum(0.0f);
+
+    auto finishMeshlet([&]() {
+        for (uint32_t i = 0; i < meshlet.vertexCount; ++i) {
+            localIndices[meshletVertices[meshlet.vertexOffset + i]] = kNotInMeshlet;
+        }
+
+        meshletTriangles.resize(meshlet.triangleOffset + meshlet.getTriangleSpan(), 0);
+        computeBounds(vertices, meshletVertices, meshletTriangles, meshlet);
+        meshlets.push_back(meshlet);
+
+        meshlet = VIEMeshlet{
+                .vertexOffset = static_cast<uint32_t>(meshletVertices.size()),
+                .triangleOffset = static_cast<uint32_t>(meshletTriangles.size())
+        };
+        centroidSum = glm::vec3(0.0f);
+    });
+
+    while (true) {
+        uint32_t best = std::numeric_limits<uint32_t>::max();
+
+        if (meshlet.triangleCount > 0) {
+            // Adjacent triangles adding fewer vertices first, then the closest ones to the meshlet centroid
+            const glm::vec3 centroid(centroidSum / static_cast<float>(meshlet.triangleCount));
+            uint32_t bestNewVertices = 4;
+            float bestDistance = std::numeric_limits<float>::max();
+
+            for (uint32_t i = 0; i < meshlet.vertexCount; ++i) {
+                const uint32_t v = meshletVertices[meshlet.vertexOffset + i];
+
+                for (uint32_t j = triangleOffsets[v]; j < triangleOffsets[v + 1]; ++j) {
+                    const uint32_t t = vertexTriangles[j];
+
+                    if (emitted[t]) {
+                        continue;
+                    }
+
+                    const uint32_t newVertices = (localIndices[indices[t * 3]] == kNotInMeshlet) +
+                                                 (localIndices[indices[t * 3 + 1]] == kNotInMeshlet) +
+                                                 (localIndices[indices[t * 3 + 2]] == kNotInMeshlet);
+
+                    if (meshlet.vertexCount + newVertices > VIEMeshlet::kMaxVertices || newVertices > bestNewVertices) {
+                        continue;
+                    }
+
+                    const glm::vec3 triangleCentroid((vertices[indices[t * 3]].pos + vertices[indices[t * 3 + 1]].pos +
+                                                      vertices[indices[t * 3 + 2]].pos) / 3.0f);
+                    const glm::vec3 delta(triangleCentroid - centroid);
+                    const float distance = glm::dot(delta, delta);
+
+                    if (newVertices < bestNewVertices || distance < bestDistance) {
+                        best = t;
+                        bestNewVertices = newVertices;
+                        bestDistance = distance;
+                    }
+                }
+            }
+
+            // No adjacent triangle fits: the next meshlet starts from the first free triangle
+            if (best == std::numeric_limits<uint32_t>::max()) {
+                finishMeshlet();
+                continue;
+            }
+        } else {
+            while (seed < triangleCount && emitted[seed]) {
+                ++seed;
+            }
+
+            if (seed == triangleCount) {
+                break;
+            }
+
+            best = static_cast<uint32_t>(seed);
+        }
+
+        emitted[best] = 1;
+
+        for (uint32_t corner = 0; corner < 3; ++corner) {
+            const uint32_t v = indices[best * 3 + corner];
+
+            if (localIndices[v] == kNotInMeshlet) {
+                localIndices[v] = static_cast<uint8_t>(meshlet.vertexCount++);
+                meshletVertices.push_back(v);
+            }
+
+            meshletTriangles.push_back(localIndices[v]);
+            centroidSum += vertices[v].pos / 3.0f;
+        }
+
+        if (++meshlet.triangleCount == VIEMeshlet::kMaxTriangles) {
+            finishMeshlet();
+        }
+    }
+
+    if (meshlet.triangleCount > 0) {
+        finishMeshlet();
+    }
+}
+
+bool tools::isMeshletVisible(const VIEMeshlet &meshlet, const glm::mat4x4 &modelMatrix, const VIEFrustum &frustum,
+                             const glm::vec3 &cameraPosition) {
+    const glm::vec3 scales(glm::length(glm::vec3(modelMatrix[0])), glm::length(glm::vec3(modelMatrix[1])),
+                           glm::length(glm::vec3(modelMatrix[2])));
+    const float maxScale = std::max({scales.x, scales.y, scales.z});
+
+    const glm::vec3 center(modelMatrix * glm::vec4(glm::vec3(meshlet.boundingSphere), 1.0f));
+
+    if (!frustum.intersectsSphere(center, meshlet.boundingSphere.w * maxScale)) {
+        return false;
+    }
+
+    const float minScale = std::min({scales.x, scales.y, scales.z});
+
+    if (meshlet.coneAxis.w >= 1.0f || maxScale > minScale * 1.001f) {
+        return true;
+    }
+
+    // Every triangle faces away if the view direction towards the apex lies inside the cone
+    const glm::vec3 apex(modelMatrix * glm::vec4(glm::vec3(meshlet.coneApex), 1.0f));
+    const glm::vec3 axis(glm::normalize(glm::vec3(modelMatrix * glm::vec4(glm::vec3(meshlet.coneAxis), 0.0f))));
+    const glm::vec3 view(apex - cameraPosition);
+    const float viewLength = glm::length(view);
+
+    return viewLength <= 0.0f || glm::dot(view, axis) < meshlet.coneAxis.w * viewLength;
+}
+
+size_t tools::cullMeshlets(std::span<const VIEMeshlet> meshlets, const glm::mat4x4 &modelMatrix,
+                           const VIEFrustum &frustum, const glm::vec3 &cameraPosition,
+                           std::vector<uint32_t> &visibleMeshlets) {
+    visibleMeshlets.clear();
+
+    for (uint32_t i = 0; i < meshlets.size(); ++i) {
+        if (isMeshletVisible(meshlets[i], modelMatrix, frustum, cameraPosition)) {
+            visibleMeshlets.push_back(i);
+        }
+    }
+
+    return visibleMeshlets.size();
+}
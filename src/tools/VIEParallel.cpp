@@ -0,0 +1,47 @@
+/* Created by LordRibblesdale on 18/10/2026.
+ * MIT License
+ */
+
+#include "tools/VIEParallel.hpp"
+#include "tools/VIETrace.hpp"
+
+#include <algorithm>
+#include <atomic>
+
+void tools::parallelFor(size_t count, size_t grainSize, const std::function<void(size_t, size_t)> &task) {
+    grainSize = std::max<size_t>(1, grainSize);
+
+    size_t batchCount = (count + grainSize - 1) / grainSize;
+    size_t workers = std::min(getWorkerCount(), batchCount);
+
+    if (workers <= 1) {
+        if (count > 0) {
+            task(0, count);
+        }
+
+        return;
+    }
+
+    // Batches are picked dynamically, so that uneven batches do not leave workers idle
+    std::atomic<size_t> nextBatch{0};
+    auto worker([&nextBatch, &task, batchCount, grainSize, count]() {
+        VIE_TRACE_ZONE("parallelFor");
+
+        for (size_t batch = nextBatch.fetch_add(1, std::memory_order_relaxed); batch < batchCount;
+             batch = nextBatch.fetch_add(1, std::memory_order_relaxed)) {
+            size_t begin = batch * grainSize;
+            task(begin, std::min(begin + grainSize, count));
+        }
+    });
+
+    // Jobs started after every batch has been taken return right away; waiting runs other jobs, so that nested
+    // loops do not block workers
+    VIEJobCounter counter;
+
+    for (size_t i = 1; i < workers; ++i) {
+        runJob(worker, &counter);
+    }
+
+    worker();
+    waitForCounter(counter);
+}
@@ -0,0 +1,515 @@
+/* Created by LordRibblesdale on 18/10/2026.
+ * MIT License
+ */
+
+#include "tools/VIETextureLoader.hpp"
+#include "tools/VIEKTX2.hpp"
+#include "tools/VIEParallel.hpp"
+#include "tools/VIEBlockCompression.hpp"
+#include "tools/VIETrace.hpp"
+#include "tools/VIELogger.hpp"
+
+#include <array>
+#include <vector>
+#include <atomic>
+#include <cmath>
+#include <cctype>
+#include <numbers>
+#include <cstring>
+#include <fstream>
+#include <algorithm>
+#include <filesystem>
+#include <fmt/format.h>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define VIE_TEXTURE_SSE2
+#include <emmintrin.h>
+#endif
+
+namespace {
+    // -- Decoding --
+
+    bool decodeTGA(const std::vector<uint8_t> &file, uint32_t &width, uint32_t &height,
+                   std::vector<uint8_t> &pixels) {
+        if (file.size() < 18) {
+            return false;
+        }
+
+        const uint8_t idLength = file[0];
+        const uint8_t colorMapType = file[1];
+        const uint8_t imageType = file[2];
+        const uint32_t colorMapLength = file[5] | (file[6] << 8);
+        const uint32_t colorMapEntrySize = file[7];
+        const uint8_t pixelDepth = file[16];
+        const uint8_t descriptor = file[17];
+
+        width = file[12] | (file[13] << 8);
+        height = file[14] | (file[15] << 8);
+
+        const bool isRLE = imageType == 10 || imageType == 11;
+        const bool isGray = imageType == 3 || imageType == 11;
+
+        // Color mapped images are not supported (color maps are only skipped for true color images)
+        if ((imageType != 2 && imageType != 3 && imageType != 10 && imageType != 11) || width == 0 || height == 0 ||
+            (isGray && pixelDepth != 8) || (!isGray && pixelDepth != 24 && pixelDepth != 32)) {
+            return false;
+        }
+
+        const size_t bytesPerPixel = pixelDepth / 8;
+        size_t position = 18 + idLength + (colorMapType ? colorMapLength * ((colorMapEntrySize + 7) / 8) : 0);
+
+        pixels.resize(static_cast<size_t>(width) * height * 4);
+
+        auto writePixel([&pixels, &file, isGray, bytesPerPixel](size_t pixel, size_t source) {
+            uint8_t *destination = &pixels[pixel * 4];
+
+            if (isGray) {
+                destination[0] = destination[1] = destination[2] = file[source];
+                destination[3] = 255;
+            } else {
+                destination[0] = file[source + 2];
+                destination[1] = file[source + 1];
+                destination[2] = file[source];
+                destination[3] = bytesPerPixel == 4 ? file[source + 3] : 255;
+            }
+        });
+
+        const size_t pixelCount = static_cast<size_t>(width) * height;
+
+        if (!isRLE) {
+            if (position + pixelCount * bytesPerPixel > file.size()) {
+                return false;
+            }
+
+            for (size_t pixel = 0; pixel < pixelCount; ++pixel, position += bytesPerPixel) {
+                writePixel(pixel, position);
+            }
+        } else {
+            for (size_t pixel = 0; pixel < pixelCount;) {
+                if (position >= file.size()) {
+                    return false;
+                }
+
+                const uint8_t packet = file[position++];
+                const size_t count = std::min<size_t>((packet & 0x7f) + 1, pixelCount - pixel);
+
+                if (packet & 0x80) {
+                    if (position + bytesPerPixel > file.size()) {
+                        return false;
+                    }
+
+                    for (size_t i = 0; i < count; ++i) {
+                        writePixel(pixel++, position);
+                    }
+
+                    position += bytesPerPixel;
+                } else {
+                    if (position + count * bytesPerPixel > file.size()) {
+                        return false;
+                    }
+
+                    for (size_t i = 0; i < count; ++i, position += bytesPerPixel) {
+                        writePixel(pixel++, position);
+                    }
+                }
+            }
+        }
+
+        // Rows are stored bottom-up unless the origin is on top, while textures are sampled top-down
+        if (!(descriptor & 0x20)) {
+            const size_t rowSize = static_cast<size_t>(width) * 4;
+
+            for (uint32_t y = 0; y < height / 2; ++y) {
+                std::swap_ranges(pixels.begin() + y * rowSize, pixels.begin() + (y + 1) * rowSize,
+                                 pixels.begin() + (height - 1 - y) * rowSize);
+            }
+        }
+
+        return true;
+    }
+
+    bool decodePNM(const std::vector<uint8_t> &file, uint32_t &width, uint32_t &height,
+                   std::vector<uint8_t> &pixels) {
+        size_t position = 2;
+
+        auto readNumber([&file, &position](uint32_t &value) {
+            // Skipping whitespaces and comments
+            while (position < file.size() && (std::isspace(file[position]) || file[position] == '#')) {
+                if (file[position] == '#') {
+                    while (position < file.size() && file[position] != '\n') {
+                        ++position;
+                    }
+                } else {
+                    ++position;
+                }
+            }
+
+            if (position >= file.size() || !std::isdigit(file[position])) {
+                return false;
+            }
+
+            value = 0;
+            while (position < file.size() && std::isdigit(file[position])) {
+                value = value * 10 + (file[position++] - '0');
+            }
+
+            return true;
+        });
+
+        const bool isGray = file[1] == '5';
+        uint32_t maxValue;
+
+        if (!readNumber(width) || !readNumber(height) || !readNumber(maxValue) || maxValue == 0 || maxValue > 255 ||
+            width == 0 || height == 0) {
+            return false;
+        }
+
+        // A single whitespace separates the header from the texels
+        ++position;
+
+        const size_t pixelCount = static_cast<size_t>(width) * height;
+        const size_t channels = isGray ? 1 : 3;
+
+        if (position + pixelCount * channels > file.size()) {
+            return false;
+        }
+
+        pixels.resize(pixelCount * 4);
+
+        for (size_t pixel = 0; pixel < pixelCount; ++pixel, position += channels) {
+            for (size_t channel = 0; channel < 3; ++channel) {
+                pixels[pixel * 4 + channel] = static_cast<uint8_t>(
+                        file[position + (isGray ? 0 : channel)] * 255 / maxValue);
+            }
+
+            pixels[pixel * 4 + 3] = 255;
+        }
+
+        return true;
+    }
+
+    // -- Mip generation --
+
+    void downsampleBox(const uint8_t *source, uint32_t sourceWidth, uint32_t sourceHeight, uint8_t *destination,
+                       uint32_t width, uint32_t height) {
+        for (uint32_t y = 0; y < height; ++y) {
+            const uint8_t *row0 = source + static_cast<size_t>(std::min(2 * y, sourceHeight - 1)) * sourceWidth * 4;
+            const uint8_t *row1 = source + static_cast<size_t>(std::min(2 * y + 1, sourceHeight - 1)) *
+                                           sourceWidth * 4;
+            uint8_t *output = destination + static_cast<size_t>(y) * width * 4;
+
+            uint32_t x = 0;
+
+#ifdef VIE_TEXTURE_SSE2
+            // Two output texels (four source texels from each row) at a time
+            const __m128i zero = _mm_setzero_si128();
+            const __m128i rounding = _mm_set1_epi16(2);
+
+            for (; 2 * x + 4 <= sourceWidth && x + 2 <= width; x += 2) {
+                __m128i top = _mm_loadu_si128(reinterpret_cast<const __m128i *>(row0 + 8 * x));
+                __m128i bottom = _mm_loadu_si128(reinterpret_cast<const __m128i *>(row1 + 8 * x));
+
+                __m128i low = _mm_add_epi16(_mm_unpacklo_epi8(top, zero), _mm_unpacklo_epi8(bottom, zero));
+                __m128i high = _mm_add_epi16(_mm_unpackhi_epi8(top, zero), _mm_unpackhi_epi8(bottom, zero));
+
+                // Adding the two horizontal neighbours, stored in the two halves of each register
+                low = _mm_add_epi16(low, _mm_srli_si128(low, 8));
+                high = _mm_add_epi16(high, _mm_srli_si128(high, 8));
+
+                __m128i sum = _mm_srli_epi16(_mm_add_epi16(_mm_unpacklo_epi64(low, high), rounding), 2);
+                _mm_storel_epi64(reinterpret_cast<__m128i *>(output + 4 * x), _mm_packus_epi16(sum, zero));
+            }
+#endif
+
+            for (; x < width; ++x) {
+                const size_t x0 = static_cast<size_t>(std::min(2 * x, sourceWidth - 1)) * 4;
+                const size_t x1 = static_cast<size_t>(std::min(2 * x + 1, sourceWidth - 1)) * 4;
+
+                for (size_t channel = 0; channel < 4; ++channel) {
+                    output[4 * x + channel] = static_cast<uint8_t>(
+                            (row0[x0 + channel] + row0[x1 + channel] + row1[x0 + channel] + row1[x1 + channel] + 2) /
+                            4);
+                }
+            }
+        }
+    }
+
+    // Kaiser-windowed sinc for 2:1 minification (filter support of kKaiserWidth destination texels on each side)
+    constexpr int kKaiserWidth{3};
+    constexpr float kKaiserAlpha{4.0f};
+    constexpr int kKaiserTaps{4 * kKaiserWidth};
+
+    float besselI0(float x) {
+        float sum = 1.0f;
+        float term = 1.0f;
+
+        for (int k = 1; k < 32 && term > 1e-8f * sum; ++k) {
+            term *= (x * x) / (4.0f * static_cast<float>(k * k));
+            sum += term;
+        }
+
+        return sum;
+    }
+
+    std::array<float, kKaiserTaps> computeKaiserWeights() {
+        std::array<float, kKaiserTaps> weights{};
+        float total = 0.0f;
+
+        for (int tap = 0; tap < kKaiserTaps; ++tap) {
+            // Distance between the source texel center and the destination texel center, in destination texels
+            const float x = (static_cast<float>(tap - 2 * kKaiserWidth) + 0.5f) / 2.0f;
+            const float sinc = std::abs(x) < 1e-6f ? 1.0f : std::sin(std::numbers::pi_v<float> * x) /
+                                                            (std::numbers::pi_v<float> * x);
+            const float ratio = x / static_cast<float>(kKaiserWidth);
+            const float window = std::abs(ratio) >= 1.0f ? 0.0f :
+                                 besselI0(kKaiserAlpha * std::sqrt(1.0f - ratio * ratio)) / besselI0(kKaiserAlpha);
+
+            weights[tap] = sinc * window;
+            total += weights[tap];
+        }
+
+        for (float &weight: weights) {
+            weight /= total;
+        }
+
+        return weights;
+    }
+
+    // Accumulates weight * texel over RGBA lanes
+    inline void accumulate(float *accumulator, const float *texel, float weight) {
+#ifdef VIE_TEXTURE_SSE2
+        _mm_storeu_ps(accumulator, _mm_add_ps(_mm_loadu_ps(accumulator),
+                                              _mm_mul_ps(_mm_loadu_ps(texel), _mm_set1_ps(weight))));
+#else
+        for (int channel = 0; channel < 4; ++channel) {
+            accumulator[channel] += texel[channel] * weight;
+        }
+#endif
+    }
+
+    void downsampleKaiser(const uint8_t *source, uint32_t sourceWidth, uint32_t sourceHeight, uint8_t *destination,
+                          uint32_t width, uint32_t height) {
+        static const std::array<float, kKaiserTaps> weights(computeKaiserWeights());
+
+        std::vector<float> sourceTexels(static_cast<size_t>(sourceWidth) * sourceHeight * 4);
+        std::transform(source, source + sourceTexels.size(), sourceTexels.begin(),
+                       [](uint8_t value) { return static_cast<float>(value); });
+
+        // Separable filter: horizontal pass (sourceHeight x width), then vertical pass (height x width)
+        std::vector<float> horizontal(static_cast<size_t>(sourceHeight) * width * 4, 0.0f);
+
+        for (uint32_t y = 0; y < sourceHeight; ++y) {
+            const float *row = &sourceTexels[static_cast<size_t>(y) * sourceWidth * 4];
+
+            for (uint32_t x = 0; x < width; ++x) {
+                float *output = &horizontal[(static_cast<size_t>(y) * width + x) * 4];
+
+                for (int tap = 0; tap < kKaiserTaps; ++tap) {
+                    const int sourceX = std::clamp(static_cast<int>(2 * x) - 2 * kKaiserWidth + 1 + tap, 0,
+                                                   static_cast<int>(sourceWidth) - 1);
+                    accumulate(output, &row[static_cast<size_t>(sourceX) * 4], weights[tap]);
+                }
+            }
+        }
+
+        std::array<float, 4> texel{};
+
+        for (uint32_t y = 0; y < height; ++y) {
+            for (uint32_t x = 0; x < width; ++x) {
+                texel.fill(0.0f);
+
+                for (int tap = 0; tap < kKaiserTaps; ++tap) {
+                    const int sourceY = std::clamp(static_cast<int>(2 * y) - 2 * kKaiserWidth + 1 + tap, 0,
+                                                   static_cast<int>(sourceHeight) - 1);
+                    accumulate(texel.data(), &horizontal[(static_cast<size_t>(sourceY) * width + x) * 4],
+                               weights[tap]);
+                }
+
+                // Negative lobes can overshoot
+                for (int channel = 0; channel < 4; ++channel) {
+                    destination[(static_cast<size_t>(y) * width + x) * 4 + channel] =
+                            static_cast<uint8_t>(std::clamp(texel[channel] + 0.5f, 0.0f, 255.0f));
+                }
+            }
+        }
+    }
+
+    // -- Cache --
+
+    // FNV-1a, stable across runs and platforms (unlike std::hash)
+    uint64_t hashLocation(const std::string &location, VIEMipFilter filter, VIETextureCompression compression) {
+        uint64_t hash = 14695981039346656037ull;
+
+        for (char character: location) {
+            hash = (hash ^ static_cast<uint8_t>(character)) * 1099511628211ull;
+        }
+
+        hash = (hash ^ static_cast<uint8_t>(filter)) * 1099511628211ull;
+
+        return (hash ^ static_cast<uint8_t>(compression)) * 1099511628211ull;
+    }
+
+    // Size and last write time of the source, stored in baked textures to detect changes
+    std::string readSourceStamp(const std::string &location) {
+        std::error_code error;
+        const uintmax_t size = std::filesystem::file_size(location, error);
+
+        if (error) {
+            return {};
+        }
+
+        const auto time = std::filesystem::last_write_time(location, error).time_since_epoch().count();
+
+        return error ? std::string() : fmt::format("{} {}", size, time);
+    }
+
+    bool hasExtension(const std::string &location, std::string_view expected) {
+        std::string extension(std::filesystem::path(location).extension().string());
+        std::ranges::transform(extension, extension.begin(), [](char c) {
+            return static_cast<char>(std::tolower(c));
+        });
+
+        return extension == expected;
+    }
+}
+
+bool tools::decodeImage(const std::string &location, uint32_t &width, uint32_t &height,
+                        std::vector<uint8_t> &pixels) {
+    std::ifstream imageFile(location, std::ios::binary);
+
+    if (!imageFile.is_open()) {
+        log_error("decodeImage: {} not opened.", location);
+        return false;
+    }
+
+    std::vector<uint8_t> file((std::istreambuf_iterator<char>(imageFile)), std::istreambuf_iterator<char>());
+
+    bool isDecoded = false;
+
+    if (hasExtension(location, ".tga")) {
+        isDecoded = decodeTGA(file, width, height, pixels);
+    } else if (file.size() > 2 && file[0] == 'P' && (file[1] == '5' || file[1] == '6')) {
+        isDecoded = decodePNM(file, width, height, pixels);
+    }
+
+    if (!isDecoded) {
+        log_error("decodeImage: {} has an unsupported format.", location);
+    }
+
+    return isDecoded;
+}
+
+void tools::generateMipChain(VIETextureData &texture, VIEMipFilter filter) {
+    if (texture.mipLevels.empty() || texture.format != VIETextureFormat::RGBA8) {
+        return;
+    }
+
+    uint32_t width = texture.getWidth();
+    uint32_t height = texture.getHeight();
+
+    texture.mipLevels.resize(1);
+
+    // Reserving the whole chain up front, as levels are read from the same array they are written into
+    size_t chainSize = getTextureLevelSize(VIETextureFormat::RGBA8, width, height);
+    for (uint32_t w = width, h = height; w > 1 || h > 1;) {
+        w = std::max(w / 2, 1u);
+        h = std::max(h / 2, 1u);
+        chainSize += getTextureLevelSize(VIETextureFormat::RGBA8, w, h);
+    }
+
+    texture.pixels.resize(chainSize);
+
+    while (width > 1 || height > 1) {
+        const VIEMipLevel &previous = texture.mipLevels.back();
+        VIEMipLevel level{previous.offset + previous.size, 0, std::max(width / 2, 1u), std::max(height / 2, 1u)};
+        level.size = getTextureLevelSize(VIETextureFormat::RGBA8, level.width, level.height);
+
+        if (filter == VIEMipFilter::KAISER) {
+            downsampleKaiser(&texture.pixels[previous.offset], previous.width, previous.height,
+                             &texture.pixels[level.offset], level.width, level.height);
+        } else {
+            downsampleBox(&texture.pixels[previous.offset], previous.width, previous.height,
+                          &texture.pixels[level.offset], level.width, level.height);
+        }
+
+        width = level.width;
+        height = level.height;
+        texture.mipLevels.push_back(level);
+    }
+}
+
+bool tools::loadTexture(VIETextureData &texture, VIEMipFilter filter, VIETextureCompression compression,
+                        const std::string &cacheDirectory) {
+    VIE_TRACE_ZONE("loadTexture");
+
+    // Already baked textures are used as they are
+    if (hasExtension(texture.location, ".ktx2")) {
+        return readKTX2(texture.location, texture);
+    }
+
+    std::filesystem::path cacheLocation;
+    std::string sourceStamp;
+
+    if (!cacheDirectory.empty()) {
+        cacheLocation = std::filesystem::path(cacheDirectory) /
+                        fmt::format("{:016x}.ktx2", hashLocation(texture.location, filter, compression));
+        sourceStamp = readSourceStamp(texture.location);
+
+        std::string bakedStamp;
+        const bool isSRGB = texture.isSRGB;
+
+        if (!sourceStamp.empty() && std::filesystem::exists(cacheLocation) &&
+            readKTX2(cacheLocation.string(), texture, &bakedStamp)) {
+            if (bakedStamp == sourceStamp) {
+                texture.isSRGB = isSRGB;
+                return true;
+            }
+
+            texture = VIETextureData{.location = std::move(texture.location), .isSRGB = isSRGB};
+        }
+    }
+
+    uint32_t width;
+    uint32_t height;
+
+    if (!decodeImage(texture.location, width, height, texture.pixels)) {
+        return false;
+    }
+
+    texture.format = VIETextureFormat::RGBA8;
+    texture.mipLevels = {VIEMipLevel{0, texture.pixels.size(), width, height}};
+    generateMipChain(texture, filter);
+    compressTexture(texture, selectBlockFormat(texture, compression));
+
+    if (!cacheLocation.empty() && !sourceStamp.empty()) {
+        std::error_code error;
+        std::filesystem::create_directories(cacheDirectory, error);
+
+        // Written aside and then renamed, so that an interrupted write never leaves a truncated entry
+        std::filesystem::path temporaryLocation(cacheLocation);
+        temporaryLocation += ".tmp";
+
+        if (writeKTX2(temporaryLocation.string(), texture, sourceStamp)) {
+            std::filesystem::rename(temporaryLocation, cacheLocation, error);
+        }
+    }
+
+    return true;
+}
+
+size_t tools::loadTextures(std::span<VIETextureData> textures, VIEMipFilter filter,
+                           VIETextureCompression compression, const std::string &cacheDirectory) {
+    std::atomic<size_t> loadedCount{0};
+
+    // One texture for each work item: decoding, filtering and encoding are independent between textures
+    tools::parallelFor(textures.size(), 1, [&textures, &loadedCount, filter, compression,
+                                            &cacheDirectory](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            if (loadTexture(textures[i], filter, compression, cacheDirectory)) {
+                loadedCount.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+    });
+
+    return loadedCount.load();
+}
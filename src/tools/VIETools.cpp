@@ -1,4 +1,15 @@
 #include "tools/VIETools.hpp"
+#include "tools/VIEJobSystem.hpp"
+
+#include <cstring>
+#include <fstream>
+
+#if _WIN64
+#include <windows.h>
+#include <psapi.h>
+#elif __linux__
+#include <unistd.h>
+#endif
 
 bool tools::selectSurfaceFormat(const std::vector<VkSurfaceFormatKHR> &availableSurfaceFormats,
                                 const VkFormat &requiredFormat, const VkColorSpaceKHR &requiredColorSpace,
@@ -119,3 +130,201 @@ bool tools::selectPhysicalDevice(VkPhysicalDevice const &deviceToCheck, VkPhysic
 
     return true;
 }
+
+bool tools::selectDepthFormat(const VkPhysicalDevice &physicalDevice, VkFormat &depthFormat) {
+    constexpr VkFormatFeatureFlags kRequiredFeatures{VK_FORMAT_FEATURE_DEPTH_STENCIL_ATTACHMENT_BIT |
+                                                     VK_FORMAT_FEATURE_SAMPLED_IMAGE_BIT};
+
+    for (VkFormat format: {VK_FORMAT_D32_SFLOAT, VK_FORMAT_D32_SFLOAT_S8_UINT, VK_FORMAT_D24_UNORM_S8_UINT}) {
+        VkFormatProperties formatProperties;
+        vkGetPhysicalDeviceFormatProperties(physicalDevice, format, &formatProperties);
+
+        if ((formatProperties.optimalTilingFeatures & kRequiredFeatures) == kRequiredFeatures) {
+            depthFormat = format;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+bool tools::findMemoryType(const VkPhysicalDevice &physicalDevice, uint32_t typeFilter,
+                           VkMemoryPropertyFlags requiredProperties, uint32_t &memoryType) {
+    VkPhysicalDeviceMemoryProperties memoryProperties;
+    vkGetPhysicalDeviceMemoryProperties(physicalDevice, &memoryProperties);
+
+    for (uint32_t i = 0; i < memoryProperties.memoryTypeCount; ++i) {
+        if ((typeFilter & (1u << i)) &&
+            (memoryProperties.memoryTypes[i].propertyFlags & requiredProperties) == requiredProperties) {
+            memoryType = i;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+bool tools::createBuffer(const VkDevice &device, const VkPhysicalDevice &physicalDevice, VkDeviceSize size,
+                         VkBufferUsageFlags usage, VkMemoryPropertyFlags requiredProperties, VkBuffer &buffer,
+                         VkDeviceMemory &bufferMemory) {
+    VkBufferCreateInfo bufferCreateInfo{
+            .sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO,
+            .size = size,
+            .usage = usage,
+            .sharingMode = VK_SHARING_MODE_EXCLUSIVE
+    };
+
+    return_log_if(vkCreateBuffer(device, &bufferCreateInfo, nullptr, &buffer) != VK_SUCCESS,
+                  "Cannot create buffer...", false)
+
+    VkMemoryRequirements memoryRequirements;
+    vkGetBufferMemoryRequirements(device, buffer, &memoryRequirements);
+
+    // The buffer is destroyed on failure, so that callers only clean up what has been returned
+    uint32_t memoryType;
+    if (!findMemoryType(physicalDevice, memoryRequirements.memoryTypeBits, requiredProperties, memoryType)) {
+        log_error("No compatible memory type found for buffer...");
+        vkDestroyBuffer(device, buffer, nullptr);
+        buffer = VK_NULL_HANDLE;
+        return false;
+    }
+
+    VkMemoryAllocateInfo memoryAllocateInfo{
+            .sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO,
+            .allocationSize = memoryRequirements.size,
+            .memoryTypeIndex = memoryType
+    };
+
+    if (vkAllocateMemory(device, &memoryAllocateInfo, nullptr, &bufferMemory) != VK_SUCCESS) {
+        log_error("Cannot allocate buffer memory...");
+        vkDestroyBuffer(device, buffer, nullptr);
+        buffer = VK_NULL_HANDLE;
+        return false;
+    }
+
+    vkBindBufferMemory(device, buffer, bufferMemory, 0);
+
+    return true;
+}
+
+VkCommandBuffer tools::beginSingleTimeCommands(const VkDevice &device, const VkCommandPool &commandPool) {
+    VkCommandBufferAllocateInfo commandBufferAllocateInfo{
+            .sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO,
+            .commandPool = commandPool,
+            .level = VK_COMMAND_BUFFER_LEVEL_PRIMARY,
+            .commandBufferCount = 1
+    };
+
+    VkCommandBuffer commandBuffer;
+    vkAllocateCommandBuffers(device, &commandBufferAllocateInfo, &commandBuffer);
+
+    VkCommandBufferBeginInfo commandBufferBeginInfo{
+            .sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO,
+            .flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT
+    };
+
+    vkBeginCommandBuffer(commandBuffer, &commandBufferBeginInfo);
+
+    return commandBuffer;
+}
+
+bool tools::endSingleTimeCommands(const VkDevice &device, const VkCommandPool &commandPool, const VkQueue &queue,
+                                  VkCommandBuffer commandBuffer) {
+    vkEndCommandBuffer(commandBuffer);
+
+    VkSubmitInfo submitInfo{
+            .sType = VK_STRUCTURE_TYPE_SUBMIT_INFO,
+            .commandBufferCount = 1,
+            .pCommandBuffers = &commandBuffer
+    };
+
+    bool isSubmitted = vkQueueSubmit(queue, 1, &submitInfo, VK_NULL_HANDLE) == VK_SUCCESS;
+    vkQueueWaitIdle(queue);
+
+    vkFreeCommandBuffers(device, commandPool, 1, &commandBuffer);
+
+    return isSubmitted;
+}
+
+bool tools::submitSingleTimeCommands(const VkQueue &queue, VkCommandBuffer commandBuffer, const VkFence &fence) {
+    vkEndCommandBuffer(commandBuffer);
+
+    VkSubmitInfo submitInfo{
+            .sType = VK_STRUCTURE_TYPE_SUBMIT_INFO,
+            .commandBufferCount = 1,
+            .pCommandBuffers = &commandBuffer
+    };
+
+    return vkQueueSubmit(queue, 1, &submitInfo, fence) == VK_SUCCESS;
+}
+
+bool tools::createDeviceLocalBuffer(const VkDevice &device, const VkPhysicalDevice &physicalDevice,
+                                    const VkCommandPool &commandPool, const VkQueue &queue, const void *data,
+                                    VkDeviceSize size, VkBufferUsageFlags usage, VkBuffer &buffer,
+                                    VkDeviceMemory &bufferMemory) {
+    VkBuffer stagingBuffer{};
+    VkDeviceMemory stagingMemory{};
+
+    auto destroyStaging([&device, &stagingBuffer, &stagingMemory]() {
+        vkDestroyBuffer(device, stagingBuffer, nullptr);
+        vkFreeMemory(device, stagingMemory, nullptr);
+    });
+
+    if (!createBuffer(device, physicalDevice, size, VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+                      VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, stagingBuffer,
+                      stagingMemory)) {
+        destroyStaging();
+        return false;
+    }
+
+    void *mappedMemory;
+    vkMapMemory(device, stagingMemory, 0, size, 0, &mappedMemory);
+    std::memcpy(mappedMemory, data, size);
+    vkUnmapMemory(device, stagingMemory);
+
+    if (!createBuffer(device, physicalDevice, size, usage | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+                      VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, buffer, bufferMemory)) {
+        destroyStaging();
+        return false;
+    }
+
+    VkCommandBuffer commandBuffer(beginSingleTimeCommands(device, commandPool));
+
+    VkBufferCopy copyRegion{.srcOffset = 0, .dstOffset = 0, .size = size};
+    vkCmdCopyBuffer(commandBuffer, stagingBuffer, buffer, 1, &copyRegion);
+
+    bool isCopied = endSingleTimeCommands(device, commandPool, queue, commandBuffer);
+
+    destroyStaging();
+
+    return_log_if(!isCopied, "Cannot copy staging buffer...", false)
+
+    return true;
+}
+
+size_t tools::getResidentMemory() {
+#if _WIN64
+    PROCESS_MEMORY_COUNTERS counters{};
+    return GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)) ? counters.WorkingSetSize : 0;
+#elif __linux__
+    // Resident pages are the second field
+    std::ifstream statm("/proc/self/statm");
+    size_t totalPages = 0;
+    size_t residentPages = 0;
+
+    return statm >> totalPages >> residentPages ? residentPages * static_cast<size_t>(sysconf(_SC_PAGESIZE)) : 0;
+#else
+    return 0;
+#endif
+}
+
+void VIEFenceAwaiter::await_suspend(std::coroutine_handle<> handle) const {
+    // Queued again for the next run until the fence is signaled
+    tools::runOnMainThread([awaiter = *this, handle]() {
+        if (awaiter.await_ready()) {
+            handle.resume();
+        } else {
+            awaiter.await_suspend(handle);
+        }
+    });
+}
@@ -0,0 +1,153 @@
+/* Created by LordRibblesdale on 18/10/2026.
+ * MIT License
+ */
+
+#include "tools/VIETrace.hpp"
+#include "tools/VIELogger.hpp"
+
+#include <array>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include <fstream>
+
+std::atomic<bool> tools::tracingEnabled{false};
+
+namespace {
+    struct TraceEvent {
+        const char *name{nullptr};
+        uint64_t begin{0};
+        uint64_t end{0};
+    };
+
+    /**
+     * @brief Zones of one thread at a time: only the owner writes, events are published by the release of eventCount
+     */
+    struct ThreadTrace {
+        static constexpr uint32_t kCapacity{1u << 16};
+
+        std::array<TraceEvent, kCapacity> events{};
+        std::atomic<uint32_t> eventCount{0};
+        std::atomic<uint32_t> droppedCount{0};          ///< Zones not recorded because the buffer is full
+        std::atomic<const char *> threadName{nullptr};
+        uint32_t threadId{0};
+    };
+
+    // Buffers outlive their threads (until the trace is written), and are handed to new threads when released, so
+    // that short lived workers do not allocate a buffer each
+    std::mutex traceMutex;
+    std::vector<std::unique_ptr<ThreadTrace>> threadTraces;
+    std::vector<ThreadTrace *> releasedTraces;
+
+    /**
+     * @brief Buffer of the calling thread, acquired on its first zone and released when the thread exits
+     */
+    struct ThreadTraceOwner {
+        ThreadTrace *trace{nullptr};
+
+        ~ThreadTraceOwner() {
+            if (trace) {
+                std::scoped_lock lock(traceMutex);
+                releasedTraces.push_back(trace);
+            }
+        }
+
+        ThreadTrace &get() {
+            if (!trace) {
+                std::scoped_lock lock(traceMutex);
+
+                if (releasedTraces.empty()) {
+                    threadTraces.push_back(std::make_unique<ThreadTrace>());
+                    trace = threadTraces.back().get();
+                    trace->threadId = static_cast<uint32_t>(threadTraces.size());
+                } else {
+                    trace = releasedTraces.back();
+                    releasedTraces.pop_back();
+                }
+            }
+
+            return *trace;
+        }
+    };
+
+    thread_local ThreadTraceOwner threadTraceOwner;
+}
+
+void tools::setTracingEnabled(bool enabled) {
+    tracingEnabled.store(enabled, std::memory_order_relaxed);
+}
+
+void tools::setTraceThreadName(const char *name) {
+    threadTraceOwner.get().threadName.store(name, std::memory_order_relaxed);
+}
+
+void tools::recordTraceZone(const char *name, uint64_t begin, uint64_t end) {
+    ThreadTrace &trace(threadTraceOwner.get());
+    const uint32_t eventCount = trace.eventCount.load(std::memory_order_relaxed);
+
+    if (eventCount == ThreadTrace::kCapacity) {
+        trace.droppedCount.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    trace.events[eventCount] = TraceEvent{name, begin, end};
+    trace.eventCount.store(eventCount + 1, std::memory_order_release);
+}
+
+bool tools::writeTrace(const std::string &traceLocation) {
+    std::ofstream traceFile(traceLocation);
+
+    if (!traceFile.is_open()) {
+        log_error("Cannot write trace {}", traceLocation);
+        return false;
+    }
+
+    std::scoped_lock lock(traceMutex);
+
+    // Timestamps are relative to the first zone
+    uint64_t origin = std::numeric_limits<uint64_t>::max();
+    for (const std::unique_ptr<ThreadTrace> &trace: threadTraces) {
+        const uint32_t eventCount = trace->eventCount.load(std::memory_order_acquire);
+
+        for (uint32_t i = 0; i < eventCount; ++i) {
+            origin = std::min(origin, trace->events[i].begin);
+        }
+    }
+
+    std::string json("{\"displayTimeUnit\": \"ns\", \"traceEvents\": [\n");
+    uint32_t droppedCount = 0;
+    bool isFirst = true;
+
+    auto appendEvent([&json, &isFirst](const std::string &event) {
+        json.append(isFirst ? "" : ",\n").append(event);
+        isFirst = false;
+    });
+
+    for (const std::unique_ptr<ThreadTrace> &trace: threadTraces) {
+        const uint32_t eventCount = trace->eventCount.load(std::memory_order_acquire);
+        droppedCount += trace->droppedCount.load(std::memory_order_relaxed);
+
+        if (const char *threadName = trace->threadName.load(std::memory_order_relaxed)) {
+            appendEvent(fmt::format(R"({{"name": "thread_name", "ph": "M", "pid": 1, "tid": {}, )"
+                                    R"("args": {{"name": "{}"}}}})", trace->threadId, threadName));
+        }
+
+        // Complete events, in microseconds
+        for (uint32_t i = 0; i < eventCount; ++i) {
+            const TraceEvent &event(trace->events[i]);
+            appendEvent(fmt::format(R"({{"name": "{}", "ph": "X", "pid": 1, "tid": {}, "ts": {:.3f}, "dur": {:.3f}}})",
+                                    event.name, trace->threadId, static_cast<double>(event.begin - origin) * 1e-3,
+                                    static_cast<double>(event.end - event.begin) * 1e-3));
+        }
+    }
+
+    json.append("\n]}\n");
+    traceFile << json;
+
+    if (droppedCount > 0) {
+        log_warning("Trace buffers full, {} zones dropped", droppedCount);
+    }
+
+    return true;
+}
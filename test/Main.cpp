@@ -5,15 +5,837 @@
 #include "engine/VIESettings.hpp"
 #include "engine/VIEngine.hpp"
 #include "structs/transform/VIERotation.hpp"
+#include "structs/VIEBVH.hpp"
+#include "structs/VIEMeshPool.hpp"
+#include "tools/VIEMeshSimplifier.hpp"
+#include "tools/VIEParallel.hpp"
+#include "tools/VIECulling.hpp"
+#include "tools/VIEMeshlets.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstdlib>
+#include <chrono>
+#include <fstream>
+#include <limits>
+#include <memory>
+#include <random>
+#include <string_view>
 
 #define FMT_HEADER_ONLY
 #include <fmt/format.h>
 
+// Simplifies every mesh of an OBJ model (as done when loading scenarios) and reports timings and errors per level
+int runLodBenchmark(const std::string &objLocation) {
+    VIEModel model;
+    VIEMeshPool meshPool;
+    std::vector<VIEMaterial> materials;
+    std::vector<VIETextureData> textures;
+
+    if (!model.loadOBJ(objLocation, meshPool, materials, textures)) {
+        std::cout << "LOD benchmark: cannot load " << objLocation << std::endl;
+        return 1;
+    }
+
+    std::span<const VIEMesh> meshes(meshPool.getMeshes(model.meshes));
+    std::vector<std::vector<VIELodLevel>> meshLods(meshes.size());
+
+    auto start(std::chrono::steady_clock::now());
+
+    tools::parallelFor(meshes.size(), 1, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            std::span<const VIEVertex> vertices(meshPool.getVertices().data() + meshes[i].firstVertex,
+                                                meshes[i].vertexCount);
+            std::span<const uint32_t> indices(meshPool.getIndices().data() + meshes[i].firstIndex,
+                                              meshes[i].indexCount);
+
+            meshLods[i] = tools::generateLodChain(vertices, indices, VIEMesh::kMaxLods - 1, 0.5f);
+        }
+    });
+
+    std::chrono::duration<double, std::milli> elapsed(std::chrono::steady_clock::now() - start);
+
+    size_t triangleCount = 0;
+    for (const VIEMesh &mesh: meshes) {
+        triangleCount += mesh.indexCount / 3;
+    }
+
+    std::cout << fmt::format("{}: {} meshes, {} triangles, radius {:.4f}\n", objLocation, meshes.size(),
+                             triangleCount, model.boundingSphere.w);
+
+    for (uint32_t level = 0; level < VIEMesh::kMaxLods - 1; ++level) {
+        size_t levelTriangles = 0;
+        float levelError = 0.0f;
+
+        for (const std::vector<VIELodLevel> &lods: meshLods) {
+            if (!lods.empty()) {
+                const VIELodLevel &lod = lods[std::min<size_t>(level, lods.size() - 1)];
+                levelTriangles += lod.indices.size() / 3;
+                levelError = std::max(levelError, lod.error);
+            }
+        }
+
+        std::cout << fmt::format("  LOD {}: {} triangles, error {:.6f}\n", level + 1, levelTriangles, levelError);
+    }
+
+    std::cout << fmt::format("Simplified in {:.1f} ms with {} workers", elapsed.count(), tools::getWorkerCount())
+              << std::endl;
+
+    return 0;
+}
+
+// Culls random spheres around a camera with every kernel supported by the CPU, on one worker and on every worker
+int runCullingBenchmark(size_t sphereCount) {
+    constexpr size_t kSingleWorkerCount{1 << 16};   // Culled inline, without splitting across workers
+    constexpr int kRepetitions{20};
+
+    VIECamera camera;
+    camera.center = glm::vec4(0.0f, 0.0f, 0.0f, 1.0f);
+    camera.lookAt = glm::vec4(0.0f, 0.0f, -1.0f, 1.0f);
+    camera.farPlane = 500.0f;
+    camera.updateView();
+    camera.updateProjection(16.0f / 9.0f);
+    const VIEFrustum frustum(camera.getFrustum());
+
+    std::mt19937 generator(42);
+    std::uniform_real_distribution<float> position(-500.0f, 500.0f);
+    std::uniform_real_distribution<float> radius(0.1f, 5.0f);
+
+    VIESphereSet spheres;
+    spheres.resize(sphereCount);
+    for (size_t i = 0; i < sphereCount; ++i) {
+        spheres.centerX[i] = position(generator);
+        spheres.centerY[i] = position(generator);
+        spheres.centerZ[i] = position(generator);
+        spheres.radius[i] = radius(generator);
+    }
+
+    VIESphereSet singleWorkerSpheres(spheres);
+    singleWorkerSpheres.resize(std::min(sphereCount, kSingleWorkerCount));
+
+    // Instances per millisecond of the best run
+    auto measure = [&](const VIESphereSet &set, VIECullingKernel kernel, size_t &visibleCount) {
+        std::vector<uint32_t> visible;
+        double best = std::numeric_limits<double>::max();
+
+        for (int i = 0; i < kRepetitions; ++i) {
+            auto start(std::chrono::steady_clock::now());
+            visibleCount = tools::cullSpheres(frustum, set, visible, kernel);
+            std::chrono::duration<double, std::milli> elapsed(std::chrono::steady_clock::now() - start);
+            best = std::min(best, elapsed.count());
+        }
+
+        return static_cast<double>(set.size()) / std::max(best, 1e-6);
+    };
+
+    std::cout << fmt::format("{} spheres, {} workers\n", sphereCount, tools::getWorkerCount());
+
+    for (auto kernel: {VIECullingKernel::SCALAR, VIECullingKernel::SSE2, VIECullingKernel::AVX2}) {
+        if (kernel > tools::getCullingKernel()) {
+            break;
+        }
+
+        size_t visibleCount = 0;
+        const double singleWorker = measure(singleWorkerSpheres, kernel, visibleCount);
+        const double allWorkers = measure(spheres, kernel, visibleCount);
+
+        std::cout << fmt::format("  {}: {:.2f} M/ms on one worker, {:.2f} M/ms on every worker ({} visible)\n",
+                                 tools::getCullingKernelName(kernel), singleWorker * 1e-6, allWorkers * 1e-6,
+                                 visibleCount);
+    }
+
+    std::cout << std::flush;
+
+    return 0;
+}
+
+// Compares every query of the instance hierarchy with a linear scan over random boxes, checking that results match
+// and reporting the time of both
+int runBVHBenchmark(size_t boxCount) {
+    constexpr int kQueryCount{100};
+
+    std::mt19937 generator(42);
+    std::uniform_real_distribution<float> position(-500.0f, 500.0f);
+    std::uniform_real_distribution<float> size(0.1f, 5.0f);
+    std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+
+    std::vector<VIEAABB> boxes(boxCount);
+    for (VIEAABB &box: boxes) {
+        box.minimum = glm::vec3(position(generator), position(generator), position(generator));
+        box.maximum = box.minimum + glm::vec3(size(generator), size(generator), size(generator));
+    }
+
+    VIEBVH bvh;
+    auto start(std::chrono::steady_clock::now());
+    bvh.build(boxes);
+    std::chrono::duration<double, std::milli> buildTime(std::chrono::steady_clock::now() - start);
+
+    start = std::chrono::steady_clock::now();
+    bvh.refit(boxes);
+    std::chrono::duration<double, std::milli> refitTime(std::chrono::steady_clock::now() - start);
+
+    std::cout << fmt::format("{} boxes, {} nodes: built in {:.2f} ms, refitted in {:.2f} ms with {} workers\n",
+                             boxCount, bvh.getNodes().size(), buildTime.count(), refitTime.count(),
+                             tools::getWorkerCount());
+
+    int failureCount = 0;
+
+    // Runs the query on the hierarchy and linearly kQueryCount times, comparing sorted results
+    auto compare = [&](const char *name, const std::function<void(int, std::vector<uint32_t> &)> &query,
+                       const std::function<bool(int, const VIEAABB &)> &isMatching) {
+        std::chrono::duration<double, std::milli> treeTime{0};
+        std::chrono::duration<double, std::milli> linearTime{0};
+        size_t resultCount = 0;
+        int mismatchCount = 0;
+        std::vector<uint32_t> treeResults;
+        std::vector<uint32_t> linearResults;
+
+        for (int q = 0; q < kQueryCount; ++q) {
+            treeResults.clear();
+            auto queryStart(std::chrono::steady_clock::now());
+            query(q, treeResults);
+            treeTime += std::chrono::steady_clock::now() - queryStart;
+
+            linearResults.clear();
+            queryStart = std::chrono::steady_clock::now();
+            for (uint32_t i = 0; i < boxes.size(); ++i) {
+                if (isMatching(q, boxes[i])) {
+                    linearResults.push_back(i);
+                }
+            }
+            linearTime += std::chrono::steady_clock::now() - queryStart;
+
+            std::ranges::sort(treeResults);
+            mismatchCount += treeResults == linearResults ? 0 : 1;
+            resultCount += linearResults.size();
+        }
+
+        std::cout << fmt::format("  {}: {:.4f} ms, linear {:.4f} ms ({:.1f}x), {} results, {} mismatches\n", name,
+                                 treeTime.count() / kQueryCount, linearTime.count() / kQueryCount,
+                                 linearTime.count() / std::max(treeTime.count(), 1e-6), resultCount / kQueryCount,
+                                 mismatchCount);
+        failureCount += mismatchCount;
+    };
+
+    std::vector<VIEFrustum> frustums(kQueryCount);
+    std::vector<glm::vec4> spheres(kQueryCount);
+    std::vector<VIEAABB> queryBoxes(kQueryCount);
+
+    for (int q = 0; q < kQueryCount; ++q) {
+        VIECamera camera;
+        camera.center = glm::vec4(position(generator), position(generator), position(generator), 1.0f);
+        camera.lookAt = camera.center + glm::vec4(unit(generator), unit(generator), unit(generator), 0.0f);
+        camera.farPlane = 200.0f;
+        camera.updateView();
+        camera.updateProjection(16.0f / 9.0f);
+        frustums[q] = camera.getFrustum();
+
+        spheres[q] = glm::vec4(position(generator), position(generator), position(generator), 20.0f);
+        queryBoxes[q].minimum = glm::vec3(position(generator), position(generator), position(generator));
+        queryBoxes[q].maximum = queryBoxes[q].minimum + glm::vec3(30.0f);
+    }
+
+    compare("Frustum", [&](int q, std::vector<uint32_t> &results) {
+        bvh.queryFrustum(frustums[q], results);
+    }, [&](int q, const VIEAABB &box) {
+        // Positive vertex of the box against each plane
+        return std::ranges::all_of(frustums[q].planes, [&box](const glm::vec4 &plane) {
+            const glm::vec3 positive(plane.x >= 0 ? box.maximum.x : box.minimum.x,
+                                     plane.y >= 0 ? box.maximum.y : box.minimum.y,
+                                     plane.z >= 0 ? box.maximum.z : box.minimum.z);
+            return glm::dot(glm::vec3(plane), positive) + plane.w >= 0.0f;
+        });
+    });
+
+    compare("Sphere", [&](int q, std::vector<uint32_t> &results) {
+        bvh.querySphere(glm::vec3(spheres[q]), spheres[q].w, results);
+    }, [&](int q, const VIEAABB &box) {
+        return box.overlapsSphere(glm::vec3(spheres[q]), spheres[q].w);
+    });
+
+    compare("Box", [&](int q, std::vector<uint32_t> &results) {
+        bvh.queryBox(queryBoxes[q], results);
+    }, [&](int q, const VIEAABB &box) {
+        return box.overlaps(queryBoxes[q]);
+    });
+
+    // Rays from random points towards random boxes, so that most of them hit something
+    std::chrono::duration<double, std::milli> treeTime{0};
+    std::chrono::duration<double, std::milli> linearTime{0};
+    int mismatchCount = 0;
+    int hitCount = 0;
+
+    for (int q = 0; q < kQueryCount; ++q) {
+        const glm::vec3 origin(position(generator), position(generator), position(generator));
+        const glm::vec3 direction(boxes[generator() % boxCount].getCenter() - origin);
+
+        float treeDistance = 1.0f;
+        uint32_t treePrimitive = kUint32Max;
+        auto queryStart(std::chrono::steady_clock::now());
+        const bool isTreeHit = bvh.raycast(origin, direction, treeDistance, treePrimitive);
+        treeTime += std::chrono::steady_clock::now() - queryStart;
+
+        float linearDistance = 1.0f;
+        bool isLinearHit = false;
+        queryStart = std::chrono::steady_clock::now();
+        for (const VIEAABB &box: boxes) {
+            const glm::vec3 t0((box.minimum - origin) / direction);
+            const glm::vec3 t1((box.maximum - origin) / direction);
+            const float entry = std::max({glm::min(t0, t1).x, glm::min(t0, t1).y, glm::min(t0, t1).z, 0.0f});
+            const float exit = std::min({glm::max(t0, t1).x, glm::max(t0, t1).y, glm::max(t0, t1).z,
+                                         linearDistance});
+
+            if (entry <= exit && entry <= linearDistance) {
+                linearDistance = entry;
+                isLinearHit = true;
+            }
+        }
+        linearTime += std::chrono::steady_clock::now() - queryStart;
+
+        mismatchCount += (isTreeHit == isLinearHit && (!isTreeHit || std::abs(treeDistance - linearDistance) <= 1e-5f))
+                         ? 0 : 1;
+        hitCount += isTreeHit ? 1 : 0;
+    }
+
+    std::cout << fmt::format("  Ray: {:.4f} ms, linear {:.4f} ms ({:.1f}x), {} hits, {} mismatches\n",
+                             treeTime.count() / kQueryCount, linearTime.count() / kQueryCount,
+                             linearTime.count() / std::max(treeTime.count(), 1e-6), hitCount, mismatchCount);
+    failureCount += mismatchCount;
+
+    std::cout << fmt::format("BVH benchmark: {} mismatches", failureCount) << std::endl;
+
+    return failureCount == 0 ? 0 : 1;
+}
+
+// Checks the reference meshlet culler on four disjoint unit quads, one for each meshlet, against hand computed cases:
+// the frustum is the box [-10, 10]^3 and the camera looks from +z
+int runMeshletTest() {
+    struct Quad {
+        glm::vec3 center;
+        bool isFacingCamera;
+        bool isVisible;                 ///< Expected result
+        const char *name;
+    };
+
+    const std::array<Quad, 4> quads{
+            Quad{glm::vec3(0.0f, 0.0f, 0.0f), true, true, "inside"},
+            Quad{glm::vec3(30.0f, 0.0f, 0.0f), true, false, "outside"},
+            Quad{glm::vec3(10.5f, 0.0f, 0.0f), true, true, "straddling"},
+            Quad{glm::vec3(0.0f, 2.5f, 0.0f), false, false, "back facing"}
+    };
+
+    std::vector<VIEVertex> vertices;
+    std::vector<uint32_t> indices;
+
+    for (const Quad &quad: quads) {
+        const auto first = static_cast<uint32_t>(vertices.size());
+        const glm::vec3 normal(0.0f, 0.0f, quad.isFacingCamera ? 1.0f : -1.0f);
+
+        for (const glm::vec3 corner: {glm::vec3(-0.5f, -0.5f, 0.0f), glm::vec3(0.5f, -0.5f, 0.0f),
+                                      glm::vec3(0.5f, 0.5f, 0.0f), glm::vec3(-0.5f, 0.5f, 0.0f)}) {
+            vertices.push_back(VIEVertex{.pos = quad.center + corner, .normal = normal});
+        }
+
+        // Counter clockwise seen from +z when facing the camera
+        const std::array<uint32_t, 6> quadIndices(quad.isFacingCamera ? std::array<uint32_t, 6>{0, 1, 2, 0, 2, 3}
+                                                                      : std::array<uint32_t, 6>{0, 2, 1, 0, 3, 2});
+        for (uint32_t index: quadIndices) {
+            indices.push_back(first + index);
+        }
+    }
+
+    std::vector<VIEMeshlet> meshlets;
+    std::vector<uint32_t> meshletVertices;
+    std::vector<uint8_t> meshletTriangles;
+    tools::buildMeshlets(vertices, indices, meshlets, meshletVertices, meshletTriangles);
+
+    VIEFrustum frustum;
+    frustum.planes = {glm::vec4(1.0f, 0.0f, 0.0f, 10.0f), glm::vec4(-1.0f, 0.0f, 0.0f, 10.0f),
+                      glm::vec4(0.0f, 1.0f, 0.0f, 10.0f), glm::vec4(0.0f, -1.0f, 0.0f, 10.0f),
+                      glm::vec4(0.0f, 0.0f, 1.0f, 10.0f), glm::vec4(0.0f, 0.0f, -1.0f, 10.0f)};
+    const glm::vec3 cameraPosition(0.0f, 0.0f, 5.0f);
+    const glm::mat4x4 identity(1.0f);
+
+    int failureCount = 0;
+    auto check = [&failureCount](bool isPassed, const std::string &description) {
+        std::cout << (isPassed ? "  passed: " : "  FAILED: ") << description << "\n";
+        failureCount += isPassed ? 0 : 1;
+    };
+
+    check(meshlets.size() == quads.size(), fmt::format("{} meshlets built", meshlets.size()));
+    if (meshlets.size() != quads.size()) {
+        std::cout << std::flush;
+        return 1;
+    }
+
+    // Meshlets are seeded in triangle order, so that each quad is the meshlet with the same index
+    std::vector<uint32_t> expectedMeshlets;
+    for (uint32_t i = 0; i < quads.size(); ++i) {
+        const VIEMeshlet &meshlet(meshlets[i]);
+
+        check(glm::distance(glm::vec3(meshlet.boundingSphere), quads[i].center) < 1e-5f &&
+              std::abs(meshlet.boundingSphere.w - std::sqrt(0.5f)) < 1e-5f,
+              fmt::format("bounding sphere of the {} meshlet", quads[i].name));
+        check(meshlet.coneAxis.w < 1e-3f && std::abs(meshlet.coneAxis.z - (quads[i].isFacingCamera ? 1.0f : -1.0f)) <
+                                            1e-5f, fmt::format("normal cone of the {} meshlet", quads[i].name));
+        check(tools::isMeshletVisible(meshlet, identity, frustum, cameraPosition) == quads[i].isVisible,
+              fmt::format("{} meshlet {}", quads[i].name, quads[i].isVisible ? "visible" : "culled"));
+
+        if (quads[i].isVisible) {
+            expectedMeshlets.push_back(i);
+        }
+    }
+
+    // Instance transforms move the bounds, and non uniform scales disable the cone test
+    check(tools::isMeshletVisible(meshlets[1], glm::translate(identity, glm::vec3(-30.0f, 0.0f, 0.0f)), frustum,
+                                  cameraPosition), "outside meshlet visible once moved inside");
+    check(tools::isMeshletVisible(meshlets[3], glm::scale(identity, glm::vec3(1.0f, 2.0f, 1.0f)), frustum,
+                                  cameraPosition), "back facing meshlet visible when scaled non uniformly");
+    check(!tools::isMeshletVisible(meshlets[0], identity, frustum, glm::vec3(0.0f, 0.0f, -5.0f)),
+          "inside meshlet culled when seen from behind");
+
+    std::vector<uint32_t> visibleMeshlets;
+    const size_t visibleCount = tools::cullMeshlets(meshlets, identity, frustum, cameraPosition, visibleMeshlets);
+    check(visibleCount == expectedMeshlets.size() && visibleMeshlets == expectedMeshlets,
+          fmt::format("cullMeshlets keeps {} of {} meshlets", visibleCount, meshlets.size()));
+
+    std::cout << fmt::format("Meshlet test: {} failed checks", failureCount) << std::endl;
+
+    return failureCount == 0 ? 0 : 1;
+}
+
+// Releases a range of meshes from a pool, compacts it and checks that the surviving meshes still reference their own
+// vertices, indices, levels of detail and meshlets; then frees the arenas and releases and compacts again
+int runMeshPoolTest() {
+    constexpr uint32_t kMeshCount{6};
+
+    int failureCount = 0;
+    auto check = [&failureCount](bool isPassed, const std::string &description) {
+        std::cout << (isPassed ? "  passed: " : "  FAILED: ") << description << "\n";
+        failureCount += isPassed ? 0 : 1;
+    };
+
+    // Each mesh is a strip of quads whose vertices are tagged by the mesh number, so misplaced data is detected
+    std::array<std::vector<VIEVertex>, kMeshCount> meshVertices;
+    std::array<std::vector<uint32_t>, kMeshCount> meshIndices;
+
+    for (uint32_t m = 0; m < kMeshCount; ++m) {
+        for (uint32_t q = 0; q <= m + 1; ++q) {
+            for (float y: {0.0f, 1.0f}) {
+                meshVertices[m].push_back(VIEVertex{.pos = glm::vec3(float(q), y, float(m)),
+                                                    .normal = glm::vec3(0.0f, 0.0f, 1.0f)});
+            }
+        }
+
+        for (uint32_t q = 0; q <= m; ++q) {
+            for (uint32_t index: {0u, 2u, 3u, 0u, 3u, 1u}) {
+                meshIndices[m].push_back(q * 2 + index);
+            }
+        }
+    }
+
+    VIEMeshPool meshPool;
+    const std::array<VIEMeshRange, 3> ranges{meshPool.createMeshes(2), meshPool.createMeshes(2),
+                                             meshPool.createMeshes(2)};
+
+    for (uint32_t m = 0; m < kMeshCount; ++m) {
+        const VIEMeshHandle handle(meshPool.getHandle(ranges[m / 2], m % 2));
+        meshPool.setGeometry(handle, meshVertices[m], meshIndices[m]);
+
+        // Coarsest level keeps the first quad only
+        const std::array<std::vector<uint32_t>, 1> lodIndices{
+                std::vector<uint32_t>(meshIndices[m].begin(), meshIndices[m].begin() + 6)};
+        const std::array<float, 1> lodErrors{float(m)};
+        meshPool.setLods(handle, lodIndices, lodErrors);
+
+        std::vector<VIEMeshlet> meshlets;
+        std::vector<uint32_t> meshletVertices;
+        std::vector<uint8_t> meshletTriangles;
+        tools::buildMeshlets(meshVertices[m], meshIndices[m], meshlets, meshletVertices, meshletTriangles);
+        meshPool.setMeshlets(handle, meshlets, meshletVertices, meshletTriangles);
+    }
+
+    const VIEMeshHandle releasedHandle(meshPool.getHandle(ranges[1], 0));
+    meshPool.releaseMeshes(ranges[1]);
+    meshPool.compactGeometry();
+
+    check(!meshPool.getMesh(releasedHandle) && meshPool.getMeshes(ranges[1]).empty(),
+          "released handles are stale");
+
+    size_t meshletVertexTotal = 0;
+    for (const uint32_t m: {0u, 1u, 4u, 5u}) {
+        const VIEMesh *mesh = meshPool.getMesh(meshPool.getHandle(ranges[m / 2], m % 2));
+
+        if (!mesh) {
+            check(false, fmt::format("mesh {} alive after compaction", m));
+            continue;
+        }
+
+        const std::span<const VIEVertex> vertices(meshPool.getVertices().data() + mesh->firstVertex,
+                                                  mesh->vertexCount);
+        const std::span<const uint32_t> indices(meshPool.getIndices().data() + mesh->firstIndex, mesh->indexCount);
+        const std::span<const uint32_t> lodIndices(meshPool.getIndices().data() + mesh->firstIndex +
+                                                   mesh->lods[1].firstIndex, mesh->lods[1].indexCount);
+
+        check(std::ranges::equal(vertices, meshVertices[m], [](const VIEVertex &a, const VIEVertex &b) {
+                  return a.pos == b.pos;
+              }), fmt::format("vertices of mesh {}", m));
+        check(std::ranges::equal(indices, meshIndices[m]), fmt::format("indices of mesh {}", m));
+        check(mesh->lodCount == 2 && mesh->lods[1].error == float(m) &&
+              std::ranges::equal(lodIndices, std::span(meshIndices[m]).first(6)),
+              fmt::format("levels of detail of mesh {}", m));
+
+        // Meshlet vertices index the mesh vertices, so they must still land on the vertices of the same mesh
+        bool isMeshletValid = mesh->meshletCount > 0;
+        for (const VIEMeshlet &meshlet: meshPool.getMeshlets(*mesh)) {
+            for (uint32_t i = 0; i < meshlet.vertexCount; ++i) {
+                const uint32_t vertex = meshPool.getMeshletVertices()[meshlet.vertexOffset + i];
+                isMeshletValid &= vertex < vertices.size() && vertices[vertex].pos.z == float(m);
+            }
+            meshletVertexTotal += meshlet.vertexCount;
+        }
+        check(isMeshletValid, fmt::format("meshlets of mesh {}", m));
+    }
+
+    check(meshPool.getMeshletVertices().size() == meshletVertexTotal, "meshlet arrays hold surviving meshes only");
+
+    // Released slots are reused with a new generation
+    const VIEMeshRange reused(meshPool.createMeshes(2));
+    check(reused.first.index == ranges[1].first.index && reused.first.generation != ranges[1].first.generation,
+          "released slots reused by a new range");
+
+    // Once the arenas are freed, records hold no geometry, so releasing and compacting never read the old arenas
+    meshPool.releaseGeometry();
+    meshPool.releaseMeshes(ranges[0]);
+    meshPool.compactGeometry();
+
+    const std::span<const VIEMesh> survivors(meshPool.getMeshes(ranges[2]));
+    check(survivors.size() == 2 && std::ranges::all_of(survivors, [](const VIEMesh &mesh) {
+              return mesh.vertexCount == 0 && mesh.getIndexSpan() == 0 && mesh.lodCount == 2 && mesh.meshletCount > 0;
+          }), "records without geometry after releasing the arenas");
+
+    std::cout << fmt::format("Mesh pool test: {} failed checks", failureCount) << std::endl;
+
+    return failureCount == 0 ? 0 : 1;
+}
+
+// Measures the job system: empty jobs, a fork-join tree (spread by stealing), a chain of dependent jobs, jobs sent
+// to the main thread by workers, and a parallel loop on one worker and on every worker
+int runSchedulerBenchmark(size_t jobCount) {
+    constexpr int kRepetitions{10};
+    constexpr size_t kLoopSize{1 << 22};
+
+    tools::startJobSystem();
+
+    // Nanoseconds per job of the best run
+    auto measure = [](size_t count, const std::function<void()> &run) {
+        double best = std::numeric_limits<double>::max();
+
+        for (int i = 0; i < kRepetitions; ++i) {
+            auto start(std::chrono::steady_clock::now());
+            run();
+            std::chrono::duration<double, std::nano> elapsed(std::chrono::steady_clock::now() - start);
+            best = std::min(best, elapsed.count());
+        }
+
+        return best / static_cast<double>(std::max<size_t>(count, 1));
+    };
+
+    std::cout << fmt::format("{} jobs, {} workers\n", jobCount, tools::getWorkerCount());
+
+    const double emptyJobs = measure(jobCount, [jobCount]() {
+        VIEJobCounter counter;
+
+        for (size_t i = 0; i < jobCount; ++i) {
+            tools::runJob([]() {}, &counter);
+        }
+
+        tools::waitForCounter(counter);
+    });
+
+    // Each job queues two children on its own worker, idle workers steal them
+    const auto treeDepth = static_cast<uint32_t>(std::max<size_t>(1, std::bit_width(jobCount) - 1));
+    const double forkJoin = measure((size_t{2} << treeDepth) - 2, [treeDepth]() {
+        VIEJobCounter counter;
+        std::function<void(uint32_t)> fork;
+
+        fork = [&counter, &fork](uint32_t depth) {
+            if (depth > 0) {
+                tools::runJob([&fork, depth]() { fork(depth - 1); }, &counter);
+                tools::runJob([&fork, depth]() { fork(depth - 1); }, &counter);
+            }
+        };
+
+        fork(treeDepth);
+        tools::waitForCounter(counter);
+    });
+
+    const size_t chainLength = std::min<size_t>(jobCount, 10000);
+    const double dependencyChain = measure(chainLength, [chainLength]() {
+        std::vector<VIEJobCounter> counters(chainLength);
+        tools::runJob([]() {}, &counters[0]);
+
+        for (size_t i = 1; i < chainLength; ++i) {
+            tools::runJobAfter(counters[i - 1], []() {}, &counters[i]);
+        }
+
+        tools::waitForCounter(counters.back());
+    });
+
+    const double mainThreadJobs = measure(jobCount, [jobCount]() {
+        VIEJobCounter counter;
+
+        for (size_t i = 0; i < jobCount; ++i) {
+            tools::runJob([&counter]() { tools::runOnMainThread([]() {}, &counter); }, &counter);
+        }
+
+        tools::waitForCounter(counter);
+    });
+
+    std::cout << fmt::format("  empty jobs: {:.1f} ns/job\n", emptyJobs);
+    std::cout << fmt::format("  fork-join tree: {:.1f} ns/job\n", forkJoin);
+    std::cout << fmt::format("  dependency chain: {:.1f} ns/job\n", dependencyChain);
+    std::cout << fmt::format("  main thread jobs: {:.1f} ns/job\n", mainThreadJobs);
+
+    std::vector<float> values(kLoopSize);
+    auto loop([&values](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            values[i] = std::sqrt(static_cast<float>(i)) * std::sin(static_cast<float>(i));
+        }
+    });
+
+    const double singleWorker = measure(1, [&loop]() { loop(0, kLoopSize); }) * 1e-6;
+    const double allWorkers = measure(1, [&loop]() { tools::parallelFor(kLoopSize, 4096, loop); }) * 1e-6;
+
+    std::cout << fmt::format("  parallel loop: {:.2f} ms on one worker, {:.2f} ms on every worker ({:.2f}x)",
+                             singleWorker, allWorkers, singleWorker / std::max(allWorkers, 1e-6)) << std::endl;
+
+    return 0;
+}
+
+// Chains jobs with runJobAfter while the counters they depend on are completing on other workers, so that a
+// continuation added as the last job leaves its counter must still run: every chain has to end before the deadline
+int runJobChainTest(size_t chainCount) {
+    constexpr size_t kChainLength{8};
+    constexpr size_t kBatchSize{256};
+    constexpr auto kTimeout{std::chrono::seconds(30)};
+
+    tools::startJobSystem();
+
+    const auto deadline(std::chrono::steady_clock::now() + kTimeout);
+    std::atomic<size_t> linkCount{0};
+
+    for (size_t first = 0; first < chainCount; first += kBatchSize) {
+        const size_t batchSize = std::min(kBatchSize, chainCount - first);
+        auto chains(std::make_unique<std::array<VIEJobCounter, kChainLength>[]>(batchSize));
+        VIEJobCounter submitters;
+
+        // Links are queued by jobs running alongside the ones they follow, which may be leaving their counters
+        for (size_t chain = 0; chain < batchSize; ++chain) {
+            std::array<VIEJobCounter, kChainLength> &counters(chains[chain]);
+            tools::runJob([]() {}, &counters[0]);
+
+            for (size_t link = 1; link < kChainLength; ++link) {
+                tools::runJob([&counters, &linkCount, link]() {
+                    tools::runJobAfter(counters[link - 1], [&linkCount]() {
+                        linkCount.fetch_add(1, std::memory_order_relaxed);
+                    }, &counters[link]);
+                }, &submitters);
+            }
+        }
+
+        bool isTimedOut = false;
+        tools::waitUntil([&]() {
+            isTimedOut = std::chrono::steady_clock::now() > deadline;
+
+            return isTimedOut || (submitters.isDone() &&
+                                  std::all_of(chains.get(), chains.get() + batchSize, [](const auto &counters) {
+                                      return std::ranges::all_of(counters, &VIEJobCounter::isDone);
+                                  }));
+        });
+
+        if (isTimedOut) {
+            std::cout << fmt::format("Job chain test: FAILED, chains hanging after {} links (lost continuations)",
+                                     linkCount.load()) << std::endl;
+
+            // Hanging chains still reference their counters, so they are leaked
+            chains.release();
+            std::quick_exit(1);
+        }
+    }
+
+    const bool isPassed = linkCount.load() == chainCount * (kChainLength - 1);
+    std::cout << fmt::format("Job chain test: {} chains, {} links run{}", chainCount, linkCount.load(),
+                             isPassed ? "" : ", FAILED") << std::endl;
+
+    return isPassed ? 0 : 1;
+}
+
+// Renders frames of the sample scenario with both eye cameras, and checks that the eyes read back are rendered and
+// differ from each other (cameras are interpupillaryDistance apart)
+int runStereoTest(uint64_t frameCount) {
+    VIESettings settings("./settings.xml");
+    settings.isStereoEnabled = true;
+
+    auto engine(std::make_unique<VIEngine>(std::move(settings)));
+
+    if (!engine->prepareEngine()) {
+        std::cout << "Stereo test: cannot prepare engine" << std::endl;
+        return 1;
+    }
+
+    engine->runEngine(frameCount);
+
+    std::vector<uint8_t> pixels;
+    if (!engine->captureStereoFrame(pixels) || pixels.empty() || pixels.size() % 8 != 0) {
+        std::cout << "Stereo test: cannot read back the stereo frame" << std::endl;
+        return 1;
+    }
+
+    // Left eye first, then the right one, with the same size
+    const size_t eyeSize = pixels.size() / 2;
+    std::span<const uint8_t> leftEye(pixels.data(), eyeSize);
+    std::span<const uint8_t> rightEye(pixels.data() + eyeSize, eyeSize);
+
+    auto isUniform = [](std::span<const uint8_t> eye) {
+        for (size_t i = 4; i < eye.size(); i += 4) {
+            if (!std::equal(eye.begin(), eye.begin() + 4, eye.begin() + static_cast<std::ptrdiff_t>(i))) {
+                return false;
+            }
+        }
+
+        return true;
+    };
+
+    size_t differentTexels = 0;
+    for (size_t i = 0; i < eyeSize; i += 4) {
+        differentTexels += std::equal(leftEye.begin() + static_cast<std::ptrdiff_t>(i),
+                                      leftEye.begin() + static_cast<std::ptrdiff_t>(i + 4),
+                                      rightEye.begin() + static_cast<std::ptrdiff_t>(i)) ? 0 : 1;
+    }
+
+    const bool isRendered = !isUniform(leftEye) && !isUniform(rightEye);
+    std::cout << fmt::format("Stereo test: {} texels for each eye, {} differ between eyes{}", eyeSize / 4,
+                             differentTexels, isRendered ? "" : ", an eye is empty") << std::endl;
+
+    return isRendered && differentTexels > 0 ? 0 : 1;
+}
+
+// Draws the scenario for a number of frames and writes the GPU time of each pass as JSON
+int runGpuBenchmark(uint64_t frameCount, const std::string &outputLocation) {
+    auto engine(std::make_unique<VIEngine>(VIESettings("./settings.xml")));
+
+    if (!engine->prepareEngine()) {
+        std::cout << "GPU benchmark: cannot prepare engine" << std::endl;
+        return 1;
+    }
+
+    engine->runEngine(frameCount);
+
+    const std::vector<VIEGpuTiming> &timings(engine->getGpuTimings());
+    if (timings.empty()) {
+        std::cout << "GPU benchmark: no timings (profiling disabled or timestamps not supported)" << std::endl;
+        return 1;
+    }
+
+    std::string json(fmt::format("{{\n  \"frames\": {},\n  \"passes\": [\n", frameCount));
+    for (size_t i = 0; i < timings.size(); ++i) {
+        json += fmt::format("    {{\"name\": \"{}\", \"averageMs\": {:.4f}, \"lastMs\": {:.4f}}}{}\n",
+                            timings[i].name, timings[i].averageMs, timings[i].lastMs,
+                            i + 1 < timings.size() ? "," : "");
+
+        std::cout << fmt::format("{}: {:.3f} ms (last {:.3f} ms)\n", timings[i].name, timings[i].averageMs,
+                                 timings[i].lastMs);
+    }
+    json += "  ],\n  \"heaps\": [\n";
+
+    // Memory of the device heaps after the last frame (sizes and no usage without VK_EXT_memory_budget)
+    const std::vector<VIEHeapBudget> &heaps(engine->getMemoryBudgets());
+    for (size_t i = 0; i < heaps.size(); ++i) {
+        json += fmt::format("    {{\"deviceLocal\": {}, \"sizeMiB\": {}, \"budgetMiB\": {}, \"usageMiB\": {}}}{}\n",
+                            heaps[i].isDeviceLocal, heaps[i].size >> 20, heaps[i].budget >> 20,
+                            heaps[i].usage >> 20, i + 1 < heaps.size() ? "," : "");
+
+        std::cout << fmt::format("Heap {}: {} of {} MiB budget used\n", i, heaps[i].usage >> 20,
+                                 heaps[i].budget >> 20);
+    }
+    json += "  ],\n  \"statuses\": [\n";
+
+    // Startup stages, each with the status reached
+    const std::vector<VIEStatusTiming> &statusTimings(engine->getStatusTimings());
+    for (size_t i = 0; i < statusTimings.size(); ++i) {
+        json += fmt::format("    {{\"status\": \"{}\", \"stage\": \"{}\", \"durationMs\": {:.3f}, "
+                            "\"hostDeltaKiB\": {}, \"deviceDeltaKiB\": {}}}{}\n",
+                            fromVIEStatusToString(statusTimings[i].status), statusTimings[i].stage,
+                            statusTimings[i].durationMs, statusTimings[i].hostMemoryDelta / 1024,
+                            statusTimings[i].deviceMemoryDelta / 1024, i + 1 < statusTimings.size() ? "," : "");
+    }
+    json += "  ]\n}\n";
+
+    std::ofstream output(outputLocation);
+    if (!output) {
+        std::cout << "GPU benchmark: cannot write " << outputLocation << std::endl;
+        return 1;
+    }
+
+    output << json;
+    std::cout << "Written " << outputLocation << std::endl;
+
+    return 0;
+}
+
 int main(int argc, char** argv) {
+    // LOD generation benchmark: --lod-benchmark [model.obj]
+    if (argc > 1 && std::string_view(argv[1]) == "--lod-benchmark") {
+        return runLodBenchmark(argc > 2 ? argv[2] : "models/David/David.obj");
+    }
+
+    // Frustum culling benchmark: --culling-benchmark [sphere count]
+    if (argc > 1 && std::string_view(argv[1]) == "--culling-benchmark") {
+        return runCullingBenchmark(argc > 2 ? std::stoull(argv[2]) : 4000000);
+    }
+
+    // Instance hierarchy benchmark: --bvh-benchmark [box count]
+    if (argc > 1 && std::string_view(argv[1]) == "--bvh-benchmark") {
+        return runBVHBenchmark(argc > 2 ? std::stoull(argv[2]) : 200000);
+    }
+
+    // Meshlet culling test: --meshlet-test
+    if (argc > 1 && std::string_view(argv[1]) == "--meshlet-test") {
+        return runMeshletTest();
+    }
+
+    // Mesh pool release and compaction test: --mesh-pool-test
+    if (argc > 1 && std::string_view(argv[1]) == "--mesh-pool-test") {
+        return runMeshPoolTest();
+    }
+
+    // Job system benchmark: --scheduler-benchmark [job count]
+    if (argc > 1 && std::string_view(argv[1]) == "--scheduler-benchmark") {
+        return runSchedulerBenchmark(argc > 2 ? std::stoull(argv[2]) : 100000);
+    }
+
+    // Job dependency test: --job-chain-test [chain count]
+    if (argc > 1 && std::string_view(argv[1]) == "--job-chain-test") {
+        return runJobChainTest(argc > 2 ? std::stoull(argv[2]) : 100000);
+    }
+
+    // Stereo rendering test: --stereo-test [frame count]
+    if (argc > 1 && std::string_view(argv[1]) == "--stereo-test") {
+        return runStereoTest(argc > 2 ? std::stoull(argv[2]) : 60);
+    }
+
+    // GPU pass timings benchmark: --gpu-benchmark [frame count] [output.json]
+    if (argc > 1 && std::string_view(argv[1]) == "--gpu-benchmark") {
+        return runGpuBenchmark(argc > 2 ? std::stoull(argv[2]) : 1000, argc > 3 ? argv[3] : "gpu_timings.json");
+    }
+
     // Initialising engine
     std::cout << "Sizeof VIEngine: " << sizeof(VIEngine) << " bytes" << std::endl;
     std::cout << "Sizeof VIESettings: " << sizeof(VIESettings) << " bytes" << std::endl;
     auto engine(std::make_unique<VIEngine>(VIESettings("./settings.xml")));
+    // The scenario is loaded by prepareEngine, along with the device
     engine->prepareEngine();
     engine->runEngine();
     engine.reset();